@@ -43,6 +43,56 @@ void parse(XCSP3MistralCallbacks& cb, const char* instancefile) {
   // cout << "end parse\n";
 }
 
+// the declared variables (name, id or value, initial bounds and degree), so
+// that solutions can be printed from a snapshot without the instance file
+std::string get_snapshot_payload(XCSP3MistralCallbacks &cb) {
+  std::string payload;
+  auto add_int = [&payload](int x) {
+    payload.append((const char *)&x, sizeof(int));
+  };
+
+  add_int(cb.variables.size);
+  for (size_t i = 0; i < cb.variables.size; ++i) {
+    Variable var = cb.variables[i];
+    add_int(cb.var_ids[i].size());
+    payload += cb.var_ids[i];
+    add_int(var.id());
+    add_int(var.id() >= 0 ? var.get_initial_min() : var.get_min());
+    add_int(var.id() >= 0 ? var.get_initial_max() : var.get_max());
+    add_int(cb.initial_degree[i]);
+  }
+  return payload;
+}
+
+void load_snapshot(XCSP3MistralCallbacks &cb, const char *snapshotfile) {
+  std::string payload;
+  if (!cb.solver.load_snapshot(snapshotfile, &payload))
+    exit(1);
+
+  const char *p = payload.data();
+  auto get_int = [&p]() {
+    int x;
+    memcpy(&x, p, sizeof(int));
+    p += sizeof(int);
+    return x;
+  };
+
+  int n = get_int();
+  for (int i = 0; i < n; ++i) {
+    int len = get_int();
+    string name(p, len);
+    p += len;
+    int id = get_int(), lb = get_int(), ub = get_int();
+    Variable X = (id >= 0 ? cb.solver.variables[id]
+                          : (lb == ub ? Variable(lb) : Variable(lb, ub)));
+    cb.variables.add(X);
+    cb.var_ids.push_back(name);
+    cb.variable[name] = X;
+    cb.initial_degree.push_back(get_int());
+  }
+  cb.goal = cb.solver.objective;
+}
+
 void read_solution(XCSP3MistralCallbacks &cb, std::istream &is, vector<string>& vars, map<string, int>& sol) {
 
   string buffer;
@@ -128,35 +178,41 @@ void print_outcome(XCSP3MistralCallbacks &cb, std::ostream &os) {
   }
 }
 
-void print_solution(XCSP3MistralCallbacks &cb, std::ostream &os, char v = 'v') {
+void print_solution(XCSP3MistralCallbacks &cb, SolutionWriter &out,
+                    char v = 'v') {
   if (cb.solver.statistics.num_solutions > 0) {
-    os << v << " <instantiation type=\"";
+    out << v << " <instantiation type=\"";
     if (cb.solver.statistics.outcome == OPT)
-      os << "optimum\" cost=\"" << cb.solver.statistics.objective_value
-         << "\">\n";
+      out << "optimum\" cost=\"" << cb.solver.statistics.objective_value
+          << "\">\n";
     else
-      os << "solution\">\n";
-    os << v << "   <list>";
+      out << "solution\">\n";
+    out << v << "   <list>";
     for (auto id : cb.var_ids) {
-      os << " " << id;
+      out << ' ' << id;
     }
-    os << " </list>\nv   <values>";
+    out << " </list>\nv   <values>";
 
     for (size_t i = 0; i < cb.variables.size; ++i) {
       Variable var = cb.variables[i];
       int deg = cb.initial_degree[i];
       if (deg == 0 && var.get_initial_min() < var.get_initial_max()) {
-        os << " *";
+        out << " *";
       } else if (var.id() >= 0)
-        os << " " << cb.solver.last_solution_lb[var.id()];
+        out << ' ' << cb.solver.last_solution_lb[var.id()];
       else
-        os << " " << var.get_value();
+        out << ' ' << var.get_value();
     }
 
-    os << " </values>\n" << v << " </instantiation>\n";
+    out << " </values>\n" << v << " </instantiation>\n";
   }
 }
 
+void print_solution(XCSP3MistralCallbacks &cb, std::ostream &os, char v = 'v') {
+  SolutionWriter out(os, 0);
+  print_solution(cb, out, v);
+}
+
 class ObjectivePrinter : public SolutionListener {
 
 public:
@@ -169,7 +225,31 @@ public:
   }
 };
 
+// writes every solution, as the raw vector of values of the solver's variables
+class BinaryPrinter : public SolutionListener {
+
+public:
+  Solver *solver;
+  std::ofstream file;
+  SolutionWriter out;
+
+  BinaryPrinter(Solver *s, const std::string &filename, const int period)
+      : SolutionListener(), solver(s),
+        file(filename.c_str(), std::ios_base::out | std::ios_base::binary),
+        out(file, period) {}
+
+  void notify_solution() {
+    out.write_binary(solver->last_solution_lb.stack_,
+                     solver->last_solution_lb.size);
+    out.end_solution();
+  }
+};
+
+BinaryPrinter *binary_ptr = NULL;
+
 static void Mistral_SIGTERM_handler(int signum) {
+  if (binary_ptr)
+    binary_ptr->out.flush();
   if (cb_ptr->solver.statistics.num_solutions > 0) {
     std::cout << "s SATISFIABLE\n";
     print_solution(*cb_ptr, std::cout);
@@ -216,6 +296,24 @@ int main(int argc, char **argv) {
                                            "propagate and print", false);
   cmd.add(propagate_and_print_Arg);
 
+  TCLAP::ValueArg<int> intension_table_Arg(
+      "", "intension_table",
+      "intension constraints over at most this many tuples are tabled "
+      "(0: never)",
+      false, 4096, "int");
+  cmd.add(intension_table_Arg);
+
+  TCLAP::ValueArg<string> dump_snapshot_Arg(
+      "", "dump-snapshot",
+      "write the consolidated model to this binary file and exit", false, "",
+      "string");
+  cmd.add(dump_snapshot_Arg);
+
+  TCLAP::SwitchArg load_snapshot_Arg(
+      "", "load-snapshot",
+      "the instance file is a snapshot written with --dump-snapshot", false);
+  cmd.add(load_snapshot_Arg);
+
   cmd.parse(argc, argv);
 
   usrand(cmd.get_seed());
@@ -229,8 +327,31 @@ int main(int argc, char **argv) {
 
   XCSP3MistralCallbacks cb(
       solver); // my interface between the parser and the solver
+  cb.intension_table_limit = intension_table_Arg.getValue();
+
+  if (load_snapshot_Arg.getValue())
+    load_snapshot(cb, cmd.get_filename().c_str());
+  else
+    parse(cb, cmd.get_filename().c_str());
+
+  if (dump_snapshot_Arg.getValue() != "") {
+    if (!solver.dump_snapshot(dump_snapshot_Arg.getValue().c_str(),
+                              get_snapshot_payload(cb)))
+      return 1;
+    std::cout << "c snapshot written to " << dump_snapshot_Arg.getValue()
+              << std::endl;
+    return 0;
+  }
 
-  parse(cb, cmd.get_filename().c_str());
+  if (cmd.get_binary_solutions() != "") {
+    binary_ptr = new BinaryPrinter(&solver, cmd.get_binary_solutions(),
+                                   cmd.get_flush_period());
+    if (!binary_ptr->file.good()) {
+      std::cerr << "cannot open " << cmd.get_binary_solutions() << std::endl;
+      return 1;
+    }
+    solver.add(binary_ptr);
+  }
 
   cb_ptr = &cb;
   signal(SIGTERM, Mistral_SIGTERM_handler);
@@ -238,6 +359,9 @@ int main(int argc, char **argv) {
 
   // std::cout << "c parsetime " << (get_run_time() - cpu_time) << std::endl;
 
+  if (solver.parameters.presolve)
+    solver.presolve();
+
   if (cmd.print_model())
     std::cout << solver << std::endl;
 
@@ -344,6 +468,7 @@ int main(int argc, char **argv) {
 
     solver.initialise_search(sequence, heuristic, new NoRestart(), NULL, false);
 
+    SolutionWriter out(std::cout, cmd.get_flush_period());
     while ((countArg.getValue() < 1 || countArg.getValue() > num_solutions) &&
            solver.get_next_solution() == SAT) {
       ++num_solutions;
@@ -351,15 +476,16 @@ int main(int argc, char **argv) {
       if (num_solutions <= 1000 ||
           (num_solutions <= 10000 && (num_solutions % 100 == 0)) ||
           (num_solutions % 1000 == 0)) {
-        cout << " numsol = " << num_solutions;
+        out << " numsol = " << num_solutions;
 
         for (auto var : cb.variables) {
           if (var.id() >= 0)
-            cout << " " << cb.solver.last_solution_lb[var.id()];
+            out << ' ' << cb.solver.last_solution_lb[var.id()];
           else
-            cout << " " << var.get_value();
+            out << ' ' << var.get_value();
         }
-        cout << endl;
+        out << '\n';
+        out.end_solution();
 
         ofstream solfile("sols/sol" + int2str(num_solutions) + ".txt",
                          ofstream::out);
@@ -368,6 +494,7 @@ int main(int argc, char **argv) {
         solfile.close();
       }
     }
+    out.flush();
     cout << num_solutions << endl;
 
   } else {
@@ -417,5 +544,7 @@ int main(int argc, char **argv) {
       print_solution(cb, std::cout);
   }
 
+  delete binary_ptr;
+
   return 0;
 }
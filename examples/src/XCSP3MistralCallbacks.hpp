@@ -33,6 +33,7 @@
 
 #include "mistral_solver.hpp"
 #include <map>
+#include <unordered_map>
 
 /**
 * This is an example that prints useful informations of a XCSP3 instance.
@@ -69,6 +70,7 @@ class XCSP3MistralCallbacks : public XCSP3CoreCallbacks {
 
 protected:
   void addCondition(Mistral::Variable X, XCondition &cond);
+  void addLexChain(vector<Mistral::VarArray> &rows, OrderType order);
   // void addSumConstraint(Mistral::VarArray &scope, vector<int> &coeffs,
   // XCondition &cond);
   void addSumConstraint(vector<Mistral::Variable> &scope, vector<int> &coeffs,
@@ -532,6 +534,35 @@ public:
 
   Mistral::Variable postExpression(Node *n, int level);
 
+  /* Intension compiler: a tree is canonicalised into a postfix program over
+   * placeholder variables (numbered by first occurrence), whose textual shape
+   * serves as a hash key. Recognisable primitives are mapped to dedicated
+   * propagators, trees over small cartesian products become tables that are
+   * computed once per (shape, domains) and shared, and the rest goes through
+   * postExpression.
+   */
+  struct IntensionTable {
+    Mistral::Vector<const int *> *tuples;
+    bool support;
+  };
+
+  int intension_table_limit;
+  vector<string> intension_scope;
+  unordered_map<string, int> intension_index;
+  vector<int> intension_code;
+  vector<int> intension_stack;
+  bool intension_undefined;
+  string intension_key;
+  unordered_map<string, IntensionTable> intension_tables;
+
+  void postIntension(Node *n);
+  static bool linearTerm(Node *n, NodeVariable *&x, int &k);
+  static bool distanceTerm(Node *n, NodeVariable *&x, NodeVariable *&y);
+  bool postPrimitiveIntension(Node *n);
+  bool postTableIntension();
+  bool compileIntension(Node *n);
+  int evaluateIntension(const int *tuple);
+
   void assign(string& var, int val);
 };
 }
@@ -545,6 +576,8 @@ XCSP3MistralCallbacks::XCSP3MistralCallbacks(Solver &s)
 
   intensionUsingString = true;
   recognizeSpecialIntensionCases = false;
+
+  intension_table_limit = 4096;
 }
 
 void XCSP3MistralCallbacks::getVariables(vector<XVariable *> &list,
@@ -1105,7 +1138,7 @@ void XCSP3MistralCallbacks::buildConstraintIntension(string id, string expr) {
   tree.dispose();
 #else
   Tree tree(expr);
-  solver.add(postExpression(tree.root, true));
+  postIntension(tree.root);
 // delete tree.root;
 #endif
 }
@@ -1115,7 +1148,7 @@ void XCSP3MistralCallbacks::buildConstraintIntension(string id, Tree *tree) {
   cout << "\n    intension constraint with tree : " << id << endl;
 #endif
 
-  solver.add(postExpression(tree->root, true));
+  postIntension(tree->root);
 }
 
 void XCSP3MistralCallbacks::buildConstraintPrimitive(string id, OrderType op,
@@ -1382,13 +1415,20 @@ void XCSP3MistralCallbacks::buildConstraintBinPacking(string id,
       the_max = vmax;
   }
 
-  vector<vector<Variable>> bin(the_max - the_min + 1);
-  for (auto b{the_min}; b <= the_max; ++b) {
-    for (auto x : list) {
-      bin[b - the_min].emplace_back(variable[x->id] == b);
-    }
-    addSumConstraint(bin[b-the_min], sizes, cond);
-  }
+  int total{0};
+  for (auto s : sizes)
+    total += s;
+
+  Vector<Variable> items;
+  for (auto x : list)
+    items.add(variable[x->id]);
+  Vector<Variable> load;
+  for (auto b{the_min}; b <= the_max; ++b)
+    load.add(Variable(0, total));
+
+  solver.add(BinPacking(items, sizes, load, the_min));
+  for (auto b{0}; b < load.size; ++b)
+    addCondition(load[b], cond);
 }
 
 void XCSP3MistralCallbacks::buildConstraintBinPacking(string id,
@@ -1396,39 +1436,59 @@ void XCSP3MistralCallbacks::buildConstraintBinPacking(string id,
                                                       vector<int> &sizes,
                                                       vector<int> &capacities,
                                                       bool load) {
-  vector<vector<Variable>> bin(capacities.size());
-  for (auto b{0}; b < capacities.size(); ++b) {
-    for (auto x : list) {
-      bin[b].emplace_back(variable[x->id] == b);
-    }
-    solver.add(Sum(bin[b], sizes, -INFTY, capacities[b]));
-  }
+  int total{0};
+  for (auto s : sizes)
+    total += s;
+
+  Vector<Variable> items;
+  for (auto x : list)
+    items.add(variable[x->id]);
+  // with 'load', the capacities are the exact loads of the bins
+  Vector<Variable> loads;
+  for (auto b{0}; b < capacities.size(); ++b)
+    loads.add(load ? Variable(capacities[b], capacities[b])
+                   : Variable(0, std::min(total, capacities[b])));
+
+  solver.add(BinPacking(items, sizes, loads));
 }
 
 void XCSP3MistralCallbacks::buildConstraintBinPacking(
     string id, vector<XVariable *> &list, vector<int> &sizes,
     vector<XVariable *> &capacities, bool load) {
+  int total{0};
+  for (auto s : sizes)
+    total += s;
 
-  vector<vector<Variable>> bin(capacities.size());
-  for (auto b{0}; b < capacities.size(); ++b) {
-    for (auto x : list) {
-      bin[b].emplace_back(variable[x->id] == b);
-    }
-    solver.add(Sum(bin[b], sizes) <= variable[capacities[b]->id]);
-  }
+  Vector<Variable> items;
+  for (auto x : list)
+    items.add(variable[x->id]);
+  Vector<Variable> loads;
+  for (auto b{0}; b < capacities.size(); ++b)
+    loads.add(load ? variable[capacities[b]->id] : Variable(0, total));
+
+  solver.add(BinPacking(items, sizes, loads));
+  if (!load)
+    for (auto b{0}; b < capacities.size(); ++b)
+      solver.add(loads[b] <= variable[capacities[b]->id]);
 }
 
 void XCSP3MistralCallbacks::buildConstraintBinPacking(
     string id, vector<XVariable *> &list, vector<int> &sizes,
     vector<XCondition> &conditions, int startindex) {
+  int total{0};
+  for (auto s : sizes)
+    total += s;
 
-  vector<vector<Variable>> bin(conditions.size());
-  for (auto b{0}; b < conditions.size(); ++b) {
-    for (auto x : list) {
-      bin[b].emplace_back(variable[x->id] == (b + startindex));
-    }
-    addSumConstraint(bin[b], sizes, conditions[b]);
-  }
+  Vector<Variable> items;
+  for (auto x : list)
+    items.add(variable[x->id]);
+  Vector<Variable> load;
+  for (auto b{0}; b < conditions.size(); ++b)
+    load.add(Variable(0, total));
+
+  solver.add(BinPacking(items, sizes, load, startindex));
+  for (auto b{0}; b < conditions.size(); ++b)
+    addCondition(load[b], conditions[b]);
 }
 
 
@@ -1443,6 +1503,32 @@ void XCSP3MistralCallbacks::buildConstraintKnapsack(
     scope.push_back(variable[x->id]);
   }
 
+  // constant capacity and non-negative coefficients: knapsack constraint
+  bool non_negative{true};
+  for (auto i{0}; non_negative && i < weights.size(); ++i)
+    non_negative = (weights[i] >= 0 && profits[i] >= 0 &&
+                    scope[i].get_min() >= 0);
+  if (non_negative && weightsCondition.operandType != VARIABLE) {
+    int wlb{-INFTY}, wub{-INFTY};
+    if (weightsCondition.operandType == INTERVAL) {
+      if (weightsCondition.op == IN) {
+        wlb = weightsCondition.min;
+        wub = weightsCondition.max;
+      }
+    } else if (weightsCondition.op == EQ) {
+      wlb = wub = weightsCondition.val;
+    } else if (weightsCondition.op == LE) {
+      wub = weightsCondition.val;
+    } else if (weightsCondition.op == LT) {
+      wub = weightsCondition.val - 1;
+    }
+    if (wub >= 0) {
+      addCondition(Knapsack(scope, wub, weights, profits, wlb),
+                   profitCondition);
+      return;
+    }
+  }
+
   if (weightsCondition.operandType == VARIABLE) {
     Variable capacity = variable[weightsCondition.var];
 
@@ -1877,7 +1963,7 @@ void XCSP3MistralCallbacks::buildConstraintAlldifferent(
   VarArray scope;
   getVariables(list, scope);
 
-  solver.add(AllDiff(scope));
+  solver.add(AllDiff(scope, AUTO_CONSISTENCY));
 
 #ifdef _VERBOSE_
   cout << "\n --> " << solver.constraints[solver.constraints.size - 1] << endl;
@@ -1947,12 +2033,12 @@ void XCSP3MistralCallbacks::buildConstraintAlldifferentMatrix(
   VarArray scope;
   for (unsigned int i = 0; i < matrix.size(); i++) {
     getVariables(matrix[i], scope);
-    solver.add(AllDiff(scope));
+    solver.add(AllDiff(scope, AUTO_CONSISTENCY));
     scope.clear();
     for (unsigned int j = 0; j < matrix.size(); j++) {
       scope.add(variable[matrix[j][i]->id]);
     }
-    solver.add(AllDiff(scope));
+    solver.add(AllDiff(scope, AUTO_CONSISTENCY));
     scope.clear();
 
 #ifdef _VERBOSE_
@@ -2075,6 +2161,22 @@ void XCSP3MistralCallbacks::buildConstraintOrdered(string id,
   }
 }
 
+// a single LexChain for the whole sequence of rows (reversed for > and >=)
+void XCSP3MistralCallbacks::addLexChain(vector<VarArray> &rows,
+                                        OrderType order) {
+  if (rows.size() < 2)
+    return;
+  if (order == GT || order == GE)
+    reverse(rows.begin(), rows.end());
+  if (rows.size() == 2) {
+    if (order == LT || order == GT)
+      solver.add(rows[0] < rows[1]);
+    else
+      solver.add(rows[0] <= rows[1]);
+  } else
+    solver.add(LexChain(rows, (order == LT || order == GT)));
+}
+
 void XCSP3MistralCallbacks::buildConstraintLex(
     string id, vector<vector<XVariable *>> &lists, OrderType order) {
 #ifdef _VERBOSE_
@@ -2103,16 +2205,7 @@ void XCSP3MistralCallbacks::buildConstraintLex(
     scope.push_back(X);
   }
 
-  for (size_t i = 1; i < lists.size(); ++i) {
-    if (order == LT)
-      solver.add(scope[i - 1] < scope[i]);
-    if (order == LE)
-      solver.add(scope[i - 1] <= scope[i]);
-    if (order == GT)
-      solver.add(scope[i - 1] > scope[i]);
-    if (order == GE)
-      solver.add(scope[i - 1] >= scope[i]);
-  }
+  addLexChain(scope, order);
 }
 
 void XCSP3MistralCallbacks::buildConstraintLexMatrix(
@@ -2144,21 +2237,7 @@ void XCSP3MistralCallbacks::buildConstraintLexMatrix(
     scope.push_back(X);
   }
 
-  for (size_t i = 1; i < scope.size(); ++i) {
-    if (order == LT)
-      solver.add(scope[i - 1] < scope[i]);
-    if (order == LE)
-      solver.add(scope[i - 1] <= scope[i]);
-    if (order == GT)
-      solver.add(scope[i - 1] > scope[i]);
-    if (order == GE)
-      solver.add(scope[i - 1] >= scope[i]);
-
-    // if(order == LT) cout << scope[i-1] << "\n<\n" <<  scope[i] << endl;
-    // if(order == LE) cout << scope[i-1] << "\n<=\n" <<  scope[i] << endl;
-    // if(order == GT) cout << scope[i-1] << "\n>\n" <<  scope[i] << endl;
-    // if(order == GE) cout << scope[i-1] << "\n>=\n" <<  scope[i] << endl;
-  }
+  addLexChain(scope, order);
 
   scope.clear();
 
@@ -2170,21 +2249,7 @@ void XCSP3MistralCallbacks::buildConstraintLexMatrix(
     scope.push_back(X);
   }
 
-  for (size_t i = 1; i < scope.size(); ++i) {
-    if (order == LT)
-      solver.add(scope[i - 1] < scope[i]);
-    if (order == LE)
-      solver.add(scope[i - 1] <= scope[i]);
-    if (order == GT)
-      solver.add(scope[i - 1] > scope[i]);
-    if (order == GE)
-      solver.add(scope[i - 1] >= scope[i]);
-
-    // if(order == LT) cout << scope[i-1] << "\n<\n" <<  scope[i] << endl;
-    // if(order == LE) cout << scope[i-1] << "\n<=\n" <<  scope[i] << endl;
-    // if(order == GT) cout << scope[i-1] << "\n>\n" <<  scope[i] << endl;
-    // if(order == GE) cout << scope[i-1] << "\n>=\n" <<  scope[i] << endl;
-  }
+  addLexChain(scope, order);
 }
 
 void XCSP3MistralCallbacks::buildConstraintSum(string id,
@@ -3073,38 +3138,23 @@ void XCSP3MistralCallbacks::buildConstraintNValues(string id,
   VarArray scope;
   getVariables(list, scope);
 
-  int min = INFTY;
-  int max = -INFTY;
-
-  for (auto X : scope) {
-    if (min > X.get_min()) {
-      min = X.get_min();
-    }
-    if (max < X.get_max()) {
-      max = X.get_max();
-    }
-  }
-
-  VarArray used;
-  for (int i = min; i <= max; ++i) {
-    used.add(Occurrence(scope, i));
-  }
+  Variable nvalue = NValue(scope);
 
   if (cond.operandType == VARIABLE) {
     Variable nval = variable[cond.var];
 
     if (cond.op == EQ) {
-      solver.add(BoolSum(used) == nval);
+      solver.add(nvalue == nval);
     } else if (cond.op == NE) {
-      solver.add(BoolSum(used) != nval);
+      solver.add(nvalue != nval);
     } else if (cond.op == LE) {
-      solver.add(BoolSum(used) <= nval);
+      solver.add(nvalue <= nval);
     } else if (cond.op == LT) {
-      solver.add(BoolSum(used) < nval);
+      solver.add(nvalue < nval);
     } else if (cond.op == GE) {
-      solver.add(BoolSum(used) >= nval);
+      solver.add(nvalue >= nval);
     } else if (cond.op == GT) {
-      solver.add(BoolSum(used) > nval);
+      solver.add(nvalue > nval);
     }
 
   } else if (cond.operandType == INTERVAL) {
@@ -3113,22 +3163,21 @@ void XCSP3MistralCallbacks::buildConstraintNValues(string id,
       exit(1);
     }
 
-    solver.add(BoolSum(used, cond.min, cond.max));
+    solver.add(Member(nvalue, cond.min, cond.max));
   } else {
 
     if (cond.op == EQ) {
-      solver.add(BoolSum(used, cond.val, cond.val));
+      solver.add(nvalue == cond.val);
     } else if (cond.op == NE) {
-      Variable cst(cond.val);
-      solver.add(BoolSum(used) != cst);
+      solver.add(nvalue != cond.val);
     } else if (cond.op == LE) {
-      solver.add(BoolSum(used, -INFTY, cond.val));
+      solver.add(nvalue <= cond.val);
     } else if (cond.op == LT) {
-      solver.add(BoolSum(used, -INFTY, cond.val - 1));
+      solver.add(nvalue < cond.val);
     } else if (cond.op == GE) {
-      solver.add(BoolSum(used, cond.val, INFTY));
+      solver.add(nvalue >= cond.val);
     } else if (cond.op == GT) {
-      solver.add(BoolSum(used, cond.val + 1, INFTY));
+      solver.add(nvalue > cond.val);
     }
   }
 }
@@ -3155,13 +3204,7 @@ void XCSP3MistralCallbacks::buildConstraintCardinality(
     for (auto X : scope)
       solver.add(Member(X, values));
 
-  if (values.back() - (*begin(values)) + 1 == (int)(values.size())) {
-    solver.add(Occurrences(scope, values, occurs, occurs));
-  } else {
-    for (size_t i = 0; i < values.size(); ++i) {
-      solver.add(Occurrence(scope, values[i]) == occurs[i]);
-    }
-  }
+  solver.add(Occurrences(scope, values, occurs, occurs, DOMAIN_CONSISTENCY));
 }
 
 void XCSP3MistralCallbacks::buildConstraintCardinality(
@@ -3184,9 +3227,7 @@ void XCSP3MistralCallbacks::buildConstraintCardinality(
   VarArray count;
   getVariables(occurs, count);
 
-  for (size_t i = 0; i < values.size(); ++i) {
-    solver.add(Occurrence(scope, values[i]) == count[i]);
-  }
+  solver.add(Cardinality(scope, values, count));
 
   if (closed) {
     solver.add(Sum(count, scope.size, scope.size));
@@ -3244,7 +3285,7 @@ void XCSP3MistralCallbacks::buildConstraintCardinality(
       solver.add(Member(X, values));
   }
 
-  solver.add(Occurrences(scope, values, lb, ub));
+  solver.add(Occurrences(scope, values, lb, ub, DOMAIN_CONSISTENCY));
 }
 
 void XCSP3MistralCallbacks::buildConstraintCardinality(
@@ -3943,21 +3984,12 @@ void XCSP3MistralCallbacks::buildConstraintElement(
   cout << "        Row index : " << *rowIndex << endl;
 #endif
 
-  VarArray rows;
-  for (auto &row : matrix) {
-    VarArray scope;
-    for (auto v : row) {
-      scope.add(Variable(v, v));
-    }
-    rows.add(Element(scope, variable[colIndex->id], startColIndex));
-  }
-
   ++initial_degree[id_map[rowIndex->id]];
   ++initial_degree[id_map[colIndex->id]];
   ++initial_degree[id_map[value->id]];
 
-  solver.add(Element(rows, variable[rowIndex->id], startRowIndex) ==
-             variable[value->id]);
+  solver.add(Element(matrix, variable[rowIndex->id], variable[colIndex->id],
+                     startRowIndex, startColIndex) == variable[value->id]);
 }
 
 void XCSP3MistralCallbacks::buildConstraintElement(
@@ -4036,7 +4068,7 @@ void XCSP3MistralCallbacks::buildConstraintChannel(string id,
 
   VarArray scope;
   getVariables(list, scope);
-  solver.add(AllDiff(scope));
+  solver.add(AllDiff(scope, AUTO_CONSISTENCY));
   for (size_t i = 0; i < scope.size; ++i) {
     for (size_t j = i + 1; j < scope.size; ++j) {
       solver.add((scope[i] == j + startIndex) == (scope[j] == i + startIndex));
@@ -4067,8 +4099,8 @@ void XCSP3MistralCallbacks::buildConstraintChannel(string id,
     sindex[0] = startIndex1;
     sindex[1] = startIndex2;
 
-    solver.add(AllDiff(scope[0]));
-    solver.add(AllDiff(scope[1]));
+    solver.add(AllDiff(scope[0], AUTO_CONSISTENCY));
+    solver.add(AllDiff(scope[1], AUTO_CONSISTENCY));
     for (size_t i = 0; i < scope[0].size; ++i) {
       for (size_t j = 0; j < scope[1].size; ++j) {
         solver.add((scope[0][i] == j + sindex[0]) ==
@@ -6416,6 +6448,545 @@ Variable XCSP3MistralCallbacks::postExpression(Node *n, int level) {
   return rv;
 }
 
+void XCSP3MistralCallbacks::postIntension(Node *n) {
+  if (n->type == OAND) {
+    for (auto x : ((NodeOperator *)n)->parameters)
+      postIntension(x);
+    return;
+  }
+
+  if (postPrimitiveIntension(n))
+    return;
+
+  intension_scope.clear();
+  intension_index.clear();
+  intension_code.clear();
+  intension_key.clear();
+  if (intension_table_limit > 0 && compileIntension(n) && postTableIntension())
+    return;
+
+  solver.add(postExpression(n, true));
+}
+
+// x, x+k, k+x or x-k
+bool XCSP3MistralCallbacks::linearTerm(Node *n, NodeVariable *&x, int &k) {
+  x = NULL;
+  k = 0;
+  if (n->type == OVAR) {
+    x = (NodeVariable *)n;
+    return true;
+  }
+  if (n->type == ODECIMAL) {
+    k = ((NodeConstant *)n)->val;
+    return true;
+  }
+  if (n->type != OADD && n->type != OSUB)
+    return false;
+  vector<Node *> &args(((NodeOperator *)n)->parameters);
+  if (args.size() != 2)
+    return false;
+  if (args[0]->type == OVAR && args[1]->type == ODECIMAL) {
+    x = (NodeVariable *)args[0];
+    k = ((NodeConstant *)args[1])->val;
+    if (n->type == OSUB)
+      k = -k;
+    return true;
+  }
+  if (n->type == OADD && args[0]->type == ODECIMAL && args[1]->type == OVAR) {
+    x = (NodeVariable *)args[1];
+    k = ((NodeConstant *)args[0])->val;
+    return true;
+  }
+  return false;
+}
+
+// dist(x,y) or abs(sub(x,y))
+bool XCSP3MistralCallbacks::distanceTerm(Node *n, NodeVariable *&x,
+                                         NodeVariable *&y) {
+  if (n->type == OABS) {
+    n = ((NodeOperator *)n)->parameters[0];
+    if (n->type != OSUB)
+      return false;
+  } else if (n->type != ODIST) {
+    return false;
+  }
+  vector<Node *> &args(((NodeOperator *)n)->parameters);
+  if (args.size() != 2 || args[0]->type != OVAR || args[1]->type != OVAR)
+    return false;
+  x = (NodeVariable *)args[0];
+  y = (NodeVariable *)args[1];
+  return x->var != y->var;
+}
+
+/* Comparisons between two offset variables (x + k op y), between a variable
+ * and a constant, and of a distance against a constant (|x - y| op k) are
+ * posted as (disjunctions of) precedences, without integer auxiliary
+ * variables.
+ */
+bool XCSP3MistralCallbacks::postPrimitiveIntension(Node *n) {
+  ExpressionType op = n->type;
+  if (op != OLT && op != OLE && op != OGE && op != OGT && op != OEQ &&
+      op != ONE)
+    return false;
+
+  vector<Node *> &args(((NodeOperator *)n)->parameters);
+  if (args.size() != 2)
+    return false;
+
+  Node *lhs = args[0];
+  Node *rhs = args[1];
+  if (lhs->type == ODECIMAL) {
+    std::swap(lhs, rhs);
+    if (op == OLT)
+      op = OGT;
+    else if (op == OGT)
+      op = OLT;
+    else if (op == OLE)
+      op = OGE;
+    else if (op == OGE)
+      op = OLE;
+  }
+
+  NodeVariable *x, *y;
+  int k;
+
+  if (rhs->type == ODECIMAL && distanceTerm(lhs, x, y)) {
+    k = ((NodeConstant *)rhs)->val;
+    if (op == OGT) {
+      op = OGE;
+      ++k;
+    } else if (op == OLT) {
+      op = OLE;
+      --k;
+    }
+
+    Variable X = variable[x->var];
+    Variable Y = variable[y->var];
+    if (op == OGE) {
+      if (k > 0)
+        solver.add(Precedence(X, k, Y) || Precedence(Y, k, X));
+    } else if (op == OLE && k >= 0) {
+      solver.add(Precedence(X, -k, Y));
+      solver.add(Precedence(Y, -k, X));
+    } else {
+      return false;
+    }
+
+    ++initial_degree[id_map[x->var]];
+    ++initial_degree[id_map[y->var]];
+    return true;
+  }
+
+  int kx, ky;
+  if (!linearTerm(lhs, x, kx) || !linearTerm(rhs, y, ky) || x == NULL)
+    return false;
+
+  if (y == NULL) {
+    // x + kx op ky
+    Variable X = variable[x->var];
+    k = ky - kx;
+    if (op == OLT)
+      solver.add(X < k);
+    else if (op == OLE)
+      solver.add(X <= k);
+    else if (op == OGE)
+      solver.add(X >= k);
+    else if (op == OGT)
+      solver.add(X > k);
+    else if (op == OEQ)
+      solver.add(X == k);
+    else
+      solver.add(X != k);
+
+    ++initial_degree[id_map[x->var]];
+    return true;
+  }
+
+  if (x->var == y->var)
+    return false;
+
+  // x + k op y
+  Variable X = variable[x->var];
+  Variable Y = variable[y->var];
+  k = kx - ky;
+  if (op == OLT) {
+    solver.add(Precedence(X, k + 1, Y));
+  } else if (op == OLE) {
+    solver.add(Precedence(X, k, Y));
+  } else if (op == OGE) {
+    solver.add(Precedence(Y, -k, X));
+  } else if (op == OGT) {
+    solver.add(Precedence(Y, 1 - k, X));
+  } else if (k == 0) {
+    if (op == OEQ)
+      solver.add(X == Y);
+    else
+      solver.add(X != Y);
+  } else if (op == OEQ &&
+             (double)X.get_size() * Y.get_size() > intension_table_limit) {
+    // too large to be tabled: bound consistent offset
+    solver.add(Precedence(X, k, Y));
+    solver.add(Precedence(Y, -k, X));
+  } else {
+    // x + k =/= y, or a small x + k = y: left to the table
+    return false;
+  }
+
+  ++initial_degree[id_map[x->var]];
+  ++initial_degree[id_map[y->var]];
+  return true;
+}
+
+/* Appends the canonical form of n to intension_code (pairs opcode/operand,
+ * the operand is the placeholder for variables, the value for constants and
+ * the number of arguments for operators) and to intension_key. GT/GE are
+ * rewritten as LT/LE and constants are moved after the other arguments of
+ * commutative operators, so that equivalent trees share a key. Returns false
+ * if the tree uses an operator that cannot be evaluated here.
+ */
+bool XCSP3MistralCallbacks::compileIntension(Node *n) {
+  if (n->type == OVAR) {
+    string &x = ((NodeVariable *)n)->var;
+    auto it = intension_index.find(x);
+    int idx;
+    if (it == intension_index.end()) {
+      idx = intension_scope.size();
+      intension_index[x] = idx;
+      intension_scope.push_back(x);
+    } else {
+      idx = it->second;
+    }
+    intension_code.push_back(OVAR);
+    intension_code.push_back(idx);
+    intension_key += '%';
+    intension_key += to_string(idx);
+    return true;
+  }
+
+  if (n->type == ODECIMAL) {
+    int val = ((NodeConstant *)n)->val;
+    intension_code.push_back(ODECIMAL);
+    intension_code.push_back(val);
+    intension_key += to_string(val);
+    return true;
+  }
+
+  ExpressionType op = n->type;
+  vector<Node *> args(((NodeOperator *)n)->parameters);
+  size_t arity = args.size();
+
+  switch (op) {
+  case ONEG:
+  case OABS:
+  case ONOT:
+    if (arity != 1)
+      return false;
+    break;
+  case OGT:
+  case OGE:
+    if (arity != 2)
+      return false;
+    op = (op == OGT ? OLT : OLE);
+    std::swap(args[0], args[1]);
+    break;
+  case OSUB:
+  case ODIV:
+  case OMOD:
+  case OLT:
+  case OLE:
+  case OIMP:
+    if (arity != 2)
+      return false;
+    break;
+  case ODIST:
+  case ONE:
+    if (arity != 2)
+      return false;
+    std::stable_partition(args.begin(), args.end(),
+                          [](Node *x) { return x->type != ODECIMAL; });
+    break;
+  case OADD:
+  case OMUL:
+  case OMIN:
+  case OMAX:
+  case OEQ:
+  case OAND:
+  case OOR:
+  case OXOR:
+  case OIFF:
+    if (arity < 1)
+      return false;
+    std::stable_partition(args.begin(), args.end(),
+                          [](Node *x) { return x->type != ODECIMAL; });
+    break;
+  case OIF:
+    if (arity != 3)
+      return false;
+    break;
+  case OIN: {
+    if (arity != 2 || args[1]->type != OSET)
+      return false;
+    // the elements of the set become the operands of 'in'
+    vector<Node *> &elements(((NodeOperator *)args[1])->parameters);
+    args.resize(1);
+    for (auto x : elements) {
+      if (x->type != ODECIMAL)
+        return false;
+      args.push_back(x);
+    }
+    arity = args.size();
+  } break;
+  default:
+    return false;
+  }
+
+  intension_key += 'o';
+  intension_key += to_string(op);
+  intension_key += '(';
+  for (size_t i = 0; i < arity; ++i) {
+    if (i)
+      intension_key += ',';
+    if (!compileIntension(args[i]))
+      return false;
+  }
+  intension_key += ')';
+
+  intension_code.push_back(op);
+  intension_code.push_back(arity);
+  return true;
+}
+
+// Runs the program compiled by compileIntension on a tuple of placeholders
+int XCSP3MistralCallbacks::evaluateIntension(const int *tuple) {
+  int *top = &intension_stack[0] - 1;
+  intension_undefined = false;
+
+  for (size_t i = 0; i < intension_code.size(); i += 2) {
+    int op = intension_code[i];
+    int arg = intension_code[i + 1];
+
+    if (op == OVAR) {
+      *++top = tuple[arg];
+      continue;
+    }
+    if (op == ODECIMAL) {
+      *++top = arg;
+      continue;
+    }
+
+    int *a = top - arg + 1;
+    int r = a[0];
+    switch (op) {
+    case ONEG:
+      r = -a[0];
+      break;
+    case OABS:
+      r = std::abs(a[0]);
+      break;
+    case ONOT:
+      r = !a[0];
+      break;
+    case OSUB:
+      r = a[0] - a[1];
+      break;
+    case ODIST:
+      r = std::abs(a[0] - a[1]);
+      break;
+    case ODIV:
+    case OMOD:
+      if (a[1] == 0) {
+        intension_undefined = true;
+        r = 0;
+      } else {
+        r = (op == ODIV ? a[0] / a[1] : a[0] % a[1]);
+      }
+      break;
+    case OLT:
+      r = (a[0] < a[1]);
+      break;
+    case OLE:
+      r = (a[0] <= a[1]);
+      break;
+    case ONE:
+      r = (a[0] != a[1]);
+      break;
+    case OIMP:
+      r = (!a[0] || a[1]);
+      break;
+    case OIF:
+      r = (a[0] ? a[1] : a[2]);
+      break;
+    case OADD:
+      for (int j = 1; j < arg; ++j)
+        r += a[j];
+      break;
+    case OMUL:
+      for (int j = 1; j < arg; ++j)
+        r *= a[j];
+      break;
+    case OMIN:
+      for (int j = 1; j < arg; ++j)
+        r = std::min(r, a[j]);
+      break;
+    case OMAX:
+      for (int j = 1; j < arg; ++j)
+        r = std::max(r, a[j]);
+      break;
+    case OEQ:
+      r = 1;
+      for (int j = 1; r && j < arg; ++j)
+        r = (a[j] == a[0]);
+      break;
+    case OAND:
+      r = 1;
+      for (int j = 0; r && j < arg; ++j)
+        r = (a[j] != 0);
+      break;
+    case OOR:
+      r = 0;
+      for (int j = 0; !r && j < arg; ++j)
+        r = (a[j] != 0);
+      break;
+    case OXOR:
+      r = 0;
+      for (int j = 0; j < arg; ++j)
+        r ^= (a[j] != 0);
+      break;
+    case OIFF:
+      r = 1;
+      for (int j = 1; r && j < arg; ++j)
+        r = ((a[j] != 0) == (a[0] != 0));
+      break;
+    case OIN:
+      r = 0;
+      for (int j = 1; !r && j < arg; ++j)
+        r = (a[j] == a[0]);
+      break;
+    }
+
+    top = a;
+    *top = r;
+  }
+
+  return *top;
+}
+
+/* Posts the compiled tree as a table if the cartesian product of the domains
+ * is within intension_table_limit. The relation is computed on the first
+ * tree of a given shape over given domains and shared by the next ones; the
+ * smaller of the supports and of the conflicts is kept.
+ */
+bool XCSP3MistralCallbacks::postTableIntension() {
+  size_t arity = intension_scope.size();
+  if (arity == 0)
+    return false;
+
+  VarArray scope;
+  double num_tuples = 1;
+  for (auto &x : intension_scope) {
+    scope.add(variable[x]);
+    num_tuples *= scope.back().get_size();
+    if (num_tuples > intension_table_limit)
+      return false;
+  }
+
+  vector<vector<int>> values(arity);
+  string key(intension_key);
+  for (size_t i = 0; i < arity; ++i) {
+    Variable X = scope[i];
+    int vnext = X.get_min();
+    do {
+      values[i].push_back(vnext);
+      vnext = X.next(vnext);
+    } while (vnext != values[i].back());
+
+    key += (i ? ',' : '|');
+    key += to_string(values[i].front());
+    if (values[i].back() - values[i].front() + 1 != (int)values[i].size())
+      for (size_t j = 1; j < values[i].size(); ++j) {
+        key += ' ';
+        key += to_string(values[i][j]);
+      }
+    else
+      key += ':' + to_string(values[i].back());
+  }
+
+  auto it = intension_tables.find(key);
+  if (it == intension_tables.end()) {
+    intension_stack.resize(intension_code.size() / 2 + 1);
+
+    vector<char> sat;
+    sat.reserve((size_t)num_tuples);
+    vector<size_t> idx(arity, 0);
+    vector<int> tuple(arity);
+    for (size_t i = 0; i < arity; ++i)
+      tuple[i] = values[i][0];
+
+    int num_supports = 0;
+    while (true) {
+      sat.push_back(evaluateIntension(&tuple[0]) && !intension_undefined);
+      num_supports += sat.back();
+
+      size_t i = arity;
+      while (i-- > 0 && ++idx[i] == values[i].size()) {
+        idx[i] = 0;
+        tuple[i] = values[i][0];
+      }
+      if (i >= arity)
+        break;
+      tuple[i] = values[i][idx[i]];
+    }
+
+    IntensionTable rel;
+    rel.support = (2 * num_supports <= (int)sat.size());
+    rel.tuples = new Vector<const int *>;
+    rel.tuples->initialise(
+        1 + (rel.support ? num_supports : sat.size() - num_supports));
+
+    std::fill(idx.begin(), idx.end(), 0);
+    for (size_t t = 0; t < sat.size(); ++t) {
+      if (sat[t] == rel.support) {
+        int *new_tuple = new int[arity];
+        for (size_t i = 0; i < arity; ++i)
+          new_tuple[i] = values[i][idx[i]];
+        rel.tuples->add(new_tuple);
+      }
+      size_t i = arity;
+      while (i-- > 0 && ++idx[i] == values[i].size())
+        idx[i] = 0;
+    }
+
+    it = intension_tables.insert(make_pair(key, rel)).first;
+  }
+
+  IntensionTable &rel(it->second);
+  if (arity == 1) {
+    vector<int> allowed;
+    if (rel.support) {
+      for (auto t : *rel.tuples)
+        allowed.push_back(*t);
+    } else {
+      size_t j = 0;
+      for (auto v : values[0])
+        if (j < rel.tuples->size && *((*rel.tuples)[j]) == v)
+          ++j;
+        else
+          allowed.push_back(v);
+    }
+    if (allowed.empty())
+      solver.fail();
+    else
+      solver.add(Member(scope[0], allowed));
+  } else {
+    solver.add(Table(scope, rel.tuples, rel.support));
+  }
+
+  for (auto &x : intension_scope)
+    ++initial_degree[id_map[x]];
+
+  return true;
+}
+
 void XCSP3MistralCallbacks::assign(string& var, int val) {
   solver.add(variable[var] == val);
 }
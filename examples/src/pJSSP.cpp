@@ -62,8 +62,8 @@ public:
     started.resize(jsp.nTasks(), false);
   };
 
-  bool fromDomain(const std::vector<int> &tasks);
-  bool fromSolution(const std::vector<int> &tasks);
+  bool fromDomain(const IndexRange &tasks);
+  bool fromSolution(const IndexRange &tasks);
 
   int get_lower_bound(const int ub);
 
@@ -128,7 +128,7 @@ int JacksonPreemptiveScheduler::get_lower_bound(const int ub) {
   return LB;
 }
 
-bool JacksonPreemptiveScheduler::fromDomain(const std::vector<int> &tasks) {
+bool JacksonPreemptiveScheduler::fromDomain(const IndexRange &tasks) {
 
   info.clear();
   for (auto a : tasks) {
@@ -139,7 +139,7 @@ bool JacksonPreemptiveScheduler::fromDomain(const std::vector<int> &tasks) {
   return compute();
 }
 
-bool JacksonPreemptiveScheduler::fromSolution(const std::vector<int> &tasks) {
+bool JacksonPreemptiveScheduler::fromSolution(const IndexRange &tasks) {
 
   info.clear();
   for (auto a : tasks) {
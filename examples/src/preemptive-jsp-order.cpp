@@ -77,9 +77,9 @@ public:
     // seen.reserve(jsp.nTasks());
   };
 
-  bool fromDomain(const std::vector<int> &tasks);
-  bool fromSolution(const std::vector<int> &tasks);
-  void printSolution(const std::vector<int> &tasks);
+  bool fromDomain(const IndexRange &tasks);
+  bool fromSolution(const IndexRange &tasks);
+  void printSolution(const IndexRange &tasks);
 
   int get_lower_bound(const int ub);
 
@@ -150,7 +150,7 @@ int JacksonPreemptiveScheduler::get_lower_bound(const int ub) {
   return LB;
 }
 
-bool JacksonPreemptiveScheduler::fromDomain(const std::vector<int> &tasks) {
+bool JacksonPreemptiveScheduler::fromDomain(const IndexRange &tasks) {
 
   info.clear();
   for (auto a : tasks) {
@@ -161,7 +161,7 @@ bool JacksonPreemptiveScheduler::fromDomain(const std::vector<int> &tasks) {
   return compute();
 }
 
-bool JacksonPreemptiveScheduler::fromSolution(const std::vector<int> &tasks) {
+bool JacksonPreemptiveScheduler::fromSolution(const IndexRange &tasks) {
 
   info.clear();
   // std::cout << std::endl;
@@ -179,7 +179,7 @@ bool JacksonPreemptiveScheduler::fromSolution(const std::vector<int> &tasks) {
   return compute();
 }
 
-void JacksonPreemptiveScheduler::printSolution(const std::vector<int> &tasks) {
+void JacksonPreemptiveScheduler::printSolution(const IndexRange &tasks) {
 
   info.clear();
   // std::cout << std::endl;
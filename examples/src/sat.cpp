@@ -7,7 +7,7 @@ using namespace std;
 
 
 
-const int nia = 9;
+const int nia = 11;
 const char* int_ident[nia] = {
   "-h",
   "-verbose",
@@ -17,7 +17,9 @@ const char* int_ident[nia] = {
   "-restart_base",
   "-checked",
   "-activity",
-  "-value"
+  "-value",
+  "-preprocess",
+  "-reuse_trail"
 };
 
 const char* int_man[nia] = {
@@ -29,7 +31,9 @@ const char* int_man[nia] = {
   "restart base",
   "whether the solution is checked",
   "initialisation method for the activity (0: none, 1: number of clauses)",
-  "value selection method (0,1,2/3:most/least active,4:random,5:persistent)"
+  "value selection method (0,1,2/3:most/least active,4:random,5:persistent)",
+  "clause simplification before search (0: none, 1: units/pure/equiv/BVE/BCE)",
+  "keep the decisions that would be made again on restart (0: no, 1: yes)"
    };
 
 			      
@@ -99,6 +103,8 @@ int main(int argc, char **argv)
       params.checked         = ( int_param[6] != NOVAL ? int_param[6] : 1 );
       params.init_activity   = ( int_param[7] != NOVAL ? int_param[7] : 1 );
       params.value_selection = ( int_param[8] != NOVAL ? int_param[8] : 2 );
+      params.preprocess      = ( int_param[9] != NOVAL ? int_param[9] : 0 );
+      params.reuse_trail     = ( int_param[10] != NOVAL ? int_param[10] : 0 );
 
 
       params.restart_factor     = ( strcmp(str_param[0],"nil") ? atof(str_param[0]) : 1.05 );
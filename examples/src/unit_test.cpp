@@ -1,5 +1,6 @@
 
 #include <vector>
+#include <set>
 #include <iomanip>
 #include <fstream>
 
@@ -499,6 +500,132 @@ public:
 };
 
 
+/// Cross-checks a global constraint against its decomposition on small
+/// random instances: both models must have the same solutions (each found
+/// once), and after propagating the global constraint alone at the root, the
+/// domains of its first 'num_gac' variables must be exactly their supports.
+class GlobalConstraintTest : public UnitTest {
+
+public:
+
+  const char *name;
+  int num_instances;
+  int num_gac;
+  int num_errors;
+
+  GlobalConstraintTest(const char *nm, const int ni, const int ng);
+  virtual ~GlobalConstraintTest();
+
+  /// post instance 'k' on X in s, with the global constraint or its decomposition
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global) = 0;
+
+  void enumerate(Solver &s, VarArray &X, std::set< std::vector<int> > &sols, int &num);
+  void check_instance(const int k);
+
+  virtual void run();
+};
+
+class NValueTest : public GlobalConstraintTest {
+
+public:
+
+  NValueTest();
+  ~NValueTest();
+
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global);
+};
+
+class BinPackingTest : public GlobalConstraintTest {
+
+public:
+
+  BinPackingTest();
+  ~BinPackingTest();
+
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global);
+};
+
+class IncrementalWeightedSumTest : public GlobalConstraintTest {
+
+public:
+
+  IncrementalWeightedSumTest();
+  ~IncrementalWeightedSumTest();
+
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global);
+};
+
+class IntElementTest : public GlobalConstraintTest {
+
+public:
+
+  IntElementTest();
+  ~IntElementTest();
+
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global);
+};
+
+class CardinalityTest : public GlobalConstraintTest {
+
+public:
+
+  CardinalityTest();
+  ~CardinalityTest();
+
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global);
+};
+
+class GaussParityTest : public GlobalConstraintTest {
+
+public:
+
+  GaussParityTest();
+  ~GaussParityTest();
+
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global);
+};
+
+class KnapsackTest : public GlobalConstraintTest {
+
+public:
+
+  KnapsackTest();
+  ~KnapsackTest();
+
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global);
+};
+
+class LexChainTest : public GlobalConstraintTest {
+
+public:
+
+  LexChainTest();
+  ~LexChainTest();
+
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global);
+};
+
+class SequenceTest : public GlobalConstraintTest {
+
+public:
+
+  SequenceTest();
+  ~SequenceTest();
+
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global);
+};
+
+class Element2DTest : public GlobalConstraintTest {
+
+public:
+
+  Element2DTest();
+  ~Element2DTest();
+
+  virtual void model(Solver &s, VarArray &X, const int k, const bool global);
+};
+
+
 
 
 template<class CON_TYPE>
@@ -1863,12 +1990,23 @@ int main(int argc, char *argv[])
   tests.push_back(new BoolPigeons(N+1, EXPRESSION));
   tests.push_back(new BoolPigeons(N+1, BITSET_VAR));
   */
+  tests.push_back(new SequenceTest());
+  tests.push_back(new LexChainTest());
+  tests.push_back(new KnapsackTest());
+  tests.push_back(new GaussParityTest());
+  tests.push_back(new CardinalityTest());
+  tests.push_back(new Element2DTest());
+  tests.push_back(new IntElementTest());
+  tests.push_back(new IncrementalWeightedSumTest());
+  tests.push_back(new BinPackingTest());
+  tests.push_back(new NValueTest());
   tests.push_back(new SatTest());
+  tests.push_back(new CostasAllDiffAllSolutions(N+1, BOUND_CONSISTENCY));
+  tests.push_back(new CostasAllDiffAllSolutions(N+1, DOMAIN_CONSISTENCY));
   /*
   tests.push_back(new Pigeons(N+2)); 
   tests.push_back(new CostasAllDiffAllSolutions(N+1, FORWARD_CHECKING));
   tests.push_back(new CostasAllDiffAllSolutions(N+1, BOUND_CONSISTENCY, RANGE_VAR));
-  tests.push_back(new CostasAllDiffAllSolutions(N+1, BOUND_CONSISTENCY));
   tests.push_back(new CostasNotEqualAllSolutions(N+1));
   //tests.push_back(new RandomCListRandomRemoveAndRestore<4>());
   tests.push_back(new RandomDomainRandomRemoveRangeAndRestore());
@@ -3175,7 +3313,8 @@ CostasAllDiffAllSolutions::~CostasAllDiffAllSolutions() {}
 void CostasAllDiffAllSolutions::run() {
 
   if(Verbosity) cout << "Run costas array of order " << size << " (alldiff - "
-		     << (consistency==FORWARD_CHECKING ? "FC" : "BC" )
+		     << (consistency==FORWARD_CHECKING ? "FC" : 
+			 (consistency==BOUND_CONSISTENCY ? "BC" : "GAC") )
 		     << "), look for all solutions "; 
 
   int i, j;
@@ -6847,6 +6986,445 @@ void MinMaxTest::run() {
 }
 
 
+GlobalConstraintTest::GlobalConstraintTest(const char *nm, const int ni, const int ng)
+  : UnitTest(LOW, LOW, LOW) { name=nm; num_instances=ni; num_gac=ng; num_errors=0; }
+GlobalConstraintTest::~GlobalConstraintTest() {}
+
+void GlobalConstraintTest::enumerate(Solver &s, VarArray &X, 
+				     std::set< std::vector<int> > &sols, int &num) {
+  s.consolidate();
+  s.initialise_search(X, 
+		      new GenericHeuristic< Lexicographic, MinValue >(&s), 
+		      new NoRestart());
+  std::vector<int> sol(X.size);
+  num = 0;
+  while(s.get_next_solution() == SAT) {
+    ++num;
+    for(unsigned int i=0; i<X.size; ++i)
+      sol[i] = X[i].get_solution_int_value();
+    sols.insert(sol);
+  }
+}
+
+void GlobalConstraintTest::check_instance(const int k) {
+  std::set< std::vector<int> > dsols, gsols;
+  std::set< std::vector<int> >::iterator it;
+  int dnum, gnum, v;
+  unsigned int i;
+
+  Solver d;
+  VarArray DX;
+  usrand(k);
+  model(d, DX, k, false);
+  enumerate(d, DX, dsols, dnum);
+
+  Solver g;
+  VarArray GX;
+  usrand(k);
+  model(g, GX, k, true);
+  enumerate(g, GX, gsols, gnum);
+
+  if(gnum != (int)(gsols.size())) {
+    cout << "Error: " << name << " #" << k << " finds duplicate solutions! (" 
+	 << gnum << " for " << gsols.size() << ")" << endl;
+    ++num_errors;
+  }
+  if(gsols != dsols) {
+    cout << "Error: " << name << " #" << k << " wrong number of solutions! (" 
+	 << gsols.size() << ", should be " << dsols.size() << ")" << endl;
+    ++num_errors;
+    return;
+  }
+
+  // the root fixpoint
+  Solver r;
+  VarArray RX;
+  usrand(k);
+  model(r, RX, k, true);
+  r.consolidate();
+  r.initialise_search(RX, 
+		      new GenericHeuristic< Lexicographic, MinValue >(&r), 
+		      new NoRestart());
+  bool consistent = r.propagate();
+  if(!consistent) {
+    if(!dsols.empty()) {
+      cout << "Error: " << name << " #" << k << " fails at the root!" << endl;
+      ++num_errors;
+    }
+    return;
+  }
+  if(dsols.empty()) {
+    if(num_gac) {
+      cout << "Error: " << name << " #" << k << " does not fail at the root!" << endl;
+      ++num_errors;
+    }
+    return;
+  }
+  for(i=0; i<RX.size; ++i) {
+    std::set<int> support;
+    for(it=dsols.begin(); it!=dsols.end(); ++it)
+      support.insert((*it)[i]);
+    for(v=RX[i].get_min(); v<=RX[i].get_max(); ++v) {
+      if(RX[i].contain(v) && (int)i<num_gac && !support.count(v)) {
+	cout << "Error: " << name << " #" << k << " is not GAC at the root! (" 
+	     << v << " in " << RX[i].get_domain() << ")" << endl;
+	++num_errors;
+	return;
+      }
+      if(!RX[i].contain(v) && support.count(v)) {
+	cout << "Error: " << name << " #" << k << " prunes a supported value! (" 
+	     << v << " from " << RX[i].get_domain() << ")" << endl;
+	++num_errors;
+	return;
+      }
+    }
+  }
+}
+
+void GlobalConstraintTest::run() {
+  if(Verbosity) cout << "Run " << name << " test: "; 
+  for(int k=1; k<=num_instances; ++k)
+    check_instance(k);
+  if(Verbosity) cout << "(" << num_instances << " instances, " << num_errors << " errors) ";
+}
+
+
+NValueTest::NValueTest() : GlobalConstraintTest("NValue", 60, 0) {}
+NValueTest::~NValueTest() {}
+
+void NValueTest::model(Solver &s, VarArray &X, const int k, const bool global) {
+  int i, v, n = 3+randint(3), lb, ub;
+  for(i=0; i<n; ++i) {
+    lb = randint(4);
+    ub = lb+randint(4);
+    Variable x(lb, ub);
+    X.add(x);
+  }
+  lb = 1+randint(3);
+  Variable N(lb, lb+randint(3));
+
+  if(global) {
+    s.add( NValue(X) == N );
+  } else {
+    VarArray used;
+    for(v=0; v<8; ++v) {
+      VarArray equal;
+      for(i=0; i<n; ++i)
+	equal.add( X[i] == v );
+      used.add( BoolSum(equal) > 0 );
+    }
+    s.add( BoolSum(used) == N );
+  }
+  X.add(N);
+}
+
+
+BinPackingTest::BinPackingTest() : GlobalConstraintTest("BinPacking", 60, 0) {}
+BinPackingTest::~BinPackingTest() {}
+
+void BinPackingTest::model(Solver &s, VarArray &X, const int k, const bool global) {
+  int i, b, n = 3+randint(3), m = 2+randint(2), first = randint(3), lb, total = 0;
+  std::vector<int> size;
+  for(i=0; i<n; ++i) {
+    size.push_back(1+randint(4));
+    total += size.back();
+    lb = first+randint(m);
+    Variable x(lb, lb+randint(first+m-lb));
+    X.add(x);
+  }
+  VarArray load;
+  for(b=0; b<m; ++b) {
+    lb = randint(total/m+1);
+    Variable l(lb, std::min(total, lb+total/m+randint(total/2+1)));
+    load.add(l);
+  }
+
+  if(global) {
+    s.add( BinPacking(X, size, load, first) );
+  } else {
+    for(b=0; b<m; ++b) {
+      VarArray in_bin;
+      for(i=0; i<n; ++i)
+	in_bin.add( X[i] == first+b );
+      s.add( Sum(in_bin, size) == load[b] );
+    }
+  }
+  for(b=0; b<m; ++b)
+    X.add(load[b]);
+}
+
+
+IncrementalWeightedSumTest::IncrementalWeightedSumTest() 
+  : GlobalConstraintTest("IncrementalWeightedSum", 60, 0) {}
+IncrementalWeightedSumTest::~IncrementalWeightedSumTest() {}
+
+void IncrementalWeightedSumTest::model(Solver &s, VarArray &X, const int k, const bool global) {
+  int i, n = 3+randint(4), lb, min_sum = 0, max_sum = 0;
+  Vector< int > weight;
+  for(i=0; i<n; ++i) {
+    weight.add(randint(9)-4);
+    lb = randint(5)-2;
+    Variable x(lb, lb+randint(4));
+    X.add(x);
+    min_sum += weight[i] * (weight[i] > 0 ? x.get_min() : x.get_max());
+    max_sum += weight[i] * (weight[i] > 0 ? x.get_max() : x.get_min());
+  }
+  lb = min_sum + randint(max_sum-min_sum+1);
+  int ub = lb + randint(max_sum-lb+1)/2;
+
+  // the propagator is only chosen for long sums, so both are posted directly
+  s.add(X);
+  Vector< Variable > scope;
+  for(i=0; i<n; ++i)
+    scope.add(X[i].get_var());
+  if(global) 
+    s.add( Constraint(new ConstraintIncrementalWeightedSum(scope, weight, lb, ub)) );
+  else
+    s.add( Constraint(new PredicateWeightedSum(scope, weight, lb, ub)) );
+}
+
+
+IntElementTest::IntElementTest() : GlobalConstraintTest("IntElement", 60, 2) {}
+IntElementTest::~IntElementTest() {}
+
+void IntElementTest::model(Solver &s, VarArray &X, const int k, const bool global) {
+  int i, n = 3+randint(5), offset = randint(3)-1, lb;
+  VarArray T;
+  for(i=0; i<n; ++i) {
+    lb = randint(6);
+    T.add(Variable(lb, lb));
+  }
+  // the index may be out of the array
+  lb = offset-1+randint(3);
+  Variable x(lb, lb+1+randint(n));
+  lb = randint(4);
+  Variable y(lb, lb+1+randint(3));
+
+  if(global) {
+    s.add( Element(T, x, offset) == y );
+  } else {
+    s.add( Member(x, offset, offset+n-1) );
+    for(i=0; i<n; ++i)
+      s.add( (x != i+offset) || (y == T[i].get_value()) );
+  }
+  X.add(x);
+  X.add(y);
+}
+
+
+Element2DTest::Element2DTest() : GlobalConstraintTest("Element2D", 60, 3) {}
+Element2DTest::~Element2DTest() {}
+
+void Element2DTest::model(Solver &s, VarArray &X, const int k, const bool global) {
+  int i, j, nr = 2+randint(3), nc = 2+randint(3), 
+    row_offset = randint(3)-1, col_offset = randint(3)-1, lb;
+  std::vector< std::vector<int> > M(nr);
+  for(i=0; i<nr; ++i)
+    for(j=0; j<nc; ++j)
+      M[i].push_back(randint(6));
+  lb = row_offset-1+randint(2);
+  Variable r(lb, lb+1+randint(nr));
+  lb = col_offset-1+randint(2);
+  Variable c(lb, lb+1+randint(nc));
+  lb = randint(3);
+  Variable z(lb, lb+1+randint(4));
+
+  if(global) {
+    s.add( Element(M, r, c, row_offset, col_offset) == z );
+  } else {
+    s.add( Member(r, row_offset, row_offset+nr-1) );
+    s.add( Member(c, col_offset, col_offset+nc-1) );
+    for(i=0; i<nr; ++i)
+      for(j=0; j<nc; ++j)
+	s.add( (r != i+row_offset) || (c != j+col_offset) || (z == M[i][j]) );
+  }
+  X.add(r);
+  X.add(c);
+  X.add(z);
+}
+
+
+CardinalityTest::CardinalityTest() : GlobalConstraintTest("Cardinality", 60, 0) {}
+CardinalityTest::~CardinalityTest() {}
+
+void CardinalityTest::model(Solver &s, VarArray &X, const int k, const bool global) {
+  int i, j, v, n = 3+randint(4), m = 2+randint(3), lb;
+  for(i=0; i<n; ++i) {
+    // domains with holes, of at least two values
+    std::vector<int> dom;
+    for(v=0; v<5; ++v)
+      if(randint(2)) dom.push_back(v);
+    while(dom.size() < 2) {
+      v = randint(5);
+      if(std::find(dom.begin(), dom.end(), v) == dom.end()) dom.push_back(v);
+    }
+    std::sort(dom.begin(), dom.end());
+    Variable x(dom);
+    X.add(x);
+  }
+  // some values may be in no domain
+  std::vector<int> values, lbs, ubs;
+  VarArray counts;
+  for(j=0; j<m; ++j) {
+    values.push_back(2*j+randint(2));
+    lb = randint(n/2+1);
+    lbs.push_back(lb);
+    ubs.push_back(lb+randint(n-lb+1));
+    Variable c(lbs[j], ubs[j]);
+    counts.add(c);
+  }
+  // all variables are checked, and their number varies
+  num_gac = n+m;
+
+  // odd instances have constant bounds, even ones occurrence variables
+  if(global) {
+    if(k&1) s.add( Occurrences(X, values, lbs, ubs, DOMAIN_CONSISTENCY) );
+    else s.add( Cardinality(X, values, counts) );
+  } else {
+    for(j=0; j<m; ++j) {
+      VarArray equal;
+      for(i=0; i<n; ++i)
+	equal.add( X[i] == values[j] );
+      if(k&1) s.add( BoolSum(equal, lbs[j], ubs[j]) );
+      else s.add( BoolSum(equal) == counts[j] );
+    }
+  }
+  if(!(k&1))
+    for(j=0; j<m; ++j)
+      X.add(counts[j]);
+}
+
+
+GaussParityTest::GaussParityTest() : GlobalConstraintTest("GaussParity", 60, 0) {}
+GaussParityTest::~GaussParityTest() {}
+
+void GaussParityTest::model(Solver &s, VarArray &X, const int k, const bool global) {
+  int i, j, n = 4+randint(5), m = 2+randint(4);
+  for(i=0; i<n; ++i) {
+    Variable x(0, 1);
+    X.add(x);
+  }
+  // some variables may be in no row
+  s.add(X);
+  for(j=0; j<m; ++j) {
+    // at least two distinct variables per row
+    VarArray row;
+    int first = randint(n-1);
+    row.add(X[first]);
+    for(i=first+1; i<n; ++i)
+      if((i == n-1 && row.size < 2) || randint(3)) row.add(X[i]);
+    s.add( Parity(row, randint(2)) );
+  }
+  // the system is complete, each parity constraint alone is not
+  num_gac = n;
+
+  if(global)
+    s.gauss_processing();
+}
+
+
+KnapsackTest::KnapsackTest() : GlobalConstraintTest("Knapsack", 60, 0) {}
+KnapsackTest::~KnapsackTest() {}
+
+void KnapsackTest::model(Solver &s, VarArray &X, const int k, const bool global) {
+  int i, n = 3+randint(4), max_weight = 0, max_profit = 0, lb, ub, pl, pu;
+  // odd instances have too many states for the DP, and use the reduced costs
+  int scale = (k&1 ? 250000 : 1);
+  std::vector<int> weight, profit;
+  for(i=0; i<n; ++i) {
+    Variable x(0, 1+randint(2));
+    X.add(x);
+    weight.push_back(scale * randint(6));
+    profit.push_back(randint(6));
+    max_weight += weight[i] * x.get_max();
+    max_profit += profit[i] * x.get_max();
+  }
+  ub = scale * randint(max_weight/scale+1);
+  lb = (randint(2) ? -INFTY : scale * randint(ub/scale+1));
+  pl = randint(max_profit+1);
+  pu = pl + randint(max_profit-pl+1);
+  Variable P(pl, pu);
+
+  if(global) {
+    s.add( Knapsack(X, ub, weight, profit, lb) == P );
+  } else {
+    s.add( Sum(X, profit) == P );
+    Variable W = Sum(X, weight);
+    s.add( W <= ub );
+    if(lb != -INFTY) s.add( W >= lb );
+  }
+  X.add(P);
+}
+
+
+LexChainTest::LexChainTest() : GlobalConstraintTest("LexChain", 60, 0) {}
+LexChainTest::~LexChainTest() {}
+
+void LexChainTest::model(Solver &s, VarArray &X, const int k, const bool global) {
+  // odd instances are a single pair of rows, posted with LexLeq/LexLess
+  int i, j, m = 2+randint(2), r = (k&1 ? 2 : 2+randint(3)), lb;
+  int strict = randint(2);
+  std::vector< VarArray > rows(r);
+  for(i=0; i<r; ++i)
+    for(j=0; j<m; ++j) {
+      lb = randint(3);
+      Variable x(lb, lb+1+randint(2));
+      rows[i].add(x);
+      X.add(x);
+    }
+  num_gac = r*m;
+
+  if(global) {
+    if(k&1) s.add( strict ? LexLess(rows[0], rows[1]) : LexLeq(rows[0], rows[1]) );
+    else s.add( LexChain(rows, strict) );
+  } else {
+    // the first difference between consecutive rows is an increase
+    for(i=1; i<r; ++i) {
+      VarArray differ;
+      for(j=0; j<m; ++j) {
+	if(j) s.add( (BoolSum(differ) > 0) || (rows[i-1][j] <= rows[i][j]) );
+	else s.add( rows[i-1][j] <= rows[i][j] );
+	differ.add( rows[i-1][j] != rows[i][j] );
+      }
+      if(strict) s.add( BoolSum(differ) > 0 );
+    }
+  }
+}
+
+
+SequenceTest::SequenceTest() : GlobalConstraintTest("Sequence", 60, 0) {}
+SequenceTest::~SequenceTest() {}
+
+void SequenceTest::model(Solver &s, VarArray &X, const int k, const bool global) {
+  int i, j, v, n = 4+randint(5), q = 2+randint(3), lo = randint(q), hi, lb;
+  hi = lo + randint(q-lo+1);
+  for(i=0; i<n; ++i) {
+    lb = randint(4);
+    Variable x(lb, lb+1+randint(2));
+    X.add(x);
+  }
+  std::vector<int> values;
+  for(v=0; v<6; ++v)
+    if(randint(2)) values.push_back(v);
+  if(values.empty()) values.push_back(randint(6));
+  num_gac = n;
+
+  if(global) {
+    s.add( Sequence(X, lo, hi, q, values) );
+  } else {
+    VarArray in;
+    for(i=0; i<n; ++i)
+      in.add( Member(X[i], values) );
+    for(i=0; i+q<=n; ++i) {
+      VarArray window;
+      for(j=i; j<i+q; ++j)
+	window.add(in[j]);
+      s.add( BoolSum(window, lo, hi) );
+    }
+  }
+}
+
+
 VarStackDynamicTest::VarStackDynamicTest() : UnitTest() {}
 
 VarStackDynamicTest::~VarStackDynamicTest() {}
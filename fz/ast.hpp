@@ -42,6 +42,7 @@
 #include <string>
 #include <iostream>
 #include <cstdlib>
+#include <new>
 
 #define forceinline inline
 
@@ -67,6 +68,77 @@ namespace FlatZinc { namespace AST {
     std::string what(void) const { return _what; }
   };
 
+  /**
+   * \brief Memory pool for the nodes of the abstract syntax trees
+   *
+   * Large models create and destroy millions of small nodes. They are
+   * carved out of large blocks and recycled through one free list per
+   * size instead of going through malloc one by one. All the blocks are
+   * released at once when the last node is deleted.
+   */
+  class NodePool {
+  private:
+    enum { GRANULARITY = sizeof(void*), CLASSES = 16, BLOCK_SIZE = 1 << 16 };
+    std::vector<char*> blocks;
+    void* free_list[CLASSES];
+    char* cursor;
+    char* end;
+    size_t live;
+
+    NodePool(void) : cursor(NULL), end(NULL), live(0) {
+      for (int c=0; c<CLASSES; c++) free_list[c] = NULL;
+    }
+    /// Release all the blocks but the first, which is reused from scratch
+    void clear(void) {
+      for (unsigned int i=1; i<blocks.size(); i++)
+        free(blocks[i]);
+      blocks.resize(1);
+      for (int c=0; c<CLASSES; c++) free_list[c] = NULL;
+      cursor = blocks[0];
+      end = cursor + BLOCK_SIZE;
+    }
+
+  public:
+    static NodePool& pool(void) {
+      static NodePool p;
+      return p;
+    }
+
+    void* allocate(size_t size) {
+      size_t c = (size + GRANULARITY - 1) / GRANULARITY;
+      if (c >= CLASSES)
+        return ::operator new(size);
+      ++live;
+      void* n = free_list[c];
+      if (n) {
+        free_list[c] = *static_cast<void**>(n);
+        return n;
+      }
+      if (cursor + c*GRANULARITY > end) {
+        cursor = static_cast<char*>(malloc(BLOCK_SIZE));
+        if (!cursor)
+          throw std::bad_alloc();
+        blocks.push_back(cursor);
+        end = cursor + BLOCK_SIZE;
+      }
+      n = cursor;
+      cursor += c*GRANULARITY;
+      return n;
+    }
+
+    void release(void* n, size_t size) {
+      size_t c = (size + GRANULARITY - 1) / GRANULARITY;
+      if (c >= CLASSES) {
+        ::operator delete(n);
+        return;
+      }
+      *static_cast<void**>(n) = free_list[c];
+      free_list[c] = n;
+      if (--live == 0)
+        clear();
+    }
+  };
+
   /**
    * \brief A node in a %FlatZinc abstract syntax tree
    */
@@ -75,6 +147,14 @@ namespace FlatZinc { namespace AST {
     /// Destructor
     virtual ~Node(void);
 
+    /// Nodes are allocated from the pool
+    static void* operator new(size_t size) {
+      return NodePool::pool().allocate(size);
+    }
+    static void operator delete(void* n, size_t size) {
+      NodePool::pool().release(n, size);
+    }
+
     /// Append \a n to an array node
     void append(Node* n);
 
@@ -40,6 +40,8 @@
 #include <iomanip>
 
 #include <vector>
+#include <algorithm>
+#include <sstream>
 #include <assert.h>
 #include <string>
 #include <set>
@@ -49,6 +51,7 @@
 #endif
 
 #include <mistral_variable.hpp>
+#include <mistral_sat.hpp>
 
 //#define _DEBUG_FLATZINC true
 //#define _VERBOSE_PARSER 1000
@@ -190,6 +193,7 @@ FlatZincModel::FlatZincModel(Solver &s)
   _option_display_mistral_model(false),
   _option_annotations(false),
   _option_parity(0),
+  _option_gauss(false),
   intVarCount(-1), boolVarCount(-1), setVarCount(-1), _optVar(-1),
   _solveAnnotations(NULL)
 {
@@ -476,6 +480,119 @@ FlatZincModel::postConstraint(const ConExpr& ce, AST::Node* ann) {
 
 
 
+void
+FlatZincModel::addConstraint(ConExpr* ce, AST::Node* ann) {
+	_constraints.push_back(std::make_pair(ce, ann));
+}
+
+/// Append the (representative of the) Boolean variables occurring in \a n to \a vars
+static void collectBoolVars(AST::Node* n, const std::vector<int>& rep,
+		std::vector<int>& vars) {
+	if (n->isBoolVar()) {
+		int x = rep[n->getBoolVar()];
+		if (x >= 0) vars.push_back(x);
+	} else if (n->isArray()) {
+		AST::Array* a = n->getArray();
+		for (unsigned int i=0; i<a->a.size(); ++i)
+			collectBoolVars(a->a[i], rep, vars);
+	} else if (AST::Call* c = dynamic_cast<AST::Call*>(n)) {
+		collectBoolVars(c->args, rep, vars);
+	}
+}
+
+/// Whether the last argument of \a ce is the Boolean result of a reification
+static bool isReification(const ConExpr& ce) {
+	const std::string& id = ce.id;
+	unsigned int n = id.size(), arity = ce.args->a.size();
+	if ((n > 5 && id.compare(n-5, 5, "_reif") == 0) ||
+			(n > 4 && id.compare(n-4, 4, "_imp") == 0))
+		return arity > 1;
+	if (id == "bool_and" || id == "bool_or" || id == "bool_xor")
+		return arity == 3;
+	if (id == "array_bool_and" || id == "array_bool_or")
+		return arity == 2;
+	return false;
+}
+
+void
+FlatZincModel::postConstraints(Printer& p) {
+	unsigned int n = _constraints.size();
+
+	// aliased Boolean variables share their implementation, constants are ignored
+	std::vector<int> rep(boolVarCount, -1);
+	std::map<Expression*, int> ids;
+	for (int i=0; i<boolVarCount; ++i)
+		if (bv[i].domain_type != CONST_VAR)
+			rep[i] = ids.insert(std::make_pair(bv[i].expression, (int)ids.size())).first->second;
+
+	std::vector<int> vars;
+	for (unsigned int i=0; i<n; ++i)
+		collectBoolVars(_constraints[i].first->args, rep, vars);
+	if (p.get_output()) collectBoolVars(p.get_output(), rep, vars);
+	if (_solveAnnotations) collectBoolVars(_solveAnnotations, rep, vars);
+	// the objective is an integer variable, it may share its implementation
+	// with a Boolean variable
+	if (_optVar >= 0 && iv[_optVar].domain_type != CONST_VAR) {
+		std::map<Expression*, int>::iterator obj = ids.find(iv[_optVar].expression);
+		if (obj != ids.end()) vars.push_back(obj->second);
+	}
+	std::vector<int> occ(ids.size(), 0);
+	for (unsigned int i=0; i<vars.size(); ++i) ++occ[vars[i]];
+
+	// reifications, chained by their result
+	std::vector<int> result(n, -1), first(ids.size(), -1), next(n, -1);
+	std::vector<bool> dropped(n, false);
+	std::vector<int> dead;
+	for (unsigned int i=0; i<n; ++i) {
+		const ConExpr& ce = *(_constraints[i].first);
+		if (isReification(ce) && ce.args->a.back()->isBoolVar()) {
+			int x = rep[ce.args->a.back()->getBoolVar()];
+			if (x >= 0) {
+				result[i] = x;
+				next[i] = first[x];
+				first[x] = i;
+				if (occ[x] == 1) dead.push_back(i);
+			}
+		}
+	}
+
+	// a reification whose result occurs nowhere else can always be satisfied
+	// by setting the result; dropping it may in turn leave other ones unused
+	int num_dropped = 0;
+	while (!dead.empty()) {
+		int c = dead.back();
+		dead.pop_back();
+		if (dropped[c] || occ[result[c]] != 1) continue;
+		dropped[c] = true;
+		++num_dropped;
+
+		vars.clear();
+		collectBoolVars(_constraints[c].first->args, rep, vars);
+		for (unsigned int j=0; j<vars.size(); ++j) --occ[vars[j]];
+		for (unsigned int j=0; j<vars.size(); ++j)
+			if (occ[vars[j]] == 1)
+				for (int k=first[vars[j]]; k>=0; k=next[k])
+					if (!dropped[k]) dead.push_back(k);
+	}
+
+	if (num_dropped && solver.parameters.verbosity > 1)
+		std::cout << " " << solver.parameters.prefix_comment << " dropped " << num_dropped
+		<< " unused reification(s)" << std::endl;
+
+	for (unsigned int i=0; i<n; ++i) {
+		if (!dropped[i]) postConstraint(*(_constraints[i].first), _constraints[i].second);
+		delete _constraints[i].first;
+		delete _constraints[i].second;
+		_constraints[i].first = NULL;
+		_constraints[i].second = NULL;
+	}
+	_constraints.clear();
+
+	// the clauses collected by the registry are loaded in the clause base at once
+	encode_clauses();
+}
+
+
 void flattenAnnotations(AST::Array* ann, std::vector<AST::Node*>& out) {
 	for (unsigned int i=0; i<ann->a.size(); i++) {
 		if (ann->a[i]->isCall("seq_search")) {
@@ -749,6 +866,10 @@ FlatZincModel::maximize(int var, AST::Array* ann) {
 
 FlatZincModel::~FlatZincModel(void) {
 	delete _solveAnnotations;
+	for (unsigned int i=0; i<_constraints.size(); ++i) {
+		delete _constraints[i].first;
+		delete _constraints[i].second;
+	}
 
 	// for(unsigned int i=0; i<iv.size; ++i) {
 	//
@@ -797,6 +918,11 @@ FlatZincModel::set_parity_processing(const int lvl) {
 	_option_parity = lvl;
 }
 
+void
+FlatZincModel::set_gauss_processing(const bool on) {
+	_option_gauss = on;
+}
+
 void
 FlatZincModel::set_display_collection(const bool on) {
 	_option_display_information = on;
@@ -952,6 +1078,9 @@ FlatZincModel::run(std::ostream& out, Printer& p) {
 
 	solver.consolidate();
 
+	if(solver.parameters.presolve)
+		solver.presolve();
+
 	solver.sequence.clear();
 
 	//std::cout << " c RUN with branch_on_auxilary  :  " << branch_on_auxilary << std::endl;
@@ -993,9 +1122,14 @@ FlatZincModel::run(std::ostream& out, Printer& p) {
 		if (solver.parameters.verbosity>0)
 			std::cout << " " << solver.parameters.prefix_comment << " Solve " << std::endl;
 #endif
-		if(_option_enumerate)
+		if(_option_enumerate) {
+			// the enumeration branches right on the last decision after each
+			// solution, learnt nogoods and backjumps would skip or revisit
+			// solutions, so the search is chronological (the clause base
+			// still propagates)
+			solver.parameters.backjump = 0;
 			goal = new Goal(Goal::ENUMERATION);
-		else
+		} else
 			goal = new Goal(Goal::SATISFACTION);
 		break;
 	}
@@ -1029,6 +1163,9 @@ FlatZincModel::run(std::ostream& out, Printer& p) {
 	if(_option_parity)
 		solver.parity_processing(_option_parity);
 
+	if(_option_gauss)
+		solver.gauss_processing();
+
 	//std::cout << _variable_ordering << " " << _value_ordering << std::endl;
 	if (!_option_heuristic)
 	{
@@ -1508,7 +1645,7 @@ FlatZincModel::print_final(std::ostream& out, const Printer& p) const {
 
 
 void
-FlatZincModel::print_solution(std::ostream& out, const Printer& p) const {
+FlatZincModel::print_solution(SolutionWriter& out, const Printer& p) const {
 
 	//#ifdef _FLATZINC_OUTPUT
 
@@ -1524,12 +1661,16 @@ FlatZincModel::print_solution(std::ostream& out, const Printer& p) const {
 			p.print(out, solver, iv, bv, sv);
 
 			if(_optVar >= 0)
-				if(solver.parameters.verbosity >0)
-					out << " " << solver.parameters.prefix_comment << " objective: " << iv[_optVar].get_var()
+				if(solver.parameters.verbosity >0) {
+					std::ostringstream var;
+					var << iv[_optVar].get_var();
+					out << " " << solver.parameters.prefix_comment << " objective: " << var.str()
 					<< " in [" << iv[_optVar].get_solution_min()
-					<< ".." << iv[_optVar].get_solution_max() << "]" << endl;
+					<< ".." << iv[_optVar].get_solution_max() << "]\n";
+				}
 		}
-		out << "----------" << std::endl;
+		out << "----------\n";
+		out.end_solution();
 	}
 	//#endif
 
@@ -1544,7 +1685,7 @@ Printer::init(AST::Array* output) {
 }
 
 void
-Printer::printElem(std::ostream& out,
+Printer::printElem(SolutionWriter& out,
 		Solver& solver,
 		AST::Node* ai,
 		const IntVarArray& iv,
@@ -1620,9 +1761,9 @@ Printer::printElem(std::ostream& out,
 		for (unsigned int i=0; i<s.size(); i++) {
 			if (s[i] == '\\' && i<s.size()-1) {
 				switch (s[i+1]) {
-				case 'n': out << "\n"; break;
-				case '\\': out << "\\"; break;
-				case 't': out << "\t"; break;
+				case 'n': out << '\n'; break;
+				case '\\': out << '\\'; break;
+				case 't': out << '\t'; break;
 				default: out << "\\" << s[i+1];
 				}
 				i++;
@@ -1634,7 +1775,7 @@ Printer::printElem(std::ostream& out,
 }
 
 void
-Printer::print(std::ostream& out,
+Printer::print(SolutionWriter& out,
 		Solver& solver,
 		const IntVarArray& iv,
 		const BoolVarArray& bv,
@@ -1665,105 +1806,70 @@ Printer::~Printer(void) {
 }
 
 
-void FlatZincModel::add_clause(Vector<Variable> pos ,  Vector<Variable> neg)
+//add the clause having all the positive literals in the vector of variables pos and the negative ones in neg
+void FlatZincModel::add_clause(const Vector<Variable>& pos, const Vector<Variable>& neg)
 {
-
-	clause_struct v;
-	v.pos =pos;
-	v.neg =neg;
-	_clauses.add(v);
-
-	if(! pos.empty())
-		for (unsigned int i=0; i< pos. size ; i++)
+	if (_clause_start.empty())
+		_clause_start.add(0);
+	unsigned int begin = _clause_start.back(), i, j;
+
+	// ground literals are evaluated, a satisfied clause is discarded (its
+	// variables are still added to the solver, as they would be otherwise)
+	bool satisfied = false;
+	for (i=0; i<pos.size; ++i) {
+		if (!pos[i].is_ground()) {
 			solver.add(pos[i]);
-
-	if(! neg.empty())
-		for (unsigned int i=0; i< neg. size ; i++)
+			_clause_literals.add(literal(pos[i], 1));
+		} else satisfied |= (pos[i].get_value() == 1);
+	}
+	for (i=0; i<neg.size; ++i) {
+		if (!neg[i].is_ground()) {
 			solver.add(neg[i]);
-}
-
-//encode the clause having all the positive literals in the vector of variables pos and the negative ones in neg
-void FlatZincModel::encode_clause (Vector<Variable> pos ,  Vector<Variable> neg)
-{
-
-	/*We use the variable alone only when the size of the clause is 1.
-	 *In that case we force it to take the value sign_alone
-	 */
-	Variable  alone;
-	int sign_alone;
-	Vector< Literal > clause;
-	//Literal  lit;
-	clause.clear();
+			_clause_literals.add(literal(neg[i], 0));
+		} else satisfied |= (neg[i].get_value() == 0);
+	}
+	if (satisfied) {
+		_clause_literals.size = begin;
+		return;
+	}
 
-	if(! pos.empty())
-	{
-		for (unsigned int i=0; i< pos. size ; i++)
-		{
-			if (! pos[i].is_ground())
-			{
-				//	solver.add(pos[i]);
-				//				lit =  (2* pos[i].id()) +1;
-				clause.add(literal(pos[i],1));
-				if(clause.size ==1)
-				{
-					sign_alone=1;
-					alone= pos[i];
-				}
-			}
-			else
-				if (pos[i].get_value())
-					return;
+	// remove the repeated literals, and the tautologies
+	Literal *lits = _clause_literals.stack_;
+	std::sort(lits+begin, lits+_clause_literals.size);
+	for (i=j=begin; i<_clause_literals.size; ++i) {
+		if (j > begin && lits[i] == lits[j-1])
+			continue;
+		if (j > begin && lits[i] == NOT(lits[j-1])) {
+			_clause_literals.size = begin;
+			return;
 		}
+		lits[j++] = lits[i];
 	}
-	if(! neg.empty())
-	{
-		for (unsigned int i=0; i< neg.size ; i++)
-		{
-			if (!neg[i].is_ground())
-			{
-				//				solver.add(neg[i]);
-				//lit =  2* neg[i].id();
-				clause.add(literal(neg[i],0));
-				if(clause.size ==1)
-				{
-					sign_alone=0;
-					alone=neg[i];
-				}
+	_clause_literals.size = j;
+
+	if (j == begin) {
+		solver.fail();
+	} else if (j == begin+1) {
+		// unit clauses are posted directly
+		Literal unit = lits[begin];
+		_clause_literals.size = begin;
+		const Vector<Variable>& vars = (SIGN(unit) ? pos : neg);
+		for (i=0; i<vars.size; ++i)
+			if (!vars[i].is_ground() && literal(vars[i], SIGN(unit)) == unit) {
+				Variable x = vars[i];
+				solver.add(x == Variable((int)SIGN(unit)));
+				return;
 			}
-			else
-				if (!neg[i].get_value())
-					return;
-		}
-	}
-	if (clause.size ==1)
-	{
-		solver.add(alone==sign_alone);
-		return ;
-	}
-	else
-	{
-		if (clause.size >0)
-		{
-			clause.sort();
-			//			std::cout<< "add clause : " <<clause<< std::endl;
-			cnf.add(clause);
-		}
-		else if (clause.size ==0)
-			solver.fail();
+	} else {
+		_clause_start.add(j);
 	}
 }
 
-
 void FlatZincModel::encode_clauses()
 {
-	int size =_clauses.size;
-	cnf.clear();
-	if(size)
-		while(--size)
-			encode_clause(_clauses[size].pos, _clauses[size].neg);
-
-	for( unsigned  int i=0; i<cnf.size; ++i)
-		solver.add(cnf[i]);
+	solver.add_clauses(_clause_literals, _clause_start);
+	_clause_literals.clear();
+	_clause_start.clear();
 }
 
 
@@ -1771,7 +1877,7 @@ void FlatZincModel::encode_clauses()
 
 
 FlatZinc::SolutionPrinter::SolutionPrinter(Printer *p, FlatZincModel *fm, Mistral::Solver *s) 
-: p_(p), fm_(fm), solver_(s) {
+: p_(p), fm_(fm), solver_(s), out_(std::cout), binary_file_(NULL), binary_(NULL) {
 	//solver_->add((SolutionListener*)this);
 #ifdef _PARALLEL
 	if (fm->method() == FlatZincModel::MINIMIZATION)
@@ -1786,7 +1892,29 @@ FlatZinc::SolutionPrinter::SolutionPrinter(Printer *p, FlatZincModel *fm, Mistra
 #endif
 }
 
-FlatZinc::SolutionPrinter::~SolutionPrinter() {}
+FlatZinc::SolutionPrinter::~SolutionPrinter() {
+	delete binary_;
+	delete binary_file_;
+}
+
+bool FlatZinc::SolutionPrinter::set_output(const int period, const std::string& binary_file) {
+	out_.set_flush_period(period);
+	if(binary_file != "") {
+		binary_file_ = new std::ofstream(binary_file.c_str(), std::ios_base::out | std::ios_base::binary);
+		if(!binary_file_->good()) return false;
+		binary_ = new Mistral::SolutionWriter(*binary_file_, period);
+	}
+	return true;
+}
+
+void FlatZinc::SolutionPrinter::write_solution() {
+	if(binary_) {
+		binary_->write_binary(solver_->last_solution_lb.stack_, solver_->last_solution_lb.size);
+		binary_->end_solution();
+	} else {
+		fm_->print_solution(out_, *p_);
+	}
+}
 
 void FlatZinc::SolutionPrinter::notify_solution() {
 #ifdef _PARALLEL
@@ -1833,11 +1961,11 @@ void FlatZinc::SolutionPrinter::notify_solution() {
 				}
 		if (print){
 			//std::cout << " thread ID : " << omp_get_thread_num() << std::endl;
-			fm_->print_solution(std::cout, *p_);
+			write_solution();
 		}
 	}
 #else
-	fm_->print_solution(std::cout, *p_);
+	write_solution();
 #endif
 
 };
@@ -39,6 +39,7 @@
 #define __GECODE_FLATZINC_HH__
 
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <map>
 #include <set>
@@ -80,7 +81,7 @@ namespace FlatZinc {
 class Printer {
 private:
 	AST::Array* _output;
-	void printElem(std::ostream& out,
+	void printElem(SolutionWriter& out,
 			Solver& solver,
 			AST::Node* ai,
 			const IntVarArray& iv,
@@ -94,7 +95,7 @@ public:
 
 	AST::Array* get_output() {return _output;}
 
-	void print(std::ostream& out,
+	void print(SolutionWriter& out,
 			Solver& solver,
 			const IntVarArray& iv,
 			const BoolVarArray& bv,
@@ -287,6 +288,7 @@ protected:
 	bool _option_display_solution;
 	bool _option_annotations;
 	int _option_parity;
+	bool _option_gauss;
 	////
 
 
@@ -305,17 +307,14 @@ protected:
 
 	/// Annotations on the solve item
 	AST::Array* _solveAnnotations;
-	struct clause_struct
-	{
-		//Variables appearing positively in the clause
-		Vector<Variable > pos;
-		//Variables appearing negatively in the clause
-		Vector<Variable > neg;
-	};
 
-	//structure used for encoding clauses
-	Vector<clause_struct> _clauses;
-	Vector< Vector< Literal > > cnf;
+	/// Literals of the clauses to be loaded in the clause base, see add_clause()
+	Vector<Literal> _clause_literals;
+	/// Start of each clause in _clause_literals, followed by the end of the last one
+	Vector<unsigned int> _clause_start;
+
+	/// Constraints read by the parser and not yet posted, with their annotations
+	std::vector< std::pair<ConExpr*, AST::Node*> > _constraints;
 
 public:
 
@@ -371,6 +370,17 @@ public:
 
 	/// Post a constraint specified by \a ce
 	void postConstraint(const ConExpr& ce, AST::Node* annotation);
+	/// Record the constraint \a ce (taking ownership), it is posted by postConstraints
+	void addConstraint(ConExpr* ce, AST::Node* annotation);
+	/**
+	 * \brief Post the recorded constraints
+	 *
+	 * Called once the whole model is read. Reified constraints whose
+	 * Boolean result is used nowhere else (in any constraint, in the
+	 * output of \a p, in the objective or in the search annotations)
+	 * are dropped instead of being posted.
+	 */
+	void postConstraints(Printer& p);
 
 	/// Post the solve item
 	void solve(AST::Array* annotation);
@@ -393,6 +403,9 @@ public:
 	/// setup the rewriting step
 	void set_parity_processing(const int lvl);
 
+	/// propagate the parity constraints together by Gauss-Jordan elimination
+	void set_gauss_processing(const bool on);
+
 	/// setup the rewriting step
 	void set_enumeration(const bool on);
 
@@ -421,7 +434,7 @@ public:
 
 	/// Produce output on \a out using \a p
 	void print_final(std::ostream& out, const Printer& p) const;
-	void print_solution(std::ostream& out, const Printer& p) const;
+	void print_solution(SolutionWriter& out, const Printer& p) const;
 
 	/**
 	 * \brief Remove all variables not needed for output
@@ -465,8 +478,9 @@ public:
 		return ((outcome == SAT) || (outcome == OPT) || ((outcome == LIMITOUT) && (solver.statistics.num_solutions >0)));
 	}
 
-	void add_clause(Vector<Variable> pos ,  Vector<Variable> neg);
-	void encode_clause(Vector<Variable> pos ,  Vector<Variable> neg);
+	/// Add the clause (\\/ pos) \\/ (\\/ not(neg)), to be loaded by encode_clauses()
+	void add_clause(const Vector<Variable>& pos, const Vector<Variable>& neg);
+	/// Load the clauses added so far in the clause base, in bulk
 	void encode_clauses();
 
 	//Chose a recommended search configuration
@@ -536,9 +550,21 @@ public:
 	//   solver->add((SolutionPrinter*)this);
 	// }
 
+	/// Buffered output of the solutions
+	Mistral::SolutionWriter out_;
+	/// If not NULL, solutions are written there in binary instead
+	std::ofstream *binary_file_;
+	Mistral::SolutionWriter *binary_;
+
 	SolutionPrinter(Printer *p, FlatZincModel *fm, Mistral::Solver *s);
 	virtual ~SolutionPrinter();
 
+	/// Flush the output every \a period solutions (never if 0), and write
+	/// the solutions in binary to \a binary_file if it is not empty
+	/// Returns false if that file could not be opened
+	bool set_output(const int period, const std::string& binary_file);
+	void write_solution();
+
 	virtual void notify_solution() ;
 	//{
 	//   fm_->print(std::cout, *p_);
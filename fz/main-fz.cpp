@@ -70,6 +70,9 @@ int main(int argc, char *argv[])
   TCLAP::ValueArg<int> parityArg("","parity","Uses parity processing", false, 0, "int");
   cmd.add( parityArg );
 
+  TCLAP::SwitchArg gaussArg("","gauss","Propagates the parity constraints by Gauss-Jordan elimination", false);
+  cmd.add( gaussArg );
+
   TCLAP::SwitchArg simple_rewriteArg("","simple_rewrite","Uses simple rewriting", false);
   cmd.add( simple_rewriteArg );
 
@@ -198,6 +201,10 @@ int main(int argc, char *argv[])
 #endif
 
   FlatZinc::SolutionPrinter *sp = new FlatZinc::SolutionPrinter(&p, fm, &s);
+  if(!sp->set_output(cmd.get_flush_period(), cmd.get_binary_solutions())) {
+	  cerr << "cannot open " << cmd.get_binary_solutions() << endl;
+	  return 1;
+  }
   s.add(sp);
 
 
@@ -220,7 +227,7 @@ int main(int argc, char *argv[])
   fm->set_rewriting(cmd.use_rewrite());
   fm->set_simple_rewriting(simple_rewriteArg.getValue());
   fm->set_parity_processing(parityArg.getValue());
-  fm->encode_clauses();
+  fm->set_gauss_processing(gaussArg.getValue());
 
 #ifdef _PARALLEL
   if (fm->method() == FlatZinc::FlatZincModel::MAXIMIZATION)
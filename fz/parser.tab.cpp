@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -61,8 +66,8 @@
 
 
 
-/* Copy the first part of user declarations.  */
-#line 40 "parser.yxx" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 41 "parser.yxx"
 
 #define YYPARSE_PARAM parm
 #define YYLEX_PARAM static_cast<ParserState*>(parm)->yyscanner
@@ -73,6 +78,10 @@
 #include <sstream>
 #include <assert.h>
 
+#if !defined(HAVE_MMAP) && !defined(_WIN32)
+#define HAVE_MMAP
+#endif
+
 #ifdef HAVE_MMAP
 #include <stdio.h>
 #include <stdlib.h>
@@ -119,23 +128,25 @@ void yyassert(ParserState* pp, bool cond, const char* str)
  *
  */
 
-AST::Node* getArrayElement(ParserState* pp, string id, unsigned int offset) {
+AST::Node* getArrayElement(ParserState* pp, const string& id, unsigned int offset) {
   if (offset > 0) {
-    vector<int> tmp;
-    if (pp->intvararrays.get(id, tmp) && offset<=tmp.size())
-      return new AST::IntVar(tmp[offset-1]);
-    if (pp->boolvararrays.get(id, tmp) && offset<=tmp.size())
-      return new AST::BoolVar(tmp[offset-1]);
-    if (pp->setvararrays.get(id, tmp) && offset<=tmp.size())
-      return new AST::SetVar(tmp[offset-1]);
-
-    if (pp->intvalarrays.get(id, tmp) && offset<=tmp.size())
-      return new AST::IntLit(tmp[offset-1]);
-    if (pp->boolvalarrays.get(id, tmp) && offset<=tmp.size())
-      return new AST::BoolLit(tmp[offset-1]);
-    vector<AST::SetLit> tmpS;
-    if (pp->setvalarrays.get(id, tmpS) && offset<=tmpS.size())
-      return new AST::SetLit(tmpS[offset-1]);
+    // the arrays are looked up in place, copying them would make every
+    // access linear in the size of the array
+    const vector<int>* tmp;
+    if ((tmp = pp->intvararrays.find(id)) && offset<=tmp->size())
+      return new AST::IntVar((*tmp)[offset-1]);
+    if ((tmp = pp->boolvararrays.find(id)) && offset<=tmp->size())
+      return new AST::BoolVar((*tmp)[offset-1]);
+    if ((tmp = pp->setvararrays.find(id)) && offset<=tmp->size())
+      return new AST::SetVar((*tmp)[offset-1]);
+
+    if ((tmp = pp->intvalarrays.find(id)) && offset<=tmp->size())
+      return new AST::IntLit((*tmp)[offset-1]);
+    if ((tmp = pp->boolvalarrays.find(id)) && offset<=tmp->size())
+      return new AST::BoolLit((*tmp)[offset-1]);
+    const vector<AST::SetLit>* tmpS;
+    if ((tmpS = pp->setvalarrays.find(id)) && offset<=tmpS->size())
+      return new AST::SetLit((*tmpS)[offset-1]);
   }
 
   pp->err << "Error: array access to " << id << " invalid"
@@ -144,7 +155,7 @@ AST::Node* getArrayElement(ParserState* pp, string id, unsigned int offset) {
   pp->hadError = true;
   return new AST::IntVar(0); // keep things consistent
 }
-AST::Node* getVarRefArg(ParserState* pp, string id, bool annotation = false) {
+AST::Node* getVarRefArg(ParserState* pp, const string& id, bool annotation = false) {
   int tmp;
   if (pp->intvarTable.get(id, tmp))
     return new AST::IntVar(tmp);
@@ -226,8 +237,7 @@ void initfg(ParserState* pp) {
     if (!pp->hadError) {
       try {
         assert(pp->domainConstraints[i]->args->a.size() == 2);
-        pp->fg->postConstraint(*pp->domainConstraints[i], NULL);
-        delete pp->domainConstraints[i];
+        pp->fg->addConstraint(pp->domainConstraints[i], NULL);
       } catch (FlatZinc::Error& e) {
         yyerror(pp, e.toString().c_str());
       }
@@ -239,6 +249,17 @@ void fillPrinter(ParserState& pp, FlatZinc::Printer& p) {
   p.init(pp.getOutput());
 }
 
+// the constraints are only posted once the whole model is read
+void postConstraints(ParserState& pp, FlatZinc::Printer& p) {
+  if (!pp.hadError) {
+    try {
+      pp.fg->postConstraints(p);
+    } catch (FlatZinc::Error& e) {
+      yyerror(&pp, e.toString().c_str());
+    }
+  }
+}
+
 AST::Node* arrayOutput(AST::Call* ann) {
   AST::Array* a = NULL;
 
@@ -287,26 +308,34 @@ namespace FlatZinc {
                        Printer& p, std::ostream& err,
                        FlatZincModel* fzs) {
 #ifdef HAVE_MMAP
+    // the file is mapped and read in place by the lexer, rather than
+    // copied into a string first
     int fd;
-    char* data;
+    char* data = NULL;
     struct stat sbuf;
     fd = open(filename.c_str(), O_RDONLY);
     if (fd == -1) {
       err << "Cannot open file " << filename << endl;
       return NULL;
     }
-    if (stat(filename.c_str(), &sbuf) == -1) {
+    if (fstat(fd, &sbuf) == -1) {
       err << "Cannot stat file " << filename << endl;
+      close(fd);
       return NULL;
     }
-    data = (char*)mmap((caddr_t)0, sbuf.st_size, PROT_READ, MAP_SHARED, fd,0);
-    if (data == (caddr_t)(-1)) {
-      err << "Cannot mmap file " << filename << endl;
-      return NULL;
+    if (sbuf.st_size > 0) {
+      data = (char*)mmap(NULL, sbuf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        err << "Cannot mmap file " << filename << endl;
+        close(fd);
+        return NULL;
+      }
+      madvise(data, sbuf.st_size, MADV_SEQUENTIAL);
     }
+    close(fd);
 
     if (fzs == NULL) {
-      fzs = new FlatZincModel();
+      fzs = new FlatZincModel(solver);
     }
     ParserState pp(data, sbuf.st_size, err, fzs);
 #else
@@ -328,9 +357,14 @@ namespace FlatZinc {
     // yydebug = 1;
     yyparse(&pp);
     fillPrinter(pp, p);
+    postConstraints(pp, p);
 
     if (pp.yyscanner)
       yylex_destroy(pp.yyscanner);
+#ifdef HAVE_MMAP
+    if (data)
+      munmap(data, sbuf.st_size);
+#endif
     return pp.hadError ? NULL : pp.fg;
   }
 
@@ -350,6 +384,7 @@ namespace FlatZinc {
     // yydebug = 1;
     yyparse(&pp);
     fillPrinter(pp, p);
+    postConstraints(pp, p);
 
     if (pp.yyscanner)
       yylex_destroy(pp.yyscanner);
@@ -359,152 +394,248 @@ namespace FlatZinc {
 }
 
 
-#line 363 "parser.tab.cpp" /* yacc.c:339  */
+#line 398 "parser.tab.cpp"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "parser.tab.hpp".  */
-#ifndef YY_YY_PARSER_TAB_HPP_INCLUDED
-# define YY_YY_PARSER_TAB_HPP_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 1
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    FZ_INT_LIT = 258,
-    FZ_BOOL_LIT = 259,
-    FZ_FLOAT_LIT = 260,
-    FZ_ID = 261,
-    FZ_STRING_LIT = 262,
-    FZ_VAR = 263,
-    FZ_PAR = 264,
-    FZ_ANNOTATION = 265,
-    FZ_ANY = 266,
-    FZ_ARRAY = 267,
-    FZ_BOOL = 268,
-    FZ_CASE = 269,
-    FZ_COLONCOLON = 270,
-    FZ_CONSTRAINT = 271,
-    FZ_DEFAULT = 272,
-    FZ_DOTDOT = 273,
-    FZ_ELSE = 274,
-    FZ_ELSEIF = 275,
-    FZ_ENDIF = 276,
-    FZ_ENUM = 277,
-    FZ_FLOAT = 278,
-    FZ_FUNCTION = 279,
-    FZ_IF = 280,
-    FZ_INCLUDE = 281,
-    FZ_INT = 282,
-    FZ_LET = 283,
-    FZ_MAXIMIZE = 284,
-    FZ_MINIMIZE = 285,
-    FZ_OF = 286,
-    FZ_SATISFY = 287,
-    FZ_OUTPUT = 288,
-    FZ_PREDICATE = 289,
-    FZ_RECORD = 290,
-    FZ_SET = 291,
-    FZ_SHOW = 292,
-    FZ_SHOWCOND = 293,
-    FZ_SOLVE = 294,
-    FZ_STRING = 295,
-    FZ_TEST = 296,
-    FZ_THEN = 297,
-    FZ_TUPLE = 298,
-    FZ_TYPE = 299,
-    FZ_VARIANT_RECORD = 300,
-    FZ_WHERE = 301
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-union YYSTYPE
+#include "parser.tab.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 337 "parser.yxx" /* yacc.c:355  */
- int iValue; char* sValue; bool bValue; double dValue;
-         std::vector<int>* setValue;
-         FlatZinc::AST::SetLit* setLit;
-         std::vector<double>* floatSetValue;
-         std::vector<FlatZinc::AST::SetLit>* setValueList;
-         FlatZinc::Option<FlatZinc::AST::SetLit* > oSet;
-         FlatZinc::VarSpec* varSpec;
-         FlatZinc::Option<FlatZinc::AST::Node*> oArg;
-         std::vector<FlatZinc::VarSpec*>* varSpecVec;
-         FlatZinc::Option<std::vector<FlatZinc::VarSpec*>* > oVarSpecVec;
-         FlatZinc::AST::Node* arg;
-         FlatZinc::AST::Array* argVec;
-       
-
-#line 465 "parser.tab.cpp" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_FZ_INT_LIT = 3,                 /* FZ_INT_LIT  */
+  YYSYMBOL_FZ_BOOL_LIT = 4,                /* FZ_BOOL_LIT  */
+  YYSYMBOL_FZ_FLOAT_LIT = 5,               /* FZ_FLOAT_LIT  */
+  YYSYMBOL_FZ_ID = 6,                      /* FZ_ID  */
+  YYSYMBOL_FZ_STRING_LIT = 7,              /* FZ_STRING_LIT  */
+  YYSYMBOL_FZ_VAR = 8,                     /* FZ_VAR  */
+  YYSYMBOL_FZ_PAR = 9,                     /* FZ_PAR  */
+  YYSYMBOL_FZ_ANNOTATION = 10,             /* FZ_ANNOTATION  */
+  YYSYMBOL_FZ_ANY = 11,                    /* FZ_ANY  */
+  YYSYMBOL_FZ_ARRAY = 12,                  /* FZ_ARRAY  */
+  YYSYMBOL_FZ_BOOL = 13,                   /* FZ_BOOL  */
+  YYSYMBOL_FZ_CASE = 14,                   /* FZ_CASE  */
+  YYSYMBOL_FZ_COLONCOLON = 15,             /* FZ_COLONCOLON  */
+  YYSYMBOL_FZ_CONSTRAINT = 16,             /* FZ_CONSTRAINT  */
+  YYSYMBOL_FZ_DEFAULT = 17,                /* FZ_DEFAULT  */
+  YYSYMBOL_FZ_DOTDOT = 18,                 /* FZ_DOTDOT  */
+  YYSYMBOL_FZ_ELSE = 19,                   /* FZ_ELSE  */
+  YYSYMBOL_FZ_ELSEIF = 20,                 /* FZ_ELSEIF  */
+  YYSYMBOL_FZ_ENDIF = 21,                  /* FZ_ENDIF  */
+  YYSYMBOL_FZ_ENUM = 22,                   /* FZ_ENUM  */
+  YYSYMBOL_FZ_FLOAT = 23,                  /* FZ_FLOAT  */
+  YYSYMBOL_FZ_FUNCTION = 24,               /* FZ_FUNCTION  */
+  YYSYMBOL_FZ_IF = 25,                     /* FZ_IF  */
+  YYSYMBOL_FZ_INCLUDE = 26,                /* FZ_INCLUDE  */
+  YYSYMBOL_FZ_INT = 27,                    /* FZ_INT  */
+  YYSYMBOL_FZ_LET = 28,                    /* FZ_LET  */
+  YYSYMBOL_FZ_MAXIMIZE = 29,               /* FZ_MAXIMIZE  */
+  YYSYMBOL_FZ_MINIMIZE = 30,               /* FZ_MINIMIZE  */
+  YYSYMBOL_FZ_OF = 31,                     /* FZ_OF  */
+  YYSYMBOL_FZ_SATISFY = 32,                /* FZ_SATISFY  */
+  YYSYMBOL_FZ_OUTPUT = 33,                 /* FZ_OUTPUT  */
+  YYSYMBOL_FZ_PREDICATE = 34,              /* FZ_PREDICATE  */
+  YYSYMBOL_FZ_RECORD = 35,                 /* FZ_RECORD  */
+  YYSYMBOL_FZ_SET = 36,                    /* FZ_SET  */
+  YYSYMBOL_FZ_SHOW = 37,                   /* FZ_SHOW  */
+  YYSYMBOL_FZ_SHOWCOND = 38,               /* FZ_SHOWCOND  */
+  YYSYMBOL_FZ_SOLVE = 39,                  /* FZ_SOLVE  */
+  YYSYMBOL_FZ_STRING = 40,                 /* FZ_STRING  */
+  YYSYMBOL_FZ_TEST = 41,                   /* FZ_TEST  */
+  YYSYMBOL_FZ_THEN = 42,                   /* FZ_THEN  */
+  YYSYMBOL_FZ_TUPLE = 43,                  /* FZ_TUPLE  */
+  YYSYMBOL_FZ_TYPE = 44,                   /* FZ_TYPE  */
+  YYSYMBOL_FZ_VARIANT_RECORD = 45,         /* FZ_VARIANT_RECORD  */
+  YYSYMBOL_FZ_WHERE = 46,                  /* FZ_WHERE  */
+  YYSYMBOL_47_ = 47,                       /* ';'  */
+  YYSYMBOL_48_ = 48,                       /* '('  */
+  YYSYMBOL_49_ = 49,                       /* ')'  */
+  YYSYMBOL_50_ = 50,                       /* ','  */
+  YYSYMBOL_51_ = 51,                       /* ':'  */
+  YYSYMBOL_52_ = 52,                       /* '['  */
+  YYSYMBOL_53_ = 53,                       /* ']'  */
+  YYSYMBOL_54_ = 54,                       /* '='  */
+  YYSYMBOL_55_ = 55,                       /* '{'  */
+  YYSYMBOL_56_ = 56,                       /* '}'  */
+  YYSYMBOL_YYACCEPT = 57,                  /* $accept  */
+  YYSYMBOL_model = 58,                     /* model  */
+  YYSYMBOL_preddecl_items = 59,            /* preddecl_items  */
+  YYSYMBOL_preddecl_items_head = 60,       /* preddecl_items_head  */
+  YYSYMBOL_vardecl_items = 61,             /* vardecl_items  */
+  YYSYMBOL_vardecl_items_head = 62,        /* vardecl_items_head  */
+  YYSYMBOL_constraint_items = 63,          /* constraint_items  */
+  YYSYMBOL_constraint_items_head = 64,     /* constraint_items_head  */
+  YYSYMBOL_preddecl_item = 65,             /* preddecl_item  */
+  YYSYMBOL_pred_arg_list = 66,             /* pred_arg_list  */
+  YYSYMBOL_pred_arg_list_head = 67,        /* pred_arg_list_head  */
+  YYSYMBOL_pred_arg = 68,                  /* pred_arg  */
+  YYSYMBOL_pred_arg_type = 69,             /* pred_arg_type  */
+  YYSYMBOL_pred_arg_simple_type = 70,      /* pred_arg_simple_type  */
+  YYSYMBOL_pred_array_init = 71,           /* pred_array_init  */
+  YYSYMBOL_pred_array_init_arg = 72,       /* pred_array_init_arg  */
+  YYSYMBOL_vardecl_item = 73,              /* vardecl_item  */
+  YYSYMBOL_int_init = 74,                  /* int_init  */
+  YYSYMBOL_int_init_list = 75,             /* int_init_list  */
+  YYSYMBOL_int_init_list_head = 76,        /* int_init_list_head  */
+  YYSYMBOL_list_tail = 77,                 /* list_tail  */
+  YYSYMBOL_int_var_array_literal = 78,     /* int_var_array_literal  */
+  YYSYMBOL_float_init = 79,                /* float_init  */
+  YYSYMBOL_float_init_list = 80,           /* float_init_list  */
+  YYSYMBOL_float_init_list_head = 81,      /* float_init_list_head  */
+  YYSYMBOL_float_var_array_literal = 82,   /* float_var_array_literal  */
+  YYSYMBOL_bool_init = 83,                 /* bool_init  */
+  YYSYMBOL_bool_init_list = 84,            /* bool_init_list  */
+  YYSYMBOL_bool_init_list_head = 85,       /* bool_init_list_head  */
+  YYSYMBOL_bool_var_array_literal = 86,    /* bool_var_array_literal  */
+  YYSYMBOL_set_init = 87,                  /* set_init  */
+  YYSYMBOL_set_init_list = 88,             /* set_init_list  */
+  YYSYMBOL_set_init_list_head = 89,        /* set_init_list_head  */
+  YYSYMBOL_set_var_array_literal = 90,     /* set_var_array_literal  */
+  YYSYMBOL_vardecl_int_var_array_init = 91, /* vardecl_int_var_array_init  */
+  YYSYMBOL_vardecl_bool_var_array_init = 92, /* vardecl_bool_var_array_init  */
+  YYSYMBOL_vardecl_float_var_array_init = 93, /* vardecl_float_var_array_init  */
+  YYSYMBOL_vardecl_set_var_array_init = 94, /* vardecl_set_var_array_init  */
+  YYSYMBOL_constraint_item = 95,           /* constraint_item  */
+  YYSYMBOL_solve_item = 96,                /* solve_item  */
+  YYSYMBOL_int_ti_expr_tail = 97,          /* int_ti_expr_tail  */
+  YYSYMBOL_bool_ti_expr_tail = 98,         /* bool_ti_expr_tail  */
+  YYSYMBOL_float_ti_expr_tail = 99,        /* float_ti_expr_tail  */
+  YYSYMBOL_set_literal = 100,              /* set_literal  */
+  YYSYMBOL_int_list = 101,                 /* int_list  */
+  YYSYMBOL_int_list_head = 102,            /* int_list_head  */
+  YYSYMBOL_bool_list = 103,                /* bool_list  */
+  YYSYMBOL_bool_list_head = 104,           /* bool_list_head  */
+  YYSYMBOL_float_list = 105,               /* float_list  */
+  YYSYMBOL_float_list_head = 106,          /* float_list_head  */
+  YYSYMBOL_set_literal_list = 107,         /* set_literal_list  */
+  YYSYMBOL_set_literal_list_head = 108,    /* set_literal_list_head  */
+  YYSYMBOL_flat_expr_list = 109,           /* flat_expr_list  */
+  YYSYMBOL_flat_expr = 110,                /* flat_expr  */
+  YYSYMBOL_non_array_expr_opt = 111,       /* non_array_expr_opt  */
+  YYSYMBOL_non_array_expr = 112,           /* non_array_expr  */
+  YYSYMBOL_non_array_expr_list = 113,      /* non_array_expr_list  */
+  YYSYMBOL_non_array_expr_list_head = 114, /* non_array_expr_list_head  */
+  YYSYMBOL_solve_expr = 115,               /* solve_expr  */
+  YYSYMBOL_minmax = 116,                   /* minmax  */
+  YYSYMBOL_annotations = 117,              /* annotations  */
+  YYSYMBOL_annotations_head = 118,         /* annotations_head  */
+  YYSYMBOL_annotation = 119,               /* annotation  */
+  YYSYMBOL_annotation_list = 120,          /* annotation_list  */
+  YYSYMBOL_annotation_expr = 121,          /* annotation_expr  */
+  YYSYMBOL_ann_non_array_expr = 122        /* ann_non_array_expr  */
 };
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
 
 
 
-int yyparse (void *parm);
+#ifdef short
+# undef short
+#endif
 
-#endif /* !YY_YY_PARSER_TAB_HPP_INCLUDED  */
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-#line 481 "parser.tab.cpp" /* yacc.c:358  */
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#else
-typedef signed char yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -512,15 +643,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -534,47 +678,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -587,8 +727,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -653,8 +807,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -663,17 +816,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -686,11 +839,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -702,12 +855,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -730,17 +883,20 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  334
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   301
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -776,36 +932,43 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   436,   436,   438,   440,   443,   444,   448,   449,   453,
-     454,   456,   458,   461,   462,   469,   471,   473,   476,   477,
-     480,   483,   484,   485,   486,   489,   490,   491,   492,   495,
-     496,   499,   500,   507,   537,   566,   571,   601,   625,   634,
-     646,   705,   757,   764,   819,   832,   845,   852,   866,   870,
-     885,   909,   910,   914,   916,   919,   919,   921,   925,   927,
-     942,   966,   967,   971,   973,   977,   981,   983,   998,  1022,
-    1023,  1027,  1029,  1032,  1035,  1037,  1052,  1076,  1077,  1081,
-    1083,  1086,  1091,  1092,  1097,  1098,  1103,  1104,  1109,  1110,
-    1114,  1128,  1141,  1163,  1165,  1167,  1173,  1175,  1188,  1189,
-    1196,  1198,  1205,  1206,  1210,  1212,  1217,  1218,  1222,  1224,
-    1229,  1230,  1234,  1236,  1241,  1242,  1246,  1248,  1256,  1258,
-    1262,  1264,  1269,  1270,  1274,  1276,  1278,  1280,  1282,  1331,
-    1345,  1346,  1350,  1352,  1360,  1371,  1393,  1394,  1402,  1403,
-    1407,  1409,  1413,  1417,  1421,  1423,  1427,  1429,  1433,  1435,
-    1437,  1439,  1441,  1484,  1495
+       0,   467,   467,   469,   471,   474,   475,   479,   480,   484,
+     485,   487,   489,   492,   493,   500,   502,   504,   507,   508,
+     511,   514,   515,   516,   517,   520,   521,   522,   523,   526,
+     527,   530,   531,   538,   568,   597,   602,   632,   656,   665,
+     677,   736,   788,   795,   850,   863,   876,   883,   897,   901,
+     916,   940,   941,   945,   947,   950,   950,   952,   956,   958,
+     973,   997,   998,  1002,  1004,  1008,  1012,  1014,  1029,  1053,
+    1054,  1058,  1060,  1063,  1066,  1068,  1083,  1107,  1108,  1112,
+    1114,  1117,  1122,  1123,  1128,  1129,  1134,  1135,  1140,  1141,
+    1145,  1156,  1169,  1191,  1193,  1195,  1201,  1203,  1216,  1217,
+    1224,  1226,  1233,  1234,  1238,  1240,  1245,  1246,  1250,  1252,
+    1257,  1258,  1262,  1264,  1269,  1270,  1274,  1276,  1284,  1286,
+    1290,  1292,  1297,  1298,  1302,  1304,  1306,  1308,  1310,  1360,
+    1374,  1375,  1379,  1381,  1389,  1400,  1421,  1422,  1430,  1431,
+    1435,  1437,  1441,  1445,  1449,  1451,  1455,  1457,  1461,  1463,
+    1465,  1467,  1469,  1513,  1524
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "FZ_INT_LIT", "FZ_BOOL_LIT",
-  "FZ_FLOAT_LIT", "FZ_ID", "FZ_STRING_LIT", "FZ_VAR", "FZ_PAR",
-  "FZ_ANNOTATION", "FZ_ANY", "FZ_ARRAY", "FZ_BOOL", "FZ_CASE",
+  "\"end of file\"", "error", "\"invalid token\"", "FZ_INT_LIT",
+  "FZ_BOOL_LIT", "FZ_FLOAT_LIT", "FZ_ID", "FZ_STRING_LIT", "FZ_VAR",
+  "FZ_PAR", "FZ_ANNOTATION", "FZ_ANY", "FZ_ARRAY", "FZ_BOOL", "FZ_CASE",
   "FZ_COLONCOLON", "FZ_CONSTRAINT", "FZ_DEFAULT", "FZ_DOTDOT", "FZ_ELSE",
   "FZ_ELSEIF", "FZ_ENDIF", "FZ_ENUM", "FZ_FLOAT", "FZ_FUNCTION", "FZ_IF",
   "FZ_INCLUDE", "FZ_INT", "FZ_LET", "FZ_MAXIMIZE", "FZ_MINIMIZE", "FZ_OF",
@@ -834,34 +997,26 @@ static const char *const yytname[] =
   "minmax", "annotations", "annotations_head", "annotation",
   "annotation_list", "annotation_expr", "ann_non_array_expr", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,    59,    40,    41,
-      44,    58,    91,    93,    61,   123,   125
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -122
+#define YYPACT_NINF (-122)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-122)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-1)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
      -17,    18,    48,    30,   -17,    28,    36,  -122,    63,    90,
@@ -900,9 +1055,9 @@ static const yytype_int16 yypact[] =
     -122,   269,  -122,  -122
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
        3,     0,     0,     7,     4,     0,     0,     1,     0,     0,
@@ -941,7 +1096,7 @@ static const yytype_uint8 yydefact[] =
      117,     0,    80,    76
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
     -122,  -122,  -122,  -122,  -122,  -122,  -122,  -122,   279,  -122,
@@ -953,10 +1108,10 @@ static const yytype_int16 yypgoto[] =
      -70,  -122,   -86,   158,  -122,   166
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
-      -1,     2,     3,     4,    15,    16,    37,    38,     5,    49,
+       0,     2,     3,     4,    15,    16,    37,    38,     5,    49,
       50,    51,    52,    53,   105,   106,    17,   272,   273,   274,
       69,   257,   282,   283,   284,   261,   277,   278,   279,   259,
      310,   311,   312,   292,   246,   248,   250,   269,    39,    72,
@@ -965,10 +1120,10 @@ static const yytype_int16 yydefgoto[] =
       94,    95,   159,   160,   128,   129
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_uint16 yytable[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
       82,    99,    18,   126,   161,    77,   102,   127,    27,    86,
       88,   153,   154,   305,   157,    18,   162,     1,   158,   115,
@@ -1042,9 +1197,9 @@ static const yytype_int16 yycheck[] =
       53,    53,    53,    -1,   158
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,    34,    58,    59,    60,    65,     6,     0,     3,     8,
       12,    13,    27,    36,    55,    61,    62,    73,    97,    65,
@@ -1082,8 +1237,8 @@ static const yytype_uint8 yystos[] =
      100,     3,    87,    53
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    57,    58,    59,    59,    60,    60,    61,    61,    62,
       62,    63,    63,    64,    64,    65,    66,    66,    67,    67,
@@ -1103,8 +1258,8 @@ static const yytype_uint8 yyr1[] =
      122,   122,   122,   122,   122
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     5,     0,     1,     2,     3,     0,     1,     2,
        3,     0,     1,     2,     3,     5,     0,     2,     1,     3,
@@ -1125,39 +1280,39 @@ static const yytype_uint8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (parm, YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (parm, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -1174,56 +1329,53 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, parm); \
+                  Kind, Value, parm); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, void *parm)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void *parm)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (parm);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (parm);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, void *parm)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void *parm)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, parm);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, parm);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1232,7 +1384,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, voi
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1255,21 +1407,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule, void *parm)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, void *parm)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              , parm);
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], parm);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1284,8 +1436,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1308,28 +1460,76 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1343,10 +1543,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1354,14 +1554,13 @@ yystpcpy (char *yydest, const char *yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1372,7 +1571,10 @@ yytnamerr (char *yyres, const char *yystr)
           case '\\':
             if (*++yyp != '\\')
               goto do_not_strip_quotes;
-            /* Fall through.  */
+            else
+              goto append;
+
+          append:
           default:
             if (yyres)
               yyres[yyn] = *yyp;
@@ -1387,36 +1589,20 @@ yytnamerr (char *yyres, const char *yystr)
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
+  /* Actual size of YYARG. */
   int yycount = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1440,63 +1626,78 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
+    default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
       YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1505,7 +1706,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1517,40 +1718,43 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
         {
-          yyp++;
-          yyformat++;
+          ++yyp;
+          ++yyformat;
         }
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, void *parm)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, void *parm)
 {
-  YYUSE (yyvaluep);
-  YYUSE (parm);
+  YY_USE (yyvaluep);
+  YY_USE (parm);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1558,7 +1762,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, void *parm)
 int
 yyparse (void *parm)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1569,45 +1773,41 @@ YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
 YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1615,71 +1815,75 @@ YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1687,30 +1891,31 @@ YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1721,20 +1926,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      //yychar = yylex (&yylval);
-     //This is taken from the code generated by Bison 2.5
-     yychar = yylex (&yylval, YYLEX_PARAM);
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, YYLEX_PARAM);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1762,15 +1976,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1785,7 +1997,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1805,21 +2017,21 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 7:
-#line 448 "parser.yxx" /* yacc.c:1646  */
-    { initfg(static_cast<ParserState*>(parm)); }
-#line 1810 "parser.tab.cpp" /* yacc.c:1646  */
+  case 7: /* vardecl_items: %empty  */
+#line 479 "parser.yxx"
+      { initfg(static_cast<ParserState*>(parm)); }
+#line 2024 "parser.tab.cpp"
     break;
 
-  case 8:
-#line 450 "parser.yxx" /* yacc.c:1646  */
-    { initfg(static_cast<ParserState*>(parm)); }
-#line 1816 "parser.tab.cpp" /* yacc.c:1646  */
+  case 8: /* vardecl_items: vardecl_items_head  */
+#line 481 "parser.yxx"
+      { initfg(static_cast<ParserState*>(parm)); }
+#line 2030 "parser.tab.cpp"
     break;
 
-  case 33:
-#line 508 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 33: /* vardecl_item: FZ_VAR int_ti_expr_tail ':' FZ_ID annotations non_array_expr_opt  */
+#line 539 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, !(yyvsp[-4].oSet)() || !(yyvsp[-4].oSet).some()->empty(), "Empty var int domain.");
         bool print = (yyvsp[-1].argVec)->hasAtom("output_var");
@@ -1848,12 +2060,12 @@ yyreduce:
         }
         delete (yyvsp[-1].argVec); free((yyvsp[-2].sValue));
       }
-#line 1850 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2064 "parser.tab.cpp"
     break;
 
-  case 34:
-#line 538 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 34: /* vardecl_item: FZ_VAR bool_ti_expr_tail ':' FZ_ID annotations non_array_expr_opt  */
+#line 569 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         bool print = (yyvsp[-1].argVec)->hasAtom("output_var");
         bool introduced = (yyvsp[-1].argVec)->hasAtom("var_is_introduced");
@@ -1881,21 +2093,21 @@ yyreduce:
         }
         delete (yyvsp[-1].argVec); free((yyvsp[-2].sValue));
       }
-#line 1883 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2097 "parser.tab.cpp"
     break;
 
-  case 35:
-#line 567 "parser.yxx" /* yacc.c:1646  */
-    { ParserState* pp = static_cast<ParserState*>(parm);
+  case 35: /* vardecl_item: FZ_VAR float_ti_expr_tail ':' FZ_ID annotations non_array_expr_opt  */
+#line 598 "parser.yxx"
+      { ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, false, "Floats not supported.");
         delete (yyvsp[-1].argVec); free((yyvsp[-2].sValue));
       }
-#line 1892 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2106 "parser.tab.cpp"
     break;
 
-  case 36:
-#line 572 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 36: /* vardecl_item: FZ_VAR FZ_SET FZ_OF int_ti_expr_tail ':' FZ_ID annotations non_array_expr_opt  */
+#line 603 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         bool print = (yyvsp[-1].argVec)->hasAtom("output_var");
         bool introduced = (yyvsp[-1].argVec)->hasAtom("var_is_introduced");
@@ -1924,12 +2136,12 @@ yyreduce:
         }
         delete (yyvsp[-1].argVec); free((yyvsp[-2].sValue));
       }
-#line 1926 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2140 "parser.tab.cpp"
     break;
 
-  case 37:
-#line 602 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 37: /* vardecl_item: int_ti_expr_tail ':' FZ_ID annotations '=' non_array_expr  */
+#line 633 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, !(yyvsp[-5].oSet)() || !(yyvsp[-5].oSet).some()->empty(), "Empty int domain.");
         yyassert(pp, (yyvsp[0].arg)->isInt(), "Invalid int initializer.");
@@ -1952,12 +2164,12 @@ yyreduce:
         pp->intvals.put((yyvsp[-3].sValue), i);
         delete (yyvsp[-2].argVec); free((yyvsp[-3].sValue));
       }
-#line 1954 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2168 "parser.tab.cpp"
     break;
 
-  case 38:
-#line 626 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 38: /* vardecl_item: FZ_BOOL ':' FZ_ID annotations '=' non_array_expr  */
+#line 657 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, (yyvsp[0].arg)->isBool(), "Invalid bool initializer.");
         if ((yyvsp[0].arg)->isBool()) {
@@ -1965,12 +2177,12 @@ yyreduce:
         }
         delete (yyvsp[-2].argVec); free((yyvsp[-3].sValue));
       }
-#line 1967 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2181 "parser.tab.cpp"
     break;
 
-  case 39:
-#line 635 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 39: /* vardecl_item: FZ_SET FZ_OF int_ti_expr_tail ':' FZ_ID annotations '=' non_array_expr  */
+#line 666 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, !(yyvsp[-5].oSet)() || !(yyvsp[-5].oSet).some()->empty(), "Empty set domain.");
         yyassert(pp, (yyvsp[0].arg)->isSet(), "Invalid set initializer.");
@@ -1981,12 +2193,12 @@ yyreduce:
         delete set;
         delete (yyvsp[-2].argVec); free((yyvsp[-3].sValue));
       }
-#line 1983 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2197 "parser.tab.cpp"
     break;
 
-  case 40:
-#line 648 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 40: /* vardecl_item: FZ_ARRAY '[' FZ_INT_LIT FZ_DOTDOT FZ_INT_LIT ']' FZ_OF FZ_VAR int_ti_expr_tail ':' FZ_ID annotations vardecl_int_var_array_init  */
+#line 679 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, (yyvsp[-10].iValue)==1, "Arrays must start at 1");
         if (!pp->hadError) {
@@ -2043,12 +2255,12 @@ yyreduce:
         }
         delete (yyvsp[-1].argVec); free((yyvsp[-2].sValue));
       }
-#line 2045 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2259 "parser.tab.cpp"
     break;
 
-  case 41:
-#line 707 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 41: /* vardecl_item: FZ_ARRAY '[' FZ_INT_LIT FZ_DOTDOT FZ_INT_LIT ']' FZ_OF FZ_VAR bool_ti_expr_tail ':' FZ_ID annotations vardecl_bool_var_array_init  */
+#line 738 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         bool print = (yyvsp[-1].argVec)->hasCall("output_array");
         yyassert(pp, (yyvsp[-10].iValue)==1, "Arrays must start at 1");
@@ -2098,22 +2310,22 @@ yyreduce:
         }
         delete (yyvsp[-1].argVec); free((yyvsp[-2].sValue));
       }
-#line 2100 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2314 "parser.tab.cpp"
     break;
 
-  case 42:
-#line 759 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 42: /* vardecl_item: FZ_ARRAY '[' FZ_INT_LIT FZ_DOTDOT FZ_INT_LIT ']' FZ_OF FZ_VAR float_ti_expr_tail ':' FZ_ID annotations vardecl_float_var_array_init  */
+#line 790 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, false, "Floats not supported.");
         delete (yyvsp[-1].argVec); free((yyvsp[-2].sValue));
       }
-#line 2110 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2324 "parser.tab.cpp"
     break;
 
-  case 43:
-#line 766 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 43: /* vardecl_item: FZ_ARRAY '[' FZ_INT_LIT FZ_DOTDOT FZ_INT_LIT ']' FZ_OF FZ_VAR FZ_SET FZ_OF int_ti_expr_tail ':' FZ_ID annotations vardecl_set_var_array_init  */
+#line 797 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         bool print = (yyvsp[-1].argVec)->hasCall("output_array");
         yyassert(pp, (yyvsp[-12].iValue)==1, "Arrays must start at 1");
@@ -2166,12 +2378,12 @@ yyreduce:
         }
         delete (yyvsp[-1].argVec); free((yyvsp[-2].sValue));
       }
-#line 2168 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2382 "parser.tab.cpp"
     break;
 
-  case 44:
-#line 821 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 44: /* vardecl_item: FZ_ARRAY '[' FZ_INT_LIT FZ_DOTDOT FZ_INT_LIT ']' FZ_OF int_ti_expr_tail ':' FZ_ID annotations '=' '[' int_list ']'  */
+#line 852 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, (yyvsp[-12].iValue)==1, "Arrays must start at 1");
         yyassert(pp, (yyvsp[-1].setValue)->size() == static_cast<unsigned int>((yyvsp[-10].iValue)),
@@ -2182,12 +2394,12 @@ yyreduce:
         free((yyvsp[-5].sValue));
         delete (yyvsp[-4].argVec);
       }
-#line 2184 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2398 "parser.tab.cpp"
     break;
 
-  case 45:
-#line 834 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 45: /* vardecl_item: FZ_ARRAY '[' FZ_INT_LIT FZ_DOTDOT FZ_INT_LIT ']' FZ_OF FZ_BOOL ':' FZ_ID annotations '=' '[' bool_list ']'  */
+#line 865 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, (yyvsp[-12].iValue)==1, "Arrays must start at 1");
         yyassert(pp, (yyvsp[-1].setValue)->size() == static_cast<unsigned int>((yyvsp[-10].iValue)),
@@ -2198,22 +2410,22 @@ yyreduce:
         free((yyvsp[-5].sValue));
         delete (yyvsp[-4].argVec);
       }
-#line 2200 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2414 "parser.tab.cpp"
     break;
 
-  case 46:
-#line 847 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 46: /* vardecl_item: FZ_ARRAY '[' FZ_INT_LIT FZ_DOTDOT FZ_INT_LIT ']' FZ_OF FZ_FLOAT ':' FZ_ID annotations '=' '[' float_list ']'  */
+#line 878 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, false, "Floats not supported.");
         delete (yyvsp[-4].argVec); free((yyvsp[-5].sValue));
       }
-#line 2210 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2424 "parser.tab.cpp"
     break;
 
-  case 47:
-#line 854 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 47: /* vardecl_item: FZ_ARRAY '[' FZ_INT_LIT FZ_DOTDOT FZ_INT_LIT ']' FZ_OF FZ_SET FZ_OF int_ti_expr_tail ':' FZ_ID annotations '=' '[' set_literal_list ']'  */
+#line 885 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         yyassert(pp, (yyvsp[-14].iValue)==1, "Arrays must start at 1");
         yyassert(pp, (yyvsp[-1].setValueList)->size() == static_cast<unsigned int>((yyvsp[-12].iValue)),
@@ -2223,20 +2435,20 @@ yyreduce:
         delete (yyvsp[-1].setValueList);
         delete (yyvsp[-4].argVec); free((yyvsp[-5].sValue));
       }
-#line 2225 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2439 "parser.tab.cpp"
     break;
 
-  case 48:
-#line 867 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 48: /* int_init: FZ_INT_LIT  */
+#line 898 "parser.yxx"
+      {
         (yyval.varSpec) = new IntVarSpec((yyvsp[0].iValue),false);
       }
-#line 2233 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2447 "parser.tab.cpp"
     break;
 
-  case 49:
-#line 871 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 49: /* int_init: FZ_ID  */
+#line 902 "parser.yxx"
+      {
         int v = 0;
         ParserState* pp = static_cast<ParserState*>(parm);
         if (pp->intvarTable.get((yyvsp[0].sValue), v))
@@ -2250,20 +2462,20 @@ yyreduce:
         }
         free((yyvsp[0].sValue));
       }
-#line 2252 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2466 "parser.tab.cpp"
     break;
 
-  case 50:
-#line 886 "parser.yxx" /* yacc.c:1646  */
-    {
-        vector<int> v;
+  case 50: /* int_init: FZ_ID '[' FZ_INT_LIT ']'  */
+#line 917 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->intvararrays.get((yyvsp[-3].sValue), v)) {
+        const vector<int>* v = pp->intvararrays.find((yyvsp[-3].sValue));
+        if (v) {
           yyassert(pp,static_cast<unsigned int>((yyvsp[-1].iValue)) > 0 &&
-                      static_cast<unsigned int>((yyvsp[-1].iValue)) <= v.size(),
+                      static_cast<unsigned int>((yyvsp[-1].iValue)) <= v->size(),
                    "array access out of bounds");
           if (!pp->hadError)
-            (yyval.varSpec) = new IntVarSpec(Alias(v[(yyvsp[-1].iValue)-1]),false);
+            (yyval.varSpec) = new IntVarSpec(Alias((*v)[(yyvsp[-1].iValue)-1]),false);
           else
             (yyval.varSpec) = new IntVarSpec(0,false); // keep things consistent
         } else {
@@ -2275,48 +2487,48 @@ yyreduce:
         }
         free((yyvsp[-3].sValue));
       }
-#line 2277 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2491 "parser.tab.cpp"
     break;
 
-  case 51:
-#line 909 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
-#line 2283 "parser.tab.cpp" /* yacc.c:1646  */
+  case 51: /* int_init_list: %empty  */
+#line 940 "parser.yxx"
+      { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
+#line 2497 "parser.tab.cpp"
     break;
 
-  case 52:
-#line 911 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
-#line 2289 "parser.tab.cpp" /* yacc.c:1646  */
+  case 52: /* int_init_list: int_init_list_head list_tail  */
+#line 942 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
+#line 2503 "parser.tab.cpp"
     break;
 
-  case 53:
-#line 915 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); }
-#line 2295 "parser.tab.cpp" /* yacc.c:1646  */
+  case 53: /* int_init_list_head: int_init  */
+#line 946 "parser.yxx"
+      { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); }
+#line 2509 "parser.tab.cpp"
     break;
 
-  case 54:
-#line 917 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); }
-#line 2301 "parser.tab.cpp" /* yacc.c:1646  */
+  case 54: /* int_init_list_head: int_init_list_head ',' int_init  */
+#line 948 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); }
+#line 2515 "parser.tab.cpp"
     break;
 
-  case 57:
-#line 922 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
-#line 2307 "parser.tab.cpp" /* yacc.c:1646  */
+  case 57: /* int_var_array_literal: '[' int_init_list ']'  */
+#line 953 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
+#line 2521 "parser.tab.cpp"
     break;
 
-  case 58:
-#line 926 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpec) = new FloatVarSpec((yyvsp[0].dValue),false); }
-#line 2313 "parser.tab.cpp" /* yacc.c:1646  */
+  case 58: /* float_init: FZ_FLOAT_LIT  */
+#line 957 "parser.yxx"
+      { (yyval.varSpec) = new FloatVarSpec((yyvsp[0].dValue),false); }
+#line 2527 "parser.tab.cpp"
     break;
 
-  case 59:
-#line 928 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 59: /* float_init: FZ_ID  */
+#line 959 "parser.yxx"
+      {
         int v = 0;
         ParserState* pp = static_cast<ParserState*>(parm);
         if (pp->floatvarTable.get((yyvsp[0].sValue), v))
@@ -2330,20 +2542,20 @@ yyreduce:
         }
         free((yyvsp[0].sValue));
       }
-#line 2332 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2546 "parser.tab.cpp"
     break;
 
-  case 60:
-#line 943 "parser.yxx" /* yacc.c:1646  */
-    {
-        vector<int> v;
+  case 60: /* float_init: FZ_ID '[' FZ_INT_LIT ']'  */
+#line 974 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->floatvararrays.get((yyvsp[-3].sValue), v)) {
+        const vector<int>* v = pp->floatvararrays.find((yyvsp[-3].sValue));
+        if (v) {
           yyassert(pp,static_cast<unsigned int>((yyvsp[-1].iValue)) > 0 &&
-                      static_cast<unsigned int>((yyvsp[-1].iValue)) <= v.size(),
+                      static_cast<unsigned int>((yyvsp[-1].iValue)) <= v->size(),
                    "array access out of bounds");
           if (!pp->hadError)
-            (yyval.varSpec) = new FloatVarSpec(Alias(v[(yyvsp[-1].iValue)-1]),false);
+            (yyval.varSpec) = new FloatVarSpec(Alias((*v)[(yyvsp[-1].iValue)-1]),false);
           else
             (yyval.varSpec) = new FloatVarSpec(0.0,false);
         } else {
@@ -2355,48 +2567,48 @@ yyreduce:
         }
         free((yyvsp[-3].sValue));
       }
-#line 2357 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2571 "parser.tab.cpp"
     break;
 
-  case 61:
-#line 966 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
-#line 2363 "parser.tab.cpp" /* yacc.c:1646  */
+  case 61: /* float_init_list: %empty  */
+#line 997 "parser.yxx"
+      { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
+#line 2577 "parser.tab.cpp"
     break;
 
-  case 62:
-#line 968 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
-#line 2369 "parser.tab.cpp" /* yacc.c:1646  */
+  case 62: /* float_init_list: float_init_list_head list_tail  */
+#line 999 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
+#line 2583 "parser.tab.cpp"
     break;
 
-  case 63:
-#line 972 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); }
-#line 2375 "parser.tab.cpp" /* yacc.c:1646  */
+  case 63: /* float_init_list_head: float_init  */
+#line 1003 "parser.yxx"
+      { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); }
+#line 2589 "parser.tab.cpp"
     break;
 
-  case 64:
-#line 974 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); }
-#line 2381 "parser.tab.cpp" /* yacc.c:1646  */
+  case 64: /* float_init_list_head: float_init_list_head ',' float_init  */
+#line 1005 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); }
+#line 2595 "parser.tab.cpp"
     break;
 
-  case 65:
-#line 978 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
-#line 2387 "parser.tab.cpp" /* yacc.c:1646  */
+  case 65: /* float_var_array_literal: '[' float_init_list ']'  */
+#line 1009 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
+#line 2601 "parser.tab.cpp"
     break;
 
-  case 66:
-#line 982 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpec) = new BoolVarSpec((yyvsp[0].iValue),false); }
-#line 2393 "parser.tab.cpp" /* yacc.c:1646  */
+  case 66: /* bool_init: FZ_BOOL_LIT  */
+#line 1013 "parser.yxx"
+      { (yyval.varSpec) = new BoolVarSpec((yyvsp[0].iValue),false); }
+#line 2607 "parser.tab.cpp"
     break;
 
-  case 67:
-#line 984 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 67: /* bool_init: FZ_ID  */
+#line 1015 "parser.yxx"
+      {
         int v = 0;
         ParserState* pp = static_cast<ParserState*>(parm);
         if (pp->boolvarTable.get((yyvsp[0].sValue), v))
@@ -2410,20 +2622,20 @@ yyreduce:
         }
         free((yyvsp[0].sValue));
       }
-#line 2412 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2626 "parser.tab.cpp"
     break;
 
-  case 68:
-#line 999 "parser.yxx" /* yacc.c:1646  */
-    {
-        vector<int> v;
+  case 68: /* bool_init: FZ_ID '[' FZ_INT_LIT ']'  */
+#line 1030 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->boolvararrays.get((yyvsp[-3].sValue), v)) {
+        const vector<int>* v = pp->boolvararrays.find((yyvsp[-3].sValue));
+        if (v) {
           yyassert(pp,static_cast<unsigned int>((yyvsp[-1].iValue)) > 0 &&
-                      static_cast<unsigned int>((yyvsp[-1].iValue)) <= v.size(),
+                      static_cast<unsigned int>((yyvsp[-1].iValue)) <= v->size(),
                    "array access out of bounds");
           if (!pp->hadError)
-            (yyval.varSpec) = new BoolVarSpec(Alias(v[(yyvsp[-1].iValue)-1]),false);
+            (yyval.varSpec) = new BoolVarSpec(Alias((*v)[(yyvsp[-1].iValue)-1]),false);
           else
             (yyval.varSpec) = new BoolVarSpec(false,false);
         } else {
@@ -2435,48 +2647,48 @@ yyreduce:
         }
         free((yyvsp[-3].sValue));
       }
-#line 2437 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2651 "parser.tab.cpp"
     break;
 
-  case 69:
-#line 1022 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
-#line 2443 "parser.tab.cpp" /* yacc.c:1646  */
+  case 69: /* bool_init_list: %empty  */
+#line 1053 "parser.yxx"
+      { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
+#line 2657 "parser.tab.cpp"
     break;
 
-  case 70:
-#line 1024 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
-#line 2449 "parser.tab.cpp" /* yacc.c:1646  */
+  case 70: /* bool_init_list: bool_init_list_head list_tail  */
+#line 1055 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
+#line 2663 "parser.tab.cpp"
     break;
 
-  case 71:
-#line 1028 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); }
-#line 2455 "parser.tab.cpp" /* yacc.c:1646  */
+  case 71: /* bool_init_list_head: bool_init  */
+#line 1059 "parser.yxx"
+      { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); }
+#line 2669 "parser.tab.cpp"
     break;
 
-  case 72:
-#line 1030 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); }
-#line 2461 "parser.tab.cpp" /* yacc.c:1646  */
+  case 72: /* bool_init_list_head: bool_init_list_head ',' bool_init  */
+#line 1061 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); }
+#line 2675 "parser.tab.cpp"
     break;
 
-  case 73:
-#line 1032 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
-#line 2467 "parser.tab.cpp" /* yacc.c:1646  */
+  case 73: /* bool_var_array_literal: '[' bool_init_list ']'  */
+#line 1063 "parser.yxx"
+                                                { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
+#line 2681 "parser.tab.cpp"
     break;
 
-  case 74:
-#line 1036 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpec) = new SetVarSpec(Option<AST::SetLit*>::some((yyvsp[0].setLit)),false); }
-#line 2473 "parser.tab.cpp" /* yacc.c:1646  */
+  case 74: /* set_init: set_literal  */
+#line 1067 "parser.yxx"
+      { (yyval.varSpec) = new SetVarSpec(Option<AST::SetLit*>::some((yyvsp[0].setLit)),false); }
+#line 2687 "parser.tab.cpp"
     break;
 
-  case 75:
-#line 1038 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 75: /* set_init: FZ_ID  */
+#line 1069 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         int v = 0;
         if (pp->setvarTable.get((yyvsp[0].sValue), v))
@@ -2490,20 +2702,20 @@ yyreduce:
         }
         free((yyvsp[0].sValue));
       }
-#line 2492 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2706 "parser.tab.cpp"
     break;
 
-  case 76:
-#line 1053 "parser.yxx" /* yacc.c:1646  */
-    {
-        vector<int> v;
+  case 76: /* set_init: FZ_ID '[' FZ_INT_LIT ']'  */
+#line 1084 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->setvararrays.get((yyvsp[-3].sValue), v)) {
+        const vector<int>* v = pp->setvararrays.find((yyvsp[-3].sValue));
+        if (v) {
           yyassert(pp,static_cast<unsigned int>((yyvsp[-1].iValue)) > 0 &&
-                      static_cast<unsigned int>((yyvsp[-1].iValue)) <= v.size(),
+                      static_cast<unsigned int>((yyvsp[-1].iValue)) <= v->size(),
                    "array access out of bounds");
           if (!pp->hadError)
-            (yyval.varSpec) = new SetVarSpec(Alias(v[(yyvsp[-1].iValue)-1]),false);
+            (yyval.varSpec) = new SetVarSpec(Alias((*v)[(yyvsp[-1].iValue)-1]),false);
           else
             (yyval.varSpec) = new SetVarSpec(Alias(0),false);
         } else {
@@ -2515,107 +2727,104 @@ yyreduce:
         }
         free((yyvsp[-3].sValue));
       }
-#line 2517 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2731 "parser.tab.cpp"
     break;
 
-  case 77:
-#line 1076 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
-#line 2523 "parser.tab.cpp" /* yacc.c:1646  */
+  case 77: /* set_init_list: %empty  */
+#line 1107 "parser.yxx"
+      { (yyval.varSpecVec) = new vector<VarSpec*>(0); }
+#line 2737 "parser.tab.cpp"
     break;
 
-  case 78:
-#line 1078 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
-#line 2529 "parser.tab.cpp" /* yacc.c:1646  */
+  case 78: /* set_init_list: set_init_list_head list_tail  */
+#line 1109 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
+#line 2743 "parser.tab.cpp"
     break;
 
-  case 79:
-#line 1082 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); }
-#line 2535 "parser.tab.cpp" /* yacc.c:1646  */
+  case 79: /* set_init_list_head: set_init  */
+#line 1113 "parser.yxx"
+      { (yyval.varSpecVec) = new vector<VarSpec*>(1); (*(yyval.varSpecVec))[0] = (yyvsp[0].varSpec); }
+#line 2749 "parser.tab.cpp"
     break;
 
-  case 80:
-#line 1084 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); }
-#line 2541 "parser.tab.cpp" /* yacc.c:1646  */
+  case 80: /* set_init_list_head: set_init_list_head ',' set_init  */
+#line 1115 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-2].varSpecVec); (yyval.varSpecVec)->push_back((yyvsp[0].varSpec)); }
+#line 2755 "parser.tab.cpp"
     break;
 
-  case 81:
-#line 1087 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
-#line 2547 "parser.tab.cpp" /* yacc.c:1646  */
+  case 81: /* set_var_array_literal: '[' set_init_list ']'  */
+#line 1118 "parser.yxx"
+      { (yyval.varSpecVec) = (yyvsp[-1].varSpecVec); }
+#line 2761 "parser.tab.cpp"
     break;
 
-  case 82:
-#line 1091 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
-#line 2553 "parser.tab.cpp" /* yacc.c:1646  */
+  case 82: /* vardecl_int_var_array_init: %empty  */
+#line 1122 "parser.yxx"
+      { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
+#line 2767 "parser.tab.cpp"
     break;
 
-  case 83:
-#line 1093 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); }
-#line 2559 "parser.tab.cpp" /* yacc.c:1646  */
+  case 83: /* vardecl_int_var_array_init: '=' int_var_array_literal  */
+#line 1124 "parser.yxx"
+      { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); }
+#line 2773 "parser.tab.cpp"
     break;
 
-  case 84:
-#line 1097 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
-#line 2565 "parser.tab.cpp" /* yacc.c:1646  */
+  case 84: /* vardecl_bool_var_array_init: %empty  */
+#line 1128 "parser.yxx"
+      { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
+#line 2779 "parser.tab.cpp"
     break;
 
-  case 85:
-#line 1099 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); }
-#line 2571 "parser.tab.cpp" /* yacc.c:1646  */
+  case 85: /* vardecl_bool_var_array_init: '=' bool_var_array_literal  */
+#line 1130 "parser.yxx"
+      { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); }
+#line 2785 "parser.tab.cpp"
     break;
 
-  case 86:
-#line 1103 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
-#line 2577 "parser.tab.cpp" /* yacc.c:1646  */
+  case 86: /* vardecl_float_var_array_init: %empty  */
+#line 1134 "parser.yxx"
+      { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
+#line 2791 "parser.tab.cpp"
     break;
 
-  case 87:
-#line 1105 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); }
-#line 2583 "parser.tab.cpp" /* yacc.c:1646  */
+  case 87: /* vardecl_float_var_array_init: '=' float_var_array_literal  */
+#line 1136 "parser.yxx"
+      { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); }
+#line 2797 "parser.tab.cpp"
     break;
 
-  case 88:
-#line 1109 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
-#line 2589 "parser.tab.cpp" /* yacc.c:1646  */
+  case 88: /* vardecl_set_var_array_init: %empty  */
+#line 1140 "parser.yxx"
+      { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::none(); }
+#line 2803 "parser.tab.cpp"
     break;
 
-  case 89:
-#line 1111 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); }
-#line 2595 "parser.tab.cpp" /* yacc.c:1646  */
+  case 89: /* vardecl_set_var_array_init: '=' set_var_array_literal  */
+#line 1142 "parser.yxx"
+      { (yyval.oVarSpecVec) = Option<vector<VarSpec*>* >::some((yyvsp[0].varSpecVec)); }
+#line 2809 "parser.tab.cpp"
     break;
 
-  case 90:
-#line 1115 "parser.yxx" /* yacc.c:1646  */
-    {
-        ConExpr c((yyvsp[-4].sValue), (yyvsp[-2].argVec));
+  case 90: /* constraint_item: FZ_CONSTRAINT FZ_ID '(' flat_expr_list ')' annotations  */
+#line 1146 "parser.yxx"
+      {
         ParserState *pp = static_cast<ParserState*>(parm);
         if (!pp->hadError) {
-          try {
-            pp->fg->postConstraint(c, (yyvsp[0].argVec));
-          } catch (FlatZinc::Error& e) {
-            yyerror(pp, e.toString().c_str());
-          }
+          pp->fg->addConstraint(new ConExpr((yyvsp[-4].sValue), (yyvsp[-2].argVec)), (yyvsp[0].argVec));
+        } else {
+          delete (yyvsp[-2].argVec); delete (yyvsp[0].argVec);
         }
-        delete (yyvsp[0].argVec); free((yyvsp[-4].sValue));
+        free((yyvsp[-4].sValue));
       }
-#line 2612 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2823 "parser.tab.cpp"
     break;
 
-  case 91:
-#line 1129 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 91: /* solve_item: FZ_SOLVE annotations FZ_SATISFY  */
+#line 1157 "parser.yxx"
+      {
         ParserState *pp = static_cast<ParserState*>(parm);
         if (!pp->hadError) {
           try {
@@ -2627,12 +2836,12 @@ yyreduce:
           delete (yyvsp[-1].argVec);
         }
       }
-#line 2629 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2840 "parser.tab.cpp"
     break;
 
-  case 92:
-#line 1142 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 92: /* solve_item: FZ_SOLVE annotations minmax solve_expr  */
+#line 1170 "parser.yxx"
+      {
         ParserState *pp = static_cast<ParserState*>(parm);
         if (!pp->hadError) {
           try {
@@ -2647,38 +2856,38 @@ yyreduce:
           delete (yyvsp[-2].argVec);
         }
       }
-#line 2649 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2860 "parser.tab.cpp"
     break;
 
-  case 93:
-#line 1164 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oSet) = Option<AST::SetLit* >::none(); }
-#line 2655 "parser.tab.cpp" /* yacc.c:1646  */
+  case 93: /* int_ti_expr_tail: FZ_INT  */
+#line 1192 "parser.yxx"
+      { (yyval.oSet) = Option<AST::SetLit* >::none(); }
+#line 2866 "parser.tab.cpp"
     break;
 
-  case 94:
-#line 1166 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oSet) = Option<AST::SetLit* >::some(new AST::SetLit(*(yyvsp[-1].setValue))); }
-#line 2661 "parser.tab.cpp" /* yacc.c:1646  */
+  case 94: /* int_ti_expr_tail: '{' int_list '}'  */
+#line 1194 "parser.yxx"
+      { (yyval.oSet) = Option<AST::SetLit* >::some(new AST::SetLit(*(yyvsp[-1].setValue))); }
+#line 2872 "parser.tab.cpp"
     break;
 
-  case 95:
-#line 1168 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 95: /* int_ti_expr_tail: FZ_INT_LIT FZ_DOTDOT FZ_INT_LIT  */
+#line 1196 "parser.yxx"
+      {
         (yyval.oSet) = Option<AST::SetLit* >::some(new AST::SetLit((yyvsp[-2].iValue), (yyvsp[0].iValue)));
       }
-#line 2669 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2880 "parser.tab.cpp"
     break;
 
-  case 96:
-#line 1174 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oSet) = Option<AST::SetLit* >::none(); }
-#line 2675 "parser.tab.cpp" /* yacc.c:1646  */
+  case 96: /* bool_ti_expr_tail: FZ_BOOL  */
+#line 1202 "parser.yxx"
+      { (yyval.oSet) = Option<AST::SetLit* >::none(); }
+#line 2886 "parser.tab.cpp"
     break;
 
-  case 97:
-#line 1176 "parser.yxx" /* yacc.c:1646  */
-    { bool haveTrue = false;
+  case 97: /* bool_ti_expr_tail: '{' bool_list_head list_tail '}'  */
+#line 1204 "parser.yxx"
+      { bool haveTrue = false;
         bool haveFalse = false;
         for (int i=(yyvsp[-2].setValue)->size(); i--;) {
           haveTrue |= ((*(yyvsp[-2].setValue))[i] == 1);
@@ -2688,233 +2897,234 @@ yyreduce:
         (yyval.oSet) = Option<AST::SetLit* >::some(
           new AST::SetLit(!haveFalse,haveTrue));
       }
-#line 2690 "parser.tab.cpp" /* yacc.c:1646  */
+#line 2901 "parser.tab.cpp"
     break;
 
-  case 100:
-#line 1197 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setLit) = new AST::SetLit(*(yyvsp[-1].setValue)); }
-#line 2696 "parser.tab.cpp" /* yacc.c:1646  */
+  case 100: /* set_literal: '{' int_list '}'  */
+#line 1225 "parser.yxx"
+      { (yyval.setLit) = new AST::SetLit(*(yyvsp[-1].setValue)); }
+#line 2907 "parser.tab.cpp"
     break;
 
-  case 101:
-#line 1199 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setLit) = new AST::SetLit((yyvsp[-2].iValue), (yyvsp[0].iValue)); }
-#line 2702 "parser.tab.cpp" /* yacc.c:1646  */
+  case 101: /* set_literal: FZ_INT_LIT FZ_DOTDOT FZ_INT_LIT  */
+#line 1227 "parser.yxx"
+      { (yyval.setLit) = new AST::SetLit((yyvsp[-2].iValue), (yyvsp[0].iValue)); }
+#line 2913 "parser.tab.cpp"
     break;
 
-  case 102:
-#line 1205 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValue) = new vector<int>(0); }
-#line 2708 "parser.tab.cpp" /* yacc.c:1646  */
+  case 102: /* int_list: %empty  */
+#line 1233 "parser.yxx"
+      { (yyval.setValue) = new vector<int>(0); }
+#line 2919 "parser.tab.cpp"
     break;
 
-  case 103:
-#line 1207 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValue) = (yyvsp[-1].setValue); }
-#line 2714 "parser.tab.cpp" /* yacc.c:1646  */
+  case 103: /* int_list: int_list_head list_tail  */
+#line 1235 "parser.yxx"
+      { (yyval.setValue) = (yyvsp[-1].setValue); }
+#line 2925 "parser.tab.cpp"
     break;
 
-  case 104:
-#line 1211 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValue) = new vector<int>(1); (*(yyval.setValue))[0] = (yyvsp[0].iValue); }
-#line 2720 "parser.tab.cpp" /* yacc.c:1646  */
+  case 104: /* int_list_head: FZ_INT_LIT  */
+#line 1239 "parser.yxx"
+      { (yyval.setValue) = new vector<int>(1); (*(yyval.setValue))[0] = (yyvsp[0].iValue); }
+#line 2931 "parser.tab.cpp"
     break;
 
-  case 105:
-#line 1213 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValue) = (yyvsp[-2].setValue); (yyval.setValue)->push_back((yyvsp[0].iValue)); }
-#line 2726 "parser.tab.cpp" /* yacc.c:1646  */
+  case 105: /* int_list_head: int_list_head ',' FZ_INT_LIT  */
+#line 1241 "parser.yxx"
+      { (yyval.setValue) = (yyvsp[-2].setValue); (yyval.setValue)->push_back((yyvsp[0].iValue)); }
+#line 2937 "parser.tab.cpp"
     break;
 
-  case 106:
-#line 1217 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValue) = new vector<int>(0); }
-#line 2732 "parser.tab.cpp" /* yacc.c:1646  */
+  case 106: /* bool_list: %empty  */
+#line 1245 "parser.yxx"
+      { (yyval.setValue) = new vector<int>(0); }
+#line 2943 "parser.tab.cpp"
     break;
 
-  case 107:
-#line 1219 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValue) = (yyvsp[-1].setValue); }
-#line 2738 "parser.tab.cpp" /* yacc.c:1646  */
+  case 107: /* bool_list: bool_list_head list_tail  */
+#line 1247 "parser.yxx"
+      { (yyval.setValue) = (yyvsp[-1].setValue); }
+#line 2949 "parser.tab.cpp"
     break;
 
-  case 108:
-#line 1223 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValue) = new vector<int>(1); (*(yyval.setValue))[0] = (yyvsp[0].iValue); }
-#line 2744 "parser.tab.cpp" /* yacc.c:1646  */
+  case 108: /* bool_list_head: FZ_BOOL_LIT  */
+#line 1251 "parser.yxx"
+      { (yyval.setValue) = new vector<int>(1); (*(yyval.setValue))[0] = (yyvsp[0].iValue); }
+#line 2955 "parser.tab.cpp"
     break;
 
-  case 109:
-#line 1225 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValue) = (yyvsp[-2].setValue); (yyval.setValue)->push_back((yyvsp[0].iValue)); }
-#line 2750 "parser.tab.cpp" /* yacc.c:1646  */
+  case 109: /* bool_list_head: bool_list_head ',' FZ_BOOL_LIT  */
+#line 1253 "parser.yxx"
+      { (yyval.setValue) = (yyvsp[-2].setValue); (yyval.setValue)->push_back((yyvsp[0].iValue)); }
+#line 2961 "parser.tab.cpp"
     break;
 
-  case 110:
-#line 1229 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.floatSetValue) = new vector<double>(0); }
-#line 2756 "parser.tab.cpp" /* yacc.c:1646  */
+  case 110: /* float_list: %empty  */
+#line 1257 "parser.yxx"
+      { (yyval.floatSetValue) = new vector<double>(0); }
+#line 2967 "parser.tab.cpp"
     break;
 
-  case 111:
-#line 1231 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.floatSetValue) = (yyvsp[-1].floatSetValue); }
-#line 2762 "parser.tab.cpp" /* yacc.c:1646  */
+  case 111: /* float_list: float_list_head list_tail  */
+#line 1259 "parser.yxx"
+      { (yyval.floatSetValue) = (yyvsp[-1].floatSetValue); }
+#line 2973 "parser.tab.cpp"
     break;
 
-  case 112:
-#line 1235 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.floatSetValue) = new vector<double>(1); (*(yyval.floatSetValue))[0] = (yyvsp[0].dValue); }
-#line 2768 "parser.tab.cpp" /* yacc.c:1646  */
+  case 112: /* float_list_head: FZ_FLOAT_LIT  */
+#line 1263 "parser.yxx"
+      { (yyval.floatSetValue) = new vector<double>(1); (*(yyval.floatSetValue))[0] = (yyvsp[0].dValue); }
+#line 2979 "parser.tab.cpp"
     break;
 
-  case 113:
-#line 1237 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.floatSetValue) = (yyvsp[-2].floatSetValue); (yyval.floatSetValue)->push_back((yyvsp[0].dValue)); }
-#line 2774 "parser.tab.cpp" /* yacc.c:1646  */
+  case 113: /* float_list_head: float_list_head ',' FZ_FLOAT_LIT  */
+#line 1265 "parser.yxx"
+      { (yyval.floatSetValue) = (yyvsp[-2].floatSetValue); (yyval.floatSetValue)->push_back((yyvsp[0].dValue)); }
+#line 2985 "parser.tab.cpp"
     break;
 
-  case 114:
-#line 1241 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValueList) = new vector<AST::SetLit>(0); }
-#line 2780 "parser.tab.cpp" /* yacc.c:1646  */
+  case 114: /* set_literal_list: %empty  */
+#line 1269 "parser.yxx"
+      { (yyval.setValueList) = new vector<AST::SetLit>(0); }
+#line 2991 "parser.tab.cpp"
     break;
 
-  case 115:
-#line 1243 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValueList) = (yyvsp[-1].setValueList); }
-#line 2786 "parser.tab.cpp" /* yacc.c:1646  */
+  case 115: /* set_literal_list: set_literal_list_head list_tail  */
+#line 1271 "parser.yxx"
+      { (yyval.setValueList) = (yyvsp[-1].setValueList); }
+#line 2997 "parser.tab.cpp"
     break;
 
-  case 116:
-#line 1247 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValueList) = new vector<AST::SetLit>(1); (*(yyval.setValueList))[0] = *(yyvsp[0].setLit); delete (yyvsp[0].setLit); }
-#line 2792 "parser.tab.cpp" /* yacc.c:1646  */
+  case 116: /* set_literal_list_head: set_literal  */
+#line 1275 "parser.yxx"
+      { (yyval.setValueList) = new vector<AST::SetLit>(1); (*(yyval.setValueList))[0] = *(yyvsp[0].setLit); delete (yyvsp[0].setLit); }
+#line 3003 "parser.tab.cpp"
     break;
 
-  case 117:
-#line 1249 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.setValueList) = (yyvsp[-2].setValueList); (yyval.setValueList)->push_back(*(yyvsp[0].setLit)); delete (yyvsp[0].setLit); }
-#line 2798 "parser.tab.cpp" /* yacc.c:1646  */
+  case 117: /* set_literal_list_head: set_literal_list_head ',' set_literal  */
+#line 1277 "parser.yxx"
+      { (yyval.setValueList) = (yyvsp[-2].setValueList); (yyval.setValueList)->push_back(*(yyvsp[0].setLit)); delete (yyvsp[0].setLit); }
+#line 3009 "parser.tab.cpp"
     break;
 
-  case 118:
-#line 1257 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.argVec) = new AST::Array((yyvsp[0].arg)); }
-#line 2804 "parser.tab.cpp" /* yacc.c:1646  */
+  case 118: /* flat_expr_list: flat_expr  */
+#line 1285 "parser.yxx"
+      { (yyval.argVec) = new AST::Array((yyvsp[0].arg)); }
+#line 3015 "parser.tab.cpp"
     break;
 
-  case 119:
-#line 1259 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.argVec) = (yyvsp[-2].argVec); (yyval.argVec)->append((yyvsp[0].arg)); }
-#line 2810 "parser.tab.cpp" /* yacc.c:1646  */
+  case 119: /* flat_expr_list: flat_expr_list ',' flat_expr  */
+#line 1287 "parser.yxx"
+      { (yyval.argVec) = (yyvsp[-2].argVec); (yyval.argVec)->append((yyvsp[0].arg)); }
+#line 3021 "parser.tab.cpp"
     break;
 
-  case 120:
-#line 1263 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = (yyvsp[0].arg); }
-#line 2816 "parser.tab.cpp" /* yacc.c:1646  */
+  case 120: /* flat_expr: non_array_expr  */
+#line 1291 "parser.yxx"
+      { (yyval.arg) = (yyvsp[0].arg); }
+#line 3027 "parser.tab.cpp"
     break;
 
-  case 121:
-#line 1265 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = (yyvsp[-1].argVec); }
-#line 2822 "parser.tab.cpp" /* yacc.c:1646  */
+  case 121: /* flat_expr: '[' non_array_expr_list ']'  */
+#line 1293 "parser.yxx"
+      { (yyval.arg) = (yyvsp[-1].argVec); }
+#line 3033 "parser.tab.cpp"
     break;
 
-  case 122:
-#line 1269 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oArg) = Option<AST::Node*>::none(); }
-#line 2828 "parser.tab.cpp" /* yacc.c:1646  */
+  case 122: /* non_array_expr_opt: %empty  */
+#line 1297 "parser.yxx"
+      { (yyval.oArg) = Option<AST::Node*>::none(); }
+#line 3039 "parser.tab.cpp"
     break;
 
-  case 123:
-#line 1271 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.oArg) = Option<AST::Node*>::some((yyvsp[0].arg)); }
-#line 2834 "parser.tab.cpp" /* yacc.c:1646  */
+  case 123: /* non_array_expr_opt: '=' non_array_expr  */
+#line 1299 "parser.yxx"
+      { (yyval.oArg) = Option<AST::Node*>::some((yyvsp[0].arg)); }
+#line 3045 "parser.tab.cpp"
     break;
 
-  case 124:
-#line 1275 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = new AST::BoolLit((yyvsp[0].iValue)); }
-#line 2840 "parser.tab.cpp" /* yacc.c:1646  */
+  case 124: /* non_array_expr: FZ_BOOL_LIT  */
+#line 1303 "parser.yxx"
+      { (yyval.arg) = new AST::BoolLit((yyvsp[0].iValue)); }
+#line 3051 "parser.tab.cpp"
     break;
 
-  case 125:
-#line 1277 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = new AST::IntLit((yyvsp[0].iValue)); }
-#line 2846 "parser.tab.cpp" /* yacc.c:1646  */
+  case 125: /* non_array_expr: FZ_INT_LIT  */
+#line 1305 "parser.yxx"
+      { (yyval.arg) = new AST::IntLit((yyvsp[0].iValue)); }
+#line 3057 "parser.tab.cpp"
     break;
 
-  case 126:
-#line 1279 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = new AST::FloatLit((yyvsp[0].dValue)); }
-#line 2852 "parser.tab.cpp" /* yacc.c:1646  */
+  case 126: /* non_array_expr: FZ_FLOAT_LIT  */
+#line 1307 "parser.yxx"
+      { (yyval.arg) = new AST::FloatLit((yyvsp[0].dValue)); }
+#line 3063 "parser.tab.cpp"
     break;
 
-  case 127:
-#line 1281 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = (yyvsp[0].setLit); }
-#line 2858 "parser.tab.cpp" /* yacc.c:1646  */
+  case 127: /* non_array_expr: set_literal  */
+#line 1309 "parser.yxx"
+      { (yyval.arg) = (yyvsp[0].setLit); }
+#line 3069 "parser.tab.cpp"
     break;
 
-  case 128:
-#line 1283 "parser.yxx" /* yacc.c:1646  */
-    {
-        vector<int> as;
+  case 128: /* non_array_expr: FZ_ID  */
+#line 1311 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->intvararrays.get((yyvsp[0].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::IntVar(as[i]);
+        const std::string id((yyvsp[0].sValue));
+        const vector<int>* as;
+        if ((as = pp->intvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::IntVar((*as)[i]);
           (yyval.arg) = ia;
-        } else if (pp->boolvararrays.get((yyvsp[0].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::BoolVar(as[i]);
+        } else if ((as = pp->boolvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::BoolVar((*as)[i]);
           (yyval.arg) = ia;
-        } else if (pp->setvararrays.get((yyvsp[0].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::SetVar(as[i]);
+        } else if ((as = pp->setvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::SetVar((*as)[i]);
           (yyval.arg) = ia;
         } else {
-          std::vector<int> is;
-          std::vector<AST::SetLit> isS;
+          const std::vector<int>* is;
+          const std::vector<AST::SetLit>* isS;
           int ival = 0;
           bool bval = false;
-          if (pp->intvalarrays.get((yyvsp[0].sValue), is)) {
-            AST::Array *v = new AST::Array(is.size());
-            for (int i=is.size(); i--;)
-              v->a[i] = new AST::IntLit(is[i]);
+          if ((is = pp->intvalarrays.find(id))) {
+            AST::Array *v = new AST::Array(is->size());
+            for (int i=is->size(); i--;)
+              v->a[i] = new AST::IntLit((*is)[i]);
             (yyval.arg) = v;
-          } else if (pp->boolvalarrays.get((yyvsp[0].sValue), is)) {
-            AST::Array *v = new AST::Array(is.size());
-            for (int i=is.size(); i--;)
-              v->a[i] = new AST::BoolLit(is[i]);
+          } else if ((is = pp->boolvalarrays.find(id))) {
+            AST::Array *v = new AST::Array(is->size());
+            for (int i=is->size(); i--;)
+              v->a[i] = new AST::BoolLit((*is)[i]);
             (yyval.arg) = v;
-          } else if (pp->setvalarrays.get((yyvsp[0].sValue), isS)) {
-            AST::Array *v = new AST::Array(isS.size());
-            for (int i=isS.size(); i--;)
-              v->a[i] = new AST::SetLit(isS[i]);
+          } else if ((isS = pp->setvalarrays.find(id))) {
+            AST::Array *v = new AST::Array(isS->size());
+            for (int i=isS->size(); i--;)
+              v->a[i] = new AST::SetLit((*isS)[i]);
             (yyval.arg) = v;
-          } else if (pp->intvals.get((yyvsp[0].sValue), ival)) {
+          } else if (pp->intvals.get(id, ival)) {
             (yyval.arg) = new AST::IntLit(ival);
-          } else if (pp->boolvals.get((yyvsp[0].sValue), bval)) {
+          } else if (pp->boolvals.get(id, bval)) {
             (yyval.arg) = new AST::BoolLit(bval);
           } else {
-            (yyval.arg) = getVarRefArg(pp,(yyvsp[0].sValue));
+            (yyval.arg) = getVarRefArg(pp,id);
           }
         }
         free((yyvsp[0].sValue));
       }
-#line 2911 "parser.tab.cpp" /* yacc.c:1646  */
+#line 3123 "parser.tab.cpp"
     break;
 
-  case 129:
-#line 1332 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 129: /* non_array_expr: FZ_ID '[' non_array_expr ']'  */
+#line 1361 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         int i = -1;
         yyassert(pp, (yyvsp[-1].arg)->isInt(i), "Non-integer array index.");
@@ -2924,36 +3134,36 @@ yyreduce:
           (yyval.arg) = new AST::IntLit(0); // keep things consistent
         free((yyvsp[-3].sValue));
       }
-#line 2926 "parser.tab.cpp" /* yacc.c:1646  */
+#line 3138 "parser.tab.cpp"
     break;
 
-  case 130:
-#line 1345 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.argVec) = new AST::Array(0); }
-#line 2932 "parser.tab.cpp" /* yacc.c:1646  */
+  case 130: /* non_array_expr_list: %empty  */
+#line 1374 "parser.yxx"
+      { (yyval.argVec) = new AST::Array(0); }
+#line 3144 "parser.tab.cpp"
     break;
 
-  case 131:
-#line 1347 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.argVec) = (yyvsp[-1].argVec); }
-#line 2938 "parser.tab.cpp" /* yacc.c:1646  */
+  case 131: /* non_array_expr_list: non_array_expr_list_head list_tail  */
+#line 1376 "parser.yxx"
+      { (yyval.argVec) = (yyvsp[-1].argVec); }
+#line 3150 "parser.tab.cpp"
     break;
 
-  case 132:
-#line 1351 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.argVec) = new AST::Array((yyvsp[0].arg)); }
-#line 2944 "parser.tab.cpp" /* yacc.c:1646  */
+  case 132: /* non_array_expr_list_head: non_array_expr  */
+#line 1380 "parser.yxx"
+      { (yyval.argVec) = new AST::Array((yyvsp[0].arg)); }
+#line 3156 "parser.tab.cpp"
     break;
 
-  case 133:
-#line 1353 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.argVec) = (yyvsp[-2].argVec); (yyval.argVec)->append((yyvsp[0].arg)); }
-#line 2950 "parser.tab.cpp" /* yacc.c:1646  */
+  case 133: /* non_array_expr_list_head: non_array_expr_list_head ',' non_array_expr  */
+#line 1382 "parser.yxx"
+      { (yyval.argVec) = (yyvsp[-2].argVec); (yyval.argVec)->append((yyvsp[0].arg)); }
+#line 3162 "parser.tab.cpp"
     break;
 
-  case 134:
-#line 1361 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 134: /* solve_expr: FZ_ID  */
+#line 1390 "parser.yxx"
+      {
         ParserState *pp = static_cast<ParserState*>(parm);
         if (!pp->intvarTable.get((yyvsp[0].sValue), (yyval.iValue))) {
           pp->err << "Error: unknown integer variable " << (yyvsp[0].sValue)
@@ -2963,169 +3173,169 @@ yyreduce:
         }
         free((yyvsp[0].sValue));
       }
-#line 2965 "parser.tab.cpp" /* yacc.c:1646  */
+#line 3177 "parser.tab.cpp"
     break;
 
-  case 135:
-#line 1372 "parser.yxx" /* yacc.c:1646  */
-    {
-        vector<int> tmp;
+  case 135: /* solve_expr: FZ_ID '[' FZ_INT_LIT ']'  */
+#line 1401 "parser.yxx"
+      {
         ParserState *pp = static_cast<ParserState*>(parm);
-        if (!pp->intvararrays.get((yyvsp[-3].sValue), tmp)) {
+        const vector<int>* tmp = pp->intvararrays.find((yyvsp[-3].sValue));
+        if (!tmp) {
           pp->err << "Error: unknown integer variable array " << (yyvsp[-3].sValue)
                   << " in line no. "
                   << yyget_lineno(pp->yyscanner) << std::endl;
           pp->hadError = true;
-        }
-        if ((yyvsp[-1].iValue) == 0 || static_cast<unsigned int>((yyvsp[-1].iValue)) > tmp.size()) {
+        } else if ((yyvsp[-1].iValue) == 0 || static_cast<unsigned int>((yyvsp[-1].iValue)) > tmp->size()) {
           pp->err << "Error: array index out of bounds for array " << (yyvsp[-3].sValue)
                   << " in line no. "
                   << yyget_lineno(pp->yyscanner) << std::endl;
           pp->hadError = true;
         } else {
-          (yyval.iValue) = tmp[(yyvsp[-1].iValue)-1];
+          (yyval.iValue) = (*tmp)[(yyvsp[-1].iValue)-1];
         }
         free((yyvsp[-3].sValue));
       }
-#line 2989 "parser.tab.cpp" /* yacc.c:1646  */
+#line 3200 "parser.tab.cpp"
     break;
 
-  case 138:
-#line 1402 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.argVec) = NULL; }
-#line 2995 "parser.tab.cpp" /* yacc.c:1646  */
+  case 138: /* annotations: %empty  */
+#line 1430 "parser.yxx"
+      { (yyval.argVec) = NULL; }
+#line 3206 "parser.tab.cpp"
     break;
 
-  case 139:
-#line 1404 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.argVec) = (yyvsp[0].argVec); }
-#line 3001 "parser.tab.cpp" /* yacc.c:1646  */
+  case 139: /* annotations: annotations_head  */
+#line 1432 "parser.yxx"
+      { (yyval.argVec) = (yyvsp[0].argVec); }
+#line 3212 "parser.tab.cpp"
     break;
 
-  case 140:
-#line 1408 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.argVec) = new AST::Array((yyvsp[0].arg)); }
-#line 3007 "parser.tab.cpp" /* yacc.c:1646  */
+  case 140: /* annotations_head: FZ_COLONCOLON annotation  */
+#line 1436 "parser.yxx"
+      { (yyval.argVec) = new AST::Array((yyvsp[0].arg)); }
+#line 3218 "parser.tab.cpp"
     break;
 
-  case 141:
-#line 1410 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.argVec) = (yyvsp[-2].argVec); (yyval.argVec)->append((yyvsp[0].arg)); }
-#line 3013 "parser.tab.cpp" /* yacc.c:1646  */
+  case 141: /* annotations_head: annotations_head FZ_COLONCOLON annotation  */
+#line 1438 "parser.yxx"
+      { (yyval.argVec) = (yyvsp[-2].argVec); (yyval.argVec)->append((yyvsp[0].arg)); }
+#line 3224 "parser.tab.cpp"
     break;
 
-  case 142:
-#line 1414 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 142: /* annotation: FZ_ID '(' annotation_list ')'  */
+#line 1442 "parser.yxx"
+      {
         (yyval.arg) = new AST::Call((yyvsp[-3].sValue), AST::extractSingleton((yyvsp[-1].arg))); free((yyvsp[-3].sValue));
       }
-#line 3021 "parser.tab.cpp" /* yacc.c:1646  */
+#line 3232 "parser.tab.cpp"
     break;
 
-  case 143:
-#line 1418 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = (yyvsp[0].arg); }
-#line 3027 "parser.tab.cpp" /* yacc.c:1646  */
+  case 143: /* annotation: annotation_expr  */
+#line 1446 "parser.yxx"
+      { (yyval.arg) = (yyvsp[0].arg); }
+#line 3238 "parser.tab.cpp"
     break;
 
-  case 144:
-#line 1422 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = new AST::Array((yyvsp[0].arg)); }
-#line 3033 "parser.tab.cpp" /* yacc.c:1646  */
+  case 144: /* annotation_list: annotation  */
+#line 1450 "parser.yxx"
+      { (yyval.arg) = new AST::Array((yyvsp[0].arg)); }
+#line 3244 "parser.tab.cpp"
     break;
 
-  case 145:
-#line 1424 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = (yyvsp[-2].arg); (yyval.arg)->append((yyvsp[0].arg)); }
-#line 3039 "parser.tab.cpp" /* yacc.c:1646  */
+  case 145: /* annotation_list: annotation_list ',' annotation  */
+#line 1452 "parser.yxx"
+      { (yyval.arg) = (yyvsp[-2].arg); (yyval.arg)->append((yyvsp[0].arg)); }
+#line 3250 "parser.tab.cpp"
     break;
 
-  case 146:
-#line 1428 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = (yyvsp[0].arg); }
-#line 3045 "parser.tab.cpp" /* yacc.c:1646  */
+  case 146: /* annotation_expr: ann_non_array_expr  */
+#line 1456 "parser.yxx"
+      { (yyval.arg) = (yyvsp[0].arg); }
+#line 3256 "parser.tab.cpp"
     break;
 
-  case 147:
-#line 1430 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = (yyvsp[-1].arg); }
-#line 3051 "parser.tab.cpp" /* yacc.c:1646  */
+  case 147: /* annotation_expr: '[' annotation_list ']'  */
+#line 1458 "parser.yxx"
+      { (yyval.arg) = (yyvsp[-1].arg); }
+#line 3262 "parser.tab.cpp"
     break;
 
-  case 148:
-#line 1434 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = new AST::BoolLit((yyvsp[0].iValue)); }
-#line 3057 "parser.tab.cpp" /* yacc.c:1646  */
+  case 148: /* ann_non_array_expr: FZ_BOOL_LIT  */
+#line 1462 "parser.yxx"
+      { (yyval.arg) = new AST::BoolLit((yyvsp[0].iValue)); }
+#line 3268 "parser.tab.cpp"
     break;
 
-  case 149:
-#line 1436 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = new AST::IntLit((yyvsp[0].iValue)); }
-#line 3063 "parser.tab.cpp" /* yacc.c:1646  */
+  case 149: /* ann_non_array_expr: FZ_INT_LIT  */
+#line 1464 "parser.yxx"
+      { (yyval.arg) = new AST::IntLit((yyvsp[0].iValue)); }
+#line 3274 "parser.tab.cpp"
     break;
 
-  case 150:
-#line 1438 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = new AST::FloatLit((yyvsp[0].dValue)); }
-#line 3069 "parser.tab.cpp" /* yacc.c:1646  */
+  case 150: /* ann_non_array_expr: FZ_FLOAT_LIT  */
+#line 1466 "parser.yxx"
+      { (yyval.arg) = new AST::FloatLit((yyvsp[0].dValue)); }
+#line 3280 "parser.tab.cpp"
     break;
 
-  case 151:
-#line 1440 "parser.yxx" /* yacc.c:1646  */
-    { (yyval.arg) = (yyvsp[0].setLit); }
-#line 3075 "parser.tab.cpp" /* yacc.c:1646  */
+  case 151: /* ann_non_array_expr: set_literal  */
+#line 1468 "parser.yxx"
+      { (yyval.arg) = (yyvsp[0].setLit); }
+#line 3286 "parser.tab.cpp"
     break;
 
-  case 152:
-#line 1442 "parser.yxx" /* yacc.c:1646  */
-    {
-        vector<int> as;
+  case 152: /* ann_non_array_expr: FZ_ID  */
+#line 1470 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
-        if (pp->intvararrays.get((yyvsp[0].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::IntVar(as[i]);
+        const std::string id((yyvsp[0].sValue));
+        const vector<int>* as;
+        if ((as = pp->intvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::IntVar((*as)[i]);
           (yyval.arg) = ia;
-        } else if (pp->boolvararrays.get((yyvsp[0].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::BoolVar(as[i]);
+        } else if ((as = pp->boolvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::BoolVar((*as)[i]);
           (yyval.arg) = ia;
-        } else if (pp->setvararrays.get((yyvsp[0].sValue), as)) {
-          AST::Array *ia = new AST::Array(as.size());
-          for (int i=as.size(); i--;)
-            ia->a[i] = new AST::SetVar(as[i]);
+        } else if ((as = pp->setvararrays.find(id))) {
+          AST::Array *ia = new AST::Array(as->size());
+          for (int i=as->size(); i--;)
+            ia->a[i] = new AST::SetVar((*as)[i]);
           (yyval.arg) = ia;
         } else {
-          std::vector<int> is;
+          const std::vector<int>* is;
           int ival = 0;
           bool bval = false;
-          if (pp->intvalarrays.get((yyvsp[0].sValue), is)) {
-            AST::Array *v = new AST::Array(is.size());
-            for (int i=is.size(); i--;)
-              v->a[i] = new AST::IntLit(is[i]);
+          if ((is = pp->intvalarrays.find(id))) {
+            AST::Array *v = new AST::Array(is->size());
+            for (int i=is->size(); i--;)
+              v->a[i] = new AST::IntLit((*is)[i]);
             (yyval.arg) = v;
-          } else if (pp->boolvalarrays.get((yyvsp[0].sValue), is)) {
-            AST::Array *v = new AST::Array(is.size());
-            for (int i=is.size(); i--;)
-              v->a[i] = new AST::BoolLit(is[i]);
+          } else if ((is = pp->boolvalarrays.find(id))) {
+            AST::Array *v = new AST::Array(is->size());
+            for (int i=is->size(); i--;)
+              v->a[i] = new AST::BoolLit((*is)[i]);
             (yyval.arg) = v;
-          } else if (pp->intvals.get((yyvsp[0].sValue), ival)) {
+          } else if (pp->intvals.get(id, ival)) {
             (yyval.arg) = new AST::IntLit(ival);
-          } else if (pp->boolvals.get((yyvsp[0].sValue), bval)) {
+          } else if (pp->boolvals.get(id, bval)) {
             (yyval.arg) = new AST::BoolLit(bval);
           } else {
-            (yyval.arg) = getVarRefArg(pp,(yyvsp[0].sValue),true);
+            (yyval.arg) = getVarRefArg(pp,id,true);
           }
         }
         free((yyvsp[0].sValue));
       }
-#line 3122 "parser.tab.cpp" /* yacc.c:1646  */
+#line 3334 "parser.tab.cpp"
     break;
 
-  case 153:
-#line 1485 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 153: /* ann_non_array_expr: FZ_ID '[' ann_non_array_expr ']'  */
+#line 1514 "parser.yxx"
+      {
         ParserState* pp = static_cast<ParserState*>(parm);
         int i = -1;
         yyassert(pp, (yyvsp[-1].arg)->isInt(i), "Non-integer array index.");
@@ -3135,20 +3345,21 @@ yyreduce:
           (yyval.arg) = new AST::IntLit(0); // keep things consistent
         free((yyvsp[-3].sValue));
       }
-#line 3137 "parser.tab.cpp" /* yacc.c:1646  */
+#line 3349 "parser.tab.cpp"
     break;
 
-  case 154:
-#line 1496 "parser.yxx" /* yacc.c:1646  */
-    {
+  case 154: /* ann_non_array_expr: FZ_STRING_LIT  */
+#line 1525 "parser.yxx"
+      {
         (yyval.arg) = new AST::String((yyvsp[0].sValue));
         free((yyvsp[0].sValue));
       }
-#line 3146 "parser.tab.cpp" /* yacc.c:1646  */
+#line 3358 "parser.tab.cpp"
     break;
 
 
-#line 3150 "parser.tab.cpp" /* yacc.c:1646  */
+#line 3362 "parser.tab.cpp"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -3162,25 +3373,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -3191,50 +3400,44 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (parm, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (parm, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -3263,12 +3466,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -3285,13 +3487,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -3305,7 +3508,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, parm);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, parm);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -3317,7 +3520,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -3328,26 +3531,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (parm, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -3363,16 +3570,15 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, parm);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, parm);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
+
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_PARSER_TAB_HPP_INCLUDED
 # define YY_YY_PARSER_TAB_HPP_INCLUDED
 /* Debug traces.  */
@@ -40,64 +45,68 @@
 extern int yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    FZ_INT_LIT = 258,
-    FZ_BOOL_LIT = 259,
-    FZ_FLOAT_LIT = 260,
-    FZ_ID = 261,
-    FZ_STRING_LIT = 262,
-    FZ_VAR = 263,
-    FZ_PAR = 264,
-    FZ_ANNOTATION = 265,
-    FZ_ANY = 266,
-    FZ_ARRAY = 267,
-    FZ_BOOL = 268,
-    FZ_CASE = 269,
-    FZ_COLONCOLON = 270,
-    FZ_CONSTRAINT = 271,
-    FZ_DEFAULT = 272,
-    FZ_DOTDOT = 273,
-    FZ_ELSE = 274,
-    FZ_ELSEIF = 275,
-    FZ_ENDIF = 276,
-    FZ_ENUM = 277,
-    FZ_FLOAT = 278,
-    FZ_FUNCTION = 279,
-    FZ_IF = 280,
-    FZ_INCLUDE = 281,
-    FZ_INT = 282,
-    FZ_LET = 283,
-    FZ_MAXIMIZE = 284,
-    FZ_MINIMIZE = 285,
-    FZ_OF = 286,
-    FZ_SATISFY = 287,
-    FZ_OUTPUT = 288,
-    FZ_PREDICATE = 289,
-    FZ_RECORD = 290,
-    FZ_SET = 291,
-    FZ_SHOW = 292,
-    FZ_SHOWCOND = 293,
-    FZ_SOLVE = 294,
-    FZ_STRING = 295,
-    FZ_TEST = 296,
-    FZ_THEN = 297,
-    FZ_TUPLE = 298,
-    FZ_TYPE = 299,
-    FZ_VARIANT_RECORD = 300,
-    FZ_WHERE = 301
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    FZ_INT_LIT = 258,              /* FZ_INT_LIT  */
+    FZ_BOOL_LIT = 259,             /* FZ_BOOL_LIT  */
+    FZ_FLOAT_LIT = 260,            /* FZ_FLOAT_LIT  */
+    FZ_ID = 261,                   /* FZ_ID  */
+    FZ_STRING_LIT = 262,           /* FZ_STRING_LIT  */
+    FZ_VAR = 263,                  /* FZ_VAR  */
+    FZ_PAR = 264,                  /* FZ_PAR  */
+    FZ_ANNOTATION = 265,           /* FZ_ANNOTATION  */
+    FZ_ANY = 266,                  /* FZ_ANY  */
+    FZ_ARRAY = 267,                /* FZ_ARRAY  */
+    FZ_BOOL = 268,                 /* FZ_BOOL  */
+    FZ_CASE = 269,                 /* FZ_CASE  */
+    FZ_COLONCOLON = 270,           /* FZ_COLONCOLON  */
+    FZ_CONSTRAINT = 271,           /* FZ_CONSTRAINT  */
+    FZ_DEFAULT = 272,              /* FZ_DEFAULT  */
+    FZ_DOTDOT = 273,               /* FZ_DOTDOT  */
+    FZ_ELSE = 274,                 /* FZ_ELSE  */
+    FZ_ELSEIF = 275,               /* FZ_ELSEIF  */
+    FZ_ENDIF = 276,                /* FZ_ENDIF  */
+    FZ_ENUM = 277,                 /* FZ_ENUM  */
+    FZ_FLOAT = 278,                /* FZ_FLOAT  */
+    FZ_FUNCTION = 279,             /* FZ_FUNCTION  */
+    FZ_IF = 280,                   /* FZ_IF  */
+    FZ_INCLUDE = 281,              /* FZ_INCLUDE  */
+    FZ_INT = 282,                  /* FZ_INT  */
+    FZ_LET = 283,                  /* FZ_LET  */
+    FZ_MAXIMIZE = 284,             /* FZ_MAXIMIZE  */
+    FZ_MINIMIZE = 285,             /* FZ_MINIMIZE  */
+    FZ_OF = 286,                   /* FZ_OF  */
+    FZ_SATISFY = 287,              /* FZ_SATISFY  */
+    FZ_OUTPUT = 288,               /* FZ_OUTPUT  */
+    FZ_PREDICATE = 289,            /* FZ_PREDICATE  */
+    FZ_RECORD = 290,               /* FZ_RECORD  */
+    FZ_SET = 291,                  /* FZ_SET  */
+    FZ_SHOW = 292,                 /* FZ_SHOW  */
+    FZ_SHOWCOND = 293,             /* FZ_SHOWCOND  */
+    FZ_SOLVE = 294,                /* FZ_SOLVE  */
+    FZ_STRING = 295,               /* FZ_STRING  */
+    FZ_TEST = 296,                 /* FZ_TEST  */
+    FZ_THEN = 297,                 /* FZ_THEN  */
+    FZ_TUPLE = 298,                /* FZ_TUPLE  */
+    FZ_TYPE = 299,                 /* FZ_TYPE  */
+    FZ_VARIANT_RECORD = 300,       /* FZ_VARIANT_RECORD  */
+    FZ_WHERE = 301                 /* FZ_WHERE  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
 union YYSTYPE
 {
-#line 337 "parser.yxx" /* yacc.c:1909  */
+#line 368 "parser.yxx"
  int iValue; char* sValue; bool bValue; double dValue;
          std::vector<int>* setValue;
          FlatZinc::AST::SetLit* setLit;
@@ -112,9 +121,9 @@ union YYSTYPE
          FlatZinc::AST::Array* argVec;
        
 
-#line 116 "parser.tab.hpp" /* yacc.c:1909  */
-};
+#line 125 "parser.tab.hpp"
 
+};
 typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
@@ -122,6 +131,8 @@ typedef union YYSTYPE YYSTYPE;
 
 
 
+
 int yyparse (void *parm);
 
+
 #endif /* !YY_YY_PARSER_TAB_HPP_INCLUDED  */
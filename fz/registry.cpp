@@ -328,6 +328,24 @@ inline Variable duplicate_variable(Variable var, Solver * s){
       return x0;
     }
 
+    /// add the clause x0 \/ x1 (\/ x2) to the clause base, x is negated when its sign is 0
+    void add_clause(FlatZincModel& m, Variable x0, const int s0,
+                    Variable x1, const int s1) {
+      Vector<Variable> pos, neg;
+      (s0 ? pos : neg).add(x0);
+      (s1 ? pos : neg).add(x1);
+      m.add_clause(pos, neg);
+    }
+
+    void add_clause(FlatZincModel& m, Variable x0, const int s0,
+                    Variable x1, const int s1, Variable x2, const int s2) {
+      Vector<Variable> pos, neg;
+      (s0 ? pos : neg).add(x0);
+      (s1 ? pos : neg).add(x1);
+      (s2 ? pos : neg).add(x2);
+      m.add_clause(pos, neg);
+    }
+
     Variable getIntVar(Solver& s,
                      FlatZincModel& m,
                      AST::Node* n) {
@@ -1756,8 +1774,32 @@ inline Variable duplicate_variable(Variable var, Solver * s){
     	  }
       }
 
-      if(posted.size >1)
-        s.add( AllDiff(posted) );
+      if(posted.size >1) {
+        int consistency = AUTO_CONSISTENCY;
+        if (ann && ann->hasAtom("domain"))
+          consistency = DOMAIN_CONSISTENCY;
+        else if (ann && ann->hasAtom("bounds"))
+          consistency = BOUND_CONSISTENCY;
+        s.add( AllDiff(posted, consistency) );
+      }
+    }
+
+    /* nvalue */
+    void p_nvalue(Solver& s, FlatZincModel& m,
+                  const ConExpr& ce, AST::Node* ann) {
+      Variable n = getIntVar(s, m, ce[0]);
+      Vector< Variable > iv = arg2intvarargs(s, m, ce[1]);
+      s.add( NValue(iv) == n );
+    }
+
+    /* mistral_bin_packing_load(load, bin, w, first) */
+    void p_mistral_bin_packing_load(Solver& s, FlatZincModel& m,
+                                    const ConExpr& ce, AST::Node* ann) {
+      Vector< Variable > load = arg2intvarargs(s, m, ce[0]);
+      Vector< Variable > bin = arg2intvarargs(s, m, ce[1]);
+      Vector< int > w = arg2intargs(ce[2]);
+      std::vector< int > size(w.begin(), w.end());
+      s.add( BinPacking(bin, size, load, ce[3]->getInt()) );
     }
 
     /*
@@ -2807,49 +2849,29 @@ predicate global_cardinality_low_up(array[int] of var int: x,
 
 */
 
-/*Not tested
- *     void p_global_cardinality_low_up(Solver& s, FlatZincModel& m,
+    void p_global_cardinality_low_up(Solver& s, FlatZincModel& m,
                       const ConExpr& ce, AST::Node* ann) {
-
-    	Vector< Variable > x = arg2intvarargs(s, m, ce[0]);
-    	Vector< int > values = arg2intargs(ce[1]);
-    	Vector< int > lower_b = arg2intargs(ce[2]);
-    	Vector< int > upper_b = arg2intargs(ce[3]);
-
-    	//values is not necessarily sorted
-    	int min=values[0], max=values[0];
-
-    	for (int i=1; i <values.size;++i )
-    	{
-    		if (min >values[i])
-    			min=values[i];
-    		if (max<values[i] )
-    			max=values[i];
-    	}
-
-    	int * index= new int[max-min +1];
-
-    	for (int i=0; i <values.size;++i )
-    	{
-    		index[values[i]-min]=i;
-    	}
-
-    	int *lb = new int[max-min +1];
-    	int *ub = new int[max-min +1];
-
-    	++max;
-    	for(int i=min; i<max; ++i) {
-    		lb[i-min] = lower_b[index[i-min]];
-    		ub[i-min] = upper_b[index[i-min]];
-    	}
-    	--max;
-    	s.add(Occurrences(x, min, max, lb, ub));
-    	delete [] lb;
-    	delete [] ub;
-    	delete [] index;
-
+      Vector< Variable > x = arg2intvarargs(s, m, ce[0]);
+      Vector< int > cover = arg2intargs(ce[1]);
+      Vector< int > lbound = arg2intargs(ce[2]);
+      Vector< int > ubound = arg2intargs(ce[3]);
+      std::vector< int > values(cover.begin(), cover.end());
+      std::vector< int > lb(lbound.begin(), lbound.end());
+      std::vector< int > ub(ubound.begin(), ubound.end());
+      if (values.size())
+        s.add( Occurrences(x, values, lb, ub, DOMAIN_CONSISTENCY) );
+    }
+
+    /* count[i] is the number of occurrences of cover[i] in x */
+    void p_global_cardinality(Solver& s, FlatZincModel& m,
+                      const ConExpr& ce, AST::Node* ann) {
+      Vector< Variable > x = arg2intvarargs(s, m, ce[0]);
+      Vector< int > cover = arg2intargs(ce[1]);
+      Vector< Variable > count = arg2intvarargs(s, m, ce[2]);
+      std::vector< int > values(cover.begin(), cover.end());
+      if (values.size())
+        s.add( Cardinality(x, values, count) );
     }
-*/
 
     /* global cardinality constraint */
     void p_distribute(Solver& s, FlatZincModel& m,
@@ -2951,26 +2973,17 @@ predicate global_cardinality_low_up(array[int] of var int: x,
 
     void p_array_bool_and(Solver& s, FlatZincModel& m,
                           const ConExpr& ce, AST::Node* ann) {
-      
-       Vector<Variable> bv = arg2boolvarargs(s, m, ce[0]);
-       Variable r = getBoolVar(s, m, ce[1]);
-
-       if(!bv.empty())
-         s.add((BoolSum(bv) == bv.size) == r);
-       else
-         s.add(r == 1);
-
-      // vec<Lit> up;
-      // up.push( safeLit(s, r) );
-      // for(size_t i = 0; i != bv.size(); ++i) {
-      //   vec<Lit> down;
-      //   down.push( ~safeLit(s, r) );
-      //   down.push( safeLit(s, bv[i]) );
-      //   s.addClause(down);
-
-      //   up.push( ~safeLit(s, bv[i]) );
-      // }
-      // s.addClause(up);
+      Vector<Variable> bv = arg2boolvarargs(s, m, ce[0]);
+      Variable r = getBoolVar(s, m, ce[1]);
+
+      // r \/ not(bv[0]) \/ ... \/ not(bv[n-1])
+      Vector<Variable> pos, neg(bv);
+      pos.add(r);
+      m.add_clause(pos, neg);
+
+      // not(r) \/ bv[i]
+      for(unsigned int i=0; i<bv.size; ++i)
+        add_clause(m, r, 0, bv[i], 1);
     }
 
     void p_array_bool_or(Solver& s, FlatZincModel& m,
@@ -2978,60 +2991,25 @@ predicate global_cardinality_low_up(array[int] of var int: x,
       Vector<Variable> bv = arg2boolvarargs(s, m, ce[0]);
       Variable r = getBoolVar(s, m, ce[1]);
 
+      // not(r) \/ bv[0] \/ ... \/ bv[n-1]
+      Vector<Variable> pos(bv), neg;
+      neg.add(r);
+      m.add_clause(pos, neg);
 
-      // std::cout << bv << " >= 1 <-> " << r << std::endl;
-
-      // for(int i=0; i<bv.size; ++i)
-      //   std::cout << bv[i].get_domain() << std::endl;
-
-      // std::cout << r.get_domain() << std::endl;
-
-      if(!bv.empty()) {
-        if(r.get_min() == 1 && bv.size == 2) {
-          s.add( bv[0] || bv[1] );
-        } else { 
-          s.add((BoolSum(bv) >= 1) == r);
-        }
-      }
-      else
-        s.add(r == 0);
-
-
-
-      // vec<Lit> up;
-      // up.push( ~safeLit(s, r) );
-      // for(size_t i = 0; i != bv.size(); ++i) {
-      //   vec<Lit> down;
-      //   down.push( safeLit(s, r) );
-      //   down.push( ~safeLit(s, bv[i]) );
-      //   s.addClause(down);
-
-      //   up.push( safeLit(s, bv[i]) );
-      // }
-      // s.addClause(up);
+      // r \/ not(bv[i])
+      for(unsigned int i=0; i<bv.size; ++i)
+        add_clause(m, r, 1, bv[i], 0);
     }
 
     void p_bool_and(Solver& s, FlatZincModel& m,
                     const ConExpr& ce, AST::Node* ann) {
-
-
       Variable x0 = getBoolVar(s, m, ce[0]);
       Variable x1 = getBoolVar(s, m, ce[1]);
       Variable r = getBoolVar(s, m, ce[2]);
 
-      s.add( (x0 && x1) == r );
-
-      // vec<Lit> ps1, ps2, ps3;
-      // ps1.push( ~safeLit(s, r) );
-      // ps1.push( safeLit(s, x0) );
-      // ps2.push( ~safeLit(s, r) );
-      // ps2.push( safeLit(s, x1) );
-      // ps3.push( ~safeLit(s, x0) );
-      // ps3.push( ~safeLit(s, x1) );
-      // ps3.push( safeLit(s, r) );
-      // s.addClause(ps1);
-      // s.addClause(ps2);
-      // s.addClause(ps3);
+      add_clause(m, r, 0, x0, 1);
+      add_clause(m, r, 0, x1, 1);
+      add_clause(m, r, 1, x0, 0, x1, 0);
     }
 
     void p_bool_or(Solver& s, FlatZincModel& m,
@@ -3040,60 +3018,11 @@ predicate global_cardinality_low_up(array[int] of var int: x,
       Variable x1 = getBoolVar(s, m, ce[1]);
       Variable r = getBoolVar(s, m, ce[2]);
 
-  	if (identical(x0,x1))
-  		s.add(r==x0);
-  	else
-      s.add( (x0 || x1) == r );
-
-      /*Can be decomposed into
-       * not(r) \/ x0  \/x1
-       * r  \/ not(x0)
-       * r  \/ not(x1)
-       */
-
-/*
-
-      Vector<Variable *> pos;
-      Vector<Variable *> neg;
-      //not(r) \/ x0  \/x1
-      pos.clear();
-      neg.clear();
-      pos.add(&x0);
-      pos.add(&x1);
-      neg.add(&r);
-      encode_clause(s,pos,neg );
-
-    // r  \/ not(x0)
-      pos.clear();
-      neg.clear();
-      pos.add(&r);
-      neg.add(&x0);
-      encode_clause(s,pos,neg );
-
-
-     // r  \/ not(x1)
-      pos.clear();
-      neg.clear();
-      pos.add(&r);
-      neg.add(&x1);
-      encode_clause(s,pos,neg );
-
-*/
-
-      // vec<Lit> ps1, ps2, ps3;
-      // ps1.push( safeLit(s, r) );
-      // ps1.push( ~safeLit(s, x0) );
-      // ps2.push( safeLit(s, r) );
-      // ps2.push( ~safeLit(s, x1) );
-      // ps3.push( safeLit(s, x0) );
-      // ps3.push( safeLit(s, x1) );
-      // ps3.push( ~safeLit(s, r) );
-      // s.addClause(ps1);
-      // s.addClause(ps2);
-      // s.addClause(ps3);
+      add_clause(m, r, 1, x0, 0);
+      add_clause(m, r, 1, x1, 0);
+      add_clause(m, r, 0, x0, 1, x1, 1);
     }
 
-
     void p_bool_clause(Solver& s, FlatZincModel& m,
                        const ConExpr& ce, AST::Node* ann) {
 
@@ -3101,18 +3030,8 @@ predicate global_cardinality_low_up(array[int] of var int: x,
       Vector<Variable> pos = arg2boolvarargs(s, m, ce[0]);
       Vector<Variable> neg = arg2boolvarargs(s, m, ce[1]);
 
-      //
       //Posting a clause instead of boolean sums
-      //m.add_clause(pos, neg);
-
-
-      if(pos.empty())
-        s.add( BoolSum(neg) < neg.size );
-      else if(neg.empty())
-        s.add( BoolSum(pos) > 0 );
-      else 
-        s.add( (BoolSum(pos) > 0) || (BoolSum(neg) < neg.size) );
-
+      m.add_clause(pos, neg);
 
       // vector<Variable> x1 = arg2boolvarargs(s, m, ce[1]);
 
@@ -3126,29 +3045,20 @@ predicate global_cardinality_low_up(array[int] of var int: x,
 
     void p_bool_clause_reif(Solver& s, FlatZincModel& m,
                             const ConExpr& ce, AST::Node* ann) {
-    	report_unsupported("p_bool_clause_reif");
+      Vector<Variable> pos = arg2boolvarargs(s, m, ce[0]);
+      Vector<Variable> neg = arg2boolvarargs(s, m, ce[1]);
+      Variable r = getBoolVar(s, m, ce[2]);
 
-      // vector<Variable> x0 = arg2boolvarargs(s, m, ce[0]);
-      // vector<Variable> x1 = arg2boolvarargs(s, m, ce[1]);
-      // Variable r = getBoolVar(s, m, ce[2]);
+      // r -> clause
+      neg.add(r);
+      m.add_clause(pos, neg);
+      neg.pop();
 
-      // vec<Lit> ps;
-      // ps.push( ~safeLit(s, r) );
-      // for(size_t i = 0; i != x0.size(); ++i) {
-      //   ps.push(safeLit(s, x0[i]));
-      //   vec<Lit> ps1;
-      //   ps1.push(~safeLit(s, x0[i]));
-      //   ps1.push(safeLit(s, r));
-      //   s.addClause(ps1);
-      // }
-      // for(size_t i = 0; i != x1.size(); ++i) {
-      //   ps.push(~safeLit(s, x1[i]));
-      //   vec<Lit> ps1;
-      //   ps1.push(safeLit(s, x1[i]));
-      //   ps1.push(safeLit(s, r));
-      //   s.addClause(ps1);
-      // }
-      // s.addClause(ps);
+      // clause -> r
+      for(unsigned int i=0; i<pos.size; ++i)
+        add_clause(m, r, 1, pos[i], 0);
+      for(unsigned int i=0; i<neg.size; ++i)
+        add_clause(m, r, 1, neg[i], 1);
     }
 
     void p_bool_eq(Solver& s, FlatZincModel& m,
@@ -3178,83 +3088,10 @@ predicate global_cardinality_low_up(array[int] of var int: x,
       Variable b = getBoolVar(s, m, ce[1]);
       Variable r = getBoolVar(s, m, ce[2]);
 
-  	//additional test
-      if (identical(a,b))
-  		s.add(r==1);
-  	else
-      s.add((a == b) == r);
-
-      //    p_bool_eq_reif can be decomposed as follows :
-      /* r \/ a \/ b
-       * r \/ not(a) \/ not(b)
-       * not(r) \/ a \/ not(b)
-       * not(r) \/ not(a) \/ b
-       *
-       * I HAD PROBLEMS WITH THE DECOMPOSITION! THE SOLVERS STOPS WITH THE INSTANCE ProjectPlannertest_12_8.mzn [MINIZINC'12 CHALLENGE]
-       */
-
-/*
-      Vector<Variable *> pos;
-      Vector<Variable *> neg;
-      pos.clear();
-      neg.clear();
-
-      pos.add(&r);
-      pos.add(&a);
-      pos.add(&b);
-
-      encode_clause(s,pos,neg );
-
-      pos.clear();
-      neg.clear();
-
-      pos.add(&r);
-      neg.add(&a);
-      neg.add(&b);
-
-      encode_clause(s,pos,neg );
-
-      pos.clear();
-      neg.clear();
-
-      neg.add(&r);
-      pos.add(&a);
-      neg.add(&b);
-
-      encode_clause(s,pos,neg );
-
-      pos.clear();
-      neg.clear();
-
-      neg.add(&r);
-      neg.add(&a);
-      pos.add(&b);
-
-      encode_clause(s,pos,neg );
-*/
-
-
-      // vec<Lit> ps1, ps2, ps3, ps4;
-      // ps1.push(~safeLit(s, a));
-      // ps1.push(~safeLit(s, b));
-      // ps1.push(safeLit(s, r));
-
-      // ps2.push(safeLit(s, a));
-      // ps2.push(safeLit(s, b));
-      // ps2.push(safeLit(s, r));
-
-      // ps3.push(safeLit(s, a));
-      // ps3.push(~safeLit(s, b));
-      // ps3.push(~safeLit(s, r));
-
-      // ps4.push(~safeLit(s, a));
-      // ps4.push(safeLit(s, b));
-      // ps4.push(~safeLit(s, r));
-
-      // s.addClause(ps1);
-      // s.addClause(ps2);
-      // s.addClause(ps3);
-      // s.addClause(ps4);
+      add_clause(m, r, 1, a, 1, b, 1);
+      add_clause(m, r, 1, a, 0, b, 0);
+      add_clause(m, r, 0, a, 1, b, 0);
+      add_clause(m, r, 0, a, 0, b, 1);
     }
 
     void p_bool_ge(Solver& s, FlatZincModel& m,
@@ -3262,13 +3099,7 @@ predicate global_cardinality_low_up(array[int] of var int: x,
       Variable a = getBoolVar(s, m, ce[0]);
       Variable b = getBoolVar(s, m, ce[1]);
 
-      if(!identical(a,b))
-      s.add(a >= b);
-
-      // vec<Lit> ps;
-      // ps.push( safeLit(s, a) );
-      // ps.push( ~safeLit(s, b) );
-      // s.addClause(ps);
+      add_clause(m, a, 1, b, 0);
     }
 
     void p_bool_ge_reif(Solver& s, FlatZincModel& m,
@@ -3276,23 +3107,11 @@ predicate global_cardinality_low_up(array[int] of var int: x,
       Variable a = getBoolVar(s, m, ce[0]);
       Variable b = getBoolVar(s, m, ce[1]);
       Variable r = getBoolVar(s, m, ce[2]);
-  	//additional test
-      if (identical(a,b))
-  		s.add(r==1);
-  	else
-      s.add((a >= b) == r);
-
-      // vec<Lit> ps1, ps2, ps3;
-      // ps1.push( safeLit(s, a) );
-      // ps1.push( ~safeLit(s, b) );
-      // ps1.push( ~safeLit(s, r) );
-      // ps2.push( ~safeLit(s, a) );
-      // ps2.push( safeLit(s, r) );
-      // ps3.push( safeLit(s, b));
-      // ps3.push( safeLit(s, r));
-      // s.addClause(ps1);
-      // s.addClause(ps2);
-      // s.addClause(ps3);
+
+      // (a \/ not(b)) <-> r
+      add_clause(m, r, 0, a, 1, b, 0);
+      add_clause(m, r, 1, a, 0);
+      add_clause(m, r, 1, b, 1);
     }
 
     void p_bool_gt(Solver& s, FlatZincModel& m,
@@ -3316,97 +3135,31 @@ predicate global_cardinality_low_up(array[int] of var int: x,
       Variable a = getBoolVar(s, m, ce[0]);
       Variable b = getBoolVar(s, m, ce[1]);
       Variable r = getBoolVar(s, m, ce[2]);
-  	//additional test
-      if (identical(a,b))
-  		s.add(r==0);
-  	else
-      s.add((a > b) == r);
 
-      // vec<Lit> ps1, ps2, ps3;
-      // ps1.push( ~safeLit(s, a) );
-      // ps1.push( safeLit(s, b) );
-      // ps1.push( safeLit(s, r) );
-
-      // ps2.push( safeLit(s, a) );
-      // ps2.push( ~safeLit(s, r) );
-      // ps3.push( ~safeLit(s, b));
-      // ps3.push( ~safeLit(s, r));
-      // s.addClause(ps1);
-      // s.addClause(ps2);
-      // s.addClause(ps3);
+      // (a /\ not(b)) <-> r
+      add_clause(m, r, 0, a, 1);
+      add_clause(m, r, 0, b, 0);
+      add_clause(m, r, 1, a, 0, b, 1);
     }
 
     void p_bool_le(Solver& s, FlatZincModel& m,
                    const ConExpr& ce, AST::Node* ann) {
-    	Variable a = getBoolVar(s, m, ce[0]);
-    	Variable b = getBoolVar(s, m, ce[1]);
-
-    	if (!identical(a,b))
-    		s.add( a <= b );
+      Variable a = getBoolVar(s, m, ce[0]);
+      Variable b = getBoolVar(s, m, ce[1]);
 
-    	//Add clause not(a) \/ b instead of a <= b
-/*
-    	Vector<Variable*> pos;
-    	Vector<Variable*> neg;
-    	pos.clear();
-    	neg.clear();
-    	pos.add(&b);
-    	neg.add(&a);
-    	encode_clause(s,pos,neg );
-*/
+      add_clause(m, a, 0, b, 1);
     }
-    /* bool_le_reif is : (Not(a) \/ b ) <--> r can be decomposed as follows
-       * a \/ r
-       * Not(b) \/ r
-       * Not(r) \/ Not(a) \/ b
-       * However, the solver stops when asking for all solutions! So we use the old constraint
-      ( (a <= b) == r)
-       */
+
     void p_bool_le_reif(Solver& s, FlatZincModel& m,
                         const ConExpr& ce, AST::Node* ann) {
-      Variable a = getBoolVar(s, m, ce[0]); 
+      Variable a = getBoolVar(s, m, ce[0]);
       Variable b = getBoolVar(s, m, ce[1]);
       Variable r = getBoolVar(s, m, ce[2]);
 
-  	if (identical(a,b))
-  		s.add(r==1);
-  	else
-      s.add( (a <= b) == r );
-
-
-      //cout << "(" << a << " <= " << b << ") = " << r << endl;
-
-      /*
-          Vector<Variable *> pos;
-            Vector<Variable *> neg;
-
-            pos.clear();
-            neg.clear();
-
-            pos.add(&a);
-            pos.add(&r);
-
-            encode_clause(s,pos,neg);
-
-            pos.clear();
-            neg.clear();
-
-            pos.add(&r);
-            neg.add(&b);
-
-            encode_clause(s,pos,neg);
-
-            pos.clear();
-            neg.clear();
-
-            pos.add(&b);
-            neg.add(&a);
-            neg.add(&r);
-
-            encode_clause(s,pos,neg);
-      */
-
-
+      // (not(a) \/ b) <-> r
+      add_clause(m, r, 0, a, 0, b, 1);
+      add_clause(m, r, 1, a, 1);
+      add_clause(m, r, 1, b, 0);
     }
 
     void p_bool_lt(Solver& s, FlatZincModel& m,
@@ -3425,10 +3178,10 @@ predicate global_cardinality_low_up(array[int] of var int: x,
       Variable b = getBoolVar(s, m, ce[1]);
       Variable r = getBoolVar(s, m, ce[2]);
 
-      if (identical(a,b))
-    	  s.add(r==0);
-      else
-      s.add( (a < b) == r );
+      // (not(a) /\ b) <-> r
+      add_clause(m, r, 0, a, 0);
+      add_clause(m, r, 0, b, 1);
+      add_clause(m, r, 1, a, 1, b, 0);
     }
 
     void p_bool_left_imp(Solver& s, FlatZincModel& m,
@@ -3445,12 +3198,9 @@ predicate global_cardinality_low_up(array[int] of var int: x,
                    const ConExpr& ce, AST::Node* ann) {
       Variable a = getBoolVar(s, m, ce[0]);
       Variable b = getBoolVar(s, m, ce[1]);
-      if (identical(a,b)){
-    	  //UNSAT
-    	  s.fail();
-      }
-      else
-      s.add( a != b );
+
+      add_clause(m, a, 1, b, 1);
+      add_clause(m, a, 0, b, 0);
     }
 
     void p_bool_ne_reif(Solver& s, FlatZincModel& m,
@@ -3458,60 +3208,11 @@ predicate global_cardinality_low_up(array[int] of var int: x,
       Variable a = getBoolVar(s, m, ce[0]);
       Variable b = getBoolVar(s, m, ce[1]);
       Variable r = getBoolVar(s, m, ce[2]);
-      //additional test
-      if (identical (a,b))
-    	  s.add(r==0);
-      else
-       s.add( (a != b) == r );
-
-      /* Can be decomposed as follows
-       * not(a) \/ b  \/ r
-       * a \/ not(b)  \/ r
-       * not(a) \/ not(b)  \/ not(r)
-       * a \/ b  \/ not(r)
-       */
-/*
-      Vector<Variable *> pos;
-      Vector<Variable *> neg;
-      // not(a) \/ b  \/ r
-      pos.clear();
-      neg.clear();
-
-      pos.add(&b);
-      pos.add(&r);
-      neg.add(&a);
 
-      encode_clause(s,pos,neg);
-      // a \/ not(b)  \/ r
-      pos.clear();
-      neg.clear();
-
-      pos.add(&a);
-      pos.add(&r);
-      neg.add(&b);
-
-      encode_clause(s,pos,neg);
-
-      //  not(a) \/ not(b)  \/ not(r)
-      pos.clear();
-      neg.clear();
-
-      neg.add(&a);
-      neg.add(&r);
-      neg.add(&b);
-
-      encode_clause(s,pos,neg);
-
-      //  a \/ b  \/ not(r)
-      pos.clear();
-      neg.clear();
-
-      pos.add(&a);
-      pos.add(&b);
-      neg.add(&r);
-
-      encode_clause(s,pos,neg);
-*/
+      add_clause(m, r, 1, a, 0, b, 1);
+      add_clause(m, r, 1, a, 1, b, 0);
+      add_clause(m, r, 0, a, 0, b, 0);
+      add_clause(m, r, 0, a, 1, b, 1);
     }
 
     void p_bool_xor(Solver& s, FlatZincModel& m,
@@ -3803,6 +3504,8 @@ predicate global_cardinality_low_up(array[int] of var int: x,
         //Add here Mistral redefinitions of global constraints
         registry().add("distribute", &p_distribute);
         registry().add("all_different_int", &p_all_different);
+        registry().add("nvalue", &p_nvalue);
+        registry().add("mistral_bin_packing_load", &p_mistral_bin_packing_load);
         registry().add("all_equal_int", &p_all_equal_int);
         registry().add("at_most_int", &p_at_most_int);
         registry().add("exactly_int", &p_exactly_int);
@@ -3832,7 +3535,8 @@ predicate global_cardinality_low_up(array[int] of var int: x,
 
 
         registry().add("cumulative", &p_cumulative);
-        //registry().add("global_cardinality_low_up", p_global_cardinality_low_up);
+        registry().add("global_cardinality_low_up", &p_global_cardinality_low_up);
+        registry().add("global_cardinality", &p_global_cardinality);
 
         registry().add("bool2int", &p_bool2int);
 
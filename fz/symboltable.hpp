@@ -38,8 +38,9 @@
 #ifndef __GECODE_FLATZINC_SYMBOLTABLE_HH__
 #define __GECODE_FLATZINC_SYMBOLTABLE_HH__
 
-#include <map>
+#include <string>
 #include <vector>
+#include <unordered_map>
 
 namespace FlatZinc {
 
@@ -47,12 +48,14 @@ namespace FlatZinc {
   template<class Val>
   class SymbolTable {
   private:
-    std::map<std::string,Val> m;
+    std::unordered_map<std::string,Val> m;
   public:
     /// Insert \a val with \a key
     void put(const std::string& key, const Val& val);
     /// Return whether \a key exists, and set \a val if it does exist
     bool get(const std::string& key, Val& val) const;
+    /// Return the value of \a key without copying it, or NULL if it does not exist
+    const Val* find(const std::string& key) const;
   };
 
   template<class Val>
@@ -64,7 +67,7 @@ namespace FlatZinc {
   template<class Val>
   bool
   SymbolTable<Val>::get(const std::string& key, Val& val) const {
-    typename std::map<std::string,Val>::const_iterator i =
+    typename std::unordered_map<std::string,Val>::const_iterator i =
       m.find(key);
     if (i == m.end())
       return false;
@@ -72,6 +75,16 @@ namespace FlatZinc {
     return true;
   }
 
+  template<class Val>
+  const Val*
+  SymbolTable<Val>::find(const std::string& key) const {
+    typename std::unordered_map<std::string,Val>::const_iterator i =
+      m.find(key);
+    if (i == m.end())
+      return NULL;
+    return &(i->second);
+  }
+
 }
 #endif
 
@@ -368,6 +368,12 @@ public:
   virtual bool simple_rewritable() { return false; }
   virtual bool explained() { return false; }
   virtual RewritingOutcome rewrite() { return NO_EVENT; }
+  /// Appends the parameters that, together with the name and the scope,
+  /// identify the constraint; returns false if it cannot be compared
+  virtual bool get_signature(Vector<int> &key) const { return false; }
+  /// Called by the presolve at the root, after propagation: may tighten the
+  /// parameters and returns true if the constraint is entailed
+  virtual bool simplify() { return false; }
   virtual void consolidate() = 0;
   virtual void consolidate_var(const int idx) = 0;
 
@@ -1890,6 +1896,7 @@ public:
   virtual bool rewritable() { return true; }
   virtual bool simple_rewritable() { return true; }
   virtual RewritingOutcome rewrite();
+  virtual bool get_signature(Vector<int> &key) const { return true; }
   //@}
 
   /**@name Miscellaneous*/
@@ -1942,6 +1949,8 @@ public:
   }
   virtual bool rewritable() { return true; }
   virtual RewritingOutcome rewrite();
+  virtual bool get_signature(Vector<int> &key) const { return true; }
+  virtual bool simplify();
   //@}
 
   /**@name Miscellaneous*/
@@ -2365,6 +2374,11 @@ public:
   virtual PropagationOutcome propagate();
   virtual PropagationOutcome propagate(const int changed_idx, const Event evt);
   // virtual RewritingOutcome rewrite();
+  virtual bool get_signature(Vector<int> &key) const {
+    key.add(offset);
+    return true;
+  }
+  virtual bool simplify();
   //@}
 
   /**@name Miscellaneous*/
@@ -2815,6 +2829,122 @@ public:
   //@}
 };
 
+/**********************************************
+ * LexGAC Constraint
+ **********************************************/
+/*! \class ConstraintLexGAC
+\brief  GAC on x <=lex y (or x <lex y) for two vectors of length n
+
+The scope is x0..x{n-1} y0..y{n-1}. Two reversible pointers are kept:
+- alpha: every pair before alpha is ground and equal
+- beta: least index from which the suffix of min(x) is lex greater
+than (or equal to, when strict) the suffix of max(y), or n+1 if none.
+The constraint is GAC when x_alpha <= y_alpha, or x_alpha < y_alpha
+if alpha+1 = beta, and only the pair at alpha is ever pruned. Beta only
+moves down, over the pairs where min(x) = max(y), so a bound change
+costs O(1) amortised.
+*/
+class ConstraintLexGAC : public GlobalConstraint {
+
+public:
+  /**@name Parameters*/
+  //@{
+  int strict;
+  int length;
+
+  ReversibleNum<int> alpha;
+  ReversibleNum<int> beta;
+  //@}
+
+  /**@name Constructors*/
+  //@{
+  ConstraintLexGAC() : GlobalConstraint() { priority = 1; }
+  ConstraintLexGAC(Vector<Variable> &scp, const int st = 0);
+  virtual Constraint clone() {
+    return Constraint(new ConstraintLexGAC(scope, strict));
+  }
+  virtual void initialise();
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  virtual ~ConstraintLexGAC();
+  //@}
+
+  /**@name Solving*/
+  //@{
+  // -1, 0 or 1 whether min(x_i) is lower, equal or greater than max(y_i)
+  inline int order(const int i) const {
+    int a = scope[i].get_min(), b = scope[i + length].get_max();
+    return (a > b) - (a < b);
+  }
+  void update_beta(const int i);
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "lex"; }
+  //@}
+};
+
+/**********************************************
+ * LexChain Constraint
+ **********************************************/
+/*! \class ConstraintLexChain
+\brief  GAC on X0 <=lex X1 <=lex ... <=lex X{m-1} (or <lex) for m rows
+of length n, stored row by row in the scope.
+
+The lexicographically least feasible tuple of each row is computed from
+the least tuple of the previous row, and the greatest one from the
+greatest tuple of the next row (Carlsson & Beldiceanu). Each row is
+then filtered to be between these two tuples, which are both feasible.
+*/
+class ConstraintLexChain : public GlobalConstraint {
+
+public:
+  /**@name Parameters*/
+  //@{
+  int strict;
+  int length;
+  int num_rows;
+
+  // least and greatest feasible tuples of every row
+  Vector<int> lower;
+  Vector<int> upper;
+  //@}
+
+  /**@name Constructors*/
+  //@{
+  ConstraintLexChain() : GlobalConstraint() { priority = 0; }
+  ConstraintLexChain(Vector<Variable> &scp, const int n, const int st = 0);
+  virtual Constraint clone() {
+    return Constraint(new ConstraintLexChain(scope, length, strict));
+  }
+  virtual void initialise();
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  virtual ~ConstraintLexChain();
+  //@}
+
+  /**@name Solving*/
+  //@{
+  bool least_above(const int r, const int *prev, const int st);
+  bool greatest_below(const int r, const int *next, const int st);
+  PropagationOutcome filter_between(const int r);
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "lex_chain"; }
+  //@}
+};
+
 /**********************************************
  * Offset Predicate
  **********************************************/
@@ -4032,6 +4162,8 @@ public:
   int getpos(const int *vals) const;
   int getpos() const;
   bool isValid(const int *tuple) const;
+  // whether the tuples are supports (otherwise, conflicts)
+  bool isPositive() const { return spin; }
 
   /**@name Solving*/
   //@{
@@ -4155,6 +4287,12 @@ public:
   virtual PropagationOutcome propagate();
   virtual iterator get_reason_for(const Atom a, const int lvl, iterator &end);
   virtual void initialise_activity(double *lact, double *vact, double norm);
+  virtual bool get_signature(Vector<int> &key) const {
+    key.add(lower_bound);
+    key.add(upper_bound);
+    return true;
+  }
+  virtual bool simplify();
   //@}
 
   /**@name Miscellaneous*/
@@ -4550,6 +4688,98 @@ public:
   //@}
 };
 
+/**********************************************
+ * Knapsack Constraint
+ **********************************************/
+// above this number of states (items x capacity), the DP is not used
+#define KNAPSACK_DP_STATES 1048576
+/*! \class ConstraintKnapsack
+\brief  Knapsack constraint (p1 * x1 + ... + pn * xn = P subject to
+L <= w1 * x1 + ... + wn * xn <= U) with non-negative weights, profits and
+variables.
+
+When the capacity is small, values are filtered on the layered graph of
+Trick's algorithm: a state of layer i is a weight reachable with the
+first i items, labelled with the least and greatest profit of the paths
+reaching it. A value of xi is kept if an arc for this value joins a state
+of layer i, reachable from the source, to a state of layer i+1 from which
+a final weight in [L,U] is reachable, with profits compatible with the
+bounds of P. The bounds of P are tightened to the extreme profits.
+The states of each layer are a reversible set: the states that are not
+reachable, that reach no final weight, or whose paths cannot meet the
+bounds of P are removed until backtrack, and each propagation only visits
+the remaining states (the profit labels are computed on the way).
+
+Otherwise, the upper bound of the LP relaxation (Dantzig) is computed
+greedily, in the order of efficiency (profit/weight) sorted once, and the
+reduced costs with respect to the critical item bound the values of every
+item (this bounding step assumes U is the binding capacity).
+*/
+class ConstraintKnapsack : public GlobalConstraint {
+
+public:
+  /**@name Parameters*/
+  //@{
+  std::vector<int> weight;
+  std::vector<int> profit;
+  int lower_capacity;
+  int upper_capacity;
+
+  int num_items;
+  bool use_dp;
+
+  // items by decreasing efficiency
+  std::vector<int> order;
+
+  // the live states (weights) of each layer of the DP
+  ReversibleSet *layer;
+  // forward layers of the DP: least and greatest profit to each weight
+  int *forward_min;
+  int *forward_max;
+  // backward layers (current and next)
+  int *backward_min[2];
+  int *backward_max[2];
+  Vector<int> dead;
+  //@}
+
+  /**@name Constructors*/
+  //@{
+  ConstraintKnapsack() : GlobalConstraint() {
+    priority = 0;
+    layer = NULL;
+    forward_min = forward_max = NULL;
+    backward_min[0] = backward_min[1] = backward_max[0] = backward_max[1] =
+        NULL;
+  }
+  ConstraintKnapsack(Vector<Variable> &scp, const std::vector<int> &w,
+                     const std::vector<int> &p, const int L, const int U);
+  virtual Constraint clone() {
+    return Constraint(new ConstraintKnapsack(scope, weight, profit,
+                                             lower_capacity, upper_capacity));
+  }
+  virtual void initialise();
+  virtual void mark_domain();
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  virtual ~ConstraintKnapsack();
+  //@}
+
+  /**@name Solving*/
+  //@{
+  PropagationOutcome filter_dp();
+  PropagationOutcome filter_lp();
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "knapsack"; }
+  //@}
+};
+
 /**********************************************
  * WeightedSum Constraint
  **********************************************/
@@ -4616,6 +4846,8 @@ public:
 virtual int check(const int *sol) const;
 virtual PropagationOutcome propagate();
 virtual RewritingOutcome rewrite();
+virtual bool get_signature(Vector<int> &key) const;
+virtual bool simplify();
 //@}
 
 /**@name Miscellaneous*/
@@ -4625,6 +4857,90 @@ virtual std::string name() const { return "sum="; }
 //@}
 };
 
+/**********************************************
+ * Incremental WeightedSum Constraint
+ **********************************************/
+// scopes at least this long are posted as ConstraintIncrementalWeightedSum
+#define LONG_SUM_ARITY 32
+/*! \class ConstraintIncrementalWeightedSum
+\brief  Constraint on a long sum of variables (L <= a1 * x1 + ... + an * xn <= U)
+
+Bounds consistency, like PredicateWeightedSum but without the parity
+reasoning. The bounds of the sum are maintained incrementally: the last
+bounds seen for every term are cached, and each bound event only applies
+the difference to the running minimum and maximum of the sum. The cache
+is restored lazily on backtrack from an undo log whose size is
+reversible. The terms are sorted by decreasing initial span so that the
+pruning scan stops at the first term whose span fits within the slack.
+Coefficients, cached bounds and spans are stored as separate arrays.
+*/
+class ConstraintIncrementalWeightedSum : public GlobalConstraint {
+
+public:
+  /**@name Parameters*/
+  //@{
+  // Lower bound of the linear expression
+  int lower_bound;
+
+  // Upper bound of the linear expression
+  int upper_bound;
+
+  Vector<int> weight;
+
+  bool init_prop;
+
+  // utils for the propagation (one entry per term)
+  int *coef;
+  int *lo_bound;
+  int *up_bound;
+  // initial span, in decreasing order
+  int *span;
+
+  // running bounds of the sum, consistent with lo_bound and up_bound
+  long long sum_min;
+  long long sum_max;
+
+  // undo log of the cached bounds
+  Vector<int> undo_index;
+  Vector<int> undo_lo;
+  Vector<int> undo_up;
+  ReversibleNum<int> undo_size;
+  //@}
+
+  /**@name Constructors*/
+  //@{
+  ConstraintIncrementalWeightedSum() : GlobalConstraint() { priority = 1; }
+  ConstraintIncrementalWeightedSum(Vector<Variable> &scp, Vector<int> &coefs,
+                                   const int L = 0, const int U = 0);
+  virtual ~ConstraintIncrementalWeightedSum();
+  virtual Constraint clone() {
+    return Constraint(new ConstraintIncrementalWeightedSum(
+        scope, weight, lower_bound, upper_bound));
+  }
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  virtual void initialise();
+  virtual void mark_domain();
+  //@}
+
+  /**@name Solving*/
+  //@{
+  void undo();
+  void update(const int i);
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  virtual bool get_signature(Vector<int> &key) const;
+  virtual bool simplify();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "isum="; }
+  //@}
+};
+
 /**********************************************
  * Parity Constraint
  **********************************************/
@@ -4676,6 +4992,97 @@ public:
   //@}
 };
 
+/**********************************************
+ * Gauss-Jordan XOR System Constraint
+ **********************************************/
+/*! \class ConstraintXorSystem
+\brief  Conjunction of parity constraints on Boolean variables, propagated
+by Gauss-Jordan elimination.
+
+The rows (one per parity constraint) are stored as packed 64-bit words,
+one bit per column (variable), and kept in reduced row echelon form: each
+row has a basic column that appears in no other row. Row operations
+preserve the solutions, so the matrix is never restored on backtrack; only
+the packed masks of the assigned columns and of their values are, lazily,
+from an undo log whose size is reversible.
+
+A row with no unassigned column is a conflict if its parity is wrong, a
+row with one unassigned column implies its value. When the basic column
+of a row with at least two unassigned columns gets assigned, another
+unassigned column of the row becomes basic and is eliminated from the
+other rows. At fixpoint, every row with at least two unassigned columns
+has an unassigned basic column, hence no other value is implied by the
+system. The rows responsible for implications and conflicts are copied
+so that they can be used as explanations.
+*/
+class ConstraintXorSystem : public GlobalConstraint {
+
+public:
+  /**@name Parameters*/
+  //@{
+  // the input rows (indices in the scope) and their parities
+  std::vector<std::vector<int> > rows;
+  std::vector<int> parities;
+
+  int num_rows;
+  int num_words;
+
+  // matrix[r*num_words...]: packed row r, rhs[r]: its parity, basic[r]: its
+  // basic column
+  unsigned long long *matrix;
+  int *rhs;
+  int *basic;
+  bool inconsistent;
+
+  // packed masks of the assigned columns and of those assigned to 1
+  unsigned long long *assigned;
+  unsigned long long *value;
+  Vector<int> undo_column;
+  ReversibleNum<int> undo_size;
+  bool init_prop;
+
+  // explanations: the row that implied each column, the row of the conflict
+  unsigned long long *reason;
+  unsigned long long *conflict;
+  int min_id;
+  Vector<int> column_of;
+  Vector<Literal> explanation;
+  //@}
+
+  /**@name Constructors*/
+  //@{
+  ConstraintXorSystem(Vector<Variable> &scp,
+                      const std::vector<std::vector<int> > &rws,
+                      const std::vector<int> &prts);
+  virtual ~ConstraintXorSystem();
+  virtual Constraint clone() {
+    return Constraint(new ConstraintXorSystem(scope, rows, parities));
+  }
+  virtual bool explained() { return true; }
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  virtual void initialise();
+  //@}
+
+  virtual iterator get_reason_for(const Atom a, const int lvl, iterator &end);
+
+  /**@name Solving*/
+  //@{
+  void undo();
+  void update(const int i);
+  void pivot(const int r, const int c);
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "gauss"; }
+  //@}
+};
+
 /**********************************************
  * AtMostSeqCard Constraint
  **********************************************/
@@ -4730,6 +5137,9 @@ public:
   //@}
 
   virtual iterator get_reason_for(const Atom a, const int lvl, iterator &end);
+  // the assigned variables of scp, before a (naive explanation)
+  static void naive_reason(Vector<Variable> &scp, Solver *sol, const Atom a,
+                           Vector<Literal> &expl);
   void greedy_assign_for_explanation(Vector<Variable> &X, int __size,
                                      int __rank);
   void set_max_equal_to_p_at_rank(int __rank, int __size, Vector<Variable> &X);
@@ -4801,6 +5211,101 @@ public:
                                             int index_a);
 };
 
+/**********************************************
+ * Sequence Constraint
+ **********************************************/
+/*! \class ConstraintSequence
+\brief  Sequence(lo, hi, q, x, values): every window of q consecutive
+variables of x takes between lo and hi values of 'values'.
+
+With y_i = (x_i in values) and the prefix sums S_0 = 0, S_{i+1} = S_i +
+y_i, the constraint is a system of difference constraints on S (Brand
+et al.). The greatest solution S = sum, i.e., the shortest paths from
+S_0, is kept in a reversible array and repaired by relaxation from the
+end points of the y_i that changed, which also detects inconsistency.
+The constraint is then made domain consistent in one pass: y_i is
+entailed iff S_i and S_{i+1} belong to the same strongly connected
+component of the tight edges (null reduced cost) with respect to sum.
+
+On Boolean scopes, the explanations are the naive explanations of
+ConstraintMultiAtMostSeqCard.
+*/
+class ConstraintSequence : public GlobalConstraint {
+
+public:
+  /**@name Parameters*/
+  //@{
+  int lower_bound;
+  int upper_bound;
+  int window;
+  std::vector<int> values;
+  bool boolean;
+
+  // the greatest prefix sums, with a log to undo their changes
+  int *sum;
+  Vector<int> undo_node;
+  Vector<int> undo_value;
+  ReversibleNum<int> undo_size;
+
+  // bounds of y_i
+  int *y_min;
+  int *y_max;
+
+  // relaxation queue (circular)
+  int *queue;
+  bool *queued;
+  int head;
+  int tail;
+
+  // Tarjan's algorithm on the tight edges
+  int *index;
+  int *lowlink;
+  int *component;
+  int *stack;
+  int *call_node;
+  int *call_next;
+
+  Vector<Literal> explanation;
+  //@}
+
+  /**@name Constructors*/
+  //@{
+  ConstraintSequence() : GlobalConstraint() { priority = 1; }
+  ConstraintSequence(Vector<Variable> &scp, const int lo, const int hi,
+                     const int q, const std::vector<int> &vals);
+  virtual Constraint clone() {
+    return Constraint(new ConstraintSequence(scope, lower_bound, upper_bound,
+                                             window, values));
+  }
+  virtual void initialise();
+  virtual bool explained() { return boolean; }
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  virtual ~ConstraintSequence();
+  //@}
+
+  virtual iterator get_reason_for(const Atom a, const int lvl, iterator &end);
+
+  /**@name Solving*/
+  //@{
+  void undo();
+  void set_y_bounds(const int i);
+  void push(const int node);
+  bool relax();
+  int successor(const int node, int &cursor);
+  void strongly_connected_components();
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "sequence"; }
+  //@}
+};
+
 /**********************************************
  * Stretch Constraint
  **********************************************/
@@ -5117,6 +5622,182 @@ public:
   //@}
 };
 
+/**********************************************
+ * IntElement Constraint
+ **********************************************/
+/*! \class ConstraintIntElement
+\brief  Element constraint on an array of integers (T[X - offset] = Y)
+
+The scope is {X, Y}. Domain consistency is maintained with one support
+counter per value of T: the number of indices in the domain of X that map
+to it. An index is killed when it leaves the domain of X or when its value
+leaves the domain of Y, and a value whose counter drops to zero is removed
+from Y. The removals are detected against two reversible sets mirroring
+the domains, and the killed indices are kept in an undo log whose size is
+reversible, so that the counters are restored lazily on backtrack.
+*/
+class ConstraintIntElement : public GlobalConstraint {
+
+public:
+  /**@name Parameters*/
+  //@{
+  std::vector<int> table;
+  int offset;
+
+  // distinct values of the table, in increasing order
+  Vector<int> values;
+  // rank[i] is the index of table[i] in values
+  int *rank;
+  // the indices of the table with value values[v] are
+  // index_of[first[v]] ... index_of[first[v+1]-1]
+  int *first;
+  int *index_of;
+
+  // number of alive indices for each value
+  int *count;
+  char *alive;
+
+  // mirrors of the domains of X (indices) and Y (ranks of values)
+  ReversibleSet index_set;
+  ReversibleSet value_set;
+
+  // undo log of the killed indices
+  Vector<int> killed;
+  ReversibleNum<int> num_killed;
+
+  bool init_prop;
+  //@}
+
+  /**@name Constructors*/
+  //@{
+  ConstraintIntElement() : GlobalConstraint() {
+    priority = 1;
+    rank = first = index_of = count = NULL;
+    alive = NULL;
+  }
+  ConstraintIntElement(Vector<Variable> &scp, const std::vector<int> &tab,
+                       const int o = 0);
+  virtual ~ConstraintIntElement();
+  virtual Constraint clone() {
+    return Constraint(new ConstraintIntElement(scope, table, offset));
+  }
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  virtual void initialise();
+  virtual void mark_domain();
+  //@}
+
+  /**@name Solving*/
+  //@{
+  void undo();
+  int kill(const int i);
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "int[x]="; }
+  //@}
+};
+
+/**********************************************
+ * Element2D Constraint
+ **********************************************/
+/*! \class ConstraintElement2D
+\brief  Element constraint on a matrix of integers
+(M[R - row_offset][C - col_offset] = Z)
+
+The scope is {R, C, Z}. Domain consistency is maintained with support
+counters on the cells of the matrix: a cell is alive while its row, its
+column and its value are in the domains of R, C and Z, and every row,
+column and value counts its alive cells. Killing a cell decrements three
+counters, and a row, column or value whose counter drops to zero is
+removed. As in ConstraintIntElement, removals are detected against
+reversible mirrors of the domains and the counters are restored lazily
+from an undo log of the killed cells.
+*/
+class ConstraintElement2D : public GlobalConstraint {
+
+public:
+  /**@name Parameters*/
+  //@{
+  int num_rows;
+  int num_cols;
+  int row_offset;
+  int col_offset;
+  // the matrix, row by row
+  std::vector<int> matrix;
+
+  // distinct values of the matrix, in increasing order
+  Vector<int> values;
+  // rank[k] is the index of matrix[k] in values
+  int *rank;
+  // the cells with value values[v] are cell_of[first[v]] ...
+  // cell_of[first[v+1]-1]
+  int *first;
+  int *cell_of;
+
+  // number of alive cells for each row, column and value
+  int *row_count;
+  int *col_count;
+  int *value_count;
+  char *alive;
+
+  // mirrors of the domains of R, C and Z (ranks of values)
+  ReversibleSet row_set;
+  ReversibleSet col_set;
+  ReversibleSet value_set;
+
+  // undo log of the killed cells
+  Vector<int> killed;
+  ReversibleNum<int> num_killed;
+
+  bool init_prop;
+  //@}
+
+  /**@name Constructors*/
+  //@{
+  ConstraintElement2D() : GlobalConstraint() {
+    priority = 1;
+    rank = first = cell_of = row_count = col_count = value_count = NULL;
+    alive = NULL;
+  }
+  ConstraintElement2D(Vector<Variable> &scp,
+                      const std::vector<std::vector<int> > &M,
+                      const int ro = 0, const int co = 0);
+  ConstraintElement2D(Vector<Variable> &scp, const int nr, const int nc,
+                      const std::vector<int> &M, const int ro = 0,
+                      const int co = 0);
+  virtual ~ConstraintElement2D();
+  virtual Constraint clone() {
+    return Constraint(new ConstraintElement2D(scope, num_rows, num_cols, matrix,
+                                              row_offset, col_offset));
+  }
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  virtual void initialise();
+  virtual void mark_domain();
+  //@}
+
+  /**@name Solving*/
+  //@{
+  void undo();
+  int kill(const int k);
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "int[x][y]="; }
+  //@}
+};
+
 /**********************************************
  * BoolElement Predicate
  **********************************************/
@@ -5327,6 +6008,218 @@ public:
 #endif
 };
 
+/***********************************************
+ * All Different Constraint (domain consistency).
+ ***********************************************/
+/*! \class ConstraintAllDiffGAC
+\brief  AllDifferent Constraint (domain consistency).
+
+Constraint of difference on a set of variables, filtered with Regin's
+algorithm. The maximum matching between variables and values is kept
+across calls and backtracks (a matching remains valid when domains grow
+back), and is only repaired by augmenting paths for the variables whose
+matched value was pruned. Unsupported edges are then found with Tarjan's
+SCC algorithm on the residual graph, where a sink node links the free
+values back to the matched ones.
+*/
+class ConstraintAllDiffGAC : public GlobalConstraint {
+
+private:
+  /**@name Parameters*/
+  //@{
+  int offset;
+  int num_values;
+
+  // matched value of each variable (NOVAL if none), and matched variable of
+  // each value (-1 if none)
+  int *match_var;
+  int *match_val;
+  int num_free_values;
+
+  // augmenting paths
+  int *parent;
+  int *visited;
+  int stamp;
+  Vector<int> frontier;
+
+  // Tarjan's SCC, nodes are variables [0,n), values [n,n+d) and the sink
+  int *index;
+  int *lowlink;
+  int *component;
+  int *stack;
+  int *call_node;
+  int *call_next;
+  Vector<int> pruned;
+
+  int successor(const int node, int &cursor);
+  bool augment(const int x);
+  void strongly_connected_components();
+  //@}
+
+public:
+  /**@name Constructors*/
+  //@{
+  ConstraintAllDiffGAC() : GlobalConstraint() { priority = 0; }
+  ConstraintAllDiffGAC(Vector<Variable> &scp);
+  ConstraintAllDiffGAC(std::vector<Variable> &scp);
+  virtual void mark_domain();
+  virtual Constraint clone() {
+    return Constraint(new ConstraintAllDiffGAC(scope));
+  }
+  virtual void initialise();
+  virtual ~ConstraintAllDiffGAC();
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  //@}
+
+  /**@name Solving*/
+  //@{
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "alldiff"; }
+  //@}
+};
+
+/***********************************************
+ * NValue Constraint.
+ ***********************************************/
+/*! \class ConstraintNValue
+\brief  NValue Constraint: N = |{x1, ..., xn}| (N is the last variable).
+
+The lower bound of N is the size of a maximum set of pairwise disjoint
+intervals, computed greedily on the variables sorted by upper bound (any
+value assignment needs at least one value per such interval). The upper
+bound is the number of distinct values already used plus the number of
+unassigned variables, capped by the size of the union of the domains.
+Once either bound is tight, the unassigned variables are restricted to the
+used values (N's upper bound) or to the unused ones (N's lower bound).
+*/
+class ConstraintNValue : public GlobalConstraint {
+
+private:
+  /**@name Parameters*/
+  //@{
+  int offset;
+  int num_values;
+
+  // values of the union / of the assigned variables, marked with timestamps
+  int *union_stamp;
+  int *used_stamp;
+  int stamp;
+
+  Vector<int> order;
+  Vector<int> used;
+  Vector<int> pruned;
+  //@}
+
+public:
+  /**@name Constructors*/
+  //@{
+  ConstraintNValue() : GlobalConstraint() { priority = 1; }
+  ConstraintNValue(Vector<Variable> &scp);
+  virtual Constraint clone() {
+    return Constraint(new ConstraintNValue(scope));
+  }
+  virtual void initialise();
+  virtual void mark_domain();
+  virtual ~ConstraintNValue();
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  //@}
+
+  /**@name Solving*/
+  //@{
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "nvalue"; }
+  //@}
+};
+
+/***********************************************
+ * BinPacking Constraint.
+ ***********************************************/
+/*! \class ConstraintBinPacking
+\brief  BinPacking Constraint (Shaw 2004).
+
+The scope is made of the item variables x1, ..., xn, whose values are bin
+indices starting at 'first_bin', followed by one load variable per bin.
+The load of a bin is the sum of the sizes of the items packed into it.
+The filtering uses the packed and candidate items of every bin, the total
+size, knapsack reasoning on each bin (no subset of the candidate sizes
+can reach the load interval, see no_sum()) and the L2 lower bound of
+Martello and Toth on the number of bins.
+*/
+class ConstraintBinPacking : public GlobalConstraint {
+
+private:
+  /**@name Parameters*/
+  //@{
+  int num_items;
+  int num_bins;
+  int first_bin;
+  int total_size;
+  std::vector<int> size;
+
+  // items by non-increasing size
+  Vector<int> order;
+
+  // per bin: load of the packed items, total size and sizes (non-increasing)
+  // of the candidate items
+  Vector<int> required;
+  Vector<int> possible;
+  Vector<Vector<int> > candidate;
+
+  Vector<int> bins;
+  Vector<int> items;
+  Vector<int> partial_sum;
+
+  bool no_sum(const Vector<int> &X, const int sum, const int alpha,
+              const int beta, int &alpha_p, int &beta_p) const;
+  int lower_bound_L2(const int capacity);
+  //@}
+
+public:
+  /**@name Constructors*/
+  //@{
+  ConstraintBinPacking() : GlobalConstraint() { priority = 0; }
+  ConstraintBinPacking(Vector<Variable> &scp, const std::vector<int> &sizes,
+                       const int first = 0);
+  virtual Constraint clone() {
+    return Constraint(new ConstraintBinPacking(scope, size, first_bin));
+  }
+  virtual void initialise();
+  virtual void mark_domain();
+  virtual ~ConstraintBinPacking();
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  //@}
+
+  /**@name Solving*/
+  //@{
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "binpacking"; }
+  //@}
+};
+
 /***********************************************
  * Global Cardinality Constraint (bounds consistency).
  ***********************************************/
@@ -5443,6 +6336,118 @@ public:
   //@}
 };
 
+/***********************************************
+ * Global Cardinality Constraint (domain consistency).
+ ***********************************************/
+/*! \class ConstraintGccGAC
+\brief  Global Cardinality Constraint (domain consistency).
+
+Each value v of 'values' must be taken by between lb(v) and ub(v) of the
+variables x1, ..., xn; other values are unconstrained. The bounds are
+either given as constants, or are the bounds of occurrence variables
+appended to the scope after x1, ..., xn (one per value of 'values').
+
+The variables are filtered with Regin's flow algorithm. A feasible flow
+(each variable assigned to one value, each value used within its bounds)
+is kept across calls and backtracks and only repaired: variables whose
+value was pruned are reassigned along augmenting paths, then the values
+used less than their lower bound pull variables from values used more
+than theirs. Unsupported edges are found with Tarjan's SCC algorithm on
+the residual graph, where a sink links the values that can be used more
+to those that can be used less. The occurrence variables are bounded by
+the least and greatest use of their value over all feasible flows, found
+by moving the flow along alternating paths to and from the value. This may
+in turn change the bounds on the use of the values, so the filtering is
+repeated until a fixpoint is reached.
+*/
+class ConstraintGccGAC : public GlobalConstraint {
+
+private:
+  /**@name Parameters*/
+  //@{
+  int num_vars;
+  std::vector<int> values;
+  std::vector<int> lower_bound;
+  std::vector<int> upper_bound;
+  bool variable_occurrences;
+
+  int offset;
+  int num_values;
+
+  // bounds on the use of each value in [offset, offset+num_values)
+  int *lower;
+  int *upper;
+  // index of each value in 'values', -1 if unconstrained
+  int *rank;
+
+  // flow: value of each variable (NOVAL if none), number of variables and
+  // list of the variables bound to each value
+  int *match_var;
+  int *flow;
+  int *head;
+  int *next_var;
+  int *prev_var;
+
+  // augmenting paths
+  int *parent;
+  int *parent_val;
+  int *visited;
+  int stamp;
+  Vector<int> frontier;
+
+  // Tarjan's SCC, nodes are variables [0,n), values [n,n+d) and the sink
+  int *index;
+  int *lowlink;
+  int *component;
+  int *stack;
+  int *call_node;
+  int *call_next;
+  Vector<int> pruned;
+
+  void assign(const int x, const int w);
+  void unassign(const int x);
+  bool augment(const int x);
+  bool fill(const int w);
+  bool release(const int w);
+  int successor(const int node, int &cursor);
+  void strongly_connected_components();
+  void new_stamp();
+  //@}
+
+public:
+  /**@name Constructors*/
+  //@{
+  ConstraintGccGAC() : GlobalConstraint() { priority = 0; }
+  ConstraintGccGAC(Vector<Variable> &scp, const std::vector<int> &vals,
+                   const std::vector<int> &lbs, const std::vector<int> &ubs);
+  ConstraintGccGAC(Vector<Variable> &scp, const std::vector<int> &vals);
+  virtual void mark_domain();
+  virtual Constraint clone() {
+    if (variable_occurrences)
+      return Constraint(new ConstraintGccGAC(scope, values));
+    return Constraint(
+        new ConstraintGccGAC(scope, values, lower_bound, upper_bound));
+  }
+  virtual void initialise();
+  virtual ~ConstraintGccGAC();
+  virtual int idempotent() { return 1; }
+  virtual int postponed() { return 1; }
+  virtual int pushed() { return 1; }
+  //@}
+
+  /**@name Solving*/
+  //@{
+  virtual int check(const int *sol) const;
+  virtual PropagationOutcome propagate();
+  //@}
+
+  /**@name Miscellaneous*/
+  //@{
+  virtual std::ostream &display(std::ostream &) const;
+  virtual std::string name() const { return "gcc"; }
+  //@}
+};
+
 /***********************************************
  * NoOverlap Constraint (overload check only).
  ***********************************************/
@@ -29,6 +29,8 @@
 #define _MISTRAL_GLOBAL_HPP
 
 #include <stdint.h>
+#include <cstdio>
+#include <cstring>
 
 #include <string>
 #include <iostream>
@@ -175,6 +177,8 @@ namespace Mistral {
 
 #define BOUND_CONSISTENCY 1
 #define FORWARD_CHECKING 0
+#define DOMAIN_CONSISTENCY 2
+#define AUTO_CONSISTENCY 3
 
 #define CONST_VAR   1
 #define BOOL_VAR    2
@@ -452,6 +456,164 @@ namespace Mistral {
   unsigned long int get_memory();
   void get_command_line(const char**,int*,int,const char**,const char**,int,char**,int);
 
+
+  /**********************************************
+   * Input scanner
+   *********************************************/
+  /*! \class InputScanner
+    \brief Fast tokenizer for the instance readers (DIMACS, OPB, ...)
+
+    Plain files are memory-mapped and scanned in place. Files compressed
+    with gzip or xz (recognised by their magic number) are piped through
+    the system decoder and scanned from a window refilled on demand, so
+    they are never decompressed to disk nor held entirely in memory.
+  */
+  class InputScanner {
+
+  public:
+
+    /*!@name Constructors*/
+    //@{
+    InputScanner();
+    InputScanner(const char* filename);
+    virtual ~InputScanner();
+
+    // returns false if the file could not be opened
+    bool open(const char* filename);
+    void close();
+    //@}
+
+    /*!@name Accessors*/
+    //@{
+    inline bool good() const { return status >= 0; }
+
+    // next character, or EOF
+    inline int peek() {
+      if(cursor == end && !refill()) return EOF;
+      return (unsigned char)(*cursor);
+    }
+    inline int get() {
+      if(cursor == end && !refill()) return EOF;
+      return (unsigned char)(*cursor++);
+    }
+
+    // skip white spaces (including new lines)
+    inline void skip_blanks() {
+      int c;
+      while((c = peek()) != EOF && (c == ' ' || (c >= '\t' && c <= '\r'))) ++cursor;
+    }
+
+    // skip up to and including the next new line
+    void skip_line();
+
+    // skip blanks, then parse an optionally signed decimal integer
+    // returns false (without consuming anything but blanks) if there is none
+    bool read_int(int& x);
+    bool read_long(long long& x);
+
+    // read a word and parse it as a floating point number
+    bool read_double(double& x);
+
+    // skip blanks, then read a maximal sequence of non-blank characters
+    bool read_word(std::string& word);
+
+    // skip blanks, then consume 'word' if it comes next
+    bool match(const char* word);
+
+    inline bool eof() { skip_blanks(); return peek() == EOF; }
+    //@}
+
+  private:
+
+    // [cursor, end) is the part of the window not yet scanned
+    const char* cursor;
+    const char* end;
+
+    // -1: closed, 0: memory-mapped (or empty) file, 1: stream (pipe)
+    int status;
+
+    char* mapped;
+    size_t mapped_size;
+
+    int fd;
+    int decoder;
+    char* window;
+
+    bool refill();
+  };
+
+
+  /**********************************************
+   * Solution writer
+   *********************************************/
+  /*! \class SolutionWriter
+    \brief Buffered output of the solutions
+
+    Text is accumulated in a local buffer (integers are formatted by hand)
+    and handed to the stream in one write per solution, or whenever the
+    buffer is full. The stream is flushed once every 'period' solutions
+    (never when 'period' is 0, i.e., only when its own buffer is full or at
+    exit).
+
+    In binary mode, a solution is a 32 bits count n followed by n 32 bits
+    values, in native byte order.
+  */
+  class SolutionWriter {
+
+  public:
+
+    /*!@name Constructors*/
+    //@{
+    SolutionWriter(std::ostream& os, const int period=1);
+    virtual ~SolutionWriter();
+    //@}
+
+    /*!@name Text output*/
+    //@{
+    inline void put(const char c) {
+      if(cursor == limit) drain();
+      *cursor++ = c;
+    }
+    void write(const char* s, const size_t l);
+    void write_int(long long x);
+
+    inline SolutionWriter& operator<<(const char c) { put(c); return *this; }
+    inline SolutionWriter& operator<<(const char* s) { write(s, strlen(s)); return *this; }
+    inline SolutionWriter& operator<<(const std::string& s) { write(s.data(), s.size()); return *this; }
+    inline SolutionWriter& operator<<(const int x) { write_int(x); return *this; }
+    inline SolutionWriter& operator<<(const long x) { write_int(x); return *this; }
+    inline SolutionWriter& operator<<(const long long x) { write_int(x); return *this; }
+    inline SolutionWriter& operator<<(const unsigned int x) { write_int(x); return *this; }
+    //@}
+
+    /*!@name Binary output*/
+    //@{
+    void write_binary(const int* values, const int n);
+    //@}
+
+    /*!@name Flush policy*/
+    //@{
+    // hands the pending output to the stream, and flushes it if due
+    void end_solution();
+    // hands the pending output to the stream and flushes it
+    void flush();
+    inline void set_flush_period(const int p) { period = p; }
+    //@}
+
+  private:
+
+    std::ostream* os;
+    int period;
+    unsigned long count;
+
+    // [buffer, cursor) is pending
+    char* buffer;
+    char* cursor;
+    char* limit;
+
+    void drain();
+  };
+
   template <class WORD_TYPE>
   void print_bitset(WORD_TYPE n, const int idx, std::ostream& os) {
     int offset = 8*sizeof(WORD_TYPE)*idx;
@@ -104,6 +104,103 @@ namespace Mistral {
   void print_clause(std::ostream& o, Clause* cl) ;
   void print_literal(std::ostream& o, Literal l, bool dir=true) ;
 
+
+  /***********************************************
+   * SatPreprocessor
+   ***********************************************/
+  /*! \class SatPreprocessor
+    \brief Simplification of a clause set before it is loaded.
+
+    Runs unit propagation, pure literal detection, equivalent literal
+    substitution (SCCs of the binary implication graph), bounded variable
+    elimination and blocked clause elimination. Frozen atoms are shared
+    with other constraints and are never eliminated. Every removed clause
+    is pushed on an elimination stack together with a witness literal, so
+    that extend() can turn a model of the simplified formula into a model
+    of the original one.
+  */
+  class SatPreprocessor {
+
+  public:
+    /**@name Parameters*/
+    //@{
+    int num_atoms;
+    bool unsat;
+    /// only use techniques that preserve the set of models (units and
+    /// equivalences), for instance when all solutions are requested
+    bool preserve_models;
+
+    /// clause set, clauses are never moved, only marked as removed
+    std::vector< std::vector< Literal > > clauses;
+    std::vector< bool > removed;
+    /// for each literal, the indices of the clauses it (may) appear in
+    std::vector< std::vector< int > > occurrences;
+
+    /// root value of each atom (-1 if unknown)
+    std::vector< int > value;
+    std::vector< bool > frozen;
+    std::vector< bool > eliminated;
+
+    /// elimination stack, in order of removal
+    std::vector< Literal > witness;
+    std::vector< std::vector< Literal > > removed_clauses;
+
+    /// bounds for variable elimination
+    unsigned int max_occurrences;
+    unsigned int max_resolvent_size;
+
+    /// statistics
+    int num_units;
+    int num_pures;
+    int num_equivalences;
+    int num_eliminated;
+    int num_blocked;
+    //@}
+
+    /**@name Constructors*/
+    //@{
+    SatPreprocessor(const int n);
+    virtual ~SatPreprocessor() {}
+
+    void freeze(const Atom a) { frozen[a] = true; }
+    void add(Vector< Literal >& clause);
+    //@}
+
+    /**@name Simplification*/
+    //@{
+    /// run all the techniques to a fixpoint, returns false if UNSAT
+    bool simplify(const int max_rounds=3);
+    bool propagate_units();
+    int eliminate_pure_literals();
+    bool substitute_equivalences();
+    bool eliminate_variables();
+    int eliminate_blocked_clauses();
+    //@}
+
+    /**@name Model reconstruction*/
+    //@{
+    /// model[a] is the value (0/1) of atom a, eliminated atoms are overwritten
+    void extend(int *model) const;
+    //@}
+
+    /**@name Miscellaneous*/
+    //@{
+    unsigned int size() const;
+    std::ostream& display(std::ostream& os) const;
+    //@}
+
+  private:
+    std::vector< Literal > unit_queue;
+    std::vector< int > mark;
+
+    void build_occurrences();
+    void remove_clause(const int i, const Literal w);
+    int add_clause(std::vector< Literal >& clause);
+    bool is_satisfied(const std::vector< Literal >& clause, const int *model) const;
+    bool resolve(const std::vector< Literal >& c1, const std::vector< Literal >& c2,
+		 const Atom a, std::vector< Literal >& res);
+  };
+
   class RestartPolicy;
 
   class SatSolver 
@@ -186,6 +283,8 @@ namespace Mistral {
     SolverParameters params;
     /// Restart
     RestartPolicy *restart_policy;
+    /// Clause simplification (NULL if params.preprocess is off)
+    SatPreprocessor *preprocessor;
     //@}
 
 
@@ -299,11 +398,20 @@ namespace Mistral {
     Vector< Clause* > learnt;
     // the watched literals data structure
     Vector< Vector< Clause* > > is_watched_by;
+    // binary clauses are not watched, instead for each literal p,
+    // implied_by[p] lists the literals q such that (p v q) is a clause 
+    Vector< Vector< Literal > > implied_by;
+    // scratch clauses used to explain binary propagations/conflicts
+    Clause* binary_conflict;
+    Literal binary_reason[2];
+    // memory blocks holding the clauses loaded in bulk, see add_clauses()
+    Vector< char* > arena_begin;
+    Vector< char* > arena_end;
     //@}
     
     /**@name Constructors*/
     //@{
-    ConstraintClauseBase() : GlobalConstraint() { conflict = NULL; }
+    ConstraintClauseBase() : GlobalConstraint() { conflict = NULL; binary_conflict = NULL; }
     ConstraintClauseBase(Vector< Variable >& scp);
     virtual void mark_domain();
     virtual Constraint clone() { return Constraint(new ConstraintClauseBase(scope), type); }
@@ -316,8 +424,13 @@ namespace Mistral {
     virtual bool explained() { return true; }
     void add( Variable x );
     void add( Vector < Literal >& clause, double init_activity=0.0 );
+    // add the clauses literals[start[i]..start[i+1]) in one go: the watch
+    // lists are sized beforehand and the clauses share a single allocation
+    void add_clauses( Vector < Literal >& literals, Vector < unsigned int >& start );
     void learn( Vector < Literal >& clause, double init_activity=0.0 );
     void remove( const int cidx );
+    // whether the clause is the reason of its first literal
+    bool is_locked( Clause *clause );
     //void forget( const double forgetfulness, const Vector< double >& activity );
     // (returns the toal removed size)
     int forget( const double forgetfulness, const double * vactivity, const double * lactivity );
@@ -329,14 +442,31 @@ namespace Mistral {
     virtual PropagationOutcome propagate();
     //virtual PropagationOutcome propagate(const int changed_idx, const Event evt) { return CONSISTENT; }
     Clause* update_watcher(const int cw, const Literal p, PropagationOutcome& o);
+    Clause* propagate_binary(const Literal p, PropagationOutcome& o);
     //virtual PropagationOutcome rewrite();
     //@}
 
+    // a binary reason is stored inline in 'reason_for': the other literal 
+    // of the clause, shifted and tagged with the lowest bit
+    static inline Clause* binary_explanation(const Literal p) { return (Clause*)((((size_t)p)<<1)|1); }
+    static inline bool is_binary_explanation(const Clause* cl) { return ((size_t)cl)&1; }
+    static inline Literal get_binary_literal(const Clause* cl) { return (Literal)(((size_t)cl)>>1); }
+
+    // a failure is charged to the variables of the falsified clause only
+    virtual double weight_conflict(double unit, Vector<double>& weights);
+    virtual bool conflict_is_explained() { return true; }
+
 
     // virtual Explanation::iterator begin(Atom a) { return (a == NULL_ATOM ? conflict->begin(a) : reason_for[a]->begin(a)); }
     // virtual Explanation::iterator end  (Atom a) { return (a == NULL_ATOM ? conflict->end(a)   : reason_for[a]->end(a));   }
 
     virtual iterator get_reason_for(const Atom a, const int lvl, iterator& end) { 
+      if(a != NULL_ATOM && is_binary_explanation(reason_for[a])) {
+	binary_reason[0] = 2*a+scope[a].get_min();
+	binary_reason[1] = get_binary_literal(reason_for[a]);
+	end = binary_reason+2;
+	return binary_reason;
+      }
       return(a == NULL_ATOM ? conflict->get_reason_for(a, lvl, end) : reason_for[a]->get_reason_for(a, lvl, end));
     }
 
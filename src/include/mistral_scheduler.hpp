@@ -214,12 +214,18 @@ public:
   std::ostream &print(std::ostream &os);
 };
 
-class pair_ {
+// a row of a compressed adjacency, i.e., the indices in [begin(), end())
+class IndexRange {
 public:
-  int element;
-  int rank;
+  const int *first;
+  const int *last;
 
-  pair_(const int elt, const int rk) : element(elt), rank(rk) {}
+  IndexRange(const int *f, const int *l) : first(f), last(l) {}
+
+  const int *begin() const { return first; }
+  const int *end() const { return last; }
+  int size() const { return last - first; }
+  int operator[](const int i) const { return first[i]; }
 };
 
 struct Term {
@@ -236,17 +242,32 @@ public:
   std::vector<int> dtp_weights;
 
 private:
-  std::vector<std::vector<int>> tasks_in_job;
-  std::vector<std::vector<int>> jobs_of_task;
-  std::vector<std::vector<int>> tasks_in_machine;
-  std::vector<std::vector<int>> machines_of_task;
+  // job/machine to task and task to job/machine adjacencies, in compressed
+  // sparse row form, e.g., the tasks of job j are
+  // job_task[job_start[j]], ..., job_task[job_start[j+1]-1] in this order,
+  // and task_job_rank[k] is the rank of task i in job task_job[k], for
+  // k in [task_job_start[i], task_job_start[i+1])
+  std::vector<int> job_start;
+  std::vector<int> job_task;
+  std::vector<int> task_job_start;
+  std::vector<int> task_job;
+  std::vector<int> task_job_rank;
+
+  std::vector<int> machine_start;
+  std::vector<int> machine_task;
+  std::vector<int> task_machine_start;
+  std::vector<int> task_machine;
+  std::vector<int> task_machine_rank;
+
+  // (task, job) and (task, machine) pairs, in the order they are read,
+  // compiled into the arrays above once the whole file is read
+  std::vector<int> job_pairs;
+  std::vector<int> machine_pairs;
+
   std::vector<int> duration;
   std::vector<int> release_date;
   std::vector<int> due_date;
 
-  std::vector<std::vector<pair_>> task_rank_in_machine;
-  std::vector<std::vector<pair_>> task_rank_in_job;
-
   int ***setup_time;
   int **time_lag[2];
   int *jsp_duedate;
@@ -272,28 +293,21 @@ private:
   void dtp_readData(const char *filename);
   void dyn_readData(const char *filename, const int p);
 
+  void compile_adjacency();
+
   int get_machine_rank(const int ti, const int mj) const {
-    int rk = -1, mc;
-    for (unsigned int i = 0; i < task_rank_in_machine[ti].size(); ++i) {
-      mc = task_rank_in_machine[ti][i].element;
-      if (mc == mj) {
-        rk = task_rank_in_machine[ti][i].rank;
-        break;
-      }
-    }
-    return rk;
+    // the task's own row, with a single entry in most formats
+    for (int k = task_machine_start[ti]; k < task_machine_start[ti + 1]; ++k)
+      if (task_machine[k] == mj)
+        return task_machine_rank[k];
+    return -1;
   }
 
   int get_job_rank(const int ti, const int jj) const {
-    int rk = -1, jb;
-    for (unsigned int i = 0; i < task_rank_in_job[ti].size(); ++i) {
-      jb = task_rank_in_job[ti][i].element;
-      if (jb == jj) {
-        rk = task_rank_in_job[ti][i].rank;
-        break;
-      }
-    }
-    return rk;
+    for (int k = task_job_start[ti]; k < task_job_start[ti + 1]; ++k)
+      if (task_job[k] == jj)
+        return task_job_rank[k];
+    return -1;
   }
 
 public:
@@ -304,41 +318,53 @@ public:
 
   std::ostream &print(std::ostream &os);
 
-  int nJobs() const { return tasks_in_job.size(); }
-  int nJobs(const int i) const { return jobs_of_task[i].size(); }
+  int nJobs() const { return job_start.size() - 1; }
+  int nJobs(const int i) const {
+    return task_job_start[i + 1] - task_job_start[i];
+  }
 
-  int nMachines() const { return tasks_in_machine.size(); }
-  int nMachines(const int i) const { return machines_of_task[i].size(); }
+  int nMachines() const { return machine_start.size() - 1; }
+  int nMachines(const int i) const {
+    return task_machine_start[i + 1] - task_machine_start[i];
+  }
 
   int nTasks() const { return duration.size(); }
-  int nTasksInJob(const int j) const { return tasks_in_job[j].size(); }
-  int nTasksInMachine(const int j) const { return tasks_in_machine[j].size(); }
+  int nTasksInJob(const int j) const {
+    return job_start[j + 1] - job_start[j];
+  }
+  int nTasksInMachine(const int j) const {
+    return machine_start[j + 1] - machine_start[j];
+  }
 
-  const std::vector<int> &getTasksOfJob(const int i) const {
-    return tasks_in_job[i];
+  IndexRange getTasksOfJob(const int i) const {
+    return IndexRange(job_task.data() + job_start[i],
+                      job_task.data() + job_start[i + 1]);
   }
-  const std::vector<int> &getTasksOfMachine(const int i) const {
-    return tasks_in_machine[i];
+  IndexRange getTasksOfMachine(const int i) const {
+    return IndexRange(machine_task.data() + machine_start[i],
+                      machine_task.data() + machine_start[i + 1]);
   }
 
-  int getJobTask(const int i, const int j) const { return tasks_in_job[i][j]; }
-  int getMachineTask(const int i, const int j) const {
-    return tasks_in_machine[i][j];
+  int getJobTask(const int i, const int j) const {
+    return job_task[job_start[i] + j];
   }
-  const std::vector<int> &getJobTasks(const int i) const {
-    return tasks_in_job[i];
+  int getMachineTask(const int i, const int j) const {
+    return machine_task[machine_start[i] + j];
   }
-  const std::vector<int> &getMachineTasks(const int i) const {
-    return tasks_in_machine[i];
+  IndexRange getJobTasks(const int i) const { return getTasksOfJob(i); }
+  IndexRange getMachineTasks(const int i) const {
+    return getTasksOfMachine(i);
   }
 
   int getLastTaskofJob(const int i) const {
-    return tasks_in_job[i][nTasksInJob(i) - 1];
+    return job_task[job_start[i + 1] - 1];
   }
 
-  int getJob(const int i, const int j) const { return jobs_of_task[i][j]; }
+  int getJob(const int i, const int j) const {
+    return task_job[task_job_start[i] + j];
+  }
   int getMachine(const int i, const int j) const {
-    return machines_of_task[i][j];
+    return task_machine[task_machine_start[i] + j];
   }
 
   int getDuration(const int i) const { return duration[i]; }
@@ -367,11 +393,11 @@ public:
   double getJobFloatCost(const int i) const { return jsp_floatcost[i]; }
 
   int getRankInJob(const int i, const int j = -1) const {
-    return get_job_rank(i, (j == -1 ? getJob(i, 0) : j));
+    return (j == -1 ? task_job_rank[task_job_start[i]] : get_job_rank(i, j));
   }
   int getHeadInJob(const int i, const int j = -1) const {
     int rj = (j == -1 ? getJob(i, 0) : j);
-    int rk = get_job_rank(i, rj);
+    int rk = getRankInJob(i, j);
     int head = 0;
     for (int k = 0; k < rk; ++k) {
       head += getDuration(getJobTask(rj, k));
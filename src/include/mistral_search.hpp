@@ -264,6 +264,13 @@ namespace Mistral {
     \brief HeuristicPoolManager Class
 
     * Listener interface for handling a pool of search strategies *
+
+    The choice of the heuristic is a multi-armed bandit (UCB1): each 
+    heuristic is played for 'threshold' restarts, the reward of a 
+    restart is the progress reported by the solver (or 1 if a solution 
+    was found), and the next heuristic is the one maximising its average 
+    reward plus an exploration bonus. pool[0] should be the heuristic 
+    the search starts with.
   */
   //class BranchingHeuristic;
   class HeuristicPoolManager : public RestartListener {
@@ -277,6 +284,16 @@ namespace Mistral {
     int counter;
     int heu_index;
 
+    /// number of windows played and cumulated reward of each heuristic
+    Vector<int> num_pulls;
+    Vector<double> total_reward;
+    /// reward accumulated during the current window, and its length
+    double window_reward;
+    int window_size;
+    /// weight of the exploration term in the UCB score
+    double exploration;
+    unsigned long int last_num_solutions;
+
 
     HeuristicPoolManager(Solver *s);//  : solver(s) {// }
 
@@ -298,6 +315,8 @@ namespace Mistral {
 
     void add(BranchingHeuristic *h) {
       pool.add(h);
+      num_pulls.add(0);
+      total_reward.add(0.0);
     }
 
     void set_threshold(const int t) {
@@ -305,6 +324,9 @@ namespace Mistral {
       counter = t;
     }
 
+    /// UCB1 choice among the heuristics of the pool
+    int select();
+
     virtual void notify_restart(const double prog);//  {
     //   if(!(solver->statistics.num_restarts % threshold) && ++counter < pool.size) {
 
@@ -427,50 +449,7 @@ namespace Mistral {
 	}
   
 
-	virtual void notify_backtrack() {
-		int i;
-		Constraint con = solver->culprit;
-		double max_weight = 0;
-
-
-		//std::cout << "failure on " << con << std::endl;
-
-		if(!con.empty()) {
-			Variable *scope = con.get_scope();
-			int idx;
-			i = con.arity();
-			//++constraint_weight[con.id()];
-			constraint_weight[con.id()] += weight_unit;
-			while(i--) {
-				idx = scope[i].id();
-				if(idx>=0) {
-					//std::cout << " ++x" << idx; 
-					variable_weight[idx] += weight_unit;
-					if(max_weight < variable_weight[idx])
-						max_weight = variable_weight[idx];
-				}
-			}
-		} 
-		// std::cout << std::endl;
-
-		// display(std::cout, false);
-		
-		if(max_weight>threshold) {
-		
-			double factor = std::min(solver->parameters.activity_increment/weight_unit, 1/max_weight);
-			weight_unit *= factor;
-		
-			int n = solver->variables.size;
-			for(int i=0; i<n; ++i) {
-				variable_weight[i] *= factor;
-			}
-		
-		}
-	
-		if(solver->parameters.activity_decay<1 && solver->parameters.activity_decay>0)
-			weight_unit /= solver->parameters.activity_decay;
-
-	}
+	virtual void notify_backtrack();
 
 	virtual void notify_post(Constraint con) {
 		int i = con.num_active(), idx;
@@ -1934,6 +1913,62 @@ namespace Mistral {
 	
 	
 	
+ /**********************************************
+  * Objective Guided Search
+  **********************************************/
+ /*! \class ObjectiveGuided
+   \brief  Class ObjectiveGuided
+
+   Wraps another heuristic, whose variable choice is kept. For
+   assignments on an optimisation problem, the value is replaced by the 
+   one with the least observed impact on the objective, that is, the 
+   average degradation of the objective's bound after propagating the 
+   decision (a failure counts as the width of the objective's domain). 
+   Values never tried have no impact, and ties go to the wrapped 
+   heuristic's value.
+ */
+	class ObjectiveGuided : public BranchingHeuristic, public BacktrackListener, public SuccessListener, public DecisionListener {
+
+	private:
+
+		std::vector< std::vector<double> > impact;
+		std::vector< int > offset;
+
+		// the variable/value of the last decision, and the objective bound before it
+		int last_var;
+		int last_val;
+		int last_bound;
+		int last_width;
+		int last_level;
+
+		int get_bound() const;
+		void update(const double imp);
+
+	public:
+
+		BranchingHeuristic *heuristic;
+		/// variables with larger initial domains are not tracked
+		int max_domain_size;
+		/// weight of the past in the running average
+		double Alpha;
+
+		ObjectiveGuided(Solver *s, BranchingHeuristic *h, const int md=1024, const double a=8);
+		virtual ~ObjectiveGuided();
+
+		virtual void initialise(VarStack< Variable, ReversibleNum<int> >& seq);
+		virtual void close() { heuristic->close(); }
+		virtual bool comp(const Variable& x, const Variable& y) { return heuristic->comp(x,y); }
+
+		virtual Decision branch();
+
+		virtual void notify_decision();
+		virtual void notify_success();
+		virtual void notify_backtrack();
+
+		virtual std::ostream& display(std::ostream& os);
+	};
+
+
  /**********************************************
   * Impact Based Search
   **********************************************/
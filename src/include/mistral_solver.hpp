@@ -33,6 +33,8 @@ The author can be contacted electronically at emmanuel.hebrard@gmail.com.
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <unordered_map>
+
 namespace Mistral {
 
 class Solution {
@@ -116,6 +118,21 @@ public:
   int value_selection;
   int dynamic_value;
 
+  /// clause-level preprocessing of SAT/PB inputs (0 -> none, 1 -> on)
+  int preprocess;
+  /// on restart, keep the decisions that the heuristic would make again
+  int reuse_trail;
+  /// simplify the model before search, see Solver::presolve() (0 -> off)
+  int presolve;
+
+  /////// PARAMETERS FOR OPTIMISATION ///////
+  /// maximum number of dichotomic probes on the objective (0 -> none)
+  int dichotomy;
+  /// failure budget of each dichotomic probe
+  unsigned int probe_fail_limit;
+  /// values are chosen by their impact on the objective
+  int objective_guided;
+
   /// MISC
   std::string prefix_comment;
   std::string prefix_statistics;
@@ -146,6 +163,8 @@ public:
   unsigned long int num_failures;
   /// Number of constraint failures
   unsigned long int num_restarts;
+  /// Number of decision levels kept across restarts
+  unsigned long int num_reused_levels;
   /// Number of calls to a constraint propagator
   unsigned long int num_propagations;
   /// Number of solutions found so far
@@ -361,6 +380,7 @@ class VarArray;
 class Goal;
 class VariableImplementation;
 class ConstraintClauseBase;
+class SatPreprocessor;
 class Solver : public Environment {
 
 public:
@@ -466,6 +486,15 @@ public:
   int num_search_variables;
 
   ConstraintClauseBase *base;
+  /// set when the clauses were simplified before search, used to extend
+  /// the solutions to the eliminated atoms
+  SatPreprocessor *preprocessor;
+  /// variables merged by the presolve (union-find, -1 for representatives),
+  /// used to extend the solutions to the eliminated variables
+  Vector<int> alias;
+  /// the snapshot the model was loaded from (it holds the tuples of the tables)
+  char *snapshot;
+  size_t snapshot_size;
   // Vector< double > lit_activity;
   // Vector< double > var_activity;
   // double * lit_activity;
@@ -499,6 +528,9 @@ public:
   int wiper_idx;
 
   Vector<Expression *> expression_store;
+  /// expressions extracted as variables, by structure (common-subexpression
+  /// elimination, see get_subexpression())
+  std::unordered_map<std::string, Expression *> subexpressions;
 
   ConsolidateListener *consolidate_manager;
 
@@ -548,6 +580,15 @@ public:
 
   void parse_dimacs(const char *filename);
   void parse_pbo(const char *filename);
+  /// simplify the clauses stored in 'preprocessor' and load the result
+  void load_preprocessed_clauses();
+  /// write the model (domains, constraints and goal) to a binary file,
+  /// 'payload' is stored as is for the front end. Returns false if a
+  /// constraint cannot be stored
+  bool dump_snapshot(const char *filename, const std::string &payload = "");
+  /// rebuild (and consolidate) a model written by dump_snapshot(); the file
+  /// is memory-mapped and table tuples are read in place
+  bool load_snapshot(const char *filename, std::string *payload = NULL);
 
   void set_parameters(SolverParameters &p);
 
@@ -598,6 +639,13 @@ public:
   void add(VarArray &x);
   void add(Constraint x);
   void add(Vector<Literal> &clause);
+  /// add the clauses literals[start[i]..start[i+1]) in bulk
+  void add_clauses(Vector<Literal> &literals, Vector<unsigned int> &start);
+  /// returns a previously extracted expression with the same name, parameters
+  /// and (already extracted) children as x, if any, otherwise records x
+  Expression *get_subexpression(Expression *x);
+  /// whether x was merged with a structurally identical expression
+  bool is_merged(Expression *x);
   // void add(ConstraintW x);
   // void add(BranchingHeuristic* h);
 
@@ -621,8 +669,15 @@ public:
   void remove(VariableListener *l);
   void remove(ConstraintListener *l);
 
-  void forbid(const int var, const int m) { domain_types[var] &= (~m); }
-  void mark_non_convex(const int var) { domain_types[var] &= (~RANGE_VAR); }
+  // constants (negative ids) have no domain type
+  void forbid(const int var, const int m) {
+    if (var >= 0)
+      domain_types[var] &= (~m);
+  }
+  void mark_non_convex(const int var) {
+    if (var >= 0)
+      domain_types[var] &= (~RANGE_VAR);
+  }
   // void add(Vector<Literal>& clause);
   //@}
 
@@ -675,8 +730,15 @@ public:
   void fail();
 
   void parity_processing(const int k = 1);
+  void gauss_processing();
   bool simple_rewrite();
   bool rewrite();
+  /// simplifies the model at the root: drops entailed and duplicate
+  /// constraints, tightens linear bounds and merges the variables related by
+  /// an equality. Returns false if the model was found inconsistent
+  bool presolve();
+  /// the variable that stands for x after the presolve merged equalities
+  Variable get_representative(Variable x);
   bool is_pseudo_boolean() const;
   void consolidate();
   void make_non_convex(const int idx);
@@ -739,6 +801,11 @@ public:
   Outcome depth_first_search(bool _restore_ = true);
 
   Outcome restart_search(const int root = 0, const bool _restore_ = true);
+  /// level above root whose decisions would be re-made first after a restart
+  int get_reusable_level(const int root);
+  /// bound the objective by dichotomy, each probe with a failure budget
+  /// (returns false if no improving solution can exist)
+  bool dichotomic_probing();
 
   /*!
   Black box search.
@@ -866,6 +933,14 @@ public:
   TCLAP::ValueArg<std::string> *psolutionArg;
   TCLAP::ValueArg<std::string> *poutcomeArg;
   TCLAP::SwitchArg *allsolArg;
+  TCLAP::SwitchArg *preprocessArg;
+  TCLAP::SwitchArg *presolveArg;
+  TCLAP::SwitchArg *reuseTrailArg;
+  TCLAP::ValueArg<int> *dichotomyArg;
+  TCLAP::ValueArg<int> *probeArg;
+  TCLAP::SwitchArg *objguidedArg;
+  TCLAP::ValueArg<int> *flushArg;
+  TCLAP::ValueArg<std::string> *binsolArg;
 
   TCLAP::ValuesConstraint<std::string> *r_allowed;
   TCLAP::ValuesConstraint<std::string> *vo_allowed;
@@ -1129,6 +1204,12 @@ public:
   bool use_rewrite();
 
   bool enumerate_solutions();
+
+  // number of solutions between two flushes of the output (0: never)
+  int get_flush_period();
+
+  // file where solutions are written in binary ("" if none)
+  std::string get_binary_solutions();
 };
 
 std::ostream &operator<<(std::ostream &os, Solution &x);
@@ -1798,6 +1798,12 @@ public:
       data[i] = ps[i];
   }
 
+  Array(const DATA_TYPE *first, const unsigned int n) {
+    size = n;
+    for (unsigned int i = 0; i < n; ++i)
+      data[i] = first[i];
+  }
+
   Array(const IntList &ps) {
     size = ps.size;
     int i = 0;
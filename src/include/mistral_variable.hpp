@@ -2533,6 +2533,12 @@ public:
   // virtual void reify(Solver *s, Variable X);
   virtual void extract_variable(Solver *);
   virtual const char *get_name() const { return "var"; }
+  /// Appends to key the parameters that, together with the name and the
+  /// children, determine the expression. Expressions returning false (the
+  /// default) are never merged with a structurally identical one
+  virtual bool get_signature(Vector<int> &key) const { return false; }
+  /// Whether the order of the children is irrelevant
+  virtual bool is_commutative() const { return false; }
   bool is_set() const {
     std::string name = get_name();
     return (name[0] == 's' && name[1] == 'e' && name[2] == 't');
@@ -2563,6 +2569,8 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
+  virtual bool is_commutative() const { return true; }
 };
 
 class MulExpression : public Expression {
@@ -2575,6 +2583,8 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
+  virtual bool is_commutative() const { return true; }
 };
 
 class ModExpression : public Expression {
@@ -2587,6 +2597,7 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
 };
 
 class AbsExpression : public Expression {
@@ -2599,6 +2610,7 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
 };
 
 Variable Abs(Variable X);
@@ -2613,6 +2625,7 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
 };
 
 class QuotientExpression : public Expression {
@@ -2627,6 +2640,10 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const {
+    key.add(quotient);
+    return true;
+  }
 };
 
 class OffsetExpression : public Expression {
@@ -2641,6 +2658,10 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const {
+    key.add(offset);
+    return true;
+  }
 };
 
 class IdExpression : public Expression {
@@ -2667,6 +2688,10 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const {
+    key.add(factor);
+    return true;
+  }
 };
 
 class SquareExpression : public Expression {
@@ -2679,6 +2704,7 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
 };
 
 class ModConstantExpression : public Expression {
@@ -2693,6 +2719,10 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const {
+    key.add(modulo);
+    return true;
+  }
 };
 
 class SubExpression : public Expression {
@@ -2705,6 +2735,7 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
 };
 
 class AndExpression : public Expression {
@@ -2719,6 +2750,11 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const {
+    key.add(spin);
+    return true;
+  }
+  virtual bool is_commutative() const { return true; }
 };
 
 Variable NotAnd(Variable X, Variable Y);
@@ -2735,6 +2771,11 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const {
+    key.add(spin);
+    return true;
+  }
+  virtual bool is_commutative() const { return true; }
 };
 
 Variable NotOr(Variable X, Variable Y);
@@ -2749,6 +2790,7 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
 };
 
 class NegExpression : public Expression {
@@ -2761,6 +2803,7 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
 };
 
 // class NeqExpression : public Expression {
@@ -2805,6 +2848,12 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const {
+    key.add(spin);
+    key.add(value);
+    return true;
+  }
+  virtual bool is_commutative() const { return true; }
 };
 
 // class EqualSetExpression : public Expression {
@@ -2856,6 +2905,11 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const {
+    key.add(spin);
+    key.add(offset);
+    return true;
+  }
 };
 
 Variable Precedence(Variable X, const int d, Variable Y);
@@ -2999,6 +3053,24 @@ Variable Occurrences(Vector<Variable> &args, std::vector<int> &values,
                      std::vector<int> &lbs, std::vector<int> &ubs,
                      const int ct = BOUND_CONSISTENCY);
 
+// the number of occurrences of values[i] in args is counts[i]
+class CardinalityExpression : public Expression {
+
+public:
+  std::vector<int> values;
+
+  CardinalityExpression(Vector<Variable> &args, const std::vector<int> &vals,
+                        Vector<Variable> &counts);
+  virtual ~CardinalityExpression();
+
+  virtual void extract_constraint(Solver *);
+  virtual void extract_variable(Solver *);
+  virtual void extract_predicate(Solver *);
+  virtual const char *get_name() const;
+};
+Variable Cardinality(Vector<Variable> &args, const std::vector<int> &values,
+                     Vector<Variable> &counts);
+
 class VertexCoverExpression : public Expression {
 
 public:
@@ -3120,6 +3192,28 @@ public:
   virtual const char *get_name() const;
 };
 
+class SequenceExpression : public Expression {
+
+public:
+  int lower_bound;
+  int upper_bound;
+  int window;
+  std::vector<int> values;
+
+  SequenceExpression(Vector<Variable> &args, const int lo, const int hi,
+                     const int q, const std::vector<int> &vals);
+  virtual ~SequenceExpression();
+
+  virtual void extract_constraint(Solver *);
+  virtual void extract_variable(Solver *);
+  virtual void extract_predicate(Solver *);
+  virtual const char *get_name() const;
+};
+
+// every q consecutive variables of args take between lo and hi values of vals
+Variable Sequence(Vector<Variable> &args, const int lo, const int hi,
+                  const int q, const std::vector<int> &vals);
+
 class TableExpression : public Expression {
 
 public:
@@ -3179,6 +3273,23 @@ public:
 Variable LexLess(VarArray &r1, VarArray &r2);
 Variable LexLeq(VarArray &r1, VarArray &r2);
 
+class LexChainExpression : public Expression {
+
+public:
+  int strict;
+  int row_size;
+
+  LexChainExpression(std::vector<VarArray> &rows, const int st_);
+  virtual ~LexChainExpression();
+
+  virtual void extract_constraint(Solver *);
+  virtual void extract_variable(Solver *);
+  virtual void extract_predicate(Solver *);
+  virtual const char *get_name() const;
+};
+
+Variable LexChain(std::vector<VarArray> &rows, const int strict = 0);
+
 class ParityExpression : public Expression {
 
 public:
@@ -3242,15 +3353,18 @@ class KnapsackExpression : public Expression {
 
 public:
   int weight_upper_bound;
+  int weight_lower_bound;
   int profit_upper_bound;
   int profit_lower_bound;
   std::vector<int> weight;
   std::vector<int> profit;
 
   KnapsackExpression(std::vector<Variable> &args, const int w_bound,
-                     const std::vector<int> &w, const std::vector<int> &p);
+                     const std::vector<int> &w, const std::vector<int> &p,
+                     const int w_lbound = -INFTY);
   KnapsackExpression(Vector<Variable> &args, const int w_bound,
-                     const std::vector<int> &w, const std::vector<int> &p);
+                     const std::vector<int> &w, const std::vector<int> &p,
+                     const int w_lbound = -INFTY);
   virtual ~KnapsackExpression();
   void initialise_bounds();
   void order_vars();
@@ -3264,10 +3378,12 @@ public:
 // Variable Knapsack(Vector<Variable> &args, const Vector<int> &w, const
 // Vector<int> &p, const int w_bound);
 Variable Knapsack(std::vector<Variable> &args, const int w_bound,
-                  const std::vector<int> &w, const std::vector<int> &p);
+                  const std::vector<int> &w, const std::vector<int> &p,
+                  const int w_lbound = -INFTY);
 
 Variable Knapsack(Vector<Variable> &args, const int w_bound,
-                  const std::vector<int> &w, const std::vector<int> &p);
+                  const std::vector<int> &w, const std::vector<int> &p,
+                  const int w_lbound = -INFTY);
 
 class LinearExpression : public Expression {
 
@@ -3340,6 +3456,27 @@ public:
 Variable Element(const Vector<Variable> &X, Variable selector, int offset = 0);
 Variable Element(const VarArray &X, Variable selector, int offset = 0);
 
+class Element2DExpression : public Expression {
+
+public:
+  std::vector<std::vector<int> > matrix;
+  int row_offset;
+  int col_offset;
+
+  Element2DExpression(const std::vector<std::vector<int> > &M, Variable R,
+                      Variable C, const int ro, const int co);
+  virtual ~Element2DExpression();
+
+  virtual void extract_constraint(Solver *);
+  virtual void extract_variable(Solver *);
+  virtual void extract_predicate(Solver *);
+  virtual const char *get_name() const;
+};
+
+Variable Element(const std::vector<std::vector<int> > &M, Variable row,
+                 Variable col, const int row_offset = 0,
+                 const int col_offset = 0);
+
 class StretchExpression : public Expression {
 
 public:
@@ -3386,6 +3523,8 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
+  virtual bool is_commutative() const { return true; }
 };
 
 Variable Min(Vector<Variable> &X);
@@ -3404,12 +3543,49 @@ public:
   virtual void extract_variable(Solver *);
   virtual void extract_predicate(Solver *);
   virtual const char *get_name() const;
+  virtual bool get_signature(Vector<int> &key) const { return true; }
+  virtual bool is_commutative() const { return true; }
 };
 
 Variable Max(Vector<Variable> &X);
 Variable Max(VarArray &X);
 Variable Max(Variable X, Variable Y);
 
+class NValueExpression : public Expression {
+
+public:
+  NValueExpression() : Expression(){};
+  NValueExpression(Vector<Variable> &args);
+  virtual ~NValueExpression();
+
+  virtual void extract_constraint(Solver *);
+  virtual void extract_variable(Solver *);
+  virtual void extract_predicate(Solver *);
+  virtual const char *get_name() const;
+};
+
+Variable NValue(Vector<Variable> &X);
+Variable NValue(VarArray &X);
+
+class BinPackingExpression : public Expression {
+
+public:
+  std::vector<int> size;
+  int first_bin;
+
+  BinPackingExpression(Vector<Variable> &items, const std::vector<int> &sizes,
+                       Vector<Variable> &loads, const int first);
+  virtual ~BinPackingExpression();
+
+  virtual void extract_constraint(Solver *);
+  virtual void extract_variable(Solver *);
+  virtual void extract_predicate(Solver *);
+  virtual const char *get_name() const;
+};
+
+Variable BinPacking(Vector<Variable> &items, const std::vector<int> &sizes,
+                    Vector<Variable> &loads, const int first = 0);
+
 // class SetExpression : public BoolSumExpression {
 
 // public:
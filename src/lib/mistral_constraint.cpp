@@ -1521,6 +1521,10 @@ void Mistral::ConstraintNotEqual::mark_domain() {
   // get_solver()->mark_non_convex(scope[1].id());
 }
 
+bool Mistral::ConstraintNotEqual::simplify() {
+  return !(scope[0].intersect(scope[1]));
+}
+
 Mistral::PropagationOutcome Mistral::ConstraintNotEqual::rewrite() {
 
   if (scope[0].id() == scope[1].id()) {
@@ -2100,6 +2104,10 @@ Mistral::PropagationOutcome Mistral::ConstraintLess::propagate(const int changed
   return wiped;
 }
 
+bool Mistral::ConstraintLess::simplify() {
+  return (scope[0].get_max() + offset <= scope[1].get_min());
+}
+
 std::ostream& Mistral::ConstraintLess::display(std::ostream& os) const {
   // os << "yes ";
   os << scope[0] /*.get_var()*/;
@@ -4498,6 +4506,296 @@ std::ostream& Mistral::ConstraintLex::display(std::ostream& os) const {
 }
 
 
+Mistral::ConstraintLexGAC::ConstraintLexGAC(Vector<Variable> &scp,
+                                            const int st)
+    : GlobalConstraint(scp), strict(st) {
+  priority = 1;
+  length = scope.size / 2;
+}
+
+void Mistral::ConstraintLexGAC::initialise() {
+  ConstraintImplementation::initialise();
+  for (unsigned int i = 0; i < scope.size; ++i)
+    trigger_on(_RANGE_, scope[i]);
+  GlobalConstraint::initialise();
+
+  // the empty suffix is lex greater only for the strict ordering
+  int b = length + !strict, i = length;
+  while (i--) {
+    int o = order(i);
+    if (o > 0 || (o == 0 && b == i + 1))
+      b = i;
+  }
+
+  alpha.initialise(get_solver(), 0);
+  beta.initialise(get_solver(), b);
+}
+
+Mistral::ConstraintLexGAC::~ConstraintLexGAC() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete lex (gac) constraint" << std::endl;
+#endif
+}
+
+// beta moves down when the pair i either becomes lex greater, or equal
+// just before beta
+void Mistral::ConstraintLexGAC::update_beta(const int i) {
+  if (i < beta) {
+    int o = order(i);
+    if (o > 0 || (o == 0 && i + 1 == beta)) {
+      int b = i;
+      while (b > 0 && order(b - 1) == 0)
+        --b;
+      beta = b;
+    }
+  }
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintLexGAC::propagate() {
+  int a, i;
+
+  for (i = changes.size; i--;)
+    update_beta(changes[i] % length);
+
+  a = alpha;
+  while (true) {
+    while (a < beta && a < length && scope[a].is_ground() &&
+           scope[a + length].is_ground() &&
+           scope[a].get_value() == scope[a + length].get_value())
+      ++a;
+    if (a != alpha)
+      alpha = a;
+
+    if (a >= beta)
+      return FAILURE(a < length ? a : length - 1);
+    if (a == length)
+      break;
+
+    Variable x = scope[a], y = scope[a + length];
+    if (beta == a + 1) {
+      if (FAILED(x.set_max(y.get_max() - 1)))
+        return FAILURE(a);
+      if (FAILED(y.set_min(x.get_min() + 1)))
+        return FAILURE(a + length);
+    } else {
+      if (FAILED(x.set_max(y.get_max())))
+        return FAILURE(a);
+      if (FAILED(y.set_min(x.get_min())))
+        return FAILURE(a + length);
+    }
+
+    // x_alpha < y_alpha is now possible, unless both are ground and equal
+    if (!x.is_ground() || !y.is_ground() || x.get_value() != y.get_value())
+      break;
+  }
+
+  return CONSISTENT;
+}
+
+int Mistral::ConstraintLexGAC::check(const int *s) const {
+  for (int i = 0; i < length; ++i)
+    if (s[i] != s[i + length])
+      return s[i] > s[i + length];
+  return strict;
+}
+
+std::ostream &Mistral::ConstraintLexGAC::display(std::ostream &os) const {
+  os << "(" << scope[0];
+  for (int i = 1; i < length; ++i)
+    os << " " << scope[i];
+  os << (strict ? ") <lex (" : ") <=lex (") << scope[length];
+  for (int i = 1; i < length; ++i)
+    os << " " << scope[i + length];
+  os << ")";
+  return os;
+}
+
+Mistral::ConstraintLexChain::ConstraintLexChain(Vector<Variable> &scp,
+                                                const int n, const int st)
+    : GlobalConstraint(scp), strict(st), length(n) {
+  priority = 0;
+  num_rows = scope.size / length;
+}
+
+void Mistral::ConstraintLexChain::initialise() {
+  ConstraintImplementation::initialise();
+  for (unsigned int i = 0; i < scope.size; ++i)
+    trigger_on(_DOMAIN_, scope[i]);
+  GlobalConstraint::initialise();
+
+  lower.initialise(scope.size, scope.size, 0);
+  upper.initialise(scope.size, scope.size, 0);
+}
+
+Mistral::ConstraintLexChain::~ConstraintLexChain() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete lex chain constraint" << std::endl;
+#endif
+}
+
+// least tuple of row r that is lex greater than (or equal to) prev
+bool Mistral::ConstraintLexChain::least_above(const int r, const int *prev,
+                                              const int st) {
+  int *t = lower.stack_ + r * length, i, j, p = 0, v;
+  Variable *x = scope.stack_ + r * length;
+
+  if (prev) {
+    while (p < length && x[p].contain(prev[p]))
+      ++p;
+    if (p == length && !st) {
+      for (i = 0; i < length; ++i)
+        t[i] = prev[i];
+      return true;
+    }
+
+    // the longest prefix of prev that can be followed by a greater value
+    for (i = (p < length ? p : length - 1); i >= 0; --i) {
+      if (prev[i] < x[i].get_min())
+        v = x[i].get_min();
+      else if (prev[i] < x[i].get_max())
+        v = x[i].next(prev[i]);
+      else
+        continue;
+      for (j = 0; j < i; ++j)
+        t[j] = prev[j];
+      t[i] = v;
+      break;
+    }
+    if (i < 0)
+      return false;
+    p = i + 1;
+  }
+
+  for (i = p; i < length; ++i)
+    t[i] = x[i].get_min();
+  return true;
+}
+
+// greatest tuple of row r that is lex lower than (or equal to) next
+bool Mistral::ConstraintLexChain::greatest_below(const int r, const int *next,
+                                                 const int st) {
+  int *t = upper.stack_ + r * length, i, j, p = 0, v;
+  Variable *x = scope.stack_ + r * length;
+
+  if (next) {
+    while (p < length && x[p].contain(next[p]))
+      ++p;
+    if (p == length && !st) {
+      for (i = 0; i < length; ++i)
+        t[i] = next[i];
+      return true;
+    }
+
+    for (i = (p < length ? p : length - 1); i >= 0; --i) {
+      if (next[i] > x[i].get_max())
+        v = x[i].get_max();
+      else if (next[i] > x[i].get_min())
+        v = x[i].prev(next[i]);
+      else
+        continue;
+      for (j = 0; j < i; ++j)
+        t[j] = next[j];
+      t[i] = v;
+      break;
+    }
+    if (i < 0)
+      return false;
+    p = i + 1;
+  }
+
+  for (i = p; i < length; ++i)
+    t[i] = x[i].get_max();
+  return true;
+}
+
+// GAC on lower[r] <=lex X_r <=lex upper[r], where both bounds are tuples
+// of the domains
+Mistral::PropagationOutcome
+Mistral::ConstraintLexChain::filter_between(const int r) {
+  int *a = lower.stack_ + r * length, *b = upper.stack_ + r * length, j,
+      q = 0;
+  Variable *x = scope.stack_ + r * length;
+
+  while (q < length && a[q] == b[q]) {
+    if (FAILED(x[q].set_domain(a[q])))
+      return FAILURE(r * length + q);
+    ++q;
+  }
+  if (q == length)
+    return CONSISTENT;
+
+  if (FAILED(x[q].set_min(a[q])) || FAILED(x[q].set_max(b[q])))
+    return FAILURE(r * length + q);
+  // a value strictly between a[q] and b[q] supports every other value
+  if (x[q].next(a[q]) < b[q])
+    return CONSISTENT;
+
+  // otherwise, x_j = v needs either a prefix of a followed by a greater
+  // value, or a prefix of b followed by a lower value
+  for (j = q + 1; j < length; ++j) {
+    if (b[j] + 1 < a[j] &&
+        FAILED(x[j].remove_interval(b[j] + 1, a[j] - 1)))
+      return FAILURE(r * length + j);
+    if (x[j].get_max() > a[j] || x[j].get_min() < b[j])
+      break;
+  }
+
+  return CONSISTENT;
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintLexChain::propagate() {
+  int r, i;
+
+  for (r = 0; r < num_rows; ++r)
+    if (!least_above(r, (r ? lower.stack_ + (r - 1) * length : NULL), strict))
+      return FAILURE(r * length);
+
+  for (r = num_rows; r--;)
+    if (!greatest_below(
+            r, (r < num_rows - 1 ? upper.stack_ + (r + 1) * length : NULL),
+            strict))
+      return FAILURE(r * length);
+
+  for (r = 0; r < num_rows; ++r) {
+    for (i = r * length; i < (r + 1) * length && lower[i] == upper[i]; ++i)
+      ;
+    if (i < (r + 1) * length && lower[i] > upper[i])
+      return FAILURE(i);
+  }
+
+  for (r = 0; r < num_rows; ++r) {
+    PropagationOutcome wiped = filter_between(r);
+    if (!IS_OK(wiped))
+      return wiped;
+  }
+
+  return CONSISTENT;
+}
+
+int Mistral::ConstraintLexChain::check(const int *s) const {
+  int r, i;
+  for (r = 1; r < num_rows; ++r) {
+    const int *x = s + (r - 1) * length, *y = s + r * length;
+    for (i = 0; i < length && x[i] == y[i]; ++i)
+      ;
+    if (i == length ? strict : x[i] > y[i])
+      return 1;
+  }
+  return 0;
+}
+
+std::ostream &Mistral::ConstraintLexChain::display(std::ostream &os) const {
+  os << "lex_chain" << (strict ? "<" : "<=") << "(";
+  for (int r = 0; r < num_rows; ++r) {
+    os << (r ? ", [" : "[") << scope[r * length];
+    for (int i = 1; i < length; ++i)
+      os << " " << scope[r * length + i];
+    os << "]";
+  }
+  os << ")";
+  return os;
+}
+
 // void Mistral::ConstraintLexf::initialise() {
 //   Constraint::initialise();
 //   for(int i=0; i<3; ++i)
@@ -10190,6 +10488,41 @@ Mistral::Explanation::iterator Mistral::ConstraintBoolSumInterval::get_reason_fo
   return explanation.begin();
 }
 
+// tighten [lb,ub] to the range of the (weighted) sum of 'scp', and returns
+// true if the range is included in [lb,ub]. The bounds are not tightened if
+// that would turn an interval into an equation (propagators check lb==ub
+// once, at initialisation)
+static bool simplify_linear(const Mistral::Vector<Mistral::Variable> &scp,
+                            const Mistral::Vector<int> *weight, int &lb,
+                            int &ub) {
+  long long smin = 0, smax = 0, w;
+  for (unsigned int i = 0; i < scp.size; ++i) {
+    w = (weight ? (*weight)[i] : 1);
+    if (w > 0) {
+      smin += w * scp[i].get_min();
+      smax += w * scp[i].get_max();
+    } else {
+      smin += w * scp[i].get_max();
+      smax += w * scp[i].get_min();
+    }
+  }
+  if (smin >= lb && smax <= ub)
+    return true;
+  if (lb != ub) {
+    int nlb = (smin > lb ? (int)smin : lb);
+    int nub = (smax < ub ? (int)smax : ub);
+    if (nlb < nub) {
+      lb = nlb;
+      ub = nub;
+    }
+  }
+  return false;
+}
+
+bool Mistral::ConstraintBoolSumInterval::simplify() {
+  return simplify_linear(scope, NULL, lower_bound, upper_bound);
+}
+
 int Mistral::ConstraintBoolSumInterval::check( const int* s ) const 
 {
   int i = scope.size, t = 0;
@@ -11487,6 +11820,18 @@ Mistral::PropagationOutcome Mistral::PredicateWeightedSum::propagate()
   return wiped;
 }
 
+bool Mistral::PredicateWeightedSum::get_signature(Vector<int> &key) const {
+  for (unsigned int i = 0; i < weight.size; ++i)
+    key.add(weight[i]);
+  key.add(lower_bound);
+  key.add(upper_bound);
+  return true;
+}
+
+bool Mistral::PredicateWeightedSum::simplify() {
+  return simplify_linear(scope, &weight, lower_bound, upper_bound);
+}
+
 int Mistral::PredicateWeightedSum::check( const int* s ) const 
 {
   int i = scope.size, t = 0;
@@ -11514,6 +11859,215 @@ std::ostream& Mistral::PredicateWeightedSum::display(std::ostream& os) const {
   return os;
 }
 
+Mistral::ConstraintIncrementalWeightedSum::ConstraintIncrementalWeightedSum(
+    Vector<Variable> &scp, Vector<int> &wgt, const int L, const int U)
+    : GlobalConstraint(scp), lower_bound(L), upper_bound(U) {
+  priority = 1;
+  for (unsigned int i = 0; i < scope.size; ++i) {
+    weight.add(wgt[i]);
+  }
+}
+
+void Mistral::ConstraintIncrementalWeightedSum::initialise() {
+  ConstraintImplementation::initialise();
+
+  int i, n = scope.size;
+
+  // sort the terms by decreasing initial span
+  Vector<int> order;
+  for (i = 0; i < n; ++i)
+    order.add(i);
+  std::sort(order.begin(), order.end(), [&](const int x, const int y) {
+    return (long long)abs(weight[x]) *
+               (scope[x].get_max() - scope[x].get_min()) >
+           (long long)abs(weight[y]) *
+               (scope[y].get_max() - scope[y].get_min());
+  });
+
+  Vector<Variable> X;
+  Vector<int> w;
+  for (i = 0; i < n; ++i) {
+    X.add(scope[order[i]]);
+    w.add(weight[order[i]]);
+  }
+  for (i = 0; i < n; ++i) {
+    scope[i] = X[i];
+    weight[i] = w[i];
+    trigger_on(_RANGE_, scope[i]);
+  }
+
+  GlobalConstraint::initialise();
+
+  coef = new int[n];
+  lo_bound = new int[n];
+  up_bound = new int[n];
+  span = new int[n];
+  for (i = 0; i < n; ++i) {
+    coef[i] = weight[i];
+    lo_bound[i] = scope[i].get_min();
+    up_bound[i] = scope[i].get_max();
+    span[i] = abs(coef[i]) * (up_bound[i] - lo_bound[i]);
+  }
+
+  undo_size.initialise(get_solver(), 0);
+  init_prop = true;
+}
+
+void Mistral::ConstraintIncrementalWeightedSum::mark_domain() {
+  for (int i = scope.size; i;)
+    get_solver()->forbid(scope[--i].id(), LIST_VAR);
+}
+
+Mistral::ConstraintIncrementalWeightedSum::~ConstraintIncrementalWeightedSum() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete incremental weightedsum constraint" << std::endl;
+#endif
+  delete[] coef;
+  delete[] lo_bound;
+  delete[] up_bound;
+  delete[] span;
+}
+
+// restores the cached bounds that were changed below the current level
+void Mistral::ConstraintIncrementalWeightedSum::undo() {
+  int i, a;
+  while ((int)undo_index.size > undo_size) {
+    i = undo_index.pop();
+    a = coef[i];
+    if (a > 0) {
+      sum_min += (long long)a * (undo_lo.back() - lo_bound[i]);
+      sum_max += (long long)a * (undo_up.back() - up_bound[i]);
+    } else {
+      sum_min += (long long)a * (undo_up.back() - up_bound[i]);
+      sum_max += (long long)a * (undo_lo.back() - lo_bound[i]);
+    }
+    lo_bound[i] = undo_lo.pop();
+    up_bound[i] = undo_up.pop();
+  }
+}
+
+// applies the current bounds of the i-th term to the running bounds
+void Mistral::ConstraintIncrementalWeightedSum::update(const int i) {
+  int lb = scope[i].get_min(), ub = scope[i].get_max(), a = coef[i];
+  if (lb != lo_bound[i] || ub != up_bound[i]) {
+    undo_index.add(i);
+    undo_lo.add(lo_bound[i]);
+    undo_up.add(up_bound[i]);
+    undo_size = undo_index.size;
+
+    if (a > 0) {
+      sum_min += (long long)a * (lb - lo_bound[i]);
+      sum_max += (long long)a * (ub - up_bound[i]);
+    } else {
+      sum_min += (long long)a * (ub - up_bound[i]);
+      sum_max += (long long)a * (lb - lo_bound[i]);
+    }
+    lo_bound[i] = lb;
+    up_bound[i] = ub;
+  }
+}
+
+Mistral::PropagationOutcome
+Mistral::ConstraintIncrementalWeightedSum::propagate() {
+  int i, a, n = scope.size;
+  long long slack_up, slack_lo, slack;
+  bool fixpoint;
+
+  if (init_prop) {
+    init_prop = false;
+    sum_min = sum_max = 0;
+    for (i = 0; i < n; ++i) {
+      lo_bound[i] = scope[i].get_min();
+      up_bound[i] = scope[i].get_max();
+    }
+    for (i = 0; i < n; ++i) {
+      a = coef[i];
+      sum_min += (long long)a * (a > 0 ? lo_bound[i] : up_bound[i]);
+      sum_max += (long long)a * (a > 0 ? up_bound[i] : lo_bound[i]);
+    }
+    changes.clear();
+  } else {
+    undo();
+    while (!changes.empty())
+      update(changes.pop());
+  }
+
+  do {
+    fixpoint = true;
+
+    slack_up = upper_bound - sum_min;
+    slack_lo = sum_max - lower_bound;
+    if (slack_up < 0 || slack_lo < 0)
+      return FAILURE(n - 1);
+    slack = (slack_up < slack_lo ? slack_up : slack_lo);
+
+    for (i = 0; i < n && span[i] > slack; ++i) {
+      a = coef[i];
+      if (a > 0) {
+        if ((long long)a * (up_bound[i] - lo_bound[i]) > slack_up &&
+            FAILED(scope[i].set_max(lo_bound[i] + slack_up / a)))
+          return FAILURE(i);
+        if ((long long)a * (up_bound[i] - lo_bound[i]) > slack_lo &&
+            FAILED(scope[i].set_min(up_bound[i] - slack_lo / a)))
+          return FAILURE(i);
+      } else {
+        if ((long long)-a * (up_bound[i] - lo_bound[i]) > slack_up &&
+            FAILED(scope[i].set_min(up_bound[i] - slack_up / -a)))
+          return FAILURE(i);
+        if ((long long)-a * (up_bound[i] - lo_bound[i]) > slack_lo &&
+            FAILED(scope[i].set_max(lo_bound[i] + slack_lo / -a)))
+          return FAILURE(i);
+      }
+
+      if (scope[i].get_min() != lo_bound[i] ||
+          scope[i].get_max() != up_bound[i]) {
+        update(i);
+        fixpoint = false;
+        slack_up = upper_bound - sum_min;
+        slack_lo = sum_max - lower_bound;
+        slack = (slack_up < slack_lo ? slack_up : slack_lo);
+      }
+    }
+  } while (!fixpoint);
+
+  return CONSISTENT;
+}
+
+bool Mistral::ConstraintIncrementalWeightedSum::get_signature(
+    Vector<int> &key) const {
+  for (unsigned int i = 0; i < weight.size; ++i)
+    key.add(weight[i]);
+  key.add(lower_bound);
+  key.add(upper_bound);
+  return true;
+}
+
+bool Mistral::ConstraintIncrementalWeightedSum::simplify() {
+  return simplify_linear(scope, &weight, lower_bound, upper_bound);
+}
+
+int Mistral::ConstraintIncrementalWeightedSum::check(const int *s) const {
+  long long t = 0;
+  for (unsigned int i = 0; i < scope.size; ++i)
+    t += (long long)weight[i] * s[i];
+  return (t < lower_bound || t > upper_bound);
+}
+
+std::ostream &
+Mistral::ConstraintIncrementalWeightedSum::display(std::ostream &os) const {
+  if (lower_bound > -INFTY)
+    os << lower_bound << " <= ";
+  os << weight[0] << "*" << scope[0];
+
+  for (unsigned int i = 1; i < scope.size; ++i)
+    os << " + " << weight[i] << "*" << scope[i];
+
+  if (upper_bound < INFTY)
+    os << " <= " << upper_bound;
+
+  return os;
+}
+
 Mistral::ConstraintParity::ConstraintParity(Vector<Variable> &scp, const int p)
     : GlobalConstraint(scp), target_parity(p) {
   priority = 1;
@@ -11639,36 +12193,288 @@ std::ostream& Mistral::ConstraintParity::display(std::ostream& os) const {
   return os;
 }
 
-Mistral::ConstraintWeightedBoolSumInterval::ConstraintWeightedBoolSumInterval(
-    Vector<Variable> &scp, const int L, const int U)
-    : GlobalConstraint(scp), lower_bound(L), upper_bound(U) {
-  priority = 1;
-  for (unsigned int i = 0; i < scope.size; ++i) {
-    weight.add(1);
-  }
-}
-
-Mistral::ConstraintWeightedBoolSumInterval::ConstraintWeightedBoolSumInterval(
-    Vector<Variable> &scp, Vector<int> &wgt, const int L, const int U)
-    : GlobalConstraint(scp), lower_bound(L), upper_bound(U) {
-  priority = 1;
-  for (unsigned int i = 0; i < scope.size; ++i) {
-    weight.add(wgt[i]);
-  }
-}
 
-Mistral::ConstraintWeightedBoolSumInterval::ConstraintWeightedBoolSumInterval(
-    std::vector<Variable> &scp, std::vector<int> &wgt, const int L, const int U)
-    : GlobalConstraint(scp), lower_bound(L), upper_bound(U) {
-  priority = 1;
-  for (unsigned int i = 0; i < scope.size; ++i) {
-    weight.add(wgt[i]);
-  }
+Mistral::ConstraintXorSystem::ConstraintXorSystem(
+    Vector<Variable> &scp, const std::vector<std::vector<int> > &rws,
+    const std::vector<int> &prts)
+    : GlobalConstraint(scp), rows(rws), parities(prts) {
+  priority = 0;
+  matrix = NULL;
+  rhs = NULL;
+  basic = NULL;
+  assigned = NULL;
+  value = NULL;
+  reason = NULL;
+  conflict = NULL;
 }
 
-void Mistral::ConstraintWeightedBoolSumInterval::initialise() {
+void Mistral::ConstraintXorSystem::initialise() {
   ConstraintImplementation::initialise();
-  // set_idempotent(true);
+  // on Boolean variables both events are the same, but only range triggers
+  // get the initial propagation, where the rows implied by the system alone
+  // are found
+  for (unsigned int i = 0; i < scope.size; ++i)
+    trigger_on(_RANGE_, scope[i]);
+  GlobalConstraint::initialise();
+
+  int i, j, r, c, w, n = scope.size, m = rows.size();
+  unsigned long long *row, *piv, bit;
+
+  num_words = (n + 63) / 64;
+  matrix = new unsigned long long[m * num_words];
+  std::fill(matrix, matrix + m * num_words, 0);
+  rhs = new int[m];
+  basic = new int[m];
+  for (r = 0; r < m; ++r) {
+    row = matrix + r * num_words;
+    for (j = 0; j < (int)rows[r].size(); ++j) {
+      c = rows[r][j];
+      // a variable twice in the same row cancels out
+      row[c / 64] ^= (1ULL << (c % 64));
+    }
+    rhs[r] = parities[r] & 1;
+  }
+
+  // Gauss-Jordan elimination, the null rows are dropped
+  num_rows = 0;
+  inconsistent = false;
+  for (c = 0; c < n && num_rows < m; ++c) {
+    w = c / 64;
+    bit = (1ULL << (c % 64));
+    for (r = num_rows; r < m && !(matrix[r * num_words + w] & bit); ++r)
+      ;
+    if (r == m)
+      continue;
+
+    if (r != num_rows) {
+      std::swap_ranges(matrix + r * num_words, matrix + (r + 1) * num_words,
+                       matrix + num_rows * num_words);
+      std::swap(rhs[r], rhs[num_rows]);
+    }
+    piv = matrix + num_rows * num_words;
+    for (r = 0; r < m; ++r)
+      if (r != num_rows && (matrix[r * num_words + w] & bit)) {
+        row = matrix + r * num_words;
+        for (i = 0; i < num_words; ++i)
+          row[i] ^= piv[i];
+        rhs[r] ^= rhs[num_rows];
+      }
+    basic[num_rows++] = c;
+  }
+  for (r = num_rows; r < m; ++r)
+    inconsistent |= (rhs[r] != 0);
+  if (inconsistent)
+    get_solver()->fail();
+
+  assigned = new unsigned long long[num_words];
+  value = new unsigned long long[num_words];
+  std::fill(assigned, assigned + num_words, 0);
+  std::fill(value, value + num_words, 0);
+  reason = new unsigned long long[n * num_words];
+  conflict = new unsigned long long[num_words];
+  std::fill(conflict, conflict + num_words, 0);
+
+  min_id = scope[0].id();
+  int max_id = min_id;
+  for (i = 1; i < n; ++i) {
+    if (scope[i].id() < min_id)
+      min_id = scope[i].id();
+    if (scope[i].id() > max_id)
+      max_id = scope[i].id();
+  }
+  column_of.initialise(max_id - min_id + 1, max_id - min_id + 1, -1);
+  for (i = 0; i < n; ++i)
+    column_of[scope[i].id() - min_id] = i;
+
+  undo_size.initialise(get_solver(), 0);
+  init_prop = true;
+}
+
+Mistral::ConstraintXorSystem::~ConstraintXorSystem() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete gauss constraint" << std::endl;
+#endif
+  delete[] matrix;
+  delete[] rhs;
+  delete[] basic;
+  delete[] assigned;
+  delete[] value;
+  delete[] reason;
+  delete[] conflict;
+}
+
+Mistral::Explanation::iterator
+Mistral::ConstraintXorSystem::get_reason_for(const Atom a, const int lvl,
+                                              Explanation::iterator &end) {
+  explanation.clear();
+
+  // the assignments of the other columns of the row
+  unsigned long long *row =
+      (a == NULL_ATOM ? conflict : reason + column_of[a - min_id] * num_words);
+  unsigned long long word;
+  int i, c;
+  for (i = 0; i < num_words; ++i) {
+    word = row[i];
+    while (word) {
+      c = i * 64 + __builtin_ctzll(word);
+      word &= (word - 1);
+      if ((unsigned)(scope[c].id()) != a)
+        explanation.add(NOT(literal(scope[c])));
+    }
+  }
+
+  end = explanation.end();
+  return explanation.begin();
+}
+
+// clears the masks of the columns assigned below the current level
+void Mistral::ConstraintXorSystem::undo() {
+  int c;
+  while ((int)undo_column.size > undo_size) {
+    c = undo_column.pop();
+    assigned[c / 64] &= ~(1ULL << (c % 64));
+    value[c / 64] &= ~(1ULL << (c % 64));
+  }
+}
+
+void Mistral::ConstraintXorSystem::update(const int i) {
+  unsigned long long bit = (1ULL << (i % 64));
+  if (!(assigned[i / 64] & bit) && scope[i].is_ground()) {
+    assigned[i / 64] |= bit;
+    if (scope[i].get_min())
+      value[i / 64] |= bit;
+    undo_column.add(i);
+    undo_size = undo_column.size;
+  }
+}
+
+// the column c becomes the basic column of the row r
+void Mistral::ConstraintXorSystem::pivot(const int r, const int c) {
+  int w = c / 64, i, k;
+  unsigned long long bit = (1ULL << (c % 64)), *row,
+                     *piv = matrix + r * num_words;
+  for (k = 0; k < num_rows; ++k) {
+    row = matrix + k * num_words;
+    if (k != r && (row[w] & bit)) {
+      for (i = 0; i < num_words; ++i)
+        row[i] ^= piv[i];
+      rhs[k] ^= rhs[r];
+    }
+  }
+  basic[r] = c;
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintXorSystem::propagate() {
+  int r, i, c, free_col, num_free, parity;
+  unsigned long long *row, word;
+  bool fixpoint;
+
+  if (inconsistent)
+    return FAILURE(0);
+
+  if (init_prop) {
+    init_prop = false;
+    changes.clear();
+    for (i = 0; i < (int)scope.size; ++i)
+      if (scope[i].is_ground())
+        update(i);
+  } else {
+    undo();
+    while (!changes.empty())
+      update(changes.pop());
+  }
+
+  do {
+    fixpoint = true;
+
+    for (r = 0; r < num_rows; ++r) {
+      row = matrix + r * num_words;
+
+      num_free = 0;
+      free_col = -1;
+      parity = rhs[r];
+      for (i = 0; i < num_words; ++i) {
+        parity ^= (__builtin_popcountll(row[i] & value[i]) & 1);
+        word = row[i] & ~assigned[i];
+        if (word) {
+          num_free += __builtin_popcountll(word);
+          if (free_col < 0)
+            free_col = i * 64 + __builtin_ctzll(word);
+        }
+      }
+
+      if (num_free >= 2) {
+        if (assigned[basic[r] / 64] & (1ULL << (basic[r] % 64))) {
+          pivot(r, free_col);
+          fixpoint = false;
+        }
+      } else if (num_free == 1) {
+        c = free_col;
+        if (!scope[c].is_ground()) {
+          std::copy(row, row + num_words, reason + c * num_words);
+          scope[c].set_domain(parity);
+        }
+        update(c);
+        fixpoint = false;
+      } else if (parity) {
+        std::copy(row, row + num_words, conflict);
+        return FAILURE(0);
+      }
+    }
+  } while (!fixpoint);
+
+  return CONSISTENT;
+}
+
+int Mistral::ConstraintXorSystem::check(const int *s) const {
+  for (unsigned int r = 0; r < rows.size(); ++r) {
+    int t = parities[r];
+    for (unsigned int j = 0; j < rows[r].size(); ++j)
+      t += s[rows[r][j]];
+    if (t % 2)
+      return 1;
+  }
+  return 0;
+}
+
+std::ostream &Mistral::ConstraintXorSystem::display(std::ostream &os) const {
+  os << "gauss(" << rows.size() << " rows on " << scope[0];
+  for (unsigned int i = 1; i < scope.size; ++i)
+    os << ", " << scope[i];
+  os << ")";
+  return os;
+}
+
+Mistral::ConstraintWeightedBoolSumInterval::ConstraintWeightedBoolSumInterval(
+    Vector<Variable> &scp, const int L, const int U)
+    : GlobalConstraint(scp), lower_bound(L), upper_bound(U) {
+  priority = 1;
+  for (unsigned int i = 0; i < scope.size; ++i) {
+    weight.add(1);
+  }
+}
+
+Mistral::ConstraintWeightedBoolSumInterval::ConstraintWeightedBoolSumInterval(
+    Vector<Variable> &scp, Vector<int> &wgt, const int L, const int U)
+    : GlobalConstraint(scp), lower_bound(L), upper_bound(U) {
+  priority = 1;
+  for (unsigned int i = 0; i < scope.size; ++i) {
+    weight.add(wgt[i]);
+  }
+}
+
+Mistral::ConstraintWeightedBoolSumInterval::ConstraintWeightedBoolSumInterval(
+    std::vector<Variable> &scp, std::vector<int> &wgt, const int L, const int U)
+    : GlobalConstraint(scp), lower_bound(L), upper_bound(U) {
+  priority = 1;
+  for (unsigned int i = 0; i < scope.size; ++i) {
+    weight.add(wgt[i]);
+  }
+}
+
+void Mistral::ConstraintWeightedBoolSumInterval::initialise() {
+  ConstraintImplementation::initialise();
+  // set_idempotent(true);
   // set_idempotent(false);
 
   wpos = 0;
@@ -15401,6 +16207,329 @@ std::ostream &Mistral::PredicateKnapsack::display(std::ostream &os) const {
   return os;
 }
 
+Mistral::ConstraintKnapsack::ConstraintKnapsack(Vector<Variable> &scp,
+                                                const std::vector<int> &w,
+                                                const std::vector<int> &p,
+                                                const int L, const int U)
+    : GlobalConstraint(scp), weight(w), profit(p), lower_capacity(L),
+      upper_capacity(U) {
+  priority = 0;
+  layer = NULL;
+  forward_min = forward_max = NULL;
+  backward_min[0] = backward_min[1] = backward_max[0] = backward_max[1] = NULL;
+}
+
+void Mistral::ConstraintKnapsack::initialise() {
+  ConstraintImplementation::initialise();
+
+  num_items = scope.size - 1;
+  use_dp = (upper_capacity >= 0 &&
+            (long long)(num_items + 1) * (upper_capacity + 1) <=
+                KNAPSACK_DP_STATES);
+
+  // the reduced costs do not filter the last unassigned item completely
+  enforce_nfc1 = use_dp;
+
+  for (int i = 0; i < num_items; ++i)
+    trigger_on((use_dp ? _DOMAIN_ : _RANGE_), scope[i]);
+  trigger_on(_RANGE_, scope[num_items]);
+
+  GlobalConstraint::initialise();
+
+  for (int i = 0; i < num_items; ++i)
+    order.push_back(i);
+  std::sort(order.begin(), order.end(), [&](const int x, const int y) {
+    return (long long)profit[x] * weight[y] > (long long)profit[y] * weight[x];
+  });
+
+  if (use_dp) {
+    int width = upper_capacity + 1;
+    // the source is the weight 0, the other layers start with every weight
+    layer = new ReversibleSet[num_items + 1];
+    layer[0].initialise(get_solver(), 0, 0, 1, true);
+    for (int i = 1; i <= num_items; ++i)
+      layer[i].initialise(get_solver(), 0, upper_capacity, width, true);
+    forward_min = new int[(num_items + 1) * width];
+    forward_max = new int[(num_items + 1) * width];
+    for (int k = 0; k < 2; ++k) {
+      backward_min[k] = new int[width];
+      backward_max[k] = new int[width];
+    }
+  }
+}
+
+void Mistral::ConstraintKnapsack::mark_domain() {
+  if (use_dp)
+    for (int i = num_items; i--;)
+      if (scope[i].id() >= 0)
+        get_solver()->forbid(scope[i].id(), RANGE_VAR);
+}
+
+Mistral::ConstraintKnapsack::~ConstraintKnapsack() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete knapsack (dp) constraint" << std::endl;
+#endif
+  delete[] layer;
+  delete[] forward_min;
+  delete[] forward_max;
+  for (int k = 0; k < 2; ++k) {
+    delete[] backward_min[k];
+    delete[] backward_max[k];
+  }
+}
+
+// Trick's algorithm on the live states of the layered graph, the labels of
+// the states not reached (forward) or reaching nothing (backward) have a
+// greatest profit of -1, these states are removed
+Mistral::PropagationOutcome Mistral::ConstraintKnapsack::filter_dp() {
+  int i, j, k, w, w2, v, pv, width = upper_capacity + 1, best = -1,
+                             worst = INFTY, vali, vnxt, pmin, pmax;
+  int *cur_min, *cur_max, *nxt_min, *nxt_max, *fw_min, *fw_max;
+  Vector<int> values;
+  std::vector<bool> supported;
+
+  forward_max[0] = forward_min[0] = 0;
+
+  for (i = 0; i < num_items; ++i) {
+    cur_min = forward_min + i * width;
+    cur_max = forward_max + i * width;
+    nxt_min = cur_min + width;
+    nxt_max = cur_max + width;
+    for (j = 0; j < (int)layer[i + 1].size; ++j) {
+      w = layer[i + 1][j];
+      nxt_max[w] = -1;
+      nxt_min[w] = INFTY;
+    }
+
+    values.clear();
+    vnxt = scope[i].get_min();
+    do {
+      vali = vnxt;
+      vnxt = scope[i].next(vali);
+      values.add(vali);
+    } while (vali < vnxt);
+
+    for (j = 0; j < (int)layer[i].size; ++j) {
+      w = layer[i][j];
+      for (k = 0; k < (int)values.size; ++k) {
+        w2 = w + weight[i] * values[k];
+        if (w2 >= width)
+          break;
+        if (!layer[i + 1].contain(w2))
+          continue;
+        pv = profit[i] * values[k];
+        if (nxt_max[w2] < cur_max[w] + pv)
+          nxt_max[w2] = cur_max[w] + pv;
+        if (nxt_min[w2] > cur_min[w] + pv)
+          nxt_min[w2] = cur_min[w] + pv;
+      }
+    }
+
+    // the final states are the weights in [L,U]
+    dead.clear();
+    for (j = 0; j < (int)layer[i + 1].size; ++j) {
+      w = layer[i + 1][j];
+      if (nxt_max[w] < 0 || (i == num_items - 1 && w < lower_capacity))
+        dead.add(w);
+    }
+    if (dead.size == layer[i + 1].size)
+      return FAILURE(i);
+    for (j = 0; j < (int)dead.size; ++j)
+      layer[i + 1].reversible_remove(dead[j]);
+  }
+
+  cur_min = backward_min[0];
+  cur_max = backward_max[0];
+  fw_min = forward_min + num_items * width;
+  fw_max = forward_max + num_items * width;
+  for (j = 0; j < (int)layer[num_items].size; ++j) {
+    w = layer[num_items][j];
+    cur_max[w] = cur_min[w] = 0;
+    if (best < fw_max[w])
+      best = fw_max[w];
+    if (worst > fw_min[w])
+      worst = fw_min[w];
+  }
+  if (FAILED(scope[num_items].set_min(worst)) ||
+      FAILED(scope[num_items].set_max(best)))
+    return FAILURE(num_items);
+
+  pmin = scope[num_items].get_min();
+  pmax = scope[num_items].get_max();
+
+  for (i = num_items; i--;) {
+    // cur: backward layer i+1, nxt: backward layer i
+    nxt_min = backward_min[(num_items - i) & 1];
+    nxt_max = backward_max[(num_items - i) & 1];
+    fw_min = forward_min + i * width;
+    fw_max = forward_max + i * width;
+
+    values.clear();
+    vnxt = scope[i].get_min();
+    do {
+      vali = vnxt;
+      vnxt = scope[i].next(vali);
+      values.add(vali);
+    } while (vali < vnxt);
+    supported.assign(values.size, false);
+
+    dead.clear();
+    for (j = 0; j < (int)layer[i].size; ++j) {
+      w = layer[i][j];
+      nxt_max[w] = -1;
+      nxt_min[w] = INFTY;
+      for (k = 0; k < (int)values.size; ++k) {
+        v = values[k];
+        w2 = w + weight[i] * v;
+        if (w2 >= width)
+          break;
+        if (!layer[i + 1].contain(w2))
+          continue;
+        pv = profit[i] * v;
+        if (nxt_max[w] < cur_max[w2] + pv)
+          nxt_max[w] = cur_max[w2] + pv;
+        if (nxt_min[w] > cur_min[w2] + pv)
+          nxt_min[w] = cur_min[w2] + pv;
+
+        if (fw_max[w] + pv + cur_max[w2] >= pmin &&
+            fw_min[w] + pv + cur_min[w2] <= pmax)
+          supported[k] = true;
+      }
+
+      // no path through this state has a profit within the bounds of P
+      if (nxt_max[w] < 0 || fw_max[w] + nxt_max[w] < pmin ||
+          fw_min[w] + nxt_min[w] > pmax)
+        dead.add(w);
+    }
+    if (dead.size == layer[i].size)
+      return FAILURE(i);
+    for (j = 0; j < (int)dead.size; ++j)
+      layer[i].reversible_remove(dead[j]);
+
+    for (k = 0; k < (int)values.size; ++k)
+      if (!supported[k] && FAILED(scope[i].remove(values[k])))
+        return FAILURE(i);
+
+    cur_min = nxt_min;
+    cur_max = nxt_max;
+  }
+
+  return CONSISTENT;
+}
+
+// Dantzig's bound, and the reduced costs with respect to the critical item
+Mistral::PropagationOutcome Mistral::ConstraintKnapsack::filter_lp() {
+  int i, j, lb, ub;
+  long long base_weight = 0, base_profit = 0, max_weight = 0, cap, room;
+  long double ratio = 0, bound, slack, d;
+
+  for (i = 0; i < num_items; ++i) {
+    base_weight += (long long)weight[i] * scope[i].get_min();
+    base_profit += (long long)profit[i] * scope[i].get_min();
+  }
+  if (base_weight > upper_capacity)
+    return FAILURE(num_items);
+
+  for (i = 0; i < num_items; ++i)
+    max_weight += (long long)weight[i] * scope[i].get_max();
+  if (max_weight < lower_capacity)
+    return FAILURE(num_items);
+
+  // items that do not fit in the residual capacity
+  cap = upper_capacity - base_weight;
+  for (i = 0; i < num_items; ++i)
+    if (weight[i] > 0 && !scope[i].is_ground() &&
+        (long long)weight[i] * (scope[i].get_max() - scope[i].get_min()) >
+            cap &&
+        FAILED(scope[i].set_max(scope[i].get_min() + cap / weight[i])))
+      return FAILURE(i);
+
+  for (j = 0; j < num_items; ++j) {
+    i = order[j];
+    room = (long long)weight[i] * (scope[i].get_max() - scope[i].get_min());
+    if (room > cap) {
+      ratio = (long double)profit[i] / weight[i];
+      break;
+    }
+    cap -= room;
+  }
+
+  // value of the Lagrangian relaxation for this ratio
+  bound = ratio * upper_capacity;
+  for (i = 0; i < num_items; ++i) {
+    d = profit[i] - ratio * weight[i];
+    bound += d * (d > 0 ? scope[i].get_max() : scope[i].get_min());
+  }
+
+  if (FAILED(scope[num_items].set_min(base_profit)) ||
+      (bound < scope[num_items].get_max() &&
+       FAILED(scope[num_items].set_max((int)floorl(bound + 1e-6)))))
+    return FAILURE(num_items);
+
+  slack = bound - scope[num_items].get_min();
+  for (i = 0; i < num_items; ++i) {
+    if (scope[i].is_ground())
+      continue;
+    d = profit[i] - ratio * weight[i];
+    if (d > 1e-9) {
+      ub = scope[i].get_max();
+      if (d * (ub - scope[i].get_min()) > slack + 1e-6 &&
+          FAILED(scope[i].set_min((int)ceill(ub - slack / d - 1e-6))))
+        return FAILURE(i);
+    } else if (d < -1e-9) {
+      lb = scope[i].get_min();
+      if (-d * (scope[i].get_max() - lb) > slack + 1e-6 &&
+          FAILED(scope[i].set_max((int)floorl(lb + slack / -d + 1e-6))))
+        return FAILURE(i);
+    }
+  }
+
+  return CONSISTENT;
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintKnapsack::propagate() {
+  PropagationOutcome wiped = CONSISTENT;
+  long long size, prev_size;
+  int i;
+
+  // neither filtering is idempotent: iterate until no domain shrinks
+  size = 0;
+  for (i = 0; i <= num_items; ++i)
+    size += scope[i].get_size();
+  do {
+    prev_size = size;
+    wiped = (use_dp ? filter_dp() : filter_lp());
+    if (IS_OK(wiped)) {
+      size = 0;
+      for (i = 0; i <= num_items; ++i)
+        size += scope[i].get_size();
+    }
+  } while (IS_OK(wiped) && size < prev_size);
+
+  return wiped;
+}
+
+int Mistral::ConstraintKnapsack::check(const int *s) const {
+  long long t = 0, p = 0;
+  for (int i = 0; i < num_items; ++i) {
+    t += (long long)weight[i] * s[i];
+    p += (long long)profit[i] * s[i];
+  }
+  return p != s[num_items] || t < lower_capacity || t > upper_capacity;
+}
+
+std::ostream &Mistral::ConstraintKnapsack::display(std::ostream &os) const {
+  os << profit[0] << "*" << scope[0];
+  for (unsigned int i = 1; i < profit.size(); ++i)
+    os << " + " << profit[i] << "*" << scope[i];
+  os << " = " << scope[profit.size()] << " subject to " << lower_capacity
+     << " <= " << weight[0] << "*" << scope[0];
+  for (unsigned int i = 1; i < weight.size(); ++i)
+    os << " + " << weight[i] << "*" << scope[i];
+  os << " <= " << upper_capacity;
+  return os;
+}
+
 /////---END
 
 Mistral::PredicateElement::PredicateElement(Vector<Variable> &scp, const int o)
@@ -15749,81 +16878,436 @@ std::ostream &Mistral::PredicateElement::display(std::ostream &os) const {
   return os;
 }
 
-Mistral::ConstraintCliqueNotEqual::ConstraintCliqueNotEqual(
-    Vector<Variable> &scp, const int except)
-    : GlobalConstraint(scp), exception(except) {
-  priority = 2;
+// computes the distinct values of 'tab' in increasing order, the rank of each
+// entry in 'values', and the entries grouped by value (counting sort)
+static void group_by_value(const std::vector<int> &tab,
+                           Mistral::Vector<int> &values, int *rank, int *first,
+                           int *entry_of) {
+  int n = tab.size(), k = 0, v;
+  std::vector<int> sorted(tab);
+  std::sort(sorted.begin(), sorted.end());
+  for (int i = 0; i < n; ++i)
+    if (!i || sorted[i] != sorted[i - 1])
+      values.add(sorted[i]);
+
+  std::fill(first, first + values.size + 1, 0);
+  for (int i = 0; i < n; ++i) {
+    rank[i] = std::lower_bound(values.begin(), values.end(), tab[i]) -
+              values.begin();
+    ++first[rank[i] + 1];
+  }
+  for (v = 0; v < (int)values.size; ++v)
+    first[v + 1] += first[v];
+  for (int i = 0; i < n; ++i) {
+    k = rank[i];
+    entry_of[first[k]++] = i;
+  }
+  for (v = values.size; v > 0; --v)
+    first[v] = first[v - 1];
+  first[0] = 0;
 }
 
-void Mistral::ConstraintCliqueNotEqual::initialise() {
+/**********************************************
+* IntElement Constraint
+**********************************************/
+
+Mistral::ConstraintIntElement::ConstraintIntElement(
+    Vector<Variable> &scp, const std::vector<int> &tab, const int o)
+    : GlobalConstraint(scp), table(tab), offset(o) {
+  priority = 1;
+  rank = first = index_of = count = NULL;
+  alive = NULL;
+}
+
+void Mistral::ConstraintIntElement::initialise() {
   ConstraintImplementation::initialise();
-  for (unsigned int i = 0; i < scope.size; ++i) {
-    trigger_on(_VALUE_, scope[i]);
-  }
+  trigger_on(_DOMAIN_, scope[0]);
+  trigger_on(_DOMAIN_, scope[1]);
   GlobalConstraint::initialise();
-  culprit = -1;
-  // GlobalConstraint::set_idempotent(true);
+
+  int n = table.size();
+  rank = new int[n];
+  first = new int[n + 1];
+  index_of = new int[n];
+  group_by_value(table, values, rank, first, index_of);
+
+  count = new int[values.size];
+  for (unsigned int v = 0; v < values.size; ++v)
+    count[v] = first[v + 1] - first[v];
+  alive = new char[n];
+  std::fill(alive, alive + n, 1);
+
+  index_set.initialise(get_solver(), 0, n - 1, n, true);
+  value_set.initialise(get_solver(), 0, values.size - 1, values.size, true);
+  num_killed.initialise(get_solver(), 0);
+  init_prop = true;
 }
 
-void Mistral::ConstraintCliqueNotEqual::mark_domain() {
-  for (unsigned int i = scope.size; i;) {
-    // get_solver()->mark_non_convex(scope[i].id());
-    get_solver()->forbid(scope[--i].id(), RANGE_VAR);
-  }
+void Mistral::ConstraintIntElement::mark_domain() {
+  for (int i = 0; i < 2; ++i)
+    if (scope[i].id() >= 0)
+      get_solver()->forbid(scope[i].id(), RANGE_VAR);
 }
 
-Mistral::ConstraintCliqueNotEqual::~ConstraintCliqueNotEqual() {
+Mistral::ConstraintIntElement::~ConstraintIntElement() {
 #ifdef _DEBUG_MEMORY
-  std::cout << "c delete cliquenotequal constraint" << std::endl;
+  std::cout << "c delete int element constraint" << std::endl;
 #endif
+  delete[] rank;
+  delete[] first;
+  delete[] index_of;
+  delete[] count;
+  delete[] alive;
 }
 
-Mistral::PropagationOutcome Mistral::ConstraintCliqueNotEqual::propagate() {
+// revives the indices killed below the current level
+void Mistral::ConstraintIntElement::undo() {
+  int i;
+  while ((int)killed.size > num_killed) {
+    i = killed.pop();
+    alive[i] = 1;
+    ++count[rank[i]];
+  }
+}
 
-  unsigned int i, j, n = active.size, m;
-  int active_var, value;
-  Event evt;
+// returns the index in the scope of the variable that was wiped out, -1 if none
+int Mistral::ConstraintIntElement::kill(const int i) {
+  alive[i] = 0;
+  killed.add(i);
+  num_killed = killed.size;
+  if (--count[rank[i]] == 0 && scope[1].contain(values[rank[i]]) &&
+      FAILED(scope[1].remove(values[rank[i]])))
+    return 1;
+  return -1;
+}
 
-#ifdef _DEBUG_CLIQUENOTEQUAL
-  std::cout << "propagate " << this << std::endl;
-  for (i = 0; i < scope.size; ++i)
-    std::cout << scope[i].get_domain() << (changes.contain(i) ? "* " : " ");
-  std::cout << std::endl << active << std::endl;
-#endif
+Mistral::PropagationOutcome Mistral::ConstraintIntElement::propagate() {
+  int i, j, k, v, vali, vnxt, n = table.size();
 
-  for (i = 0; i < changes.size; ++i) {
-    culprit = changes[i];
-    value = scope[culprit].get_min();
+  undo();
 
-    if (value != exception) {
-#ifdef _DEBUG_CLIQUENOTEQUAL
-      std::cout << "react to " << scope[changes[i]] << "=" << value
-                << std::endl;
-      std::cout << "  check pairs of recently assigned vars: " << std::endl;
-#endif
-      for (j = i + 1; j < changes.size; ++j) {
-#ifdef _DEBUG_CLIQUENOTEQUAL
-        std::cout << "    " << scope[changes[j]] << "="
-                  << scope[changes[j]].get_min() << " ";
-#endif
-        if (scope[changes[j]].get_min() == value) {
-#ifdef _DEBUG_CLIQUENOTEQUAL
-          std::cout << "FAIL!" << std::endl;
-#endif
+  if (FAILED(scope[0].set_min(offset)) ||
+      FAILED(scope[0].set_max(offset + n - 1)))
+    return FAILURE(0);
 
-          // std::cout << "a " << culprit << std::endl;
-          return FAILURE(changes[j]);
+  if (init_prop) {
+    vnxt = scope[1].get_min();
+    do {
+      vali = vnxt;
+      vnxt = scope[1].next(vali);
+      if (!std::binary_search(values.begin(), values.end(), vali) &&
+          FAILED(scope[1].remove(vali)))
+        return FAILURE(1);
+    } while (vali < vnxt);
+    init_prop = false;
+  }
+
+  // indices removed from X
+  for (k = index_set.size; k--;) {
+    i = index_set[k];
+    if (!scope[0].contain(i + offset)) {
+      index_set.reversible_remove(i);
+      if (alive[i] && kill(i) >= 0)
+        return FAILURE(1);
+    }
+  }
+
+  // values removed from Y
+  for (k = value_set.size; k--;) {
+    v = value_set[k];
+    if (!scope[1].contain(values[v])) {
+      value_set.reversible_remove(v);
+      for (j = first[v]; j < first[v + 1]; ++j) {
+        i = index_of[j];
+        if (alive[i]) {
+          kill(i);
+          index_set.reversible_remove(i);
+          if (FAILED(scope[0].remove(i + offset)))
+            return FAILURE(0);
         }
-#ifdef _DEBUG_CLIQUENOTEQUAL
-        else
-          std::cout << "OK!" << std::endl;
-#endif
       }
+    }
+  }
 
-#ifdef _DEBUG_CLIQUENOTEQUAL
-      std::cout << "  remove this value from active vars: " << std::endl;
-#endif
-      // since the set of active variables might change while
+  return CONSISTENT;
+}
+
+int Mistral::ConstraintIntElement::check(const int *s) const {
+  int i = s[0] - offset;
+  return (i < 0 || i >= (int)table.size() || table[i] != s[1]);
+}
+
+std::ostream &Mistral::ConstraintIntElement::display(std::ostream &os) const {
+  os << "[" << table[0];
+  for (unsigned int i = 1; i < table.size(); ++i)
+    os << ", " << table[i];
+  os << "][" << scope[0];
+  if (offset)
+    os << " - " << offset;
+  os << "] == " << scope[1];
+  return os;
+}
+
+/**********************************************
+* Element2D Constraint
+**********************************************/
+
+Mistral::ConstraintElement2D::ConstraintElement2D(
+    Vector<Variable> &scp, const std::vector<std::vector<int> > &M,
+    const int ro, const int co)
+    : GlobalConstraint(scp), row_offset(ro), col_offset(co) {
+  priority = 1;
+  rank = first = cell_of = row_count = col_count = value_count = NULL;
+  alive = NULL;
+  num_rows = M.size();
+  num_cols = (num_rows ? M[0].size() : 0);
+  for (int r = 0; r < num_rows; ++r)
+    for (int c = 0; c < num_cols; ++c)
+      matrix.push_back(M[r][c]);
+}
+
+Mistral::ConstraintElement2D::ConstraintElement2D(
+    Vector<Variable> &scp, const int nr, const int nc,
+    const std::vector<int> &M, const int ro, const int co)
+    : GlobalConstraint(scp), num_rows(nr), num_cols(nc), row_offset(ro),
+      col_offset(co), matrix(M) {
+  priority = 1;
+  rank = first = cell_of = row_count = col_count = value_count = NULL;
+  alive = NULL;
+}
+
+void Mistral::ConstraintElement2D::initialise() {
+  ConstraintImplementation::initialise();
+  for (int i = 0; i < 3; ++i)
+    trigger_on(_DOMAIN_, scope[i]);
+  GlobalConstraint::initialise();
+
+  int n = matrix.size();
+  rank = new int[n];
+  first = new int[n + 1];
+  cell_of = new int[n];
+  group_by_value(matrix, values, rank, first, cell_of);
+
+  row_count = new int[num_rows];
+  std::fill(row_count, row_count + num_rows, num_cols);
+  col_count = new int[num_cols];
+  std::fill(col_count, col_count + num_cols, num_rows);
+  value_count = new int[values.size];
+  for (unsigned int v = 0; v < values.size; ++v)
+    value_count[v] = first[v + 1] - first[v];
+  alive = new char[n];
+  std::fill(alive, alive + n, 1);
+
+  row_set.initialise(get_solver(), 0, num_rows - 1, num_rows, true);
+  col_set.initialise(get_solver(), 0, num_cols - 1, num_cols, true);
+  value_set.initialise(get_solver(), 0, values.size - 1, values.size, true);
+  num_killed.initialise(get_solver(), 0);
+  init_prop = true;
+}
+
+void Mistral::ConstraintElement2D::mark_domain() {
+  for (int i = 0; i < 3; ++i)
+    if (scope[i].id() >= 0)
+      get_solver()->forbid(scope[i].id(), RANGE_VAR);
+}
+
+Mistral::ConstraintElement2D::~ConstraintElement2D() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete element2d constraint" << std::endl;
+#endif
+  delete[] rank;
+  delete[] first;
+  delete[] cell_of;
+  delete[] row_count;
+  delete[] col_count;
+  delete[] value_count;
+  delete[] alive;
+}
+
+// revives the cells killed below the current level
+void Mistral::ConstraintElement2D::undo() {
+  int k;
+  while ((int)killed.size > num_killed) {
+    k = killed.pop();
+    alive[k] = 1;
+    ++row_count[k / num_cols];
+    ++col_count[k % num_cols];
+    ++value_count[rank[k]];
+  }
+}
+
+// returns the index in the scope of the variable that was wiped out, -1 if none
+int Mistral::ConstraintElement2D::kill(const int k) {
+  int r = k / num_cols, c = k % num_cols, v = rank[k];
+
+  alive[k] = 0;
+  killed.add(k);
+  num_killed = killed.size;
+
+  if (--row_count[r] == 0 && scope[0].contain(r + row_offset) &&
+      FAILED(scope[0].remove(r + row_offset)))
+    return 0;
+  if (--col_count[c] == 0 && scope[1].contain(c + col_offset) &&
+      FAILED(scope[1].remove(c + col_offset)))
+    return 1;
+  if (--value_count[v] == 0 && scope[2].contain(values[v]) &&
+      FAILED(scope[2].remove(values[v])))
+    return 2;
+  return -1;
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintElement2D::propagate() {
+  int r, c, v, k, j, x, vali, vnxt;
+
+  undo();
+
+  if (FAILED(scope[0].set_min(row_offset)) ||
+      FAILED(scope[0].set_max(row_offset + num_rows - 1)))
+    return FAILURE(0);
+  if (FAILED(scope[1].set_min(col_offset)) ||
+      FAILED(scope[1].set_max(col_offset + num_cols - 1)))
+    return FAILURE(1);
+
+  if (init_prop) {
+    vnxt = scope[2].get_min();
+    do {
+      vali = vnxt;
+      vnxt = scope[2].next(vali);
+      if (!std::binary_search(values.begin(), values.end(), vali) &&
+          FAILED(scope[2].remove(vali)))
+        return FAILURE(2);
+    } while (vali < vnxt);
+    init_prop = false;
+  }
+
+  // rows removed from R
+  for (j = row_set.size; j--;) {
+    r = row_set[j];
+    if (!scope[0].contain(r + row_offset)) {
+      row_set.reversible_remove(r);
+      for (k = r * num_cols; k < (r + 1) * num_cols; ++k)
+        if (alive[k] && (x = kill(k)) >= 0)
+          return FAILURE(x);
+    }
+  }
+
+  // columns removed from C
+  for (j = col_set.size; j--;) {
+    c = col_set[j];
+    if (!scope[1].contain(c + col_offset)) {
+      col_set.reversible_remove(c);
+      for (k = c; k < num_rows * num_cols; k += num_cols)
+        if (alive[k] && (x = kill(k)) >= 0)
+          return FAILURE(x);
+    }
+  }
+
+  // values removed from Z
+  for (j = value_set.size; j--;) {
+    v = value_set[j];
+    if (!scope[2].contain(values[v])) {
+      value_set.reversible_remove(v);
+      for (k = first[v]; k < first[v + 1]; ++k)
+        if (alive[cell_of[k]] && (x = kill(cell_of[k])) >= 0)
+          return FAILURE(x);
+    }
+  }
+
+  return CONSISTENT;
+}
+
+int Mistral::ConstraintElement2D::check(const int *s) const {
+  int r = s[0] - row_offset, c = s[1] - col_offset;
+  return (r < 0 || r >= num_rows || c < 0 || c >= num_cols ||
+          matrix[r * num_cols + c] != s[2]);
+}
+
+std::ostream &Mistral::ConstraintElement2D::display(std::ostream &os) const {
+  os << "M(" << num_rows << "x" << num_cols << ")[" << scope[0];
+  if (row_offset)
+    os << " - " << row_offset;
+  os << "][" << scope[1];
+  if (col_offset)
+    os << " - " << col_offset;
+  os << "] == " << scope[2];
+  return os;
+}
+
+Mistral::ConstraintCliqueNotEqual::ConstraintCliqueNotEqual(
+    Vector<Variable> &scp, const int except)
+    : GlobalConstraint(scp), exception(except) {
+  priority = 2;
+}
+
+void Mistral::ConstraintCliqueNotEqual::initialise() {
+  ConstraintImplementation::initialise();
+  for (unsigned int i = 0; i < scope.size; ++i) {
+    trigger_on(_VALUE_, scope[i]);
+  }
+  GlobalConstraint::initialise();
+  culprit = -1;
+  // GlobalConstraint::set_idempotent(true);
+}
+
+void Mistral::ConstraintCliqueNotEqual::mark_domain() {
+  for (unsigned int i = scope.size; i;) {
+    // get_solver()->mark_non_convex(scope[i].id());
+    get_solver()->forbid(scope[--i].id(), RANGE_VAR);
+  }
+}
+
+Mistral::ConstraintCliqueNotEqual::~ConstraintCliqueNotEqual() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete cliquenotequal constraint" << std::endl;
+#endif
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintCliqueNotEqual::propagate() {
+
+  unsigned int i, j, n = active.size, m;
+  int active_var, value;
+  Event evt;
+
+#ifdef _DEBUG_CLIQUENOTEQUAL
+  std::cout << "propagate " << this << std::endl;
+  for (i = 0; i < scope.size; ++i)
+    std::cout << scope[i].get_domain() << (changes.contain(i) ? "* " : " ");
+  std::cout << std::endl << active << std::endl;
+#endif
+
+  for (i = 0; i < changes.size; ++i) {
+    culprit = changes[i];
+    value = scope[culprit].get_min();
+
+    if (value != exception) {
+#ifdef _DEBUG_CLIQUENOTEQUAL
+      std::cout << "react to " << scope[changes[i]] << "=" << value
+                << std::endl;
+      std::cout << "  check pairs of recently assigned vars: " << std::endl;
+#endif
+      for (j = i + 1; j < changes.size; ++j) {
+#ifdef _DEBUG_CLIQUENOTEQUAL
+        std::cout << "    " << scope[changes[j]] << "="
+                  << scope[changes[j]].get_min() << " ";
+#endif
+        if (scope[changes[j]].get_min() == value) {
+#ifdef _DEBUG_CLIQUENOTEQUAL
+          std::cout << "FAIL!" << std::endl;
+#endif
+
+          // std::cout << "a " << culprit << std::endl;
+          return FAILURE(changes[j]);
+        }
+#ifdef _DEBUG_CLIQUENOTEQUAL
+        else
+          std::cout << "OK!" << std::endl;
+#endif
+      }
+
+#ifdef _DEBUG_CLIQUENOTEQUAL
+      std::cout << "  remove this value from active vars: " << std::endl;
+#endif
+      // since the set of active variables might change while
       // processing this loop, we do it backward
       for (j = n; j; --j) {
         active_var = active[j - 1];
@@ -17253,6 +18737,295 @@ Mistral::ConstraintMultiAtMostSeqCard::display(std::ostream &os) const {
   return os;
 }
 
+/**********************************************
+* Sequence Constraint
+**********************************************/
+
+Mistral::ConstraintSequence::ConstraintSequence(Vector<Variable> &scp,
+                                                const int lo, const int hi,
+                                                const int q,
+                                                const std::vector<int> &vals)
+    : GlobalConstraint(scp), lower_bound(lo), upper_bound(hi), window(q),
+      values(vals) {
+  priority = 1;
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+
+  boolean = true;
+  for (unsigned int i = 0; boolean && i < scope.size; ++i)
+    boolean = scope[i].is_boolean();
+
+  sum = y_min = y_max = queue = NULL;
+  index = lowlink = component = stack = call_node = call_next = NULL;
+  queued = NULL;
+}
+
+void Mistral::ConstraintSequence::initialise() {
+  ConstraintImplementation::initialise();
+  for (unsigned int i = 0; i < scope.size; ++i)
+    trigger_on(_DOMAIN_, scope[i]);
+  GlobalConstraint::initialise();
+
+  int n = scope.size;
+  sum = new int[n + 1];
+  y_min = new int[n];
+  y_max = new int[n];
+  queue = new int[n + 2];
+  queued = new bool[n + 1];
+  index = new int[n + 1];
+  lowlink = new int[n + 1];
+  component = new int[n + 1];
+  stack = new int[n + 1];
+  call_node = new int[n + 1];
+  call_next = new int[n + 1];
+
+  // S_k <= k is an upper bound of the greatest solution, every node is
+  // relaxed in the first propagation
+  head = tail = 0;
+  for (int k = 0; k <= n; ++k) {
+    sum[k] = k;
+    queued[k] = false;
+    push(k);
+  }
+
+  undo_size.initialise(get_solver(), 0);
+}
+
+Mistral::ConstraintSequence::~ConstraintSequence() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete sequence constraint" << std::endl;
+#endif
+  delete[] sum;
+  delete[] y_min;
+  delete[] y_max;
+  delete[] queue;
+  delete[] queued;
+  delete[] index;
+  delete[] lowlink;
+  delete[] component;
+  delete[] stack;
+  delete[] call_node;
+  delete[] call_next;
+}
+
+void Mistral::ConstraintSequence::undo() {
+  while ((int)undo_node.size > undo_size) {
+    sum[undo_node.back()] = undo_value.back();
+    undo_node.pop();
+    undo_value.pop();
+  }
+}
+
+void Mistral::ConstraintSequence::set_y_bounds(const int i) {
+  int count = 0;
+  for (unsigned int k = 0; k < values.size(); ++k)
+    count += scope[i].contain(values[k]);
+  y_max[i] = (count > 0);
+  y_min[i] = (count == (int)scope[i].get_size());
+}
+
+void Mistral::ConstraintSequence::push(const int node) {
+  if (!queued[node]) {
+    queued[node] = true;
+    queue[tail] = node;
+    if (++tail > (int)scope.size + 1)
+      tail = 0;
+  }
+}
+
+// Bellman-Ford from the current sums, which are upper bounds of the
+// shortest paths. A negative value means that there is a negative cycle
+bool Mistral::ConstraintSequence::relax() {
+  int n = scope.size, u, v, w, k;
+
+  while (head != tail) {
+    u = queue[head];
+    if (++head > n + 1)
+      head = 0;
+    queued[u] = false;
+
+    for (k = 0; k < 4; ++k) {
+      if (k == 0 && u < n) {
+        v = u + 1;
+        w = y_max[u];
+      } else if (k == 1 && u > 0) {
+        v = u - 1;
+        w = -y_min[u - 1];
+      } else if (k == 2 && u + window <= n) {
+        v = u + window;
+        w = upper_bound;
+      } else if (k == 3 && u >= window) {
+        v = u - window;
+        w = -lower_bound;
+      } else
+        continue;
+
+      if (sum[v] > sum[u] + w) {
+        undo_node.add(v);
+        undo_value.add(sum[v]);
+        sum[v] = sum[u] + w;
+        if (sum[v] < 0) {
+          while (head != tail) {
+            queued[queue[head]] = false;
+            if (++head > n + 1)
+              head = 0;
+          }
+          return false;
+        }
+        push(v);
+      }
+    }
+  }
+
+  return true;
+}
+
+// next tight edge out of node, cursor is the rank of the last one
+int Mistral::ConstraintSequence::successor(const int node, int &cursor) {
+  int n = scope.size, v, w;
+
+  while (++cursor < 4) {
+    if (cursor == 0 && node < n) {
+      v = node + 1;
+      w = y_max[node];
+    } else if (cursor == 1 && node > 0) {
+      v = node - 1;
+      w = -y_min[node - 1];
+    } else if (cursor == 2 && node + window <= n) {
+      v = node + window;
+      w = upper_bound;
+    } else if (cursor == 3 && node >= window) {
+      v = node - window;
+      w = -lower_bound;
+    } else
+      continue;
+
+    if (sum[v] == sum[node] + w)
+      return v;
+  }
+
+  return -1;
+}
+
+void Mistral::ConstraintSequence::strongly_connected_components() {
+  int num_nodes = scope.size + 1, count = 0, top = 0, depth, u, w, s;
+
+  std::fill(index, index + num_nodes, -1);
+  std::fill(component, component + num_nodes, -1);
+
+  for (s = 0; s < num_nodes; ++s) {
+    if (index[s] >= 0)
+      continue;
+
+    index[s] = lowlink[s] = count++;
+    stack[top++] = s;
+    call_next[s] = -1;
+    call_node[0] = s;
+    depth = 1;
+
+    while (depth) {
+      u = call_node[depth - 1];
+      w = successor(u, call_next[u]);
+
+      if (w >= 0) {
+        if (index[w] < 0) {
+          index[w] = lowlink[w] = count++;
+          stack[top++] = w;
+          call_next[w] = -1;
+          call_node[depth++] = w;
+        } else if (component[w] < 0 && index[w] < lowlink[u]) {
+          lowlink[u] = index[w];
+        }
+      } else {
+        --depth;
+        if (lowlink[u] == index[u]) {
+          do {
+            w = stack[--top];
+            component[w] = u;
+          } while (w != u);
+        }
+        if (depth && lowlink[u] < lowlink[call_node[depth - 1]])
+          lowlink[call_node[depth - 1]] = lowlink[u];
+      }
+    }
+  }
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintSequence::propagate() {
+  int n = scope.size, i, vali, vnxt;
+
+  undo();
+
+  for (i = 0; i < n; ++i)
+    set_y_bounds(i);
+  for (i = changes.size; i--;) {
+    push(changes[i]);
+    push(changes[i] + 1);
+  }
+
+  if (!relax())
+    return FAILURE(changes.size ? changes[0] : 0);
+
+  strongly_connected_components();
+
+  for (i = 0; i < n; ++i) {
+    if (y_min[i] == y_max[i] || component[i] != component[i + 1])
+      continue;
+
+    if (sum[i + 1] > sum[i]) {
+      vnxt = scope[i].get_min();
+      do {
+        vali = vnxt;
+        vnxt = scope[i].next(vali);
+        if (!std::binary_search(values.begin(), values.end(), vali) &&
+            FAILED(scope[i].remove(vali)))
+          return FAILURE(i);
+      } while (vali < vnxt);
+    } else {
+      for (unsigned int k = 0; k < values.size(); ++k)
+        if (FAILED(scope[i].remove(values[k])))
+          return FAILURE(i);
+    }
+  }
+
+  undo_size = undo_node.size;
+
+  return CONSISTENT;
+}
+
+Mistral::Explanation::iterator
+Mistral::ConstraintSequence::get_reason_for(const Atom a, const int lvl,
+                                            iterator &end) {
+  ConstraintMultiAtMostSeqCard::naive_reason(scope, get_solver(), a,
+                                             explanation);
+  end = explanation.end();
+  return explanation.begin();
+}
+
+int Mistral::ConstraintSequence::check(const int *s) const {
+  int n = scope.size, count = 0, i;
+  for (i = 0; i < n; ++i) {
+    count += std::binary_search(values.begin(), values.end(), s[i]);
+    if (i >= window)
+      count -= std::binary_search(values.begin(), values.end(), s[i - window]);
+    if (i >= window - 1 && (count < lower_bound || count > upper_bound))
+      return 1;
+  }
+  return 0;
+}
+
+std::ostream &Mistral::ConstraintSequence::display(std::ostream &os) const {
+  os << "sequence(" << lower_bound << ", " << upper_bound << ", " << window
+     << ", [" << scope[0];
+  for (unsigned int i = 1; i < scope.size; ++i)
+    os << " " << scope[i];
+  os << "], {";
+  for (unsigned int k = 0; k < values.size(); ++k)
+    os << (k ? "," : "") << values[k];
+  os << "})";
+  return os;
+}
+
 /**********************************************
 * Stretch Constraint
 **********************************************/
@@ -18267,91 +20040,825 @@ double Mistral::ConstraintAllDiff::weight_conflict(double unit, Vector<double>&
       // }
       // std::cout << std::endl;
 
-      for (int i = 0; i <= rank; ++i) {
-        l = other_bounds[rank - i];
-        if (u - l < i)
-          break;
-        // std::cout << "[" << l << ".." << u << "] is ok\n";
+      for (int i = 0; i <= rank; ++i) {
+        l = other_bounds[rank - i];
+        if (u - l < i)
+          break;
+        // std::cout << "[" << l << ".." << u << "] is ok\n";
+      }
+    }
+
+#ifdef _DIV_ARITY
+    int size_conflict = 0;
+    for (int i = 0; i < scope.size; ++i)
+      if (iv[i].min >= l && iv[i].max <= u)
+        ++size_conflict;
+    w /= (double)size_conflict;
+#endif
+
+    for (size_t i = 0; i < scope.size; ++i) {
+      // std::cout << scope[i].get_domain() << std::endl;
+      if (iv[i].min >= l && iv[i].max <= u) {
+        // std::cout << " " << scope[i].id();
+        idx = scope[i].id();
+        if (idx >= 0) {
+          weights[idx] += w;
+#ifdef _ONLY_ACTIVE
+          weight_contributed[i] += w;
+#endif
+          if (the_max < weights[idx])
+            the_max = weights[idx];
+        }
+      }
+    }
+  } else {
+
+    // TODO: this thing is not "correct" (we don't care it's a heuristic, but
+    // still)
+
+    rank = -1 - expl_note;
+    l = scope[rank].get_min();
+    u = scope[rank].get_max();
+
+#ifdef _DIV_ARITY
+    int size_conflict = 0;
+    for (int i = 0; i < scope.size; ++i)
+      if (iv[i].min <= u && iv[i].max >= l)
+        ++size_conflict;
+    w /= (double)size_conflict;
+#endif
+
+    for (size_t i = 0; i < scope.size; ++i) {
+      if (iv[i].min <= u && iv[i].max >= l) {
+        idx = scope[i].id();
+        if (idx >= 0) {
+          weights[idx] += w;
+#ifdef _ONLY_ACTIVE
+          weight_contributed[i] += w;
+#endif
+          if (the_max < weights[idx])
+            the_max = weights[idx];
+        }
+      }
+    }
+  }
+
+  // std::cout << "the Hall interval is  [" << l << ".." << u << "]\n";
+
+  return the_max;
+
+  // std::cout << std::endl;
+}
+#endif
+
+void Mistral::ConstraintAllDiff::print_structs() {
+
+  std::cout << std::endl;
+  for (size_t i = 0; i < scope.size; ++i) {
+    std::cout << i << " [" << minsorted[i]->min << ".." << minsorted[i]->max
+              << "] [" << maxsorted[i]->min << ".." << maxsorted[i]->max
+              << "] \n";
+  }
+  // for(int i=0; i<2*scope.size+2; ++i) {
+  //   std::cout << i << " bounds=" << bounds[i] << " t=" << t[i] << " d=" <<
+  //   d[i] << " h=" << h[i] << std::endl;
+  // }
+}
+
+
+/**********************************************
+* AllDiff Constraint (domain consistency)
+**********************************************/
+
+Mistral::ConstraintAllDiffGAC::ConstraintAllDiffGAC(Vector<Variable> &scp)
+    : GlobalConstraint(scp) {
+  priority = 0;
+  match_var = match_val = parent = visited = NULL;
+  index = lowlink = component = stack = call_node = call_next = NULL;
+}
+
+Mistral::ConstraintAllDiffGAC::ConstraintAllDiffGAC(std::vector<Variable> &scp)
+    : GlobalConstraint(scp) {
+  priority = 0;
+  match_var = match_val = parent = visited = NULL;
+  index = lowlink = component = stack = call_node = call_next = NULL;
+}
+
+void Mistral::ConstraintAllDiffGAC::initialise() {
+
+  ConstraintImplementation::initialise();
+
+  for (unsigned int i = 0; i < scope.size; ++i) {
+    trigger_on(_DOMAIN_, scope[i]);
+  }
+
+  GlobalConstraint::initialise();
+
+  int lb = INFTY, ub = -INFTY, n = scope.size;
+  for (int i = 0; i < n; ++i) {
+    if (scope[i].get_min() < lb)
+      lb = scope[i].get_min();
+    if (scope[i].get_max() > ub)
+      ub = scope[i].get_max();
+  }
+  offset = lb;
+  num_values = ub - lb + 1;
+  num_free_values = num_values;
+
+  match_var = new int[n];
+  std::fill(match_var, match_var + n, NOVAL);
+  match_val = new int[num_values];
+  std::fill(match_val, match_val + num_values, -1);
+
+  parent = new int[num_values];
+  visited = new int[n + num_values];
+  std::fill(visited, visited + n + num_values, 0);
+  stamp = 0;
+
+  int num_nodes = n + num_values + 1;
+  index = new int[num_nodes];
+  lowlink = new int[num_nodes];
+  component = new int[num_nodes];
+  stack = new int[num_nodes];
+  call_node = new int[num_nodes];
+  call_next = new int[num_nodes];
+}
+
+void Mistral::ConstraintAllDiffGAC::mark_domain() {
+  for (unsigned int i = scope.size; i--;) {
+    if (scope[i].id() >= 0)
+      get_solver()->forbid(scope[i].id(), RANGE_VAR);
+  }
+}
+
+Mistral::ConstraintAllDiffGAC::~ConstraintAllDiffGAC() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete alldiff (gac) constraint" << std::endl;
+#endif
+  delete[] match_var;
+  delete[] match_val;
+  delete[] parent;
+  delete[] visited;
+  delete[] index;
+  delete[] lowlink;
+  delete[] component;
+  delete[] stack;
+  delete[] call_node;
+  delete[] call_next;
+}
+
+// breadth-first search for an alternating path from the unmatched variable x
+// to a free value, the matching is flipped along the path when one is found
+bool Mistral::ConstraintAllDiffGAC::augment(const int x) {
+  int n = scope.size, i, y, z, vali, vnxt, w, prev;
+
+  if (++stamp == INFTY) {
+    std::fill(visited, visited + n + num_values, 0);
+    stamp = 1;
+  }
+
+  frontier.clear();
+  frontier.add(x);
+  visited[x] = stamp;
+
+  for (i = 0; i < (int)(frontier.size); ++i) {
+    y = frontier[i];
+    vnxt = scope[y].get_min();
+    do {
+      vali = vnxt;
+      vnxt = scope[y].next(vali);
+
+      w = vali - offset;
+      if (visited[n + w] != stamp) {
+        visited[n + w] = stamp;
+        parent[w] = y;
+        z = match_val[w];
+        if (z < 0) {
+          // augment
+          do {
+            y = parent[w];
+            prev = match_var[y];
+            match_var[y] = w + offset;
+            match_val[w] = y;
+            w = prev - offset;
+          } while (y != x);
+          --num_free_values;
+          return true;
+        } else if (visited[z] != stamp) {
+          visited[z] = stamp;
+          frontier.add(z);
+        }
+      }
+    } while (vali < vnxt);
+  }
+
+  return false;
+}
+
+// successors in the residual graph: a variable points to its unmatched
+// values, a value to its matched variable (or to the sink if free) and the
+// sink to every matched value
+int Mistral::ConstraintAllDiffGAC::successor(const int node, int &cursor) {
+  int n = scope.size, v;
+
+  if (node < n) {
+    do {
+      if (cursor == NOVAL)
+        v = scope[node].get_min();
+      else if (cursor >= scope[node].get_max())
+        return -1;
+      else
+        v = scope[node].next(cursor);
+      cursor = v;
+    } while (v == match_var[node]);
+    return n + v - offset;
+  } else if (node < n + num_values) {
+    if (cursor)
+      return -1;
+    cursor = 1;
+    v = match_val[node - n];
+    return (v >= 0 ? v : n + num_values);
+  }
+
+  if (cursor >= n)
+    return -1;
+  return n + match_var[cursor++] - offset;
+}
+
+void Mistral::ConstraintAllDiffGAC::strongly_connected_components() {
+  int n = scope.size, num_nodes = n + num_values + 1, count = 0, top = 0,
+      depth, u, w, s;
+
+  std::fill(index, index + num_nodes, -1);
+  std::fill(component, component + num_nodes, -1);
+
+  // iterative version of Tarjan's algorithm, started from every variable
+  // (values outside all domains are irrelevant)
+  for (s = 0; s < n; ++s) {
+    if (index[s] >= 0)
+      continue;
+
+    index[s] = lowlink[s] = count++;
+    stack[top++] = s;
+    call_next[s] = NOVAL;
+    call_node[0] = s;
+    depth = 1;
+
+    while (depth) {
+      u = call_node[depth - 1];
+      w = successor(u, call_next[u]);
+
+      if (w >= 0) {
+        if (index[w] < 0) {
+          index[w] = lowlink[w] = count++;
+          stack[top++] = w;
+          call_next[w] = (w < n ? NOVAL : 0);
+          call_node[depth++] = w;
+        } else if (component[w] < 0 && index[w] < lowlink[u]) {
+          lowlink[u] = index[w];
+        }
+      } else {
+        --depth;
+        if (lowlink[u] == index[u]) {
+          do {
+            w = stack[--top];
+            component[w] = u;
+          } while (w != u);
+        }
+        if (depth && lowlink[u] < lowlink[call_node[depth - 1]])
+          lowlink[call_node[depth - 1]] = lowlink[u];
+      }
+    }
+  }
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintAllDiffGAC::propagate() {
+  int n = scope.size, i, vali, vnxt;
+
+  // the matching survives backtracks, only the edges pruned since are lost
+  for (i = 0; i < n; ++i) {
+    if (match_var[i] != NOVAL && !scope[i].contain(match_var[i])) {
+      match_val[match_var[i] - offset] = -1;
+      match_var[i] = NOVAL;
+      ++num_free_values;
+    }
+  }
+
+  for (i = 0; i < n; ++i) {
+    if (match_var[i] == NOVAL && !augment(i))
+      return FAILURE(i);
+  }
+
+  strongly_connected_components();
+
+  for (i = 0; i < n; ++i) {
+    if (scope[i].is_ground())
+      continue;
+
+    pruned.clear();
+    vnxt = scope[i].get_min();
+    do {
+      vali = vnxt;
+      vnxt = scope[i].next(vali);
+      if (vali != match_var[i] &&
+          component[i] != component[n + vali - offset])
+        pruned.add(vali);
+    } while (vali < vnxt);
+
+    for (unsigned int j = 0; j < pruned.size; ++j)
+      if (FAILED(scope[i].remove(pruned[j])))
+        return FAILURE(i);
+  }
+
+  return CONSISTENT;
+}
+
+int Mistral::ConstraintAllDiffGAC::check(const int *s) const {
+  int i = scope.size, j;
+  while (--i) {
+    j = i;
+    while (j--)
+      if (s[i] == s[j])
+        return 1;
+  }
+  return 0;
+}
+
+std::ostream &Mistral::ConstraintAllDiffGAC::display(std::ostream &os) const {
+  os << "alldiff-gac(" << scope[0];
+  for (unsigned int i = 1; i < scope.size; ++i)
+    os << ", " << scope[i];
+  os << ")";
+  return os;
+}
+
+/**********************************************
+* NValue Constraint
+**********************************************/
+
+Mistral::ConstraintNValue::ConstraintNValue(Vector<Variable> &scp)
+    : GlobalConstraint(scp) {
+  priority = 1;
+  union_stamp = used_stamp = NULL;
+}
+
+void Mistral::ConstraintNValue::initialise() {
+  ConstraintImplementation::initialise();
+
+  int n = scope.size - 1;
+  for (int i = 0; i < n; ++i) {
+    trigger_on(_DOMAIN_, scope[i]);
+  }
+  trigger_on(_RANGE_, scope[n]);
+
+  GlobalConstraint::initialise();
+
+  int lb = INFTY, ub = -INFTY;
+  for (int i = 0; i < n; ++i) {
+    if (scope[i].get_min() < lb)
+      lb = scope[i].get_min();
+    if (scope[i].get_max() > ub)
+      ub = scope[i].get_max();
+    order.add(i);
+  }
+  offset = lb;
+  num_values = (n ? ub - lb + 1 : 1);
+
+  union_stamp = new int[num_values];
+  used_stamp = new int[num_values];
+  std::fill(union_stamp, union_stamp + num_values, 0);
+  std::fill(used_stamp, used_stamp + num_values, 0);
+  stamp = 0;
+}
+
+void Mistral::ConstraintNValue::mark_domain() {
+  for (unsigned int i = scope.size - 1; i--;) {
+    if (scope[i].id() >= 0)
+      get_solver()->forbid(scope[i].id(), RANGE_VAR);
+  }
+}
+
+Mistral::ConstraintNValue::~ConstraintNValue() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete nvalue constraint" << std::endl;
+#endif
+  delete[] union_stamp;
+  delete[] used_stamp;
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintNValue::propagate() {
+  int n = scope.size - 1, i, vali, vnxt, lb, ub, last, num_union, num_free;
+  unsigned int j, k;
+  bool fixpoint;
+
+  do {
+    fixpoint = true;
+
+    if (++stamp == INFTY) {
+      std::fill(union_stamp, union_stamp + num_values, 0);
+      std::fill(used_stamp, used_stamp + num_values, 0);
+      stamp = 1;
+    }
+
+    used.clear();
+    num_union = num_free = 0;
+    for (i = 0; i < n; ++i) {
+      if (scope[i].is_ground()) {
+        vali = scope[i].get_value() - offset;
+        if (used_stamp[vali] != stamp) {
+          used_stamp[vali] = stamp;
+          used.add(vali + offset);
+        }
+        if (union_stamp[vali] != stamp) {
+          union_stamp[vali] = stamp;
+          ++num_union;
+        }
+      } else {
+        ++num_free;
+        vnxt = scope[i].get_min();
+        do {
+          vali = vnxt;
+          vnxt = scope[i].next(vali);
+          if (union_stamp[vali - offset] != stamp) {
+            union_stamp[vali - offset] = stamp;
+            ++num_union;
+          }
+        } while (vali < vnxt);
+      }
+    }
+
+    // maximum set of pairwise disjoint intervals
+    std::sort(order.begin(), order.end(), [&](const int x, const int y) {
+      return scope[x].get_max() < scope[y].get_max();
+    });
+    lb = 0;
+    last = -INFTY;
+    for (i = 0; i < n; ++i) {
+      if (scope[order[i]].get_min() > last) {
+        ++lb;
+        last = scope[order[i]].get_max();
+      }
+    }
+
+    ub = used.size + num_free;
+    if (ub > num_union)
+      ub = num_union;
+
+    if (FAILED(scope[n].set_min(lb)) || FAILED(scope[n].set_max(ub)))
+      return FAILURE(n);
+
+    if (!num_free)
+      break;
+
+    if (scope[n].get_max() == (int)(used.size)) {
+      // no new value can be used
+      for (i = 0; i < n; ++i) {
+        if (scope[i].is_ground())
+          continue;
+        pruned.clear();
+        vnxt = scope[i].get_min();
+        do {
+          vali = vnxt;
+          vnxt = scope[i].next(vali);
+          if (used_stamp[vali - offset] != stamp)
+            pruned.add(vali);
+        } while (vali < vnxt);
+        for (j = 0; j < pruned.size; ++j) {
+          if (FAILED(scope[i].remove(pruned[j])))
+            return FAILURE(i);
+          fixpoint = false;
+        }
+      }
+    } else if (scope[n].get_min() == (int)(used.size) + num_free) {
+      // every unassigned variable must take a new value
+      for (i = 0; i < n; ++i) {
+        if (scope[i].is_ground())
+          continue;
+        for (k = 0; k < used.size; ++k) {
+          if (scope[i].contain(used[k])) {
+            if (FAILED(scope[i].remove(used[k])))
+              return FAILURE(i);
+            fixpoint = false;
+          }
+        }
+      }
+    }
+  } while (!fixpoint);
+
+  return CONSISTENT;
+}
+
+int Mistral::ConstraintNValue::check(const int *s) const {
+  int n = scope.size - 1, num_distinct = 0, i, j;
+  for (i = 0; i < n; ++i) {
+    for (j = 0; j < i && s[j] != s[i]; ++j)
+      ;
+    num_distinct += (j == i);
+  }
+  return num_distinct != s[n];
+}
+
+std::ostream &Mistral::ConstraintNValue::display(std::ostream &os) const {
+  os << scope[scope.size - 1] << " == nvalue(" << scope[0];
+  for (unsigned int i = 1; i < scope.size - 1; ++i)
+    os << ", " << scope[i];
+  os << ")";
+  return os;
+}
+
+/**********************************************
+* BinPacking Constraint
+**********************************************/
+
+Mistral::ConstraintBinPacking::ConstraintBinPacking(
+    Vector<Variable> &scp, const std::vector<int> &sizes, const int first)
+    : GlobalConstraint(scp), size(sizes) {
+  priority = 0;
+  num_items = size.size();
+  num_bins = scope.size - num_items;
+  first_bin = first;
+}
+
+void Mistral::ConstraintBinPacking::initialise() {
+  ConstraintImplementation::initialise();
+
+  for (int i = 0; i < num_items; ++i)
+    trigger_on(_DOMAIN_, scope[i]);
+  for (int j = 0; j < num_bins; ++j)
+    trigger_on(_RANGE_, scope[num_items + j]);
+
+  GlobalConstraint::initialise();
+
+  total_size = 0;
+  for (int i = 0; i < num_items; ++i) {
+    total_size += size[i];
+    order.add(i);
+  }
+  std::sort(order.begin(), order.end(),
+            [&](const int x, const int y) { return size[x] > size[y]; });
+
+  required.initialise(num_bins, num_bins, 0);
+  possible.initialise(num_bins, num_bins, 0);
+  candidate.initialise(num_bins, num_bins);
+}
+
+void Mistral::ConstraintBinPacking::mark_domain() {
+  for (int i = 0; i < num_items; ++i)
+    if (scope[i].id() >= 0)
+      get_solver()->forbid(scope[i].id(), RANGE_VAR);
+}
+
+Mistral::ConstraintBinPacking::~ConstraintBinPacking() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete binpacking constraint" << std::endl;
+#endif
+}
+
+// Shaw's NoSum: X is sorted by non-increasing size and sums up to 'sum'.
+// Returns true if no subset of X has a sum in [alpha, beta], in which case
+// alpha_p (resp. beta_p) is the largest (resp. smallest) subset sum below
+// alpha (resp. above beta) that was found
+bool Mistral::ConstraintBinPacking::no_sum(const Vector<int> &X,
+                                           const int sum, const int alpha,
+                                           const int beta, int &alpha_p,
+                                           int &beta_p) const {
+  if (alpha <= 0 || beta >= sum)
+    return false;
+
+  // X[n-k] is the k-th smallest element, X[k-1] the k-th largest
+  int n = X.size, sum_a = 0, sum_b = 0, sum_c = 0, k = 0, kp = 0;
+
+  while (sum_c + X[n - kp - 1] < alpha) {
+    sum_c += X[n - kp - 1];
+    ++kp;
+  }
+  sum_b = X[n - kp - 1];
+
+  while (sum_a < alpha && sum_b <= beta) {
+    sum_a += X[k++];
+    if (sum_a < alpha) {
+      --kp;
+      sum_b += X[n - kp - 1];
+      sum_c -= X[n - kp - 1];
+      while (sum_a + sum_c >= alpha) {
+        --kp;
+        sum_c -= X[n - kp - 1];
+        sum_b += X[n - kp - 1] - X[n - kp - k - 2];
       }
     }
+  }
 
-#ifdef _DIV_ARITY
-    int size_conflict = 0;
-    for (int i = 0; i < scope.size; ++i)
-      if (iv[i].min >= l && iv[i].max <= u)
-        ++size_conflict;
-    w /= (double)size_conflict;
-#endif
+  alpha_p = sum_a + sum_c;
+  beta_p = sum_b;
+  return sum_a < alpha;
+}
 
-    for (size_t i = 0; i < scope.size; ++i) {
-      // std::cout << scope[i].get_domain() << std::endl;
-      if (iv[i].min >= l && iv[i].max <= u) {
-        // std::cout << " " << scope[i].id();
-        idx = scope[i].id();
-        if (idx >= 0) {
-          weights[idx] += w;
-#ifdef _ONLY_ACTIVE
-          weight_contributed[i] += w;
-#endif
-          if (the_max < weights[idx])
-            the_max = weights[idx];
-        }
-      }
+// L2 bound of Martello and Toth on the number of bins of size 'capacity'
+// needed for 'items' (sorted by non-increasing size)
+int Mistral::ConstraintBinPacking::lower_bound_L2(const int capacity) {
+  int n = items.size, i, K, n1, nK, half, lo, hi, mid, fr, bound, lb;
+
+  partial_sum.clear();
+  partial_sum.add(0);
+  for (i = 0; i < n; ++i)
+    partial_sum.add(partial_sum[i] + items[i]);
+
+  bound = (partial_sum[n] + capacity - 1) / capacity;
+
+  // number of items strictly larger than capacity/2
+  for (half = 0; half < n && 2 * items[half] > capacity; ++half)
+    ;
+
+  // K ranges over 0 and the distinct sizes at most capacity/2
+  for (i = n; i >= half; --i) {
+    if (i < n - 1 && items[i + 1] == items[i])
+      continue;
+    K = (i == n ? 0 : items[i]);
+    nK = (i == n ? n : i + 1);
+
+    // number of items strictly larger than capacity-K
+    lo = 0;
+    hi = half;
+    while (lo < hi) {
+      mid = (lo + hi) / 2;
+      if (items[mid] > capacity - K)
+        lo = mid + 1;
+      else
+        hi = mid;
     }
-  } else {
+    n1 = lo;
 
-    // TODO: this thing is not "correct" (we don't care it's a heuristic, but
-    // still)
+    fr = (half - n1) * capacity - (partial_sum[half] - partial_sum[n1]);
+    lb = partial_sum[nK] - partial_sum[half] - fr;
+    lb = half + (lb > 0 ? (lb + capacity - 1) / capacity : 0);
+    if (lb > bound)
+      bound = lb;
+  }
 
-    rank = -1 - expl_note;
-    l = scope[rank].get_min();
-    u = scope[rank].get_max();
+  return bound;
+}
 
-#ifdef _DIV_ARITY
-    int size_conflict = 0;
-    for (int i = 0; i < scope.size; ++i)
-      if (iv[i].min <= u && iv[i].max >= l)
-        ++size_conflict;
-    w /= (double)size_conflict;
-#endif
+Mistral::PropagationOutcome Mistral::ConstraintBinPacking::propagate() {
+  int i, j, k, s, vali, vnxt, lo, hi, ap, bp, min_sum, max_sum, capacity;
+  unsigned int l;
+  bool fixpoint;
+  Event evt;
 
-    for (size_t i = 0; i < scope.size; ++i) {
-      if (iv[i].min <= u && iv[i].max >= l) {
-        idx = scope[i].id();
-        if (idx >= 0) {
-          weights[idx] += w;
-#ifdef _ONLY_ACTIVE
-          weight_contributed[i] += w;
-#endif
-          if (the_max < weights[idx])
-            the_max = weights[idx];
+  for (i = 0; i < num_items; ++i)
+    if (FAILED(scope[i].set_min(first_bin)) ||
+        FAILED(scope[i].set_max(first_bin + num_bins - 1)))
+      return FAILURE(i);
+
+  do {
+    fixpoint = true;
+
+    for (j = 0; j < num_bins; ++j) {
+      required[j] = possible[j] = 0;
+      candidate[j].clear();
+    }
+    for (k = 0; k < num_items; ++k) {
+      i = order[k];
+      s = size[i];
+      if (scope[i].is_ground()) {
+        required[scope[i].get_value() - first_bin] += s;
+      } else {
+        vnxt = scope[i].get_min();
+        do {
+          vali = vnxt;
+          vnxt = scope[i].next(vali);
+          possible[vali - first_bin] += s;
+          candidate[vali - first_bin].add(s);
+        } while (vali < vnxt);
+      }
+    }
+
+    // a load is bounded by its packed and candidate items
+    min_sum = max_sum = 0;
+    for (j = 0; j < num_bins; ++j) {
+      Variable load = scope[num_items + j];
+      if (FAILED(load.set_min(required[j])) ||
+          FAILED(load.set_max(required[j] + possible[j])))
+        return FAILURE(num_items + j);
+      min_sum += load.get_min();
+      max_sum += load.get_max();
+    }
+
+    // the loads add up to the total size
+    if (min_sum > total_size || max_sum < total_size)
+      return FAILURE(num_items);
+    for (j = 0; j < num_bins; ++j) {
+      Variable load = scope[num_items + j];
+      evt = load.set_min(total_size - max_sum + load.get_max()) |
+            load.set_max(total_size - min_sum + load.get_min());
+      if (FAILED(evt))
+        return FAILURE(num_items + j);
+      if (evt != NO_EVENT)
+        fixpoint = false;
+    }
+
+    // knapsack reasoning on each bin
+    for (j = 0; j < num_bins; ++j) {
+      if (candidate[j].empty())
+        continue;
+      Variable load = scope[num_items + j];
+      lo = load.get_min() - required[j];
+      hi = load.get_max() - required[j];
+      if (no_sum(candidate[j], possible[j], lo, hi, ap, bp))
+        return FAILURE(num_items + j);
+      if (no_sum(candidate[j], possible[j], lo, lo, ap, bp)) {
+        if (FAILED(load.set_min(required[j] + bp)))
+          return FAILURE(num_items + j);
+        fixpoint = false;
+      }
+      if (no_sum(candidate[j], possible[j], hi, hi, ap, bp)) {
+        if (FAILED(load.set_max(required[j] + ap)))
+          return FAILURE(num_items + j);
+        fixpoint = false;
+      }
+    }
+
+    // an item cannot overload a bin, and must go to a bin that cannot
+    // reach its minimum load without it
+    for (i = 0; i < num_items; ++i) {
+      if (scope[i].is_ground())
+        continue;
+      s = size[i];
+      bins.clear();
+      vnxt = scope[i].get_min();
+      do {
+        vali = vnxt;
+        vnxt = scope[i].next(vali);
+        bins.add(vali - first_bin);
+      } while (vali < vnxt);
+
+      for (l = 0; l < bins.size; ++l) {
+        j = bins[l];
+        Variable load = scope[num_items + j];
+        if (required[j] + s > load.get_max()) {
+          if (FAILED(scope[i].remove(first_bin + j)))
+            return FAILURE(i);
+          fixpoint = false;
+        } else if (required[j] + possible[j] - s < load.get_min()) {
+          if (FAILED(scope[i].set_domain(first_bin + j)))
+            return FAILURE(i);
+          fixpoint = false;
+          break;
         }
       }
     }
-  }
-
-  // std::cout << "the Hall interval is  [" << l << ".." << u << "]\n";
 
-  return the_max;
+    if (fixpoint) {
+      // L2 bound on a relaxation with bins of equal capacity, where each
+      // bin is filled with its packed items and its unused capacity
+      capacity = 0;
+      for (j = 0; j < num_bins; ++j)
+        if (scope[num_items + j].get_max() > capacity)
+          capacity = scope[num_items + j].get_max();
+      if (capacity > 0) {
+        items.clear();
+        for (j = 0; j < num_bins; ++j) {
+          s = capacity - scope[num_items + j].get_max() + required[j];
+          if (s > 0)
+            items.add(s);
+        }
+        for (k = 0; k < num_items; ++k)
+          if (!scope[order[k]].is_ground())
+            items.add(size[order[k]]);
+        std::sort(items.begin(), items.end(), std::greater<int>());
+        if (lower_bound_L2(capacity) > num_bins)
+          return FAILURE(num_items);
+      }
+    }
+  } while (!fixpoint);
 
-  // std::cout << std::endl;
+  return CONSISTENT;
 }
-#endif
-
-void Mistral::ConstraintAllDiff::print_structs() {
 
-  std::cout << std::endl;
-  for (size_t i = 0; i < scope.size; ++i) {
-    std::cout << i << " [" << minsorted[i]->min << ".." << minsorted[i]->max
-              << "] [" << maxsorted[i]->min << ".." << maxsorted[i]->max
-              << "] \n";
+int Mistral::ConstraintBinPacking::check(const int *sol) const {
+  int i, j;
+  std::vector<int> load(num_bins, 0);
+  for (i = 0; i < num_items; ++i) {
+    j = sol[i] - first_bin;
+    if (j < 0 || j >= num_bins)
+      return 1;
+    load[j] += size[i];
   }
-  // for(int i=0; i<2*scope.size+2; ++i) {
-  //   std::cout << i << " bounds=" << bounds[i] << " t=" << t[i] << " d=" <<
-  //   d[i] << " h=" << h[i] << std::endl;
-  // }
+  for (j = 0; j < num_bins; ++j)
+    if (load[j] != sol[num_items + j])
+      return 1;
+  return 0;
 }
 
+std::ostream &Mistral::ConstraintBinPacking::display(std::ostream &os) const {
+  os << "binpacking(" << scope[0] << ":" << size[0];
+  for (int i = 1; i < num_items; ++i)
+    os << ", " << scope[i] << ":" << size[i];
+  os << " | " << scope[num_items];
+  for (int j = 1; j < num_bins; ++j)
+    os << ", " << scope[num_items + j];
+  os << ")";
+  return os;
+}
 
 //#define _DEBUG_VERTEXCOVER 0
 
@@ -20866,25 +23373,30 @@ Mistral::ConstraintNaiveMultiAtMostSeqCard::ConstraintNaiveMultiAtMostSeqCard(Ve
 {
 }
 
-Mistral::Explanation::iterator Mistral::ConstraintNaiveMultiAtMostSeqCard::get_reason_for(const Atom a, const int lvl, iterator& end)
-{
-  //	std::cout<< "d\n" ;
-  unsigned int arity = scope.size, idx;
+void Mistral::ConstraintMultiAtMostSeqCard::naive_reason(
+    Vector<Variable> &scp, Solver *sol, const Atom a, Vector<Literal> &expl) {
+  unsigned int arity = scp.size, idx;
   int literal__;
-  int *rank = get_solver()->assignment_order.stack_;
+  int *rank = sol->assignment_order.stack_;
   int a_rank = (a == NULL_ATOM ? INFTY - 1 : rank[a]);
 
-  explanation.clear();
+  expl.clear();
 
   while (arity--) {
-    if (scope[arity].is_ground()) {
-      idx = scope[arity].id();
+    if (scp[arity].is_ground()) {
+      idx = scp[arity].id();
       if (idx != a && rank[idx] < a_rank) {
-        literal__ = (literal(scope[arity]));
-        explanation.add(NOT(literal__));
+        literal__ = (literal(scp[arity]));
+        expl.add(NOT(literal__));
       }
     }
   }
+}
+
+Mistral::Explanation::iterator Mistral::ConstraintNaiveMultiAtMostSeqCard::get_reason_for(const Atom a, const int lvl, iterator& end)
+{
+  //	std::cout<< "d\n" ;
+  naive_reason(scope, get_solver(), a, explanation);
 
   Solver *sol = get_solver();
   // sol->statistics.avg_amsc_expl_size =
@@ -22289,6 +24801,490 @@ std::ostream& ConstraintOccurrences::display(std::ostream& o) const
   return o;
 }
 
+/**********************************************
+* Global Cardinality Constraint (domain consistency)
+**********************************************/
+
+Mistral::ConstraintGccGAC::ConstraintGccGAC(Vector<Variable> &scp,
+                                            const std::vector<int> &vals,
+                                            const std::vector<int> &lbs,
+                                            const std::vector<int> &ubs)
+    : GlobalConstraint(scp), values(vals), lower_bound(lbs),
+      upper_bound(ubs) {
+  priority = 0;
+  num_vars = scope.size;
+  variable_occurrences = false;
+}
+
+Mistral::ConstraintGccGAC::ConstraintGccGAC(Vector<Variable> &scp,
+                                            const std::vector<int> &vals)
+    : GlobalConstraint(scp), values(vals) {
+  priority = 0;
+  num_vars = scope.size - values.size();
+  variable_occurrences = true;
+}
+
+void Mistral::ConstraintGccGAC::initialise() {
+
+  ConstraintImplementation::initialise();
+
+  int i, n = num_vars;
+  for (i = 0; i < n; ++i)
+    trigger_on(_DOMAIN_, scope[i]);
+  for (i = n; i < (int)scope.size; ++i)
+    trigger_on(_RANGE_, scope[i]);
+
+  GlobalConstraint::initialise();
+
+  int lb = INFTY, ub = -INFTY;
+  for (i = 0; i < n; ++i) {
+    if (scope[i].get_min() < lb)
+      lb = scope[i].get_min();
+    if (scope[i].get_max() > ub)
+      ub = scope[i].get_max();
+  }
+  for (i = 0; i < (int)values.size(); ++i) {
+    if (values[i] < lb)
+      lb = values[i];
+    if (values[i] > ub)
+      ub = values[i];
+  }
+  offset = lb;
+  num_values = ub - lb + 1;
+
+  lower = new int[num_values];
+  upper = new int[num_values];
+  rank = new int[num_values];
+  std::fill(lower, lower + num_values, 0);
+  std::fill(upper, upper + num_values, n);
+  std::fill(rank, rank + num_values, -1);
+  for (i = 0; i < (int)values.size(); ++i) {
+    rank[values[i] - offset] = i;
+    if (!variable_occurrences) {
+      lower[values[i] - offset] = lower_bound[i];
+      upper[values[i] - offset] = upper_bound[i];
+    }
+  }
+
+  match_var = new int[n];
+  std::fill(match_var, match_var + n, NOVAL);
+  next_var = new int[n];
+  prev_var = new int[n];
+  flow = new int[num_values];
+  std::fill(flow, flow + num_values, 0);
+  head = new int[num_values];
+  std::fill(head, head + num_values, -1);
+
+  parent = new int[num_values];
+  parent_val = new int[num_values];
+  visited = new int[n + num_values];
+  std::fill(visited, visited + n + num_values, 0);
+  stamp = 0;
+
+  int num_nodes = n + num_values + 1;
+  index = new int[num_nodes];
+  lowlink = new int[num_nodes];
+  component = new int[num_nodes];
+  stack = new int[num_nodes];
+  call_node = new int[num_nodes];
+  call_next = new int[num_nodes];
+}
+
+void Mistral::ConstraintGccGAC::mark_domain() {
+  for (int i = num_vars; i--;) {
+    if (scope[i].id() >= 0)
+      get_solver()->forbid(scope[i].id(), RANGE_VAR);
+  }
+}
+
+Mistral::ConstraintGccGAC::~ConstraintGccGAC() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete gcc (gac) constraint" << std::endl;
+#endif
+  delete[] lower;
+  delete[] upper;
+  delete[] rank;
+  delete[] match_var;
+  delete[] next_var;
+  delete[] prev_var;
+  delete[] flow;
+  delete[] head;
+  delete[] parent;
+  delete[] parent_val;
+  delete[] visited;
+  delete[] index;
+  delete[] lowlink;
+  delete[] component;
+  delete[] stack;
+  delete[] call_node;
+  delete[] call_next;
+}
+
+void Mistral::ConstraintGccGAC::assign(const int x, const int w) {
+  match_var[x] = w + offset;
+  ++flow[w];
+  prev_var[x] = -1;
+  next_var[x] = head[w];
+  if (head[w] >= 0)
+    prev_var[head[w]] = x;
+  head[w] = x;
+}
+
+void Mistral::ConstraintGccGAC::unassign(const int x) {
+  int w = match_var[x] - offset;
+  --flow[w];
+  if (prev_var[x] >= 0)
+    next_var[prev_var[x]] = next_var[x];
+  else
+    head[w] = next_var[x];
+  if (next_var[x] >= 0)
+    prev_var[next_var[x]] = prev_var[x];
+  match_var[x] = NOVAL;
+}
+
+void Mistral::ConstraintGccGAC::new_stamp() {
+  if (++stamp == INFTY) {
+    std::fill(visited, visited + num_vars + num_values, 0);
+    stamp = 1;
+  }
+}
+
+// breadth-first search for an alternating path from the unassigned variable
+// x to a value used less than its upper bound, the variables along the path
+// are then moved to the next value
+bool Mistral::ConstraintGccGAC::augment(const int x) {
+  int n = num_vars, i, y, z, vali, vnxt, w, prev;
+
+  new_stamp();
+  frontier.clear();
+  frontier.add(x);
+  visited[x] = stamp;
+
+  for (i = 0; i < (int)(frontier.size); ++i) {
+    y = frontier[i];
+    vnxt = scope[y].get_min();
+    do {
+      vali = vnxt;
+      vnxt = scope[y].next(vali);
+
+      w = vali - offset;
+      if (visited[n + w] != stamp) {
+        visited[n + w] = stamp;
+        parent[w] = y;
+        if (flow[w] < upper[w]) {
+          do {
+            y = parent[w];
+            prev = match_var[y];
+            if (prev != NOVAL)
+              unassign(y);
+            assign(y, w);
+            w = prev - offset;
+          } while (y != x);
+          return true;
+        }
+        for (z = head[w]; z >= 0; z = next_var[z])
+          if (visited[z] != stamp) {
+            visited[z] = stamp;
+            frontier.add(z);
+          }
+      }
+    } while (vali < vnxt);
+  }
+
+  return false;
+}
+
+// breadth-first search for a path from the value w, used less than its lower
+// bound, to a value used more than its lower bound: each variable along the
+// path moves to the previous value
+bool Mistral::ConstraintGccGAC::fill(const int w) {
+  int n = num_vars, i, u, v, y;
+
+  new_stamp();
+  frontier.clear();
+  frontier.add(w);
+  visited[n + w] = stamp;
+
+  for (i = 0; i < (int)(frontier.size); ++i) {
+    v = frontier[i];
+    for (y = 0; y < n; ++y) {
+      u = match_var[y] - offset;
+      if (u == v || visited[n + u] == stamp || !scope[y].contain(v + offset))
+        continue;
+      visited[n + u] = stamp;
+      parent[u] = y;
+      parent_val[u] = v;
+      if (flow[u] > lower[u]) {
+        do {
+          y = parent[u];
+          v = parent_val[u];
+          unassign(y);
+          assign(y, v);
+          u = v;
+        } while (u != w);
+        return true;
+      }
+      frontier.add(u);
+    }
+  }
+
+  return false;
+}
+
+// breadth-first search from the variables bound to the value w to a value used
+// less than its upper bound, without going through w: each variable along the
+// path moves to the next value, so w is used once less
+bool Mistral::ConstraintGccGAC::release(const int w) {
+  int n = num_vars, i, y, z, u, vali, vnxt, prev;
+
+  new_stamp();
+  frontier.clear();
+  visited[n + w] = stamp;
+  for (y = head[w]; y >= 0; y = next_var[y]) {
+    visited[y] = stamp;
+    frontier.add(y);
+  }
+
+  for (i = 0; i < (int)(frontier.size); ++i) {
+    y = frontier[i];
+    vnxt = scope[y].get_min();
+    do {
+      vali = vnxt;
+      vnxt = scope[y].next(vali);
+
+      u = vali - offset;
+      if (visited[n + u] != stamp) {
+        visited[n + u] = stamp;
+        parent[u] = y;
+        if (flow[u] < upper[u]) {
+          do {
+            y = parent[u];
+            prev = match_var[y] - offset;
+            unassign(y);
+            assign(y, u);
+            u = prev;
+          } while (u != w);
+          return true;
+        }
+        for (z = head[u]; z >= 0; z = next_var[z])
+          if (visited[z] != stamp) {
+            visited[z] = stamp;
+            frontier.add(z);
+          }
+      }
+    } while (vali < vnxt);
+  }
+
+  return false;
+}
+
+// successors in the residual graph: a variable points to its other values, a
+// value to its variables (and to the sink if it can be used more) and the
+// sink to the values that can be used less
+int Mistral::ConstraintGccGAC::successor(const int node, int &cursor) {
+  int n = num_vars, v;
+
+  if (node < n) {
+    do {
+      if (cursor == NOVAL)
+        v = scope[node].get_min();
+      else if (cursor >= scope[node].get_max())
+        return -1;
+      else
+        v = scope[node].next(cursor);
+      cursor = v;
+    } while (v == match_var[node]);
+    return n + v - offset;
+  } else if (node < n + num_values) {
+    v = node - n;
+    if (cursor == NOVAL) {
+      cursor = head[v];
+    } else if (cursor >= 0) {
+      cursor = next_var[cursor];
+    } else {
+      return -1;
+    }
+    if (cursor >= 0)
+      return cursor;
+    cursor = -1;
+    return (flow[v] < upper[v] ? n + num_values : -1);
+  }
+
+  while (cursor < num_values && flow[cursor] <= lower[cursor])
+    ++cursor;
+  if (cursor >= num_values)
+    return -1;
+  return n + cursor++;
+}
+
+void Mistral::ConstraintGccGAC::strongly_connected_components() {
+  int n = num_vars, num_nodes = n + num_values + 1, count = 0, top = 0, depth,
+      u, w, s;
+
+  std::fill(index, index + num_nodes, -1);
+  std::fill(component, component + num_nodes, -1);
+
+  // iterative version of Tarjan's algorithm, started from every variable
+  for (s = 0; s < n; ++s) {
+    if (index[s] >= 0)
+      continue;
+
+    index[s] = lowlink[s] = count++;
+    stack[top++] = s;
+    call_next[s] = NOVAL;
+    call_node[0] = s;
+    depth = 1;
+
+    while (depth) {
+      u = call_node[depth - 1];
+      w = successor(u, call_next[u]);
+
+      if (w >= 0) {
+        if (index[w] < 0) {
+          index[w] = lowlink[w] = count++;
+          stack[top++] = w;
+          call_next[w] = (w < n + num_values ? NOVAL : 0);
+          call_node[depth++] = w;
+        } else if (component[w] < 0 && index[w] < lowlink[u]) {
+          lowlink[u] = index[w];
+        }
+      } else {
+        --depth;
+        if (lowlink[u] == index[u]) {
+          do {
+            w = stack[--top];
+            component[w] = u;
+          } while (w != u);
+        }
+        if (depth && lowlink[u] < lowlink[call_node[depth - 1]])
+          lowlink[call_node[depth - 1]] = lowlink[u];
+      }
+    }
+  }
+}
+
+Mistral::PropagationOutcome Mistral::ConstraintGccGAC::propagate() {
+  int n = num_vars, i, w, vali, vnxt, total;
+  bool fixpoint;
+  Event evt;
+
+  do {
+    fixpoint = true;
+
+    if (variable_occurrences) {
+      total = 0;
+      for (i = 0; i < (int)values.size(); ++i) {
+        w = values[i] - offset;
+        lower[w] = scope[n + i].get_min();
+        upper[w] = scope[n + i].get_max();
+        total += lower[w];
+      }
+      if (total > n)
+        return FAILURE(n);
+    }
+
+    // the flow survives backtracks, only the edges pruned since are lost
+    for (i = 0; i < n; ++i) {
+      if (match_var[i] != NOVAL && !scope[i].contain(match_var[i]))
+        unassign(i);
+    }
+    for (w = 0; w < num_values; ++w) {
+      while (flow[w] > upper[w])
+        unassign(head[w]);
+    }
+
+    for (i = 0; i < n; ++i) {
+      if (match_var[i] == NOVAL && !augment(i))
+        return FAILURE(i);
+    }
+    for (w = 0; w < num_values; ++w) {
+      while (flow[w] < lower[w])
+        if (!fill(w))
+          return FAILURE(n);
+    }
+
+    strongly_connected_components();
+
+    for (i = 0; i < n; ++i) {
+      if (scope[i].is_ground())
+        continue;
+
+      pruned.clear();
+      vnxt = scope[i].get_min();
+      do {
+        vali = vnxt;
+        vnxt = scope[i].next(vali);
+        if (vali != match_var[i] &&
+            component[i] != component[n + vali - offset])
+          pruned.add(vali);
+      } while (vali < vnxt);
+
+      for (unsigned int j = 0; j < pruned.size; ++j)
+        if (FAILED(scope[i].remove(pruned[j])))
+          return FAILURE(i);
+    }
+
+    // bounds of the occurrence variables: the least and greatest use of their
+    // value over all feasible flows, the flow stays feasible meanwhile
+    if (variable_occurrences) {
+      for (i = 0; i < (int)values.size(); ++i) {
+        w = values[i] - offset;
+        while (flow[w] > lower[w] && release(w))
+          ;
+        lower[w] = flow[w];
+        while (flow[w] < upper[w] && fill(w))
+          ;
+        upper[w] = flow[w];
+      }
+      for (i = 0; i < (int)values.size(); ++i) {
+        w = values[i] - offset;
+        evt = scope[n + i].set_min(lower[w]) | scope[n + i].set_max(upper[w]);
+        if (FAILED(evt))
+          return FAILURE(n + i);
+        if (evt != NO_EVENT)
+          fixpoint = false;
+      }
+    }
+  } while (!fixpoint);
+
+  return CONSISTENT;
+}
+
+int Mistral::ConstraintGccGAC::check(const int *s) const {
+  int i, k;
+  std::vector<int> occ(values.size(), 0);
+  for (i = 0; i < num_vars; ++i) {
+    k = std::find(values.begin(), values.end(), s[i]) - values.begin();
+    if (k < (int)values.size())
+      ++occ[k];
+  }
+  for (k = 0; k < (int)values.size(); ++k) {
+    if (variable_occurrences) {
+      if (occ[k] != s[num_vars + k])
+        return 1;
+    } else if (occ[k] < lower_bound[k] || occ[k] > upper_bound[k]) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+std::ostream &Mistral::ConstraintGccGAC::display(std::ostream &os) const {
+  os << "gcc-gac(" << scope[0];
+  for (int i = 1; i < num_vars; ++i)
+    os << ", " << scope[i];
+  os << " |";
+  for (unsigned int k = 0; k < values.size(); ++k) {
+    os << " " << values[k] << ":";
+    if (variable_occurrences)
+      os << scope[num_vars + k];
+    else
+      os << "[" << lower_bound[k] << "," << upper_bound[k] << "]";
+  }
+  os << ")";
+  return os;
+}
+
 // //// OLDNOOVERLAP
 
 // Mistral::ConstraintPreemptiveNoOverlap::ConstraintPreemptiveNoOverlap(
@@ -35,6 +35,12 @@
 #include <vector>
 #include <sstream>
 #include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 
 
 /*************** TIMING AND MEMORY USAGE ROUTINES, FROM MINISAT ******/
@@ -361,6 +367,291 @@ void Mistral::get_command_line(const char** int_ident,
 }
 
 
+/**********************************************
+ * Input scanner
+ *********************************************/
+
+#define INPUT_WINDOW_SIZE (1 << 20)
+
+Mistral::InputScanner::InputScanner() {
+  cursor = end = NULL;
+  status = -1;
+  mapped = NULL;
+  mapped_size = 0;
+  fd = -1;
+  decoder = -1;
+  window = NULL;
+}
+
+Mistral::InputScanner::InputScanner(const char* filename) {
+  cursor = end = NULL;
+  status = -1;
+  mapped = NULL;
+  mapped_size = 0;
+  fd = -1;
+  decoder = -1;
+  window = NULL;
+  open(filename);
+}
+
+Mistral::InputScanner::~InputScanner() {
+  close();
+}
+
+bool Mistral::InputScanner::open(const char* filename) {
+  close();
+
+  fd = ::open(filename, O_RDONLY);
+  if(fd < 0) return false;
+
+  // look for the gzip (1f 8b) or xz (fd '7zXZ' 00) magic number
+  unsigned char magic[6];
+  ssize_t n = pread(fd, magic, 6, 0);
+  const char* program = NULL;
+  if(n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+    program = "gzip";
+  else if(n == 6 && !memcmp(magic, "\xfd" "7zXZ\0", 6))
+    program = "xz";
+
+  if(program) {
+    int channel[2];
+    if(pipe(channel) < 0) {
+      ::close(fd);
+      fd = -1;
+      return false;
+    }
+    decoder = fork();
+    if(decoder == 0) {
+      dup2(fd, 0);
+      dup2(channel[1], 1);
+      ::close(channel[0]);
+      ::close(channel[1]);
+      execlp(program, program, "-dc", (char*)NULL);
+      _exit(127);
+    }
+    ::close(fd);
+    ::close(channel[1]);
+    fd = channel[0];
+    if(decoder < 0) {
+      ::close(fd);
+      fd = -1;
+      return false;
+    }
+    window = new char[INPUT_WINDOW_SIZE];
+    cursor = end = window;
+    status = 1;
+  } else {
+    struct stat info;
+    if(fstat(fd, &info) < 0) {
+      ::close(fd);
+      fd = -1;
+      return false;
+    }
+    if(!S_ISREG(info.st_mode)) {
+      // a pipe or a device cannot be mapped, read it as a stream
+      window = new char[INPUT_WINDOW_SIZE];
+      cursor = end = window;
+      status = 1;
+      return true;
+    }
+    mapped_size = info.st_size;
+    if(mapped_size) {
+      void *mem = mmap(NULL, mapped_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(mem == MAP_FAILED) {
+        ::close(fd);
+        fd = -1;
+        mapped_size = 0;
+        return false;
+      }
+      madvise(mem, mapped_size, MADV_SEQUENTIAL);
+      mapped = (char*)mem;
+    }
+    ::close(fd);
+    fd = -1;
+    cursor = mapped;
+    end = mapped + mapped_size;
+    status = 0;
+  }
+
+  return true;
+}
+
+void Mistral::InputScanner::close() {
+  if(mapped) munmap(mapped, mapped_size);
+  mapped = NULL;
+  mapped_size = 0;
+  if(fd >= 0) ::close(fd);
+  fd = -1;
+  if(decoder > 0) {
+    // the decoder may still be writing if we stopped reading early
+    kill(decoder, SIGTERM);
+    waitpid(decoder, NULL, 0);
+  }
+  decoder = -1;
+  delete [] window;
+  window = NULL;
+  cursor = end = NULL;
+  status = -1;
+}
+
+bool Mistral::InputScanner::refill() {
+  if(status != 1) return false;
+  // keep the part of the window not yet scanned
+  size_t left = end - cursor;
+  memmove(window, cursor, left);
+  cursor = window;
+  end = window + left;
+  ssize_t n;
+  do {
+    n = read(fd, window + left, INPUT_WINDOW_SIZE - left);
+  } while(n < 0 && errno == EINTR);
+  if(n <= 0) return false;
+  end += n;
+  return true;
+}
+
+void Mistral::InputScanner::skip_line() {
+  while(cursor != end || refill()) {
+    const char* nl = (const char*)memchr(cursor, '\n', end - cursor);
+    if(nl) {
+      cursor = nl + 1;
+      return;
+    }
+    cursor = end;
+  }
+}
+
+bool Mistral::InputScanner::read_long(long long& x) {
+  skip_blanks();
+  int c = peek();
+  bool negative = false;
+  if(c == '-' || c == '+') {
+    negative = (c == '-');
+    ++cursor;
+    c = peek();
+  }
+  if(c < '0' || c > '9') return false;
+  x = 0;
+  do {
+    x = 10 * x + (c - '0');
+    ++cursor;
+    c = peek();
+  } while(c >= '0' && c <= '9');
+  if(negative) x = -x;
+  return true;
+}
+
+bool Mistral::InputScanner::read_int(int& x) {
+  long long y;
+  if(!read_long(y)) return false;
+  x = (int)y;
+  return true;
+}
+
+bool Mistral::InputScanner::read_double(double& x) {
+  std::string word;
+  if(!read_word(word)) return false;
+  char* stop;
+  x = strtod(word.c_str(), &stop);
+  return stop != word.c_str();
+}
+
+bool Mistral::InputScanner::read_word(std::string& word) {
+  skip_blanks();
+  word.clear();
+  int c;
+  while((c = peek()) != EOF && c != ' ' && (c < '\t' || c > '\r')) {
+    word += (char)c;
+    ++cursor;
+  }
+  return !word.empty();
+}
+
+bool Mistral::InputScanner::match(const char* word) {
+  skip_blanks();
+  size_t l = strlen(word);
+  while((size_t)(end - cursor) < l && refill());
+  if((size_t)(end - cursor) < l || memcmp(cursor, word, l)) return false;
+  cursor += l;
+  return true;
+}
+
+
+/**********************************************
+ * Solution writer
+ *********************************************/
+
+#define OUTPUT_BUFFER_SIZE (1 << 16)
+
+Mistral::SolutionWriter::SolutionWriter(std::ostream& s, const int p) {
+  os = &s;
+  period = p;
+  count = 0;
+  buffer = new char[OUTPUT_BUFFER_SIZE];
+  cursor = buffer;
+  limit = buffer + OUTPUT_BUFFER_SIZE;
+}
+
+Mistral::SolutionWriter::~SolutionWriter() {
+  drain();
+  delete [] buffer;
+}
+
+void Mistral::SolutionWriter::drain() {
+  if(cursor > buffer) os->write(buffer, cursor - buffer);
+  cursor = buffer;
+}
+
+void Mistral::SolutionWriter::write(const char* s, const size_t l) {
+  if((size_t)(limit - cursor) < l) {
+    drain();
+    if(l > OUTPUT_BUFFER_SIZE) {
+      os->write(s, l);
+      return;
+    }
+  }
+  memcpy(cursor, s, l);
+  cursor += l;
+}
+
+void Mistral::SolutionWriter::write_int(long long x) {
+  // at most 20 digits and a sign, digits are produced backward
+  if(limit - cursor < 21) drain();
+  unsigned long long y = (x < 0 ? -(unsigned long long)x : x);
+  char digits[20];
+  char* d = digits + 20;
+  do {
+    *--d = '0' + (y % 10);
+    y /= 10;
+  } while(y);
+  if(x < 0) *cursor++ = '-';
+  while(d < digits + 20) *cursor++ = *d++;
+}
+
+void Mistral::SolutionWriter::write_binary(const int* values, const int n) {
+  int32_t size = n;
+  write((const char*)(&size), sizeof(int32_t));
+  if(sizeof(int) == sizeof(int32_t)) {
+    write((const char*)values, n * sizeof(int32_t));
+  } else {
+    for(int i=0; i<n; ++i) {
+      int32_t v = values[i];
+      write((const char*)(&v), sizeof(int32_t));
+    }
+  }
+}
+
+void Mistral::SolutionWriter::end_solution() {
+  drain();
+  if(period > 0 && ++count % period == 0) os->flush();
+}
+
+void Mistral::SolutionWriter::flush() {
+  drain();
+  os->flush();
+}
+
+
 int Mistral::log2_( const unsigned int v ) {
 //   union {float f; unsigned int i; } t;
 //   unsigned int b = v & -v;
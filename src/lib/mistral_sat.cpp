@@ -90,11 +90,13 @@ void SatSolver::set_policy( const int policy )
 SatSolver::SatSolver() 
 {
   restart_policy = NULL;
+  preprocessor = NULL;
 }
 
 SatSolver::SatSolver(const char* filename) 
 {
   restart_policy = NULL;
+  preprocessor = NULL;
   parse_dimacs(filename);
 }
 
@@ -105,6 +107,7 @@ SatSolver::~SatSolver()
   for(unsigned int i=0; i<base.size; ++i)
     free(base[i]);
   delete restart_policy;
+  delete preprocessor;
 }
 
 int SatSolver::solve()
@@ -334,42 +337,56 @@ void SatSolver::init_watchers()
 
 void SatSolver::parse_dimacs(const char* filename) 
 {
-  unsigned int LARGENUMBER = 131072;
-  ifstream infile( filename );
-  char c=' ';
-  string word;
-  int N, M, l=0, lit, cs;
+  InputScanner infile( filename );
+  int N=0, M=0, l=0, lit, cs;
 
-  // skip comments
-  infile >> c;
-  while( c != 'p' ) {
-    infile.ignore( LARGENUMBER, '\n' );
-    infile >> c;
+  if( !infile.good() ) {
+    cout << "c cannot open " << filename << ", exiting" << endl;
+    exit(1);
   }
 
-  infile >> word;
-  assert( word == "cnf" );
-  
-  // get number of atoms and clauses
-  infile >> N;
-  infile >> M;
+  // skip comments
+  while( !infile.eof() && infile.peek() != 'p' )
+    infile.skip_line();
+
+  infile.get();
+  if( !infile.match("cnf") || !infile.read_int(N) || !infile.read_int(M) ) {
+    cout << "c " << filename << " is not in DIMACS format, exiting" << endl;
+    exit(1);
+  }
 
   //init(N, M);
   init_vars(N, M);
   learnt_clause.initialise(0, N);
 
+  if(params.preprocess) 
+    preprocessor = new SatPreprocessor(N);
+
   for(int i=0; i<M; ++i)
     {
       learnt_clause.clear();
-      do {
-	infile >> l;
-	if(l!=0) {
-	  if(l>0) lit = (l-1)*2+1;
-	  else lit = (l+1)*-2;
-	  learnt_clause.add(lit);
+      while( true ) {
+	if( !infile.read_int(l) ) {
+	  // a comment, or the end of the formula
+	  if( infile.peek() == 'c' ) {
+	    infile.skip_line();
+	    continue;
+	  }
+	  l = 0;
+	  i = M;
 	}
-      } while(l && infile.good());
+	if( !l ) break;
+	if(l>0) lit = (l-1)*2+1;
+	else lit = (l+1)*-2;
+	learnt_clause.add(lit);
+      }
+      if( learnt_clause.empty() ) continue;
 
+      if(params.checked) add_original_clause( learnt_clause );
+      if(preprocessor) {
+	preprocessor->add( learnt_clause );
+	continue;
+      }
 
       if(params.init_activity == 1) {
 	cs = learnt_clause.size;
@@ -380,9 +397,39 @@ void SatSolver::parse_dimacs(const char* filename)
       }
 
       add_clause( learnt_clause );
-      if(params.checked) add_original_clause( learnt_clause );
     }
 
+  if(preprocessor) {
+    if(!preprocessor->simplify()) {
+      status = UNSAT;
+    } else {
+      for(int a=0; a<N; ++a) 
+	if(preprocessor->value[a] >= 0) {
+	  learnt_clause.clear();
+	  learnt_clause.add(2*a + preprocessor->value[a]);
+	  add_clause( learnt_clause );
+	}
+      for(unsigned int i=0; i<preprocessor->clauses.size(); ++i) {
+	if(preprocessor->removed[i]) continue;
+	learnt_clause.clear();
+	for(unsigned int j=0; j<preprocessor->clauses[i].size(); ++j)
+	  learnt_clause.add(preprocessor->clauses[i][j]);
+
+	if(params.init_activity == 1) {
+	  cs = learnt_clause.size;
+	  for(int j=cs-1; j>=0; --j)
+	    activity[learnt_clause[j]] += (params.activity_increment/cs);
+	}
+
+	add_clause( learnt_clause );
+      }
+    }
+    if(params.verbosity > 0) {
+      preprocessor->display(std::cout << "c ");
+      std::cout << std::endl;
+    }
+  }
+
   init_watchers();
 
   if(params.normalize_activity != 0)
@@ -391,6 +438,16 @@ void SatSolver::parse_dimacs(const char* filename)
 
 int SatSolver::check_solution()
 {
+  if(preprocessor) {
+    // give a value to the eliminated atoms
+    std::vector< int > model(state.size);
+    for(unsigned int a=0; a<state.size; ++a)
+      model[a] = SIGN(state[a]);
+    preprocessor->extend(&(model[0]));
+    for(unsigned int a=0; a<state.size; ++a)
+      state[a] = (state[a] & ~1u) | model[a];
+  }
+
   if(params.checked) {
     Atom x;
     bool correct = true;
@@ -420,11 +477,440 @@ int SatSolver::check_solution()
 }
 
 
+Mistral::SatPreprocessor::SatPreprocessor(const int n) {
+  num_atoms = n;
+  unsat = false;
+  preserve_models = false;
+
+  occurrences.resize(2*n);
+  value.resize(n, -1);
+  frozen.resize(n, false);
+  eliminated.resize(n, false);
+  mark.resize(2*n, 0);
+
+  max_occurrences = 16;
+  max_resolvent_size = 24;
+
+  num_units = 0;
+  num_pures = 0;
+  num_equivalences = 0;
+  num_eliminated = 0;
+  num_blocked = 0;
+}
+
+void Mistral::SatPreprocessor::add(Vector< Literal >& clause) {
+  std::vector< Literal > cl(clause.begin(), clause.end());
+  add_clause(cl);
+}
+
+int Mistral::SatPreprocessor::add_clause(std::vector< Literal >& clause) {
+  // remove duplicate literals and tautologies
+  unsigned int i, j=0;
+  bool tautology = false;
+  for(i=0; i<clause.size(); ++i) {
+    Literal l = clause[i];
+    if(mark[NOT(l)]) tautology = true;
+    else if(!mark[l]) {
+      mark[l] = 1;
+      clause[j++] = l;
+    }
+  }
+  clause.resize(j);
+  for(i=0; i<j; ++i) mark[clause[i]] = 0;
+
+  if(tautology) return -1;
+  if(clause.empty()) {
+    unsat = true;
+    return -1;
+  }
+  if(clause.size() == 1) unit_queue.push_back(clause[0]);
+
+  int idx = clauses.size();
+  clauses.push_back(clause);
+  removed.push_back(false);
+  for(i=0; i<j; ++i) occurrences[clause[i]].push_back(idx);
+  return idx;
+}
+
+void Mistral::SatPreprocessor::remove_clause(const int i, const Literal w) {
+  removed[i] = true;
+  if(w != NULL_ATOM) {
+    witness.push_back(w);
+    removed_clauses.push_back(clauses[i]);
+  }
+}
+
+void Mistral::SatPreprocessor::build_occurrences() {
+  for(unsigned int l=0; l<occurrences.size(); ++l)
+    occurrences[l].clear();
+  for(unsigned int i=0; i<clauses.size(); ++i)
+    if(!removed[i])
+      for(unsigned int j=0; j<clauses[i].size(); ++j)
+	occurrences[clauses[i][j]].push_back(i);
+}
+
+bool Mistral::SatPreprocessor::propagate_units() {
+  unsigned int i, j, k;
+  while(!unsat && !unit_queue.empty()) {
+    Literal p = unit_queue.back();
+    unit_queue.pop_back();
+    Atom a = UNSIGNED(p);
+
+    if(value[a] >= 0) {
+      if(value[a] != (int)SIGN(p)) unsat = true;
+      continue;
+    }
+    value[a] = SIGN(p);
+    ++num_units;
+
+    // clauses satisfied by p are removed
+    std::vector< int >& sat = occurrences[p];
+    for(i=0; i<sat.size(); ++i)
+      removed[sat[i]] = true;
+    sat.clear();
+
+    // NOT(p) is removed from the others
+    std::vector< int >& shrink = occurrences[NOT(p)];
+    for(i=0; !unsat && i<shrink.size(); ++i) {
+      int c = shrink[i];
+      if(removed[c]) continue;
+      std::vector< Literal >& clause = clauses[c];
+      for(j=k=0; j<clause.size(); ++j)
+	if(clause[j] != NOT(p)) clause[k++] = clause[j];
+      if(k == clause.size()) continue;
+      clause.resize(k);
+      if(k == 0) unsat = true;
+      else if(k == 1) unit_queue.push_back(clause[0]);
+    }
+    shrink.clear();
+  }
+  unit_queue.clear();
+  return !unsat;
+}
+
+int Mistral::SatPreprocessor::eliminate_pure_literals() {
+  int count = 0;
+  std::vector< int > num_occ(2*num_atoms, 0);
+  for(unsigned int i=0; i<clauses.size(); ++i)
+    if(!removed[i])
+      for(unsigned int j=0; j<clauses[i].size(); ++j)
+	++num_occ[clauses[i][j]];
+
+  for(int a=0; a<num_atoms; ++a) {
+    if(frozen[a] || eliminated[a] || value[a] >= 0) continue;
+    if(num_occ[NEG(a)] + num_occ[POS(a)] == 0) continue;
+    if(!num_occ[NEG(a)]) unit_queue.push_back(POS(a));
+    else if(!num_occ[POS(a)]) unit_queue.push_back(NEG(a));
+    else continue;
+    ++count;
+  }
+
+  num_pures += count;
+  propagate_units();
+  return count;
+}
+
+bool Mistral::SatPreprocessor::substitute_equivalences() {
+  unsigned int i, j;
+  int n = 2*num_atoms;
+
+  // binary implication graph: (a v b) gives ~a -> b and ~b -> a
+  std::vector< std::vector< Literal > > implies(n);
+  for(i=0; i<clauses.size(); ++i)
+    if(!removed[i] && clauses[i].size() == 2) {
+      Literal a = clauses[i][0], b = clauses[i][1];
+      implies[NOT(a)].push_back(b);
+      implies[NOT(b)].push_back(a);
+    }
+
+  // iterative Tarjan
+  std::vector< int > index(n, -1), low(n, 0), component(n, -1);
+  std::vector< bool > on_stack(n, false);
+  std::vector< Literal > stack, call_stack;
+  std::vector< unsigned int > next_edge(n, 0);
+  int counter = 0, num_components = 0;
+
+  for(int root=0; root<n; ++root) {
+    if(index[root] >= 0 || implies[root].empty()) continue;
+    call_stack.push_back(root);
+    while(!call_stack.empty()) {
+      Literal u = call_stack.back();
+      if(index[u] < 0) {
+	index[u] = low[u] = counter++;
+	stack.push_back(u);
+	on_stack[u] = true;
+      }
+      if(next_edge[u] < implies[u].size()) {
+	Literal v = implies[u][next_edge[u]++];
+	if(index[v] < 0) call_stack.push_back(v);
+	else if(on_stack[v] && index[v] < low[u]) low[u] = index[v];
+      } else {
+	call_stack.pop_back();
+	if(!call_stack.empty() && low[u] < low[call_stack.back()])
+	  low[call_stack.back()] = low[u];
+	if(low[u] == index[u]) {
+	  Literal w;
+	  do {
+	    w = stack.back();
+	    stack.pop_back();
+	    on_stack[w] = false;
+	    component[w] = num_components;
+	  } while(w != u);
+	  ++num_components;
+	}
+      }
+    }
+  }
+
+  // pick a representative per component, frozen atoms first
+  std::vector< Literal > representative(num_components, NULL_ATOM);
+  for(int l=0; l<n; ++l) {
+    if(component[l] < 0) continue;
+    if(component[l] == component[NOT(l)]) {
+      unsat = true;
+      return false;
+    }
+    Literal& r = representative[component[l]];
+    if(r == NULL_ATOM || (frozen[UNSIGNED(l)] && !frozen[UNSIGNED(r)])) r = l;
+  }
+
+  std::vector< Literal > repr(n);
+  bool change = false;
+  for(int l=0; l<n; ++l) {
+    repr[l] = l;
+    if(component[l] < 0) continue;
+    Literal r = representative[component[l]];
+    // the dual component must agree
+    if(representative[component[NOT(l)]] != NOT(r)) {
+      if(r < representative[component[NOT(l)]]) representative[component[NOT(l)]] = NOT(r);
+      else r = NOT(representative[component[NOT(l)]]);
+      representative[component[l]] = r;
+    }
+  }
+  for(int l=0; l<n; ++l) {
+    if(component[l] < 0) continue;
+    Literal r = representative[component[l]];
+    Atom a = UNSIGNED(l);
+    if(UNSIGNED(r) == a || frozen[a] || eliminated[a] || value[a] >= 0) continue;
+    repr[l] = r;
+    if(SIGN(l)) {
+      // l <-> r
+      eliminated[a] = true;
+      ++num_equivalences;
+      witness.push_back(l);
+      removed_clauses.push_back(std::vector< Literal >());
+      removed_clauses.back().push_back(l);
+      removed_clauses.back().push_back(NOT(r));
+      witness.push_back(NOT(l));
+      removed_clauses.push_back(std::vector< Literal >());
+      removed_clauses.back().push_back(NOT(l));
+      removed_clauses.back().push_back(r);
+      change = true;
+    }
+  }
+
+  if(!change) return true;
+
+  std::vector< Literal > aux;
+  unsigned int nclauses = clauses.size();
+  for(i=0; i<nclauses; ++i) {
+    if(removed[i]) continue;
+    bool modified = false;
+    for(j=0; !modified && j<clauses[i].size(); ++j)
+      modified = (repr[clauses[i][j]] != clauses[i][j]);
+    if(!modified) continue;
+    removed[i] = true;
+    aux.clear();
+    for(j=0; j<clauses[i].size(); ++j)
+      aux.push_back(repr[clauses[i][j]]);
+    add_clause(aux);
+  }
+  build_occurrences();
+  return propagate_units();
+}
+
+bool Mistral::SatPreprocessor::resolve(const std::vector< Literal >& c1,
+				       const std::vector< Literal >& c2,
+				       const Atom a, std::vector< Literal >& res) {
+  unsigned int i;
+  bool tautology = false;
+  res.clear();
+  for(i=0; i<c1.size(); ++i)
+    if(UNSIGNED(c1[i]) != a) {
+      mark[c1[i]] = 1;
+      res.push_back(c1[i]);
+    }
+  for(i=0; !tautology && i<c2.size(); ++i)
+    if(UNSIGNED(c2[i]) != a) {
+      if(mark[NOT(c2[i])]) tautology = true;
+      else if(!mark[c2[i]]) res.push_back(c2[i]);
+    }
+  for(i=0; i<c1.size(); ++i)
+    mark[c1[i]] = 0;
+  return !tautology;
+}
+
+bool Mistral::SatPreprocessor::eliminate_variables() {
+  unsigned int i, j;
+  build_occurrences();
+
+  // cheapest atoms first
+  std::vector< std::pair< unsigned int, int > > candidates;
+  for(int a=0; a<num_atoms; ++a) {
+    if(frozen[a] || eliminated[a] || value[a] >= 0) continue;
+    unsigned int cost = occurrences[NEG(a)].size() * occurrences[POS(a)].size();
+    if(occurrences[NEG(a)].size() + occurrences[POS(a)].size() <= 2*max_occurrences)
+      candidates.push_back(std::make_pair(cost, a));
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  std::vector< int > pos, neg;
+  std::vector< Literal > res;
+  std::vector< std::vector< Literal > > resolvents;
+
+  for(unsigned int c=0; !unsat && c<candidates.size(); ++c) {
+    Atom a = candidates[c].second;
+    if(value[a] >= 0) continue;
+
+    pos.clear();
+    neg.clear();
+    for(i=0; i<occurrences[POS(a)].size(); ++i)
+      if(!removed[occurrences[POS(a)][i]]) pos.push_back(occurrences[POS(a)][i]);
+    for(i=0; i<occurrences[NEG(a)].size(); ++i)
+      if(!removed[occurrences[NEG(a)][i]]) neg.push_back(occurrences[NEG(a)][i]);
+    if(pos.size() > max_occurrences || neg.size() > max_occurrences) continue;
+
+    // the resolvents must not outnumber the clauses they replace
+    bool ok = true;
+    resolvents.clear();
+    for(i=0; ok && i<pos.size(); ++i)
+      for(j=0; ok && j<neg.size(); ++j)
+	if(resolve(clauses[pos[i]], clauses[neg[j]], a, res)) {
+	  if(res.size() > max_resolvent_size ||
+	     resolvents.size() >= pos.size() + neg.size()) ok = false;
+	  else resolvents.push_back(res);
+	}
+    if(!ok) continue;
+
+    eliminated[a] = true;
+    ++num_eliminated;
+    for(i=0; i<pos.size(); ++i) remove_clause(pos[i], POS(a));
+    for(i=0; i<neg.size(); ++i) remove_clause(neg[i], NEG(a));
+    for(i=0; i<resolvents.size(); ++i) {
+      if(resolvents[i].empty()) unsat = true;
+      else add_clause(resolvents[i]);
+    }
+    if(!unit_queue.empty()) propagate_units();
+  }
+
+  return !unsat;
+}
+
+int Mistral::SatPreprocessor::eliminate_blocked_clauses() {
+  unsigned int i, j, k, l;
+  int count = 0;
+  build_occurrences();
+
+  for(i=0; i<clauses.size(); ++i) {
+    if(removed[i]) continue;
+    std::vector< Literal >& clause = clauses[i];
+    for(j=0; j<clause.size(); ++j) mark[clause[j]] = 1;
+
+    for(j=0; j<clause.size(); ++j) {
+      Literal p = clause[j];
+      if(frozen[UNSIGNED(p)]) continue;
+
+      // every resolvent on p must be a tautology
+      bool blocked = true;
+      std::vector< int >& occ = occurrences[NOT(p)];
+      for(k=0; blocked && k<occ.size(); ++k) {
+	if(removed[occ[k]]) continue;
+	std::vector< Literal >& other = clauses[occ[k]];
+	blocked = false;
+	for(l=0; !blocked && l<other.size(); ++l)
+	  blocked = (other[l] != NOT(p) && mark[NOT(other[l])]);
+      }
+
+      if(blocked) {
+	remove_clause(i, p);
+	++count;
+	break;
+      }
+    }
+
+    for(j=0; j<clause.size(); ++j) mark[clause[j]] = 0;
+  }
+
+  num_blocked += count;
+  return count;
+}
+
+bool Mistral::SatPreprocessor::simplify(const int max_rounds) {
+  build_occurrences();
+  if(!propagate_units()) return false;
+
+  unsigned int previous = size()+1;
+  for(int round=0; !unsat && round<max_rounds && size()<previous; ++round) {
+    previous = size();
+    if(preserve_models) {
+      // pure literals, elimination and blocking only preserve satisfiability
+      if(!substitute_equivalences()) break;
+      continue;
+    }
+    eliminate_pure_literals();
+    if(!substitute_equivalences()) break;
+    if(!eliminate_variables()) break;
+    eliminate_blocked_clauses();
+  }
+
+  return !unsat;
+}
+
+unsigned int Mistral::SatPreprocessor::size() const {
+  unsigned int s = 0;
+  for(unsigned int i=0; i<clauses.size(); ++i)
+    s += !removed[i];
+  return s;
+}
+
+bool Mistral::SatPreprocessor::is_satisfied(const std::vector< Literal >& clause,
+					    const int *model) const {
+  for(unsigned int i=0; i<clause.size(); ++i)
+    if(model[UNSIGNED(clause[i])] == (int)SIGN(clause[i])) return true;
+  return false;
+}
+
+void Mistral::SatPreprocessor::extend(int *model) const {
+  for(int a=0; a<num_atoms; ++a)
+    if(value[a] >= 0) model[a] = value[a];
+    else if(model[a] != 0 && model[a] != 1) model[a] = 0;
+
+  for(unsigned int i=witness.size(); i--;)
+    if(!is_satisfied(removed_clauses[i], model))
+      model[UNSIGNED(witness[i])] = SIGN(witness[i]);
+}
+
+std::ostream& Mistral::SatPreprocessor::display(std::ostream& os) const {
+  os << "preprocessing: " << num_units << " units, "
+     << num_pures << " pure literals, "
+     << num_equivalences << " equivalences, "
+     << num_eliminated << " eliminated atoms, "
+     << num_blocked << " blocked clauses, "
+     << size() << " clauses left";
+  return os;
+}
+
+
 
 Mistral::ConstraintClauseBase::ConstraintClauseBase(Vector< Variable >& scp) 
   : GlobalConstraint(scp) { 
   conflict = NULL;
   priority = 1;
+
+  Vector< Literal > pair;
+  pair.add(0);
+  pair.add(0);
+  binary_conflict = (Clause*)(Clause::Array_new(pair));
 }
 
 void Mistral::ConstraintClauseBase::mark_domain() {
@@ -449,6 +935,7 @@ void Mistral::ConstraintClauseBase::initialise() {
   GlobalConstraint::initialise();
 
   is_watched_by.initialise(0,2*scope.size);
+  implied_by.initialise(0,2*scope.size);
   // lit_activity.initialise(0,2*scope.size);
   // var_activity.initialise(0,scope.size);
 
@@ -470,11 +957,20 @@ void Mistral::ConstraintClauseBase::initialise() {
 
 Mistral::ConstraintClauseBase::~ConstraintClauseBase() {
   for(unsigned int i=0; i<clauses.size; ++i) {
-    free(clauses[i]);
+    char *cl = (char*)(clauses[i]);
+    bool in_arena = false;
+    for(unsigned int j=0; !in_arena && j<arena_begin.size; ++j)
+      in_arena = (cl >= arena_begin[j] && cl < arena_end[j]);
+    if(!in_arena)
+      free(clauses[i]);
+  }
+  for(unsigned int j=0; j<arena_begin.size; ++j) {
+    free(arena_begin[j]);
   }
   for(unsigned int i=0; i<learnt.size; ++i) {
     free(learnt[i]);
   }
+  free(binary_conflict);
 }
 
 void Mistral::ConstraintClauseBase::add(Variable x) {
@@ -502,6 +998,8 @@ void Mistral::ConstraintClauseBase::add(Variable x) {
 
   while(is_watched_by.capacity <= 2*idx)
     is_watched_by.extendStack();
+  while(implied_by.capacity <= 2*idx)
+    implied_by.extendStack();
   // while(lit_activity.capacity <= 2*idx)
   //   lit_activity.extendStack();
   // while(var_activity.capacity <= idx)
@@ -514,8 +1012,13 @@ void Mistral::ConstraintClauseBase::add( Vector < Literal >& clause, double acti
  if(clause.size > 1) {
    Clause *cl = (Clause*)(Clause::Array_new(clause));
    clauses.add( cl );
-   is_watched_by[clause[0]].add(cl);
-   is_watched_by[clause[1]].add(cl);
+   if(clause.size == 2) {
+     implied_by[clause[0]].add(clause[1]);
+     implied_by[clause[1]].add(clause[0]);
+   } else {
+     is_watched_by[clause[0]].add(cl);
+     is_watched_by[clause[1]].add(cl);
+   }
 
    // // should we split the increment?
    // activity_increment /= clause.size;
@@ -536,6 +1039,87 @@ void Mistral::ConstraintClauseBase::add( Vector < Literal >& clause, double acti
  }
 }
 
+void Mistral::ConstraintClauseBase::add_clauses( Vector < Literal >& literals, Vector < unsigned int >& start ) {
+  if(start.size < 2) return;
+
+  unsigned int i, j, n = start.size-1, l, sz;
+  size_t bytes = 0, offset;
+  const size_t align = sizeof(void*);
+
+  Vector< unsigned int > watches(2*scope.size);
+  Vector< unsigned int > implications(2*scope.size);
+
+  // count the new watchers of each literal and the size of the arena
+  for(i=0; i<n; ++i) {
+    sz = start[i+1] - start[i];
+    if(sz == 2) {
+      ++implications[literals[start[i]]];
+      ++implications[literals[start[i]+1]];
+    } else if(sz > 2) {
+      ++watches[literals[start[i]]];
+      ++watches[literals[start[i]+1]];
+    }
+    if(sz > 1)
+      bytes += (sizeof(Clause) + sz*sizeof(Literal) + align-1) / align * align;
+  }
+
+  for(l=0; l<2*scope.size; ++l) {
+    if(is_watched_by[l].capacity < is_watched_by[l].size + watches[l])
+      is_watched_by[l].extendStack(is_watched_by[l].size + watches[l] - is_watched_by[l].capacity);
+    if(implied_by[l].capacity < implied_by[l].size + implications[l])
+      implied_by[l].extendStack(implied_by[l].size + implications[l] - implied_by[l].capacity);
+  }
+
+  j = clauses.size;
+  while(clauses.capacity < j + n)
+    clauses.extendStack();
+
+  char *block = NULL;
+  if(bytes) {
+    block = (char*)malloc(bytes);
+    arena_begin.add(block);
+    arena_end.add(block + bytes);
+  }
+
+  offset = 0;
+  for(i=0; i<n; ++i) {
+    Literal *first = literals.stack_ + start[i];
+    sz = start[i+1] - start[i];
+    if(sz > 1) {
+      Clause *cl = new (block + offset) Clause(first, sz);
+      offset += (sizeof(Clause) + sz*sizeof(Literal) + align-1) / align * align;
+      clauses.fast_add( cl );
+      if(sz == 2) {
+        implied_by[first[0]].fast_add(first[1]);
+        implied_by[first[1]].fast_add(first[0]);
+      } else {
+        is_watched_by[first[0]].fast_add(cl);
+        is_watched_by[first[1]].fast_add(cl);
+      }
+    } else if(sz == 1) {
+      scope[UNSIGNED(first[0])].set_domain(SIGN(first[0]));
+    }
+  }
+}
+
+double Mistral::ConstraintClauseBase::weight_conflict(double unit, Vector<double>& weights) {
+  double the_max = 0;
+  int idx;
+  unsigned int i, x, n = (conflict ? conflict->size : scope.size);
+  for(i=0; i<n; ++i) {
+    x = (conflict ? UNSIGNED(conflict->data[i]) : i);
+    idx = scope[x].id();
+    if(idx >= 0) {
+      weights[idx] += unit;
+#ifdef _ONLY_ACTIVE
+      if(x < weight_contributed.size) weight_contributed[x] += unit;
+#endif
+      if(weights[idx] > the_max) the_max = weights[idx];
+    }
+  }
+  return the_max;
+}
+
 void Mistral::ConstraintClauseBase::learn( Vector < Literal >& clause, double activity_increment ) {
  if(clause.size > 1) {
    Clause *cl = (Clause*)(Clause::Array_new(clause));
@@ -552,8 +1136,13 @@ void Mistral::ConstraintClauseBase::learn( Vector < Literal >& clause, double ac
    //   }
    // }
 
-   is_watched_by[clause[0]].add(cl);
-   is_watched_by[clause[1]].add(cl);
+   if(clause.size == 2) {
+     implied_by[clause[0]].add(clause[1]);
+     implied_by[clause[1]].add(clause[0]);
+   } else {
+     is_watched_by[clause[0]].add(cl);
+     is_watched_by[clause[1]].add(cl);
+   }
  } else {
    scope[UNSIGNED(clause[0])].set_domain(SIGN(clause[0]));
  }
@@ -639,6 +1228,9 @@ Mistral::PropagationOutcome Mistral::ConstraintClauseBase::propagate() {
     std::cout << " " << is_watched_by[p].size << std::endl;
 #endif
 
+    // binary clauses first, they do not need to access the clause
+    conflict = propagate_binary(p, wiped);
+
     cw = is_watched_by[p].size;
     while(cw-- && !conflict) {
       conflict = update_watcher(cw, p, wiped);
@@ -828,6 +1420,39 @@ Mistral::Clause* Mistral::ConstraintClauseBase::update_watcher(const int cw,
   return NULL;
 }
 
+Mistral::Clause* Mistral::ConstraintClauseBase::propagate_binary(const Literal p,
+								PropagationOutcome& po)
+{
+  Vector< Literal >& implied = implied_by[p];
+  Literal q;
+  Variable v;
+  int vb;
+
+  for(unsigned int i=0; i<implied.size; ++i) {
+    q = implied[i];
+    v = scope[UNSIGNED(q)];
+    vb = *(v.bool_domain);
+
+    if( vb == 3 ) {
+      changes.add(UNSIGNED(q));
+      v.set_domain(SIGN(q));
+      reason_for[UNSIGNED(q)] = binary_explanation(p);
+
+#ifdef _DEBUG_UNITPROP
+      std::cout << "    -> " << v << " in " << v.get_domain() << " (binary)" << std::endl;
+#endif
+
+    } else if( vb>>1 != (int)SIGN(q) ) {
+      po = FAILURE(UNSIGNED(q));
+      binary_conflict->data[0] = p;
+      binary_conflict->data[1] = q;
+      return binary_conflict;
+    }
+  }
+
+  return NULL;
+}
+
 void Mistral::ConstraintClauseBase::remove( const int cidx )
 {
   Clause *clause = learnt[cidx];
@@ -836,14 +1461,25 @@ void Mistral::ConstraintClauseBase::remove( const int cidx )
   // print_clause(std::cout, clause);
   // std::cout << std::endl;
 
-
-  is_watched_by[clause->data[0]].remove_elt( clause );
-  is_watched_by[clause->data[1]].remove_elt( clause );
+  if(clause->size == 2) {
+    implied_by[clause->data[0]].remove_elt( clause->data[1] );
+    implied_by[clause->data[1]].remove_elt( clause->data[0] );
+  } else {
+    is_watched_by[clause->data[0]].remove_elt( clause );
+    is_watched_by[clause->data[1]].remove_elt( clause );
+  }
   learnt.remove( cidx );
 
   free(clause);
 }
 
+bool Mistral::ConstraintClauseBase::is_locked(Clause *clause)
+{
+  Atom a = UNSIGNED(clause->data[0]);
+  return( scope[a].is_ground() && 
+	  (reason_for[a] == clause || get_solver()->reason_for[a] == clause) );
+}
+
 //#define _DEBUG_FORGET true
 
 
@@ -950,8 +1586,10 @@ int Mistral::ConstraintClauseBase::forget(const double forgetfulness,
 
 
     for(i=nlearnt; i>keep && sa[order[i-1]] != INFTY;) {
-      removed += learnt[i-1]->size;
-      remove( --i );
+      // clauses explaining the current (reused) trail cannot go
+      if(is_locked(learnt[--i])) continue;
+      removed += learnt[i]->size;
+      remove( i );
     }
 
     
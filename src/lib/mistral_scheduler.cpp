@@ -1131,6 +1131,8 @@ void Instance::initialise_from(const char* data_file, const char* data_type) {
   } else if(strcmp(data_type, "dtp") == 0) {
     dtp_readData( data_file );
   } 
+
+  compile_adjacency();
 }
 
 Instance::~Instance() {
@@ -1421,42 +1423,60 @@ int Instance::addTask(const int dur, const int job, const int machine) {
 }
 
 void Instance::addTaskToJob(const unsigned int index, const unsigned int j) {
-	if(tasks_in_job.size() <= j) tasks_in_job.resize(j+1);
-	if(jobs_of_task.size() <= index) jobs_of_task.resize(index+1);
-	if(task_rank_in_job.size() <= index) task_rank_in_job.resize(index+1);
-	tasks_in_job[j].push_back(index);
-	jobs_of_task[index].push_back(j);
-	pair_ x(j, tasks_in_job[j].size()-1);
-	task_rank_in_job[index].push_back(x);
+	job_pairs.push_back(index);
+	job_pairs.push_back(j);
 }
 
 void Instance::addTaskToMachine(const unsigned int index, const unsigned int j) {
-	if(tasks_in_machine.size() <= j) tasks_in_machine.resize(j+1);
-	if(machines_of_task.size() <= index) machines_of_task.resize(index+1);
-	if(task_rank_in_machine.size() <= index) task_rank_in_machine.resize(index+1);
-	tasks_in_machine[j].push_back(index);
-	machines_of_task[index].push_back(j);
-	pair_ x(j, tasks_in_machine[j].size()-1);
-	task_rank_in_machine[index].push_back(x);
+	machine_pairs.push_back(index);
+	machine_pairs.push_back(j);
+}
+
+// counting sort of the (task, x) pairs by x and by task, stable so that the
+// rank of a task in x is the order in which it was added to x
+static void compile_rows(const std::vector<int>& pairs, const int n_tasks,
+		std::vector<int>& start, std::vector<int>& tasks,
+		std::vector<int>& task_start, std::vector<int>& of_task, std::vector<int>& rank) {
+	int n = 0, m = pairs.size()/2;
+	for(int k=1; k<2*m; k+=2)
+		if(n <= pairs[k]) n = pairs[k]+1;
+
+	start.assign(n+1, 0);
+	task_start.assign(n_tasks+1, 0);
+	for(int k=0; k<2*m; k+=2) {
+		++start[pairs[k+1]+1];
+		++task_start[pairs[k]+1];
+	}
+	for(int i=0; i<n; ++i) start[i+1] += start[i];
+	for(int i=0; i<n_tasks; ++i) task_start[i+1] += task_start[i];
+
+	tasks.resize(m);
+	of_task.resize(m);
+	rank.resize(m);
+	std::vector<int> next(start.begin(), start.end()-1);
+	std::vector<int> task_next(task_start.begin(), task_start.end()-1);
+	for(int k=0; k<2*m; k+=2) {
+		int t = pairs[k], x = pairs[k+1];
+		int pos = next[x]++;
+		tasks[pos] = t;
+		int tpos = task_next[t]++;
+		of_task[tpos] = x;
+		rank[tpos] = pos - start[x];
+	}
 }
 
-int Instance::getSetupTime(const int k, const int i, const int j) const {
-	// get the rank of task i in machine k
-	int ri = 0;
-	for(unsigned int x=0; x<task_rank_in_machine[i].size(); ++x)
-	if(task_rank_in_machine[i][x].element == k) {
-		ri = task_rank_in_machine[i][x].rank;
-		break;
-	}
+void Instance::compile_adjacency() {
+	compile_rows(job_pairs, nTasks(), job_start, job_task, task_job_start, task_job, task_job_rank);
+	compile_rows(machine_pairs, nTasks(), machine_start, machine_task, task_machine_start, task_machine, task_machine_rank);
+	std::vector<int>().swap(job_pairs);
+	std::vector<int>().swap(machine_pairs);
+}
 
-	int rj = 0;
-	for(unsigned int x=0; x<task_rank_in_machine[j].size(); ++x)
-	if(task_rank_in_machine[j][x].element == k) {
-		rj = task_rank_in_machine[j][x].rank;
-		break;
-	}
-  
-	return setup_time[k][ri][rj];
+int Instance::getSetupTime(const int k, const int i, const int j) const {
+	// get the rank of tasks i and j in machine k
+	int ri = get_machine_rank(i, k);
+	int rj = get_machine_rank(j, k);
+	return setup_time[k][(ri < 0 ? 0 : ri)][(rj < 0 ? 0 : rj)];
 }
 
 std::ostream& Instance::print(std::ostream& os) {
@@ -1467,16 +1487,16 @@ std::ostream& Instance::print(std::ostream& os) {
 		if(nTasksInJob(i) > 1) {
 			os << " c ";
 			for(int j=1; j<nTasksInJob(i); ++j)
-				os << "  t" << tasks_in_job[i][j-1] << "+" << (duration[tasks_in_job[i][j-1]]) 
-					<< " <= t" << tasks_in_job[i][j];
+				os << "  t" << getJobTask(i,j-1) << "+" << (duration[getJobTask(i,j-1)]) 
+					<< " <= t" << getJobTask(i,j);
 			os << std::endl;
 		}
 	}
 	for(int i=0; i<nMachines(); ++i) {
-		if(tasks_in_machine[i].size() > 0) {
-			os << " c machine" << i << ": t" << tasks_in_machine[i][0];
-			for(unsigned int j=1; j<tasks_in_machine[i].size(); ++j)
-				os << ", t" << tasks_in_machine[i][j];
+		if(nTasksInMachine(i) > 0) {
+			os << " c machine" << i << ": t" << getMachineTask(i,0);
+			for(int j=1; j<nTasksInMachine(i); ++j)
+				os << ", t" << getMachineTask(i,j);
 			os << std::endl;
 		}
 	}
@@ -1749,51 +1769,37 @@ int Instance::getEarlinessTardinessUpperBound(const int c_max) {
 }
 
 
+// skip the lines starting with character c
+static void skip_comments(InputScanner& infile, const char c='#') {
+	infile.skip_blanks();
+	while(infile.peek() == c) {
+		infile.skip_line();
+		infile.skip_blanks();
+	}
+}
+
 void Instance::osp_readData( const char* filename ) {
 
 	DBG("Read (osp)%s\n", "");
 
-	int i=0, j, k, nJobs, nMachines, dur, bufsize=1000;
-	char buf[bufsize];
-	std::ifstream infile( filename, std::ios_base::in );
+	int i, j, k, nJobs=0, nMachines=0, dur=0;
+	InputScanner infile( filename );
 	
-	do {
-		infile.getline( buf, bufsize, '\n' );
-	} while( buf[0] == '#' );
+	// the line with the lower bound and the optimal value
+	skip_comments( infile );
+	infile.skip_line();
 	
-	while( buf[i] != ' ' ) ++i;
-	buf[i] = '\0';
-	// lb = atoi( buf );
+	skip_comments( infile );
+	infile.read_int( nJobs );
+	infile.read_int( nMachines );
+	infile.skip_line();
 	
-	while( buf[i] == '\0' || buf[i] == ' ' || buf[i] == '*' ) ++i;
-	j = i;
-	while( buf[i] != ' ' && buf[i] != '\n' && buf[i] != '\0' ) ++i;
-	buf[i] = '\0';
-	// opt = atoi( &(buf[j]) );
-	
-	do {
-		infile.get( buf[0] );
-		if( buf[0] != '#' ) break;
-		infile.getline( buf, bufsize, '\n' );
-	} while( true );
-	infile.unget();
-	
-	infile >> nJobs;
-	infile >> nMachines;
-
-	infile.getline( buf, bufsize, '\n' );
-	
-	do {
-		infile.get( buf[0] );
-		if( buf[0] != '#' ) break;
-		infile.getline( buf, bufsize, '\n' );
-	} while( true );
-	infile.unget();
+	skip_comments( infile );
 	
 	k = 0;
 	for(i=0; i<nJobs; ++i) {
 		for(j=0; j<nMachines; ++j) {
-			infile >> dur;
+			infile.read_int( dur );
 			addTask(dur, k, -1);
 
 			addTaskToMachine(k, i);
@@ -1808,13 +1814,12 @@ void Instance::sds_readData( const char* filename ) {
 
 	DBG("Read (sds)%s\n", "");
 
-	int i, j, nJobs, nMachines, nFamilies, dur, mach;
-	std::string tag;
-	std::ifstream infile( filename, std::ios_base::in );
+	int i, j, nJobs=0, nMachines=0, nFamilies=0, dur=0, mach=0;
+	InputScanner infile( filename );
 	
-	infile >> nMachines;
-	infile >> nJobs;
-	infile >> nFamilies;
+	infile.read_int( nMachines );
+	infile.read_int( nJobs );
+	infile.read_int( nFamilies );
 
 	int **family_matrix = new int*[nFamilies+1];
 	for(i=0; i<=nFamilies; ++i)
@@ -1834,26 +1839,26 @@ void Instance::sds_readData( const char* filename ) {
 
 	for(i=0; i<nJobs; ++i) {
 		
-		infile >> j;
+		infile.read_int( j );
 		assert(j==nMachines);
 		
 		for(j=0; j<nMachines; ++j) {
 
-			infile >> dur;
-			infile >> mach;
+			infile.read_int( dur );
+			infile.read_int( mach );
 			--mach;
 
 			addTask(dur, i, mach);
 			//addTaskToMachine(k++, mach);
 			
-			infile >> family[i][j];
+			infile.read_int( family[i][j] );
 			--family[i][j];
 		}
 	}
 	
 	for(i=0; i<=nFamilies; ++i)
 		for(j=0; j<nFamilies; ++j)
-			infile >> family_matrix[i][j];
+			infile.read_int( family_matrix[i][j] );
 	
 	for(int k=0; k<nMachines; ++k) {
 		for(i=0; i<nJobs; ++i) {
@@ -1877,35 +1882,30 @@ void Instance::jtl_readData( const char* filename ) {
 
 	DBG("Read (jtl)%s\n", "");
 
-	int i, j, dur, mach, nJobs, nMachines, opt;
+	int i, j, dur=0, mach=0, nJobs=0, nMachines=0, opt;
 	std::string tag;
-	char c;
-	std::ifstream infile( filename, std::ios_base::in );
+	InputScanner infile( filename );
   
-	infile >> nJobs;
-	infile >> nMachines;
+	infile.read_int( nJobs );
+	infile.read_int( nMachines );
 
 	for(i=0; i<nJobs; ++i) {
 		for(j=0; j<nMachines; ++j) {
 
-			infile >> mach;
-			infile >> dur;
+			infile.read_int( mach );
+			infile.read_int( dur );
 
 			addTask(dur, i, mach);
 		}
 	}
 
 
-	infile >> tag;
-	infile >> opt;
-	infile.ignore( 100, '\n' );
+	infile.read_word( tag );
+	infile.read_int( opt );
+	infile.skip_line();
   
-	infile.get(c);
-	assert( c == 'T' );
-	infile.get(c);
-	assert( c == 'L' );
-	infile.get(c);
-	assert( c == '=' );
+	bool time_lags = infile.match( "TL=" );
+	assert( time_lags );
 
   
 	time_lag[0] = new int*[nJobs];
@@ -1915,8 +1915,8 @@ void Instance::jtl_readData( const char* filename ) {
 		time_lag[0][i] = new int[nMachines];
 		time_lag[1][i] = new int[nMachines];
 		for(j=0; j<nMachines; ++j) {
-			infile >> time_lag[0][i][j];
-			infile >> time_lag[1][i][j];
+			infile.read_int( time_lag[0][i][j] );
+			infile.read_int( time_lag[1][i][j] );
 		}
 	}
 
@@ -1925,23 +1925,21 @@ void Instance::now_readData( const char* filename ) {
 
 	DBG("Read (now)%s\n", "");
 
-	int i, j, dur, mach, nJobs, nMachines;
-
-	std::string tag;
+	int i, j, dur=0, mach=0, nJobs=0, nMachines=0;
 
-	std::ifstream infile( filename, std::ios_base::in );
+	InputScanner infile( filename );
 
-	infile >> nJobs;
+	infile.read_int( nJobs );
 
-	infile >> nMachines;
+	infile.read_int( nMachines );
 
 	for(i=0; i<nJobs; ++i) {
 
 		for(j=0; j<nMachines; ++j) {
 
-			infile >> mach;
+			infile.read_int( mach );
 
-			infile >> dur;
+			infile.read_int( dur );
 
 			addTask(dur, i, mach);
 
@@ -1988,17 +1986,17 @@ void Instance::jla_readData( const char* filename ) {
 
 	DBG("Read (jla)%s\n", "");
 
-	int i, j, dur, mach, nJobs, nMachines;
-	std::ifstream infile( filename, std::ios_base::in );
+	int i, j, dur=0, mach=0, nJobs=0, nMachines=0;
+	InputScanner infile( filename );
   
-	infile >> nJobs;
-	infile >> nMachines;
+	infile.read_int( nJobs );
+	infile.read_int( nMachines );
 
 	for(i=0; i<nJobs; ++i) {
 		for(j=0; j<nMachines; ++j) {
 
-			infile >> mach;
-			infile >> dur;
+			infile.read_int( mach );
+			infile.read_int( dur );
 
 			addTask(dur, i, mach);
 		}
@@ -2016,15 +2014,13 @@ void Instance::fsp_readData( const char* filename ) {
 
 	int dur;
 	std::vector<int> duration;
-	double obj;
-	std::ifstream infile( filename, std::ios_base::in );
+	double obj = 0;
+	InputScanner infile( filename );
 	
-	infile >> obj;
+	infile.read_double( obj );
 	max_makespan = (int)obj;
 
-	while( true ) {
-		infile >> dur;
-		if(!infile.good()) break;
+	while( infile.read_int( dur ) ) {
 		duration.push_back(dur);
 
 		//std::cout << dur << std::endl;
@@ -2046,40 +2042,40 @@ void Instance::jsp_readData( const char* filename ) {
 
 	DBG("Read (jsp)%s\n", "");
 
-	int i, j, k, dur, mach;
-	long int dump;
+	int i, j, k, dur=0, mach=0;
+	long long dump;
 	std::string tag;
-	std::ifstream infile( filename, std::ios_base::in );
+	InputScanner infile( filename );
 	
-	int nJobs;
-	int nMachines;
-	infile >> nJobs;
-	infile >> nMachines;
+	int nJobs=0;
+	int nMachines=0;
+	infile.read_int( nJobs );
+	infile.read_int( nMachines );
 	
-	infile >> dump;
-	infile >> dump;
+	infile.read_long( dump );
+	infile.read_long( dump );
 	
-	infile >> dump;
-	infile >> dump;
+	infile.read_long( dump );
+	infile.read_long( dump );
 	
-	infile >> tag;
+	infile.read_word( tag );
 
 	assert( tag == "Times" );
 
 	for(i=0; i<nJobs; ++i) {
 		for(j=0; j<nMachines; ++j) {
-			infile >> dur;
+			infile.read_int( dur );
 			addTask(dur, i, -1);
 		}
 	}
 	
-	infile >> tag;
+	infile.read_word( tag );
 	assert( tag == "Machines" );
   
 	k = 0;
 	for(i=0; i<nJobs; ++i) 
 	for(j=0; j<nMachines; ++j) {
-		infile >> mach;
+		infile.read_int( mach );
 		addTaskToMachine(k++, --mach);
 	}
 }
@@ -2088,12 +2084,11 @@ void Instance::jet_readData( const char* filename ) {
 
 	DBG("Read (jet)%s\n", "");
 
-	int i, j, dur, mach, nJobs, nMachines, c;
-	std::string tag;
-	std::ifstream infile( filename, std::ios_base::in );
+	int i, j, dur=0, mach=0, nJobs=0, nMachines=0, c=0;
+	InputScanner infile( filename );
 	
-	infile >> nJobs;
-	infile >> nMachines;
+	infile.read_int( nJobs );
+	infile.read_int( nMachines );
 	
 	jsp_duedate = new int[nJobs];
 	//jsp_earlycost = new int[nJobs];
@@ -2102,16 +2097,16 @@ void Instance::jet_readData( const char* filename ) {
 	for(i=0; i<nJobs; ++i) {
 		for(j=0; j<nMachines; ++j) {
 			
-			infile >> mach;
-			infile >> dur;
+			infile.read_int( mach );
+			infile.read_int( dur );
 			addTask(dur, i, mach);
 
 		}
 		
-		infile >> jsp_duedate[i];
-		infile >> c;
+		infile.read_int( jsp_duedate[i] );
+		infile.read_int( c );
 		jsp_earlycost.add(c);
-		infile >> c;
+		infile.read_int( c );
 		jsp_latecost.add(c);
 	}
 
@@ -2121,12 +2116,11 @@ void Instance::dyn_readData( const char* filename, const int precision ) {
 
 	DBG("Read (dyn)%s\n", "");
 
-	int i, j, k, dur, mach, nJobs, nMachines;
-	std::string tag;
-	std::ifstream infile( filename, std::ios_base::in );
+	int i, j=0, k, dur=0, mach=0, nJobs=0, nMachines=0;
+	InputScanner infile( filename );
 	
-	infile >> nJobs;
-	infile >> nMachines;
+	infile.read_int( nJobs );
+	infile.read_int( nMachines );
 	
 	DBG("%i jobs, %i machines\n", nJobs, nMachines);
 	
@@ -2140,8 +2134,8 @@ void Instance::dyn_readData( const char* filename, const int precision ) {
 
 		for(j=0; j<nMachines; ++j) {
       
-			infile >> mach;
-			infile >> dur;
+			infile.read_int( mach );
+			infile.read_int( dur );
       
 			if(mach != -1 && dur != -1) addTask(dur, i, mach);
 			
@@ -2150,10 +2144,10 @@ void Instance::dyn_readData( const char* filename, const int precision ) {
 		}	
 		
 
-		infile >> jsp_duedate[i];
-		infile >> j;
+		infile.read_int( jsp_duedate[i] );
+		infile.read_int( j );
 		//infile >> jsp_latecost[i];
-		infile >> jsp_floatcost[i];
+		infile.read_double( jsp_floatcost[i] );
 		
 		
 		DBG("job_%i, must end at %i, penalty=%f\n", i, jsp_duedate[i], jsp_floatcost[i]);
@@ -2185,24 +2179,15 @@ void Instance::dtp_readData( const char* filename ) {
 
 	DBG("Read (dtp)%s\n", "");
 
-	char comment = '#';
-	std::ifstream infile( filename, std::ios_base::in );
+	InputScanner infile( filename );
 
-	while(true) {
-		comment = infile.get();
-		if(comment == '#') {
-			infile.ignore(1000, '\n');
-		} else break;
-	}
-	infile.unget();
+	skip_comments( infile );
   
 	std::string exp;
 	int i, j, x, y, d;
 	int step = 0;
 
-	while(true) {
-		infile >> exp;
-		if(!infile.good())  break;
+	while(infile.read_word( exp )) {
 
 		if(step == 0) {
 			std::vector< Term > clause;
@@ -151,35 +151,191 @@ Mistral::HeuristicPoolManager::HeuristicPoolManager(Solver *s) : solver(s) {// }
 
   //std::cout << " c add restart listener" << std::endl;
   
-  heu_index = 1;
+  heu_index = 0;
+  threshold = counter = 10;
+  window_reward = 0.0;
+  window_size = 0;
+  exploration = 1.41421356;
+  last_num_solutions = 0;
   solver->add((RestartListener*)this);
 }
 
 Mistral::HeuristicPoolManager::~HeuristicPoolManager() {// }
   for(unsigned int i=0; i<pool.size; ++i) {
     if(solver->heuristic != pool[i]) {
-      delete [] pool[i];
+      delete pool[i];
     }
   }
   solver->remove((RestartListener*)this);
 }
 
 
+int Mistral::HeuristicPoolManager::select() {
+  int i, best = 0, total = 0;
+  double score, best_score = -1.0;
+
+  for(i=0; i<(int)(pool.size); ++i) {
+    // every heuristic is tried once first
+    if(!num_pulls[i]) return i;
+    total += num_pulls[i];
+  }
+
+  for(i=0; i<(int)(pool.size); ++i) {
+    score = total_reward[i]/num_pulls[i] 
+      + exploration * sqrt(log((double)total)/num_pulls[i]);
+    if(score > best_score) {
+      best_score = score;
+      best = i;
+    }
+  }
+
+  return best;
+}
+
+
 void Mistral::HeuristicPoolManager::notify_restart(const double prog) {
   //std::cout << " c notify restart (3): " << solver->statistics.num_restarts << std::endl;
-  if(heu_index<(int)(pool.size)) {
-    if(prog > 0.0) {
-      counter = threshold;
-    } else if(--counter <= 0) {
-      counter = threshold;
-      std::cout << " c switch heuristic!\n";
-      solver->heuristic = pool[heu_index++];
+
+  // the first notification comes before any search
+  if(pool.size < 2 || solver->statistics.num_restarts <= 1) return;
+
+  // progress is mapped from [-1,1] to [0,1], a new solution is the best outcome
+  double reward = (prog > 1.0 ? 1.0 : (prog < -1.0 ? -1.0 : prog));
+  reward = (1.0 + reward) / 2.0;
+  if(solver->statistics.num_solutions > last_num_solutions) {
+    last_num_solutions = solver->statistics.num_solutions;
+    reward = 1.0;
+  }
+  window_reward += reward;
+  ++window_size;
+
+  if(--counter <= 0) {
+    ++num_pulls[heu_index];
+    total_reward[heu_index] += window_reward / window_size;
+    window_reward = 0.0;
+    window_size = 0;
+    counter = threshold;
+
+    int next = select();
+    if(next != heu_index) {
+      if(solver->parameters.verbosity > 1)
+	std::cout << " " << solver->parameters.prefix_comment << " switch heuristic (" 
+		  << heu_index << " -> " << next << ")" << std::endl;
+      heu_index = next;
+      solver->heuristic = pool[heu_index];
     }
   }
   //std::cout << " c " << counter << std::endl;
 }
 
 
+Mistral::ObjectiveGuided::ObjectiveGuided(Solver *s, BranchingHeuristic *h, const int md, const double a) 
+  : BranchingHeuristic(s), heuristic(h), max_domain_size(md), Alpha(a) {
+  last_var = -1;
+  last_val = 0;
+  last_bound = 0;
+  last_width = 0;
+  last_level = -1;
+}
+
+Mistral::ObjectiveGuided::~ObjectiveGuided() {
+  if(!offset.empty()) {
+    solver->remove((SuccessListener*)this);
+    solver->remove((DecisionListener*)this);
+    solver->remove((BacktrackListener*)this);
+  }
+  delete heuristic;
+}
+
+void Mistral::ObjectiveGuided::initialise(VarStack< Variable, ReversibleNum<int> >& seq) {
+  heuristic->initialise(seq);
+
+  if(!offset.empty() || !solver->objective || !solver->objective->is_optimization()) return;
+
+  unsigned int n = solver->variables.size;
+  impact.resize(n);
+  offset.resize(n, 0);
+  for(unsigned int i=0; i<n; ++i) {
+    Variable x = solver->variables[i];
+    if(!x.is_ground() && x.get_max() - x.get_min() < max_domain_size) {
+      offset[i] = x.get_min();
+      impact[i].resize(x.get_max() - x.get_min() + 1, 0.0);
+    }
+  }
+
+  solver->add((BacktrackListener*)this);
+  solver->add((DecisionListener*)this);
+  solver->add((SuccessListener*)this);
+}
+
+int Mistral::ObjectiveGuided::get_bound() const {
+  Goal *goal = solver->objective;
+  return (goal->sub_type == Goal::MINIMIZATION ? 
+	  goal->objective.get_min() : -goal->objective.get_max());
+}
+
+void Mistral::ObjectiveGuided::update(const double imp) {
+  double& w = impact[last_var][last_val - offset[last_var]];
+  w = ((Alpha-1) * w + imp) / Alpha;
+}
+
+Mistral::Decision Mistral::ObjectiveGuided::branch() {
+  Decision d = heuristic->branch();
+
+  last_var = -1;
+  if(d.type() == Decision::ASSIGNMENT && !impact.empty()) {
+    Variable x = d.var;
+    int i = x.id();
+
+    if(i >= 0 && i < (int)(impact.size()) && !impact[i].empty()) {
+      std::vector<double>& imp = impact[i];
+      int best = d.value(), vali, vnxt = x.get_min();
+      double best_impact = imp[best - offset[i]];
+
+      do {
+	vali = vnxt;
+	vnxt = x.next(vali);
+	if(imp[vali - offset[i]] < best_impact) {
+	  best_impact = imp[vali - offset[i]];
+	  best = vali;
+	}
+      } while(vali < vnxt);
+
+      d.set_value(best);
+
+      last_var = i;
+      last_val = best;
+      last_bound = get_bound();
+      last_width = solver->objective->objective.get_max() - solver->objective->objective.get_min() + 1;
+    }
+  }
+
+  return d;
+}
+
+void Mistral::ObjectiveGuided::notify_decision() {
+  last_level = (last_var >= 0 ? solver->level : -1);
+}
+
+void Mistral::ObjectiveGuided::notify_success() {
+  // only the propagation of our own last decision is measured
+  if(last_level >= 0 && last_level == solver->level) 
+    update(get_bound() - last_bound);
+  last_level = -1;
+}
+
+void Mistral::ObjectiveGuided::notify_backtrack() {
+  if(last_level >= 0 && last_level == solver->level) 
+    update(last_width);
+  last_level = -1;
+}
+
+std::ostream& Mistral::ObjectiveGuided::display(std::ostream& os) {
+  os << "objective guided: ";
+  return heuristic->display(os);
+}
+
+
 // //Mistral::LiteralActivityManager::LiteralActivityManager(Solver *s, void *a) 
 // Mistral::LiteralActivityManager::LiteralActivityManager(Solver *s) 
 //   : solver(s) {
@@ -1462,6 +1618,57 @@ int Mistral::PruningCountManager::get_maxweight_value(const Variable x) {
 
 
 
+void Mistral::FailureCountManager::notify_backtrack() {
+	int i;
+	Constraint con = solver->culprit;
+	double max_weight = 0;
+
+
+	//std::cout << "failure on " << con << std::endl;
+
+	if(!con.empty()) {
+		if(con.propagator == solver->base) {
+			// the clause base is charged through the falsified clause
+			max_weight = solver->base->weight_conflict(weight_unit, variable_weight);
+		} else {
+			Variable *scope = con.get_scope();
+			int idx;
+			i = con.arity();
+			//++constraint_weight[con.id()];
+			constraint_weight[con.id()] += weight_unit;
+			while(i--) {
+				idx = scope[i].id();
+				if(idx>=0) {
+					//std::cout << " ++x" << idx; 
+					variable_weight[idx] += weight_unit;
+					if(max_weight < variable_weight[idx])
+						max_weight = variable_weight[idx];
+				}
+			}
+		}
+	} 
+	// std::cout << std::endl;
+
+	// display(std::cout, false);
+
+	if(max_weight>threshold) {
+
+		double factor = std::min(solver->parameters.activity_increment/weight_unit, 1/max_weight);
+		weight_unit *= factor;
+
+		int n = solver->variables.size;
+		for(int i=0; i<n; ++i) {
+			variable_weight[i] *= factor;
+		}
+
+	}
+
+	if(solver->parameters.activity_decay<1 && solver->parameters.activity_decay>0)
+		weight_unit /= solver->parameters.activity_decay;
+
+}
+
+
 #ifdef _ABS_VAL	
 void Mistral::PruningCountManager::notify_backtrack() {
 	
@@ -22,6 +22,11 @@ The author can be contacted electronically at emmanuel.hebrard@gmail.com.
 #include <fstream>
 #include <signal.h>
 #include <assert.h>
+#include <typeinfo>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 
 #include <mistral_sat.hpp>
@@ -148,6 +153,12 @@ void Mistral::SolverParameters::initialise() {
   backjump = 0;
   value_selection = 2;
   dynamic_value = 0; // 1;
+  preprocess = 0;
+  reuse_trail = 0;
+  presolve = 0;
+  dichotomy = 0;
+  probe_fail_limit = 1000;
+  objective_guided = 0;
 
   prefix_comment = "c";
   prefix_statistics = "d";
@@ -179,6 +190,12 @@ void Mistral::SolverParameters::copy(const SolverParameters& sp) {
   backjump = sp.backjump;
   value_selection = sp.value_selection;
   dynamic_value = sp.dynamic_value;
+  preprocess = sp.preprocess;
+  reuse_trail = sp.reuse_trail;
+  presolve = sp.presolve;
+  dichotomy = sp.dichotomy;
+  probe_fail_limit = sp.probe_fail_limit;
+  objective_guided = sp.objective_guided;
 
   verbosity = sp.verbosity;
   find_all = sp.find_all;
@@ -251,6 +268,7 @@ void Mistral::SolverStatistics::initialise(Solver *s) {
   num_nodes = 0;
   num_decisions = 0;
   num_restarts = 0;
+  num_reused_levels = 0;
   num_backtracks = 0;
   num_failures = 0;
   num_propagations = 0;
@@ -487,8 +505,12 @@ std::ostream& Mistral::SolverStatistics::print_full(std::ostream& os) const {
      << num_nodes << std::endl
      << std::left << " " << solver->parameters.prefix_statistics
      << std::setw(44 - lps) << "  RESTARTS" << std::right << std::setw(46)
-     << num_restarts << std::endl
-     << std::left << " " << solver->parameters.prefix_statistics
+     << num_restarts << std::endl;
+  if (num_reused_levels)
+    os << std::left << " " << solver->parameters.prefix_statistics
+       << std::setw(44 - lps) << "  REUSED LEVELS" << std::right
+       << std::setw(46) << num_reused_levels << std::endl;
+  os << std::left << " " << solver->parameters.prefix_statistics
      << std::setw(44 - lps) << "  FAILURES" << std::right << std::setw(46)
      << num_failures << std::endl
      << std::left << " " << solver->parameters.prefix_statistics
@@ -594,6 +616,7 @@ void Mistral::SolverStatistics::copy(const SolverStatistics& sp) {
   num_nodes = sp.num_nodes;
   num_decisions = sp.num_decisions;
   num_restarts = sp.num_restarts;
+  num_reused_levels = sp.num_reused_levels;
   num_backtracks = sp.num_backtracks;
   num_failures = sp.num_failures;
   num_propagations = sp.num_propagations;
@@ -609,6 +632,7 @@ void Mistral::SolverStatistics::update(const SolverStatistics& sp) {
   num_nodes += sp.num_nodes;
   num_decisions += sp.num_decisions;
   num_restarts += sp.num_restarts;
+  num_reused_levels += sp.num_reused_levels;
   num_backtracks += sp.num_backtracks;
   num_failures += sp.num_failures;
   num_propagations += sp.num_propagations;
@@ -1001,6 +1025,9 @@ Mistral::Solver::Solver()
   initialised_cons = 0;
   num_search_variables = 0;
   base = NULL;
+  preprocessor = NULL;
+  snapshot = NULL;
+  snapshot_size = 0;
 
   search_root = -2;
 
@@ -1044,277 +1071,197 @@ Mistral::Solver::Solver()
 }
 
 void Mistral::Solver::parse_pbo(const char *filename) {
-  unsigned int LARGENUMBER = 131072;
-  std::ifstream infile(filename);
-  char c = ' ';
-  std::string word;
-  // int N, M, l=0;
+  InputScanner infile(filename);
   Literal lit;
-  Vector<Vector<Literal>> clauses;
+  // the clauses, stored contiguously: clause i is literals[start[i]..start[i+1])
+  Vector<Literal> literals;
+  Vector<unsigned int> start;
   Vector<Literal> new_clause;
   Vector<int> weight;
   Vector<Variable> scope;
 
-  new_clause.initialise(0, 10);
-
   Variable Goal;
   int obj_dir = 0;
+  // atoms that also appear in a linear constraint or in the objective
+  Vector<int> frozen;
 
-  // skip comments
-  infile >> c;
-  while (c == '*') {
-    infile.ignore(LARGENUMBER, '\n');
-    infile >> c;
+  if (!infile.good()) {
+    std::cout << "c cannot open " << filename << ", exiting" << std::endl;
+    exit(1);
   }
 
-  infile.unget();
-
   int aux, parse_objective;
 
-  bool should_continue = infile.good();
+  start.add(0);
 
-  while (should_continue) {
+  while (!infile.eof()) {
 
-    //    std::cout << "DEBUT DE LIGNE! ";
+    // skip comments
+    if (infile.peek() == '*') {
+      infile.skip_line();
+      continue;
+    }
 
     weight.clear();
     scope.clear();
-    new_clause.clear();
 
     bool all_pones = true;
     bool all_mones = true;
 
     parse_objective = 0;
-    do {
-      infile >> c;
-
-      should_continue = infile.good();
+    if (infile.match("min:"))
+      parse_objective = 1;
+    else if (infile.match("max:"))
+      parse_objective = 2;
 
-      if (should_continue) {
+    // terms '<weight> x<index>'
+    while (infile.read_int(aux)) {
+      weight.add(aux);
 
-        if (c == 'm') {
+      all_pones &= (aux == 1);
+      all_mones &= (aux == -1);
 
-          // std::cout << " obj" ;
-
-          infile >> word;
-
-          if (word == "in:") {
-            parse_objective = 1;
-          } else if (word == "ax:") {
-            parse_objective = 2;
-          }
-
-          infile.ignore(LARGENUMBER, ' ');
-          infile >> c;
-        }
-
-        if (c == '+' || c == '-') {
+      if (!infile.match("x") || !infile.read_int(aux) || aux <= 0) {
+        std::cout << "malformed term in " << filename << ", exiting"
+                  << std::endl;
+        exit(1);
+      }
 
-          // std::cout << " trm" ;
+      while (aux > (int)(variables.size)) {
+        Variable x(0, 1);
+        add(x);
+      }
 
-          infile >> aux;
-          weight.add((c == '+' ? aux : -aux));
+      --aux;
+      scope.add(variables[aux]);
+    }
 
-          all_pones &= (weight.back() == 1);
-          all_mones &= (weight.back() == -1);
+    if (!parse_objective) {
 
-          // std::cout << " " << weight.back() << std::endl;
+      int bounds[2] = {-INFTY, INFTY};
 
-          infile.ignore(LARGENUMBER, ' ');
-          infile >> c;
+      int op = (infile.match(">=")   ? 0
+                : infile.match("<=") ? 1
+                : infile.match("=")  ? 2
+                : infile.match(">")  ? 3
+                : infile.match("<")  ? 4
+                                     : -1);
 
-          assert(c == 'x');
+      if (op < 0 || !infile.read_int(aux)) {
+        std::string word;
+        infile.read_word(word);
+        std::cout << "unknown connector: " << word << " exiting" << std::endl;
+        exit(1);
+      }
+      infile.skip_line();
+
+      switch (op) {
+      case 0:
+        bounds[0] = aux;
+        break;
+      case 1:
+        bounds[1] = aux;
+        break;
+      case 2:
+        bounds[0] = bounds[1] = aux;
+        break;
+      case 3:
+        bounds[0] = aux + 1;
+        break;
+      default:
+        bounds[1] = aux - 1;
+      }
+
+      // is it a clause?
+      bool is_clause = false;
+
+      // compute the minimum
+      int reachable[2] = {0, 0};
+      for (unsigned int i = 0; i < weight.size; ++i) {
+        if (weight[i] >= 0)
+          reachable[1] += weight[i];
+        else
+          reachable[0] += weight[i];
+      }
 
-          infile >> aux;
-          while (aux > (int)(variables.size)) {
-            Variable x(0, 1);
-            add(x);
+      // check that each variable can make it true
+      if (bounds[1] == INFTY) {
+        is_clause = true;
+        for (unsigned int i = 0; is_clause && i < weight.size; ++i) {
+          if (weight[i] >= 0) {
+            is_clause = (reachable[0] + weight[i] >= bounds[0]);
+            lit = scope[i].id() * 2 + 1;
+          } else {
+            is_clause = (reachable[0] - weight[i] >= bounds[0]);
+            lit = scope[i].id() * 2;
           }
-
-          --aux;
-          scope.add(variables[aux]);
-        } else {
-
-          // std::cout << " end" ;
-
-          infile.unget();
-
-          if (!parse_objective) {
-
-            // std::cout << " CON" ;
-
-            infile >> word;
-            infile >> aux;
-            infile.ignore(LARGENUMBER, '\n');
-
-            int bounds[2] = {-INFTY, INFTY};
-
-            if (word == ">=") {
-              bounds[0] = aux;
-            } else if (word == ">") {
-              bounds[0] = aux + 1;
-            } else if (word == "<=") {
-              bounds[1] = aux;
-            } else if (word == "<") {
-              bounds[1] = aux - 1;
-            } else if (word == "=") {
-              bounds[0] = bounds[1] = aux;
-            } else {
-              std::cout << "unknown connector: " << word << " exiting"
-                        << std::endl;
-              exit(1);
-            }
-
-            // is it a clause?
-            bool is_clause = false;
-            int max_weight = 0;
-
-            // compute the minimum
-            int reachable[2] = {0, 0}; // = 0, reachable[1] = 0;
-            for (unsigned int i = 0; i < weight.size; ++i) {
-              if (weight[i] >= 0)
-                reachable[1] += weight[i];
-              else
-                reachable[0] += weight[i];
-              int abs_weight = std::abs(weight[i]);
-              if (max_weight < abs_weight)
-                max_weight = abs_weight;
-              // mean_weight = ((mean_weight*(double)i) + (double)(weight[i])) /
-              // (double)(i+1);
-            }
-
-            // check that each variable can make it true
-            if (bounds[1] == INFTY) {
-              is_clause = true;
-              for (unsigned int i = 0; is_clause && i < weight.size; ++i) {
-                if (weight[i] >= 0) {
-                  is_clause = (reachable[0] + weight[i] >= bounds[0]);
-                  lit = scope[i].id() * 2 + 1;
-                  new_clause.add(lit);
-                } else {
-                  is_clause = (reachable[0] - weight[i] >= bounds[0]);
-                  lit = scope[i].id() * 2;
-                  new_clause.add(lit);
-                }
-              }
-            } else if (bounds[0] == -INFTY) {
-              is_clause = true;
-              for (unsigned int i = 0; is_clause && i < weight.size; ++i) {
-                if (weight[i] >= 0) {
-                  is_clause = (reachable[1] - weight[i] <= bounds[1]);
-                  lit = scope[i].id() * 2;
-                  new_clause.add(lit);
-                } else {
-                  is_clause = (reachable[1] + weight[i] <= bounds[1]);
-                  lit = scope[i].id() * 2 + 1;
-                  new_clause.add(lit);
-                }
-              }
-            }
-
-            if (is_clause) {
-              clauses.add(new_clause);
-            } else {
-
-              if (all_mones) {
-                int aux = -bounds[0];
-                bounds[0] = -bounds[1];
-                bounds[1] = aux;
-                all_pones = true;
-              }
-
-              if (all_pones) {
-
-                // std::cout << "cardinality constraint" << std::endl;
-
-                add(BoolSum(scope, // weight,
-                            bounds[0], bounds[1]));
-
-                // int real_max = std::min((int)scope.size, bounds[1]);
-                // int real_min = std::max(0, bounds[0]);
-                // int span = (real_max - real_min);
-
-                // double center = (double)(real_min + real_max) / 2;
-                // double skew = center/(double)(scope.size);
-
-                // double activity_increment = parameters.activity_increment /
-                // (scope.size * (1 << span));
-
-                // if(activity_increment > 0.0) {
-                //   int i=scope.size;
-                //   while(i--) {
-                //     lit_activity[2*scope[i].id()] += (1-skew) *
-                //     activity_increment; lit_activity[2*scope[i].id()+1] +=
-                //     skew * activity_increment; var_activity[scope[i].id()] +=
-                //     activity_increment;
-                //   }
-                // }
-
-              } else {
-
-                // int real_max = std::min(reachable[1], bounds[1]);
-                // int real_min = std::max(reachable[0], bounds[0]);
-                // double span = (real_max - real_min);
-
-                // double center = (double)(real_min + real_max) / 2;
-                // double skew = center/(double)(reachable[1] - reachable[0] +
-                // 1);
-
-                // int exp = (int)(scope.size * (span)/(double)(reachable[1] -
-                // reachable[0] + 1));
-
-                // double activity_increment = parameters.activity_increment /
-                // (1 << exp); double ac_i; // = activity_increment;
-
-                // if(activity_increment > 0.0) {
-                //   int i=scope.size;
-                //   while(i--) {
-                //     ac_i = activity_increment * (double)(std::abs(weight[i]))
-                //     / (double)max_weight;
-                //     lit_activity[2*scope[i].id()+(weight[i]<0)] += (1-skew) *
-                //     ac_i; lit_activity[2*scope[i].id()+(weight[i]>=0)] +=
-                //     skew * ac_i; var_activity[scope[i].id()] += ac_i;
-                //   }
-                // }
-
-                // std::cout << "linear constraint" << std::endl;
-
-                add(BoolSum(scope, weight, bounds[0], bounds[1]));
-              }
-            }
+          literals.add(lit);
+        }
+      } else if (bounds[0] == -INFTY) {
+        is_clause = true;
+        for (unsigned int i = 0; is_clause && i < weight.size; ++i) {
+          if (weight[i] >= 0) {
+            is_clause = (reachable[1] - weight[i] <= bounds[1]);
+            lit = scope[i].id() * 2;
           } else {
+            is_clause = (reachable[1] + weight[i] <= bounds[1]);
+            lit = scope[i].id() * 2 + 1;
+          }
+          literals.add(lit);
+        }
+      }
 
-            // std::cout << " OBJ" << std::endl;
-
-            // minimize(BoolSum(scope, weight));
-
-            Goal = BoolSum(scope, weight);
-            obj_dir = parse_objective;
-            // objective = new Goal(Goal::MINIMIZATION,  );
+      if (is_clause) {
+        start.add(literals.size);
+      } else {
+        literals.size = start.back();
 
-            infile.ignore(LARGENUMBER, '\n');
-            // std::cout << "OBJECTIVE!" << std::endl;
-            // exit(1);
-          }
+        for (unsigned int i = 0; i < scope.size; ++i)
+          frozen.add(scope[i].id());
 
-          // std::cout << " END LINE" << std::endl;
+        if (all_mones) {
+          int aux = -bounds[0];
+          bounds[0] = -bounds[1];
+          bounds[1] = aux;
+          all_pones = true;
+        }
 
-          break;
+        if (all_pones) {
+          add(BoolSum(scope, bounds[0], bounds[1]));
+        } else {
+          add(BoolSum(scope, weight, bounds[0], bounds[1]));
         }
       }
-    } while (should_continue);
-  }
+    } else {
 
-  // std::cout << clauses << std::endl;
+      Goal = BoolSum(scope, weight);
+      obj_dir = parse_objective;
+      for (unsigned int i = 0; i < scope.size; ++i)
+        frozen.add(scope[i].id());
 
-  if (parameters.backjump || clauses.size) {
+      infile.skip_line();
+    }
+  }
+
+  if (parameters.backjump || start.size > 1) {
     base = new ConstraintClauseBase(variables);
     add(base);
   }
 
-  for (unsigned int i = 0; i < clauses.size; ++i) {
-
-    add(clauses[i]);
+  if (parameters.preprocess && start.size > 1) {
+    preprocessor = new SatPreprocessor(variables.size);
+    preprocessor->preserve_models = (parameters.find_all != 0);
+    for (unsigned int i = 0; i < frozen.size; ++i)
+      preprocessor->freeze(frozen[i]);
+    for (unsigned int i = 1; i < start.size; ++i) {
+      new_clause.clear();
+      for (unsigned int j = start[i - 1]; j < start[i]; ++j)
+        new_clause.add(literals[j]);
+      preprocessor->add(new_clause);
+    }
+    load_preprocessed_clauses();
+  } else {
+    add_clauses(literals, start);
   }
 
   if (!Goal.is_void()) {
@@ -1327,70 +1274,726 @@ void Mistral::Solver::parse_pbo(const char *filename) {
 }
 
 void Mistral::Solver::parse_dimacs(const char* filename) {
-  unsigned int LARGENUMBER = 131072;
-  std::ifstream infile(filename);
-  char c = ' ';
-  std::string word;
-  int N, M, l = 0;
-  Literal lit;
+  InputScanner infile(filename);
+  int N = 0, M = 0, l = 0;
+  // the clauses, stored contiguously: clause i is literals[start[i]..start[i+1])
+  Vector<Literal> literals;
+  Vector<unsigned int> start;
   Vector<Literal> new_clause;
 
-  // skip comments
-  infile >> c;
-  while (c != 'p') {
-    infile.ignore(LARGENUMBER, '\n');
-    infile >> c;
+  if (!infile.good()) {
+    std::cout << "c cannot open " << filename << ", exiting" << std::endl;
+    exit(1);
   }
 
-  infile >> word;
-  assert(word == "cnf");
+  // skip comments
+  while (!infile.eof() && infile.peek() != 'p')
+    infile.skip_line();
 
-  // get number of atoms and clauses
-  infile >> N;
-  infile >> M;
+  infile.get();
+  if (!infile.match("cnf") || !infile.read_int(N) || !infile.read_int(M)) {
+    std::cout << "c " << filename << " is not in DIMACS format, exiting"
+              << std::endl;
+    exit(1);
+  }
 
   for (int i = 0; i < N; ++i) {
     Variable x(0, 1);
     add(x);
   }
 
-  new_clause.initialise(0, N);
-  // ConstraintClauseBase *cbase = new ConstraintClauseBase(variables);
-  // base->reason = reason.stack_;
-  // add(cbase);
+  // three literals per clause is a reasonable first guess
+  literals.initialise(0, 3 * M + 1);
+  start.initialise(0, M + 1);
+  start.add(0);
 
-  for (int i = 0; i < M; ++i) {
-    new_clause.clear();
-    do {
-      infile >> l;
-      if (l != 0) {
-        if (l > 0)
-          lit = (l - 1) * 2 + 1;
-        else
-          lit = (l + 1) * -2;
-        new_clause.add(lit);
-        // if(parameters.init_activity == 1)
-        //   base->activity[lit] += parameters.activity_increment;
+  while ((int)(start.size) <= M) {
+    if (!infile.read_int(l)) {
+      // a comment, or the end of the formula ('%' in some benchmarks)
+      if (infile.peek() == 'c') {
+        infile.skip_line();
+        continue;
+      }
+      break;
+    }
+    if (l != 0) {
+      if (l > 0)
+        literals.add((l - 1) * 2 + 1);
+      else
+        literals.add((l + 1) * -2);
+    } else {
+      start.add(literals.size);
+    }
+  }
+  // the last clause may not be terminated
+  if (literals.size > start.back())
+    start.add(literals.size);
+
+  if (parameters.preprocess) {
+    preprocessor = new SatPreprocessor(N);
+    preprocessor->preserve_models = (parameters.find_all != 0);
+    new_clause.initialise(0, N);
+    for (unsigned int i = 1; i < start.size; ++i) {
+      new_clause.clear();
+      for (unsigned int j = start[i - 1]; j < start[i]; ++j)
+        new_clause.add(literals[j]);
+      preprocessor->add(new_clause);
+    }
+    load_preprocessed_clauses();
+  } else {
+    add_clauses(literals, start);
+  }
+}
+
+
+void Mistral::Solver::load_preprocessed_clauses() {
+  Vector<Literal> clause;
+  unsigned int i, j;
+
+  if (!preprocessor->simplify()) {
+    // the formula is unsatisfiable
+    fail();
+  } else {
+    // eliminated atoms are left unconstrained, extend() overwrites them
+    for (i = 0; i < (unsigned int)(preprocessor->num_atoms); ++i)
+      if (preprocessor->value[i] >= 0)
+        variables[i].set_domain(preprocessor->value[i]);
+    for (i = 0; i < preprocessor->clauses.size(); ++i) {
+      if (preprocessor->removed[i])
+        continue;
+      clause.clear();
+      for (j = 0; j < preprocessor->clauses[i].size(); ++j)
+        clause.add(preprocessor->clauses[i][j]);
+      add(clause);
+    }
+    // substituted atoms are tied back to their representative so that
+    // every model is enumerated
+    if (preprocessor->preserve_models)
+      for (i = 0; i < preprocessor->removed_clauses.size(); ++i) {
+        clause.clear();
+        for (j = 0; j < preprocessor->removed_clauses[i].size(); ++j)
+          clause.add(preprocessor->removed_clauses[i][j]);
+        add(clause);
       }
-    } while (l && infile.good());
-    // cbase->add( new_clause );
-    add(new_clause);
+  }
 
-    // std::cout << new_clause << std::endl;
+  if (parameters.verbosity > 0) {
+    std::cout << " " << parameters.prefix_comment << " ";
+    preprocessor->display(std::cout);
+    std::cout << std::endl;
+  }
+}
 
-    // if(params.checked) add_original_clause( new_clause );
+/**********************************************
+ * Snapshots
+ **********************************************/
+// A snapshot is a flat sequence of native 32 bits integers:
+//  magic, version, #variables, #constraints, payload size (in bytes)
+//  for each variable: min, max, size and, if the domain has holes, its values
+//  for each constraint: kind, arity, the scope, #parameters, the parameters
+//  (a scope entry is a variable id, or -1 followed by a constant)
+//  the goal: type, sub-type and objective id (-1 if none)
+//  the payload, padded to a multiple of 4 bytes
+
+#define SNAPSHOT_MAGIC 0x4d53504e
+#define SNAPSHOT_VERSION 1
+
+enum SnapshotKind {
+  SNAPSHOT_EQUAL,
+  SNAPSHOT_NOT_EQUAL,
+  SNAPSHOT_LESS,
+  SNAPSHOT_AND,
+  SNAPSHOT_OR,
+  SNAPSHOT_NOT_AND,
+  SNAPSHOT_PREDICATE_EQUAL,
+  SNAPSHOT_PREDICATE_CONSTANT_EQUAL,
+  SNAPSHOT_PREDICATE_LESS,
+  SNAPSHOT_PREDICATE_UPPER_BOUND,
+  SNAPSHOT_PREDICATE_LOWER_BOUND,
+  SNAPSHOT_PREDICATE_INTERVAL_MEMBER,
+  SNAPSHOT_PREDICATE_SET_MEMBER,
+  SNAPSHOT_PREDICATE_OFFSET,
+  SNAPSHOT_PREDICATE_FACTOR,
+  SNAPSHOT_PREDICATE_NOT,
+  SNAPSHOT_PREDICATE_NEG,
+  SNAPSHOT_PREDICATE_AND,
+  SNAPSHOT_PREDICATE_OR,
+  SNAPSHOT_PREDICATE_ADD,
+  SNAPSHOT_PREDICATE_MUL,
+  SNAPSHOT_PREDICATE_DIV,
+  SNAPSHOT_PREDICATE_MOD,
+  SNAPSHOT_PREDICATE_CMOD,
+  SNAPSHOT_PREDICATE_DIV_CONSTANT,
+  SNAPSHOT_PREDICATE_MOD_CONSTANT,
+  SNAPSHOT_PREDICATE_CMOD_CONSTANT,
+  SNAPSHOT_PREDICATE_ABS,
+  SNAPSHOT_PREDICATE_SQUARE,
+  SNAPSHOT_PREDICATE_MIN,
+  SNAPSHOT_PREDICATE_MAX,
+  SNAPSHOT_PREDICATE_ELEMENT,
+  SNAPSHOT_INT_ELEMENT,
+  SNAPSHOT_ALLDIFF,
+  SNAPSHOT_ALLDIFF_GAC,
+  SNAPSHOT_CLIQUE_NOT_EQUAL,
+  SNAPSHOT_BOOL_SUM_INTERVAL,
+  SNAPSHOT_WEIGHTED_BOOL_SUM_INTERVAL,
+  SNAPSHOT_INCREMENTAL_WEIGHTED_BOOL_SUM_INTERVAL,
+  SNAPSHOT_PREDICATE_BOOL_SUM,
+  SNAPSHOT_PREDICATE_WEIGHTED_BOOL_SUM,
+  SNAPSHOT_PREDICATE_WEIGHTED_SUM,
+  SNAPSHOT_INCREMENTAL_WEIGHTED_SUM,
+  SNAPSHOT_GAC2001,
+  SNAPSHOT_GAC3,
+  SNAPSHOT_GAC4,
+  SNAPSHOT_CLAUSES
+};
+
+static void add_snapshot_weights(const Mistral::Vector<int> &weight,
+                                 std::vector<int> &params) {
+  params.push_back(weight.size);
+  for (unsigned int i = 0; i < weight.size; ++i)
+    params.push_back(weight[i]);
+}
+
+static void add_snapshot_tuples(const Mistral::ConstraintTable *c,
+                                std::vector<int> &params) {
+  params.push_back(c->table.size);
+  for (unsigned int i = 0; i < c->table.size; ++i)
+    params.insert(params.end(), c->table[i], c->table[i] + c->scope.size);
+}
+
+// the kind of c and its parameters, -1 if it cannot be stored in a snapshot
+static int get_snapshot_kind(Mistral::ConstraintImplementation *c,
+                             std::vector<int> &params) {
+  using namespace Mistral;
+
+  const std::type_info &t = typeid(*c);
+
+  if (t == typeid(ConstraintEqual))
+    return SNAPSHOT_EQUAL;
+  if (t == typeid(ConstraintNotEqual))
+    return SNAPSHOT_NOT_EQUAL;
+  if (t == typeid(ConstraintLess)) {
+    params.push_back(((ConstraintLess *)c)->offset);
+    return SNAPSHOT_LESS;
+  }
+  if (t == typeid(ConstraintAnd))
+    return SNAPSHOT_AND;
+  if (t == typeid(ConstraintOr))
+    return SNAPSHOT_OR;
+  if (t == typeid(ConstraintNotAnd))
+    return SNAPSHOT_NOT_AND;
+  if (t == typeid(PredicateEqual)) {
+    params.push_back(((PredicateEqual *)c)->spin);
+    return SNAPSHOT_PREDICATE_EQUAL;
+  }
+  if (t == typeid(PredicateConstantEqual)) {
+    params.push_back(((PredicateConstantEqual *)c)->value);
+    params.push_back(((PredicateConstantEqual *)c)->spin);
+    return SNAPSHOT_PREDICATE_CONSTANT_EQUAL;
+  }
+  if (t == typeid(PredicateLess)) {
+    params.push_back(((PredicateLess *)c)->offset);
+    return SNAPSHOT_PREDICATE_LESS;
+  }
+  if (t == typeid(PredicateUpperBound)) {
+    params.push_back(((PredicateUpperBound *)c)->bound);
+    return SNAPSHOT_PREDICATE_UPPER_BOUND;
+  }
+  if (t == typeid(PredicateLowerBound)) {
+    params.push_back(((PredicateLowerBound *)c)->bound);
+    return SNAPSHOT_PREDICATE_LOWER_BOUND;
+  }
+  if (t == typeid(PredicateIntervalMember)) {
+    params.push_back(((PredicateIntervalMember *)c)->lower_bound);
+    params.push_back(((PredicateIntervalMember *)c)->upper_bound);
+    params.push_back(((PredicateIntervalMember *)c)->spin);
+    return SNAPSHOT_PREDICATE_INTERVAL_MEMBER;
+  }
+  if (t == typeid(PredicateSetMember)) {
+    const BitSet &values = ((PredicateSetMember *)c)->values;
+    params.push_back(((PredicateSetMember *)c)->spin);
+    if (!values.empty()) {
+      int v = values.min(), w;
+      do {
+        params.push_back(v);
+        w = v;
+        v = values.next(w);
+      } while (v != w);
+    }
+    return SNAPSHOT_PREDICATE_SET_MEMBER;
+  }
+  if (t == typeid(PredicateOffset)) {
+    params.push_back(((PredicateOffset *)c)->offset);
+    return SNAPSHOT_PREDICATE_OFFSET;
+  }
+  if (t == typeid(PredicateFactor)) {
+    params.push_back(((PredicateFactor *)c)->factor);
+    return SNAPSHOT_PREDICATE_FACTOR;
+  }
+  if (t == typeid(PredicateNot))
+    return SNAPSHOT_PREDICATE_NOT;
+  if (t == typeid(PredicateNeg))
+    return SNAPSHOT_PREDICATE_NEG;
+  if (t == typeid(PredicateAnd))
+    return SNAPSHOT_PREDICATE_AND;
+  if (t == typeid(PredicateOr))
+    return SNAPSHOT_PREDICATE_OR;
+  if (t == typeid(PredicateAdd))
+    return SNAPSHOT_PREDICATE_ADD;
+  if (t == typeid(PredicateMul))
+    return SNAPSHOT_PREDICATE_MUL;
+  if (t == typeid(PredicateDiv))
+    return SNAPSHOT_PREDICATE_DIV;
+  if (t == typeid(PredicateMod))
+    return SNAPSHOT_PREDICATE_MOD;
+  if (t == typeid(PredicateCMod))
+    return SNAPSHOT_PREDICATE_CMOD;
+  if (t == typeid(PredicateDivConstant)) {
+    params.push_back(((PredicateDivConstant *)c)->quotient);
+    return SNAPSHOT_PREDICATE_DIV_CONSTANT;
+  }
+  if (t == typeid(PredicateModConstant)) {
+    params.push_back(((PredicateModConstant *)c)->modulo);
+    return SNAPSHOT_PREDICATE_MOD_CONSTANT;
+  }
+  if (t == typeid(PredicateCModConstant)) {
+    params.push_back(((PredicateCModConstant *)c)->modulo);
+    return SNAPSHOT_PREDICATE_CMOD_CONSTANT;
+  }
+  if (t == typeid(PredicateAbs))
+    return SNAPSHOT_PREDICATE_ABS;
+  if (t == typeid(PredicateSquare))
+    return SNAPSHOT_PREDICATE_SQUARE;
+  if (t == typeid(PredicateMin))
+    return SNAPSHOT_PREDICATE_MIN;
+  if (t == typeid(PredicateMax))
+    return SNAPSHOT_PREDICATE_MAX;
+  if (t == typeid(PredicateElement)) {
+    params.push_back(((PredicateElement *)c)->offset);
+    return SNAPSHOT_PREDICATE_ELEMENT;
+  }
+  if (t == typeid(ConstraintIntElement)) {
+    ConstraintIntElement *e = (ConstraintIntElement *)c;
+    params.push_back(e->offset);
+    params.insert(params.end(), e->table.begin(), e->table.end());
+    return SNAPSHOT_INT_ELEMENT;
+  }
+  if (t == typeid(ConstraintAllDiff))
+    return SNAPSHOT_ALLDIFF;
+  if (t == typeid(ConstraintAllDiffGAC))
+    return SNAPSHOT_ALLDIFF_GAC;
+  if (t == typeid(ConstraintCliqueNotEqual)) {
+    params.push_back(((ConstraintCliqueNotEqual *)c)->exception);
+    return SNAPSHOT_CLIQUE_NOT_EQUAL;
+  }
+  if (t == typeid(ConstraintBoolSumInterval)) {
+    params.push_back(((ConstraintBoolSumInterval *)c)->lower_bound);
+    params.push_back(((ConstraintBoolSumInterval *)c)->upper_bound);
+    return SNAPSHOT_BOOL_SUM_INTERVAL;
+  }
+  if (t == typeid(ConstraintWeightedBoolSumInterval)) {
+    ConstraintWeightedBoolSumInterval *s = (ConstraintWeightedBoolSumInterval *)c;
+    params.push_back(s->lower_bound);
+    params.push_back(s->upper_bound);
+    add_snapshot_weights(s->weight, params);
+    return SNAPSHOT_WEIGHTED_BOOL_SUM_INTERVAL;
+  }
+  if (t == typeid(ConstraintIncrementalWeightedBoolSumInterval)) {
+    ConstraintIncrementalWeightedBoolSumInterval *s =
+        (ConstraintIncrementalWeightedBoolSumInterval *)c;
+    params.push_back(s->lower_bound);
+    params.push_back(s->upper_bound);
+    add_snapshot_weights(s->weight, params);
+    return SNAPSHOT_INCREMENTAL_WEIGHTED_BOOL_SUM_INTERVAL;
+  }
+  if (t == typeid(PredicateBoolSum)) {
+    params.push_back(((PredicateBoolSum *)c)->offset);
+    return SNAPSHOT_PREDICATE_BOOL_SUM;
+  }
+  if (t == typeid(PredicateWeightedBoolSum)) {
+    params.push_back(((PredicateWeightedBoolSum *)c)->offset);
+    add_snapshot_weights(((PredicateWeightedBoolSum *)c)->weight, params);
+    return SNAPSHOT_PREDICATE_WEIGHTED_BOOL_SUM;
+  }
+  if (t == typeid(PredicateWeightedSum)) {
+    PredicateWeightedSum *s = (PredicateWeightedSum *)c;
+    params.push_back(s->lower_bound);
+    params.push_back(s->upper_bound);
+    add_snapshot_weights(s->weight, params);
+    return SNAPSHOT_PREDICATE_WEIGHTED_SUM;
+  }
+  if (t == typeid(ConstraintIncrementalWeightedSum)) {
+    ConstraintIncrementalWeightedSum *s = (ConstraintIncrementalWeightedSum *)c;
+    params.push_back(s->lower_bound);
+    params.push_back(s->upper_bound);
+    add_snapshot_weights(s->weight, params);
+    return SNAPSHOT_INCREMENTAL_WEIGHTED_SUM;
+  }
+  if (t == typeid(ConstraintGAC2001)) {
+    add_snapshot_tuples((ConstraintTable *)c, params);
+    return SNAPSHOT_GAC2001;
+  }
+  if (t == typeid(ConstraintGAC3)) {
+    params.push_back(((ConstraintGAC3 *)c)->isPositive());
+    add_snapshot_tuples((ConstraintTable *)c, params);
+    return SNAPSHOT_GAC3;
+  }
+  if (t == typeid(ConstraintGAC4)) {
+    add_snapshot_tuples((ConstraintTable *)c, params);
+    return SNAPSHOT_GAC4;
+  }
+  if (t == typeid(ConstraintClauseBase)) {
+    // literals are re-indexed on the ids of the variables
+    ConstraintClauseBase *b = (ConstraintClauseBase *)c;
+    params.push_back(b->clauses.size);
+    for (unsigned int i = 0; i < b->clauses.size; ++i) {
+      Clause &cl = *(b->clauses[i]);
+      params.push_back(cl.size);
+      for (unsigned int j = 0; j < cl.size; ++j)
+        params.push_back(2 * b->scope[UNSIGNED(cl[j])].id() + SIGN(cl[j]));
+    }
+    return SNAPSHOT_CLAUSES;
+  }
+
+  return -1;
+}
+
+// builds a constraint of the given kind from the parameters 'p'
+static Mistral::ConstraintImplementation *
+make_snapshot_constraint(const int kind, Mistral::Vector<Mistral::Variable> &X,
+                         const int *p, const int n) {
+  using namespace Mistral;
+
+  switch (kind) {
+  case SNAPSHOT_EQUAL:
+    return new ConstraintEqual(X);
+  case SNAPSHOT_NOT_EQUAL:
+    return new ConstraintNotEqual(X);
+  case SNAPSHOT_LESS:
+    return new ConstraintLess(X, p[0]);
+  case SNAPSHOT_AND:
+    return new ConstraintAnd(X);
+  case SNAPSHOT_OR:
+    return new ConstraintOr(X);
+  case SNAPSHOT_NOT_AND:
+    return new ConstraintNotAnd(X);
+  case SNAPSHOT_PREDICATE_EQUAL:
+    return new PredicateEqual(X, p[0]);
+  case SNAPSHOT_PREDICATE_CONSTANT_EQUAL:
+    return new PredicateConstantEqual(X, p[0], p[1]);
+  case SNAPSHOT_PREDICATE_LESS:
+    return new PredicateLess(X, p[0]);
+  case SNAPSHOT_PREDICATE_UPPER_BOUND:
+    return new PredicateUpperBound(X, p[0]);
+  case SNAPSHOT_PREDICATE_LOWER_BOUND:
+    return new PredicateLowerBound(X, p[0]);
+  case SNAPSHOT_PREDICATE_INTERVAL_MEMBER:
+    return new PredicateIntervalMember(X, p[0], p[1], p[2]);
+  case SNAPSHOT_PREDICATE_SET_MEMBER: {
+    int lb = INFTY, ub = -INFTY;
+    for (int i = 1; i < n; ++i) {
+      lb = std::min(lb, p[i]);
+      ub = std::max(ub, p[i]);
+    }
+    if (n == 1)
+      lb = ub = 0;
+    BitSet values(lb, ub, BitSet::empt);
+    for (int i = 1; i < n; ++i)
+      values.add(p[i]);
+    return new PredicateSetMember(X, values, p[0]);
+  }
+  case SNAPSHOT_PREDICATE_OFFSET:
+    return new PredicateOffset(X, p[0]);
+  case SNAPSHOT_PREDICATE_FACTOR:
+    return new PredicateFactor(X, p[0]);
+  case SNAPSHOT_PREDICATE_NOT:
+    return new PredicateNot(X);
+  case SNAPSHOT_PREDICATE_NEG:
+    return new PredicateNeg(X);
+  case SNAPSHOT_PREDICATE_AND:
+    return new PredicateAnd(X);
+  case SNAPSHOT_PREDICATE_OR:
+    return new PredicateOr(X);
+  case SNAPSHOT_PREDICATE_ADD:
+    return new PredicateAdd(X);
+  case SNAPSHOT_PREDICATE_MUL:
+    return new PredicateMul(X);
+  case SNAPSHOT_PREDICATE_DIV:
+    return new PredicateDiv(X);
+  case SNAPSHOT_PREDICATE_MOD:
+    return new PredicateMod(X);
+  case SNAPSHOT_PREDICATE_CMOD:
+    return new PredicateCMod(X);
+  case SNAPSHOT_PREDICATE_DIV_CONSTANT:
+    return new PredicateDivConstant(X, p[0]);
+  case SNAPSHOT_PREDICATE_MOD_CONSTANT:
+    return new PredicateModConstant(X, p[0]);
+  case SNAPSHOT_PREDICATE_CMOD_CONSTANT:
+    return new PredicateCModConstant(X, p[0]);
+  case SNAPSHOT_PREDICATE_ABS:
+    return new PredicateAbs(X);
+  case SNAPSHOT_PREDICATE_SQUARE:
+    return new PredicateSquare(X);
+  case SNAPSHOT_PREDICATE_MIN:
+    return new PredicateMin(X);
+  case SNAPSHOT_PREDICATE_MAX:
+    return new PredicateMax(X);
+  case SNAPSHOT_PREDICATE_ELEMENT:
+    return new PredicateElement(X, p[0]);
+  case SNAPSHOT_INT_ELEMENT: {
+    std::vector<int> table(p + 1, p + n);
+    return new ConstraintIntElement(X, table, p[0]);
+  }
+  case SNAPSHOT_ALLDIFF:
+    return new ConstraintAllDiff(X);
+  case SNAPSHOT_ALLDIFF_GAC:
+    return new ConstraintAllDiffGAC(X);
+  case SNAPSHOT_CLIQUE_NOT_EQUAL:
+    return new ConstraintCliqueNotEqual(X, p[0]);
+  case SNAPSHOT_BOOL_SUM_INTERVAL:
+    return new ConstraintBoolSumInterval(X, p[0], p[1]);
+  case SNAPSHOT_WEIGHTED_BOOL_SUM_INTERVAL:
+  case SNAPSHOT_INCREMENTAL_WEIGHTED_BOOL_SUM_INTERVAL:
+  case SNAPSHOT_PREDICATE_WEIGHTED_SUM:
+  case SNAPSHOT_INCREMENTAL_WEIGHTED_SUM: {
+    Vector<int> weight;
+    for (int i = 0; i < p[2]; ++i)
+      weight.add(p[3 + i]);
+    if (kind == SNAPSHOT_WEIGHTED_BOOL_SUM_INTERVAL)
+      return new ConstraintWeightedBoolSumInterval(X, weight, p[0], p[1]);
+    if (kind == SNAPSHOT_INCREMENTAL_WEIGHTED_BOOL_SUM_INTERVAL)
+      return new ConstraintIncrementalWeightedBoolSumInterval(X, weight, p[0],
+                                                              p[1]);
+    if (kind == SNAPSHOT_PREDICATE_WEIGHTED_SUM)
+      return new PredicateWeightedSum(X, weight, p[0], p[1]);
+    return new ConstraintIncrementalWeightedSum(X, weight, p[0], p[1]);
+  }
+  case SNAPSHOT_PREDICATE_BOOL_SUM:
+    return new PredicateBoolSum(X, p[0]);
+  case SNAPSHOT_PREDICATE_WEIGHTED_BOOL_SUM: {
+    Vector<int> weight;
+    for (int i = 0; i < p[1]; ++i)
+      weight.add(p[2 + i]);
+    return new PredicateWeightedBoolSum(X, weight, p[0]);
+  }
+  case SNAPSHOT_GAC2001:
+  case SNAPSHOT_GAC3:
+  case SNAPSHOT_GAC4: {
+    ConstraintTable *tab;
+    if (kind == SNAPSHOT_GAC3) {
+      tab = new ConstraintGAC3(X, p[0]);
+      ++p;
+    } else if (kind == SNAPSHOT_GAC2001)
+      tab = new ConstraintGAC2001(X);
+    else
+      tab = new ConstraintGAC4(X);
+    // the tuples are not copied, they point into the snapshot
+    for (int i = 0; i < p[0]; ++i)
+      tab->add(p + 1 + i * X.size);
+    return tab;
   }
+  }
+
+  return NULL;
+}
+
+bool Mistral::Solver::dump_snapshot(const char *filename,
+                                    const std::string &payload) {
+  std::vector<int> data;
+  std::vector<int> params;
+  unsigned int i, j, num_constraints = 0;
 
-  // init_watchers();
+  data.push_back(SNAPSHOT_MAGIC);
+  data.push_back(SNAPSHOT_VERSION);
+  data.push_back(variables.size);
+  data.push_back(0);
+  data.push_back(payload.size());
 
-  // if(params.normalize_activity != 0)
-  // normalize_activity(params.normalize_activity);
+  for (i = 0; i < variables.size; ++i) {
+    Variable x = variables[i];
+    int lb = x.get_min(), ub = x.get_max(), size = x.get_size();
+    data.push_back(lb);
+    data.push_back(ub);
+    data.push_back(size);
+    if (size < ub - lb + 1)
+      for (int v = lb; data.push_back(v), v < ub; v = x.next(v))
+        ;
+  }
+
+  for (i = 0; i < constraints.size; ++i) {
+    if (!posted_constraints.contain(i))
+      continue;
+    ConstraintImplementation *c = constraints[i].propagator;
+    params.clear();
+    int kind = get_snapshot_kind(c, params);
+    if (kind < 0) {
+      std::cout << parameters.prefix_comment << " cannot store " << c->name()
+                << " constraints in a snapshot" << std::endl;
+      return false;
+    }
+    data.push_back(kind);
+    if (kind == SNAPSHOT_CLAUSES) {
+      data.push_back(0);
+    } else {
+      data.push_back(c->_scope.size);
+      for (j = 0; j < c->_scope.size; ++j) {
+        Variable x = c->_scope[j].get_var();
+        if (x.domain_type == CONST_VAR) {
+          data.push_back(-1);
+          data.push_back(x.get_value());
+        } else
+          data.push_back(x.id());
+      }
+    }
+    data.push_back(params.size());
+    data.insert(data.end(), params.begin(), params.end());
+    ++num_constraints;
+  }
+  data[3] = num_constraints;
 
-  //  std::cout << base << std::endl;
+  if (objective) {
+    data.push_back(objective->type);
+    data.push_back(objective->sub_type);
+    data.push_back(objective->is_optimization() ? objective->objective.id()
+                                                : -1);
+  } else {
+    data.push_back(Goal::NONE);
+    data.push_back(Goal::NONE);
+    data.push_back(-1);
+  }
+
+  std::ofstream outfile(filename, std::ios_base::out | std::ios_base::binary);
+  outfile.write((const char *)data.data(), data.size() * sizeof(int));
+  outfile.write(payload.data(), payload.size());
+  int padding = 0;
+  outfile.write((const char *)&padding, (-payload.size()) & (sizeof(int) - 1));
+  outfile.close();
 
-  // cbase->reason = reason.stack_;
+  if (!outfile) {
+    std::cout << parameters.prefix_comment << " cannot write " << filename
+              << std::endl;
+    return false;
+  }
+  return true;
 }
 
+bool Mistral::Solver::load_snapshot(const char *filename,
+                                    std::string *payload) {
+  struct stat info;
+  int fd = ::open(filename, O_RDONLY);
+  if (fd < 0 || fstat(fd, &info) < 0 ||
+      info.st_size < (off_t)(5 * sizeof(int))) {
+    if (fd >= 0)
+      ::close(fd);
+    std::cout << parameters.prefix_comment << " cannot open " << filename
+              << std::endl;
+    return false;
+  }
+  void *mem = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mem == MAP_FAILED) {
+    std::cout << parameters.prefix_comment << " cannot map " << filename
+              << std::endl;
+    return false;
+  }
+  snapshot = (char *)mem;
+  snapshot_size = info.st_size;
+
+  const int *p = (const int *)snapshot;
+  const int *end = p + snapshot_size / sizeof(int);
+
+  if (p[0] != SNAPSHOT_MAGIC || p[1] != SNAPSHOT_VERSION) {
+    std::cout << parameters.prefix_comment << " " << filename
+              << " is not a snapshot" << std::endl;
+    return false;
+  }
+  int num_variables = p[2], num_constraints = p[3], payload_size = p[4], i, j,
+      n;
+  p += 5;
+
+  // the variables are declared in order, so that they get the same ids
+  Vector<int> values;
+  for (i = 0; i < num_variables; ++i) {
+    int lb = p[0], ub = p[1], size = p[2];
+    p += 3;
+    if (lb == ub) {
+      Variable x(lb, lb + 1);
+      add(x);
+      variables.back().set_domain(lb);
+    } else if (size < ub - lb + 1) {
+      values.clear();
+      for (j = 0; j < size; ++j)
+        values.add(p[j]);
+      p += size;
+      Variable x(values);
+      add(x);
+    } else {
+      Variable x(lb, ub);
+      add(x);
+    }
+  }
+
+  Vector<Variable> scope;
+  Vector<Literal> literals;
+  Vector<unsigned int> start;
+  start.add(0);
+  for (i = 0; i < num_constraints && p < end; ++i) {
+    int kind = p[0], arity = p[1];
+    p += 2;
+    scope.clear();
+    for (j = 0; j < arity; ++j) {
+      if (*p < 0) {
+        scope.add(Variable(p[1]));
+        p += 2;
+      } else
+        scope.add(variables[*p++]);
+    }
+    n = *p++;
+    if (kind == SNAPSHOT_CLAUSES) {
+      // the clauses are loaded in bulk, once every variable is declared
+      const int *q = p + 1;
+      for (j = 0; j < p[0]; ++j) {
+        for (int k = 1; k <= q[0]; ++k)
+          literals.add(q[k]);
+        start.add(literals.size);
+        q += q[0] + 1;
+      }
+    } else {
+      ConstraintImplementation *c =
+          make_snapshot_constraint(kind, scope, p, n);
+      if (!c) {
+        std::cout << parameters.prefix_comment << " " << filename
+                  << " is corrupted" << std::endl;
+        return false;
+      }
+      add(Constraint(c));
+    }
+    p += n;
+  }
+  add_clauses(literals, start);
+
+  consolidate();
+
+  if (p + 3 > end) {
+    std::cout << parameters.prefix_comment << " " << filename
+              << " is corrupted" << std::endl;
+    return false;
+  }
+  Goal::method type = (Goal::method)p[0], sub_type = (Goal::method)p[1];
+  if (p[2] >= 0)
+    set_goal(new Goal(type, sub_type, variables[p[2]]));
+  else if (type != Goal::NONE)
+    set_goal(new Goal(type));
+  p += 3;
+
+  if (payload)
+    payload->assign((const char *)p,
+                    std::min((size_t)payload_size,
+                             (size_t)(snapshot + snapshot_size - (char *)p)));
+
+  return true;
+}
 
 void Mistral::Solver::add(Vector< Literal >& clause) {
   if (!base) {
@@ -1419,6 +2022,64 @@ void Mistral::Solver::add(Vector< Literal >& clause) {
             (parameters.init_activity ? parameters.activity_increment : 0.0));
 }
 
+void Mistral::Solver::add_clauses(Vector<Literal> &literals,
+                                  Vector<unsigned int> &start) {
+  if (start.size < 2)
+    return;
+  if (!base) {
+    base = new ConstraintClauseBase(variables);
+    add(base);
+  }
+  base->add_clauses(literals, start);
+}
+
+// structural key of x: name, children (ids or values) and parameters
+static bool get_subexpression_key(Mistral::Expression *x, std::string &key) {
+  Mistral::Vector<int> params;
+  if (!x->get_signature(params))
+    return false;
+
+  // children are (is-constant, id or value) pairs, sorted when their order
+  // does not matter
+  std::vector<std::pair<int, int> > args;
+  for (unsigned int i = 0; i < x->children.size; ++i) {
+    Mistral::Variable y = x->children[i].get_var();
+    if (y.domain_type == CONST_VAR)
+      args.push_back(std::make_pair(1, y.get_min()));
+    else
+      args.push_back(std::make_pair(0, y.id()));
+  }
+  if (x->is_commutative())
+    std::sort(args.begin(), args.end());
+
+  key = x->get_name();
+  key += '(';
+  for (auto &a : args) {
+    key.append((const char *)&a.first, sizeof(int));
+    key.append((const char *)&a.second, sizeof(int));
+  }
+  key += ')';
+  for (unsigned int i = 0; i < params.size; ++i)
+    key.append((const char *)&params[i], sizeof(int));
+  return true;
+}
+
+Mistral::Expression *Mistral::Solver::get_subexpression(Expression *x) {
+  std::string key;
+  if (!get_subexpression_key(x, key))
+    return NULL;
+  auto it = subexpressions.insert(std::make_pair(key, x));
+  return (it.second ? NULL : it.first->second);
+}
+
+bool Mistral::Solver::is_merged(Expression *x) {
+  std::string key;
+  if (!get_subexpression_key(x, key))
+    return false;
+  auto it = subexpressions.find(key);
+  return (it != subexpressions.end() && it->second != x);
+}
+
 void Mistral::Solver::set_parameters(SolverParameters &p) { parameters = p; }
 
 void Mistral::Solver::add(VarArray& x) {
@@ -1697,9 +2358,104 @@ Mistral::Outcome Mistral::Solver::depth_first_search(bool _restore_) {
 
   search_started = true;
 
+  if (parameters.dichotomy && objective->is_optimization() &&
+      !dichotomic_probing()) {
+    // the bounds deduced by the probes are inconsistent at the root
+    if (objective->sub_type == Goal::MINIMIZATION)
+      objective->lower_bound = objective->upper_bound;
+    else
+      objective->upper_bound = objective->lower_bound;
+    statistics.outcome = (statistics.num_solutions ? OPT : UNSAT);
+    statistics.end_time = get_run_time();
+    if (parameters.verbosity)
+      std::cout << statistics;
+    return statistics.outcome;
+  }
+
   return restart_search(0, _restore_);
 }
 
+bool Mistral::Solver::dichotomic_probing() {
+  // bounds are expressed as if minimising
+  bool minimise = (objective->sub_type == Goal::MINIMIZATION);
+  // the objective may change representation during search, so no copy
+  Variable &obj = objective->objective;
+
+  unsigned int fail_limit = parameters.fail_limit;
+  unsigned int limit = parameters.limit;
+  int verbosity = parameters.verbosity;
+  unsigned int num_learnt = (base ? base->learnt.size : 0);
+  unsigned long int num_solutions;
+  int lb = INFTY, ub, target, probe = 0;
+  bool consistent = true;
+  Outcome result;
+
+  parameters.limit = 1;
+  parameters.verbosity = 0;
+
+  while (probe++ < parameters.dichotomy) {
+    // lb is the dichotomic lower bound, it is not necessarily proven
+    if (lb == INFTY || lb < (minimise ? obj.get_min() : -obj.get_max()))
+      lb = (minimise ? obj.get_min() : -obj.get_max());
+    ub = (minimise ? objective->upper_bound - 1 : -objective->lower_bound - 1);
+    if (lb >= ub ||
+        (parameters.time_limit > 0.0 &&
+         (get_run_time() - statistics.start_time) > parameters.time_limit))
+      break;
+
+    target = lb + (ub - lb) / 2;
+    num_solutions = statistics.num_solutions;
+    parameters.fail_limit = statistics.num_failures + parameters.probe_fail_limit;
+
+    save();
+    if (FAILED(minimise ? obj.set_max(target) : obj.set_min(-target)))
+      result = UNSAT;
+    else {
+      policy->initialise(parameters.restart_limit);
+      parameters.restart_limit += statistics.num_failures;
+      result = restart_search(level);
+    }
+    restore();
+
+    // clauses learnt under the probe's bound are not globally valid
+    if (base)
+      while (base->learnt.size > num_learnt) {
+        statistics.size_learned -= base->learnt.back()->size;
+        base->remove(base->learnt.size - 1);
+      }
+
+    if (verbosity > 0)
+      std::cout << " " << parameters.prefix_comment << " probe "
+                << (minimise ? "<= " : ">= ") << (minimise ? target : -target)
+                << ": "
+                << (statistics.num_solutions > num_solutions
+                        ? "solution"
+                        : (result == LIMITOUT ? "limit" : "refuted"))
+                << std::endl;
+
+    if (statistics.num_solutions > num_solutions) {
+      // a probe exhausted after a solution proves optimality
+      if (result == OPT)
+        break;
+    } else if (result == LIMITOUT) {
+      lb = target + 1;
+    } else if (FAILED(minimise ? obj.set_min(target + 1)
+                               : obj.set_max(-target - 1)) ||
+               !propagate()) {
+      consistent = false;
+      break;
+    }
+  }
+
+  parameters.fail_limit = fail_limit;
+  parameters.limit = limit;
+  parameters.verbosity = verbosity;
+  policy->initialise(parameters.restart_limit);
+  parameters.restart_limit += statistics.num_failures;
+
+  return consistent;
+}
+
 Mistral::Outcome Mistral::Solver::depth_first_search(BranchingHeuristic *heu,
                                                      RestartPolicy *pol,
                                                      Goal *goal,
@@ -2030,7 +2786,9 @@ Mistral::Outcome Mistral::Solver::restart_search(const int root, const bool _res
       }
     }
 
-    if (_restore_ || satisfiability == UNKNOWN)
+    if (satisfiability == UNKNOWN && parameters.reuse_trail)
+      restore(get_reusable_level(root));
+    else if (_restore_ || satisfiability == UNKNOWN)
       restore(root);
 
     forget();
@@ -2061,6 +2819,32 @@ Mistral::Outcome Mistral::Solver::restart_search(const int root, const bool _res
   return satisfiability;
 }
 
+int Mistral::Solver::get_reusable_level(const int root) {
+  // the current node failed, so at least its level must be undone
+  if (level <= root + 1 || sequence.empty())
+    return root;
+
+  // the variable that the heuristic would pick among the free ones
+  Variable next = sequence[0];
+  for (int i = 1; i < sequence.size; ++i)
+    if (heuristic->comp(sequence[i], next))
+      next = sequence[i];
+
+  // decisions are kept as long as their variable is strictly preferred to
+  // 'next' (comparators that cannot order variables never allow reuse)
+  int lvl = root, last = level - 1;
+  while (lvl < last) {
+    Variable x = decisions[lvl - root].var;
+    if (!heuristic->comp(x, next) || heuristic->comp(next, x))
+      break;
+    ++lvl;
+  }
+
+  statistics.num_reused_levels += (lvl - root);
+
+  return lvl;
+}
+
 Mistral::Outcome Mistral::Solver::get_next_solution()  
 {
   Outcome satisfiability = UNSAT;
@@ -2129,7 +2913,7 @@ void Mistral::Solver::initialise_search(Vector<Variable> &seq,
   sequence.clear();
   // decisions.clear();
   for (unsigned int i = seq.size; i;) {
-    Variable x = seq[--i].get_var();
+    Variable x = get_representative(seq[--i].get_var());
     if (!x.is_ground())
       if (!sequence.contain(x) && !(domain_types[x.id()] & REMOVED_VAR))
         sequence.add(x);
@@ -2150,6 +2934,8 @@ void Mistral::Solver::initialise_search(Vector<Variable> &seq,
     objective = goal;
   } else if (!objective)
     objective = new Goal(Goal::SATISFACTION);
+  if (!objective->objective.is_void())
+    objective->objective = get_representative(objective->objective);
 
   heuristic->initialise(sequence);
 
@@ -2246,6 +3032,7 @@ Mistral::Solver::~Solver() {
   delete heuristic;
   delete policy;
   delete objective;
+  delete preprocessor;
 
   // std::cout << "c delete consolidate manager" << std::endl;
 
@@ -2333,6 +3120,9 @@ Mistral::Solver::~Solver() {
     //     delete constraint_graph[i].propagator;
     // #endif
   }
+
+  if (snapshot)
+    munmap(snapshot, snapshot_size);
 }
 
 
@@ -2959,6 +3749,50 @@ void Mistral::Solver::parity_processing(const int Knst) {
   }
 }
 
+void Mistral::Solver::gauss_processing() {
+  // all parity constraints on Boolean variables are gathered into a single
+  // Gauss-Jordan system, the constants are moved to the parity
+  VarArray X;
+  std::vector<int> column(variables.size, -1);
+  std::vector<std::vector<int> > rows;
+  std::vector<int> parities;
+
+  Variable *scope;
+  int arity, p, id;
+  bool boolean;
+  for (unsigned int i = 0; i < constraints.size; ++i) {
+    if (constraints[i].symbol() == "parity") {
+      scope = constraints[i].get_scope();
+      arity = constraints[i].arity();
+      boolean = true;
+      for (int j = 0; boolean && j < arity; ++j)
+        boolean = (scope[j].id() < 0 ? scope[j].get_min() == scope[j].get_max()
+                                      : scope[j].is_boolean());
+      if (!boolean)
+        continue;
+
+      p = ((ConstraintParity *)(constraints[i].propagator))->target_parity;
+      rows.push_back(std::vector<int>());
+      for (int j = 0; j < arity; ++j) {
+        id = scope[j].id();
+        if (id < 0) {
+          p ^= (scope[j].get_min() & 1);
+        } else {
+          if (column[id] < 0) {
+            column[id] = X.size;
+            X.add(variables[id]);
+          }
+          rows.back().push_back(column[id]);
+        }
+      }
+      parities.push_back(p);
+    }
+  }
+
+  if (rows.size() > 1)
+    add(Constraint(new ConstraintXorSystem(X, rows, parities)));
+}
+
 bool Mistral::Solver::is_pseudo_boolean() const {
 
   bool is_pb = true;
@@ -3298,6 +4132,189 @@ bool Mistral::Solver::rewrite()
   // return IS_OK(wiped_idx);
 }
 
+Mistral::Variable Mistral::Solver::get_representative(Variable x) {
+  if (alias.size && !x.is_void()) {
+    x = x.get_var();
+    int i = x.id();
+    if (i >= 0 && i < (int)alias.size && alias[i] >= 0) {
+      while (alias[i] >= 0)
+        i = alias[i];
+      x = variables[i];
+    }
+  }
+  return x;
+}
+
+// whether the constraint only depends on its scope and parameters, so that
+// its variables can be substituted with set_scope()
+static bool is_substitutable(Mistral::Constraint c) {
+  Mistral::Vector<int> params;
+  return (c.binary() || c.ternary() || c.propagator->get_signature(params));
+}
+
+// structural key of a constraint: name, scope and parameters
+static bool get_constraint_key(Mistral::Constraint c, std::string &key) {
+  Mistral::Vector<int> params;
+  if (!c.propagator->get_signature(params))
+    return false;
+
+  Mistral::Vector<Mistral::Variable> &scp = c.propagator->_scope;
+  key = c.propagator->name();
+  key += '(';
+  for (unsigned int i = 0; i < scp.size; ++i) {
+    int a[2] = {scp[i].is_ground(), 0};
+    a[1] = (a[0] ? scp[i].get_min() : scp[i].id());
+    key.append((const char *)a, 2 * sizeof(int));
+  }
+  key += ')';
+  for (unsigned int i = 0; i < params.size; ++i)
+    key.append((const char *)&params[i], sizeof(int));
+  return true;
+}
+
+// propagate() clears the failure, it is restored so that the search does not
+// start from an inconsistent root
+static bool presolve_failure(Mistral::Solver *s) {
+  s->fail();
+  return false;
+}
+
+bool Mistral::Solver::presolve() {
+  unsigned int i, j, k;
+  int x, y, n_merged = 0;
+  Constraint con, c;
+  Vector<int> tuple;
+  Vector<Constraint> equalities;
+
+  consolidate();
+  is_relevant.resize(variables.size, 0);
+  if (!propagate())
+    return presolve_failure(this);
+
+  unsigned int n_cons = posted_constraints.size;
+
+  // drop the constraints entailed at the root (in particular those whose
+  // variables are all fixed) and let the others tighten their parameters
+  for (i = posted_constraints.size; i--;) {
+    con = constraints[posted_constraints[i]];
+    if (con.propagator == base)
+      continue;
+    Vector<Variable> &scp = con.propagator->_scope;
+    bool entailed = true;
+    tuple.clear();
+    for (j = 0; entailed && j < scp.size; ++j) {
+      entailed = scp[j].is_ground();
+      if (entailed)
+        tuple.add(scp[j].get_min());
+    }
+    if (entailed) {
+      if (scp.size && con.propagator->check(tuple.stack_))
+        return presolve_failure(this);
+    } else {
+      entailed = con.propagator->simplify();
+    }
+    if (entailed) {
+      con.relax();
+      posted_constraints.remove(con.id());
+    } else if (dynamic_cast<ConstraintEqual *>(con.propagator)) {
+      equalities.add(con);
+    }
+  }
+
+  // merge the variables related by an equality (the one with fewer
+  // constraints is eliminated and its constraints are moved onto the other)
+  Vector<int> occurrences;
+  occurrences.initialise(variables.size, variables.size, 0);
+  for (i = 0; i < posted_constraints.size; ++i) {
+    Vector<Variable> &scp = constraints[posted_constraints[i]].propagator->_scope;
+    for (j = 0; j < scp.size; ++j)
+      if (!scp[j].is_ground())
+        ++occurrences[scp[j].id()];
+  }
+  int obj = (objective && !objective->objective.is_void()
+                 ? objective->objective.get_var().id()
+                 : -1);
+
+  for (i = 0; i < equalities.size; ++i) {
+    con = equalities[i];
+    Variable X = con.propagator->_scope[0];
+    Variable Y = con.propagator->_scope[1];
+    if (X.is_ground() || Y.is_ground() || X.domain_type != Y.domain_type)
+      continue;
+    x = X.id();
+    y = Y.id();
+    if (y == obj ||
+        (x != obj && constraint_graph[x].size() > constraint_graph[y].size()))
+      std::swap(x, y);
+
+    // x must not share another constraint with y, nor appear twice in one
+    // (the predicates assume distinct arguments), and every constraint on x
+    // must be reachable from its triggers
+    bool mergeable = (x != obj && occurrences[x] == constraint_graph[x].size());
+    for (Event trig = 0; mergeable && trig < 3; ++trig) {
+      for (j = constraint_graph[x].on[trig].size; mergeable && j--;) {
+        c = constraint_graph[x].on[trig][j];
+        if (c.propagator == con.propagator)
+          continue;
+        mergeable = is_substitutable(c);
+        Vector<Variable> &scp = c.propagator->_scope;
+        int count = 0;
+        for (k = 0; mergeable && k < scp.size; ++k) {
+          if (!scp[k].is_ground()) {
+            mergeable = (scp[k].id() != y);
+            count += (scp[k].id() == x);
+          }
+        }
+        mergeable &= (count == 1);
+      }
+    }
+    if (!mergeable)
+      continue;
+
+    con.relax();
+    posted_constraints.remove(con.id());
+    domain_types[x] |= REMOVED_VAR;
+    for (Event trig = 0; trig < 3; ++trig) {
+      for (j = constraint_graph[x].on[trig].size; j--;) {
+        c = constraint_graph[x].on[trig][j];
+        c.relax();
+        c.set_scope(c.index(), variables[y]);
+        // keep the scope up to date when y changes its domain type
+        consolidate_manager->notify_add_con(c);
+        add(c);
+      }
+    }
+
+    while (alias.size < variables.size)
+      alias.add(-1);
+    alias[x] = y;
+    occurrences[y] += occurrences[x] - 1;
+    occurrences[x] = 0;
+    ++n_merged;
+  }
+
+  // drop the duplicates (same name, scope and parameters), including those
+  // created by the merges
+  std::unordered_map<std::string, int> signatures;
+  std::string key;
+  for (i = posted_constraints.size; i--;) {
+    con = constraints[posted_constraints[i]];
+    if (get_constraint_key(con, key) &&
+        !signatures.insert(std::make_pair(key, con.id())).second) {
+      con.relax();
+      posted_constraints.remove(con.id());
+    }
+  }
+
+  if (parameters.verbosity > 0)
+    std::cout << " " << parameters.prefix_comment << " presolve: "
+              << (n_cons - posted_constraints.size)
+              << " constraints removed, " << n_merged << " variables merged"
+              << std::endl;
+
+  return (propagate() || presolve_failure(this));
+}
+
 Mistral::PropagationOutcome Mistral::Solver::propagate(Constraint c, 
 const bool force_trigger,
 const bool trigger_self) {
@@ -5399,6 +6416,17 @@ Mistral::Outcome Mistral::Solver::satisfied() {
     // std::cout << variables[i] << " := " << last_solution_lb[i] << " " <<
     // variables[i].get_domain() << std::endl;
   }
+  if (preprocessor) {
+    preprocessor->extend(last_solution_lb.stack_);
+    for (i = preprocessor->num_atoms; i--;)
+      last_solution_ub[i] = last_solution_lb[i];
+  }
+  for (i = 0; i < alias.size; ++i)
+    if (alias[i] >= 0) {
+      int r = get_representative(variables[i]).id();
+      last_solution_lb[i] = last_solution_lb[r];
+      last_solution_ub[i] = last_solution_ub[r];
+    }
   // std::cout << std::endl;
   ++statistics.num_solutions;
 
@@ -13483,6 +14511,8 @@ Mistral::BranchingHeuristic *Mistral::Solver::heuristic_factory(std::string var_
     std::cout << " " << parameters.prefix_comment
               << " Warning, there is no known heuristic \"" << var_ordering
               << "/" << branching << "\"" << std::endl;
+  } else if (parameters.objective_guided) {
+    heu = new ObjectiveGuided(this, heu);
   }
 
   return heu;
@@ -13623,6 +14653,14 @@ Mistral::SolverCmdLine::~SolverCmdLine() {
   // delete printArg;
   //  delete printsolArg;
   delete allsolArg;
+  delete preprocessArg;
+  delete presolveArg;
+  delete reuseTrailArg;
+  delete dichotomyArg;
+  delete probeArg;
+  delete objguidedArg;
+  delete flushArg;
+  delete binsolArg;
   delete printsolArg;
   delete printstaArg;
   delete printmodArg;
@@ -13719,6 +14757,52 @@ void Mistral::SolverCmdLine::initialise() {
   allsolArg = new TCLAP::SwitchArg("a", "all", "find all solutions", false);
   add(*allsolArg);
 
+  // WHETHER WE SIMPLIFY THE CLAUSES BEFORE SEARCH
+  preprocessArg = new TCLAP::SwitchArg(
+      "", "preprocess", "simplify the clauses of SAT/PB inputs", false);
+  add(*preprocessArg);
+
+  // WHETHER WE SIMPLIFY THE MODEL BEFORE SEARCH
+  presolveArg = new TCLAP::SwitchArg(
+      "", "presolve",
+      "merge equalities, drop entailed and duplicate constraints before search",
+      false);
+  add(*presolveArg);
+
+  reuseTrailArg = new TCLAP::SwitchArg(
+      "", "reuse-trail",
+      "on restart, keep the decisions that would be made again", false);
+  add(*reuseTrailArg);
+
+  dichotomyArg = new TCLAP::ValueArg<int>(
+      "", "dichotomy", "maximum number of dichotomic probes on the objective",
+      false, 0, "int");
+  add(*dichotomyArg);
+
+  probeArg = new TCLAP::ValueArg<int>(
+      "", "probe-fails", "failure limit of each dichotomic probe", false, 1000,
+      "int");
+  add(*probeArg);
+
+  objguidedArg = new TCLAP::SwitchArg(
+      "", "objective-guided",
+      "prefer values with the least impact on the objective", false);
+  add(*objguidedArg);
+
+  // SOLUTION OUTPUT
+  flushArg = new TCLAP::ValueArg<int>(
+      "", "flush-every",
+      "flush the output every n solutions (0: only when the buffer is full)",
+      false, 1, "int");
+  add(*flushArg);
+
+  binsolArg = new TCLAP::ValueArg<std::string>(
+      "", "binary-solutions",
+      "write the solutions (as raw vectors of 32 bits values) to this file "
+      "instead of printing them",
+      false, "", "string");
+  add(*binsolArg);
+
   // RESTART POLICY
   std::vector<std::string> rallowed;
   rallowed.push_back("no");
@@ -13899,7 +14983,13 @@ void Mistral::SolverCmdLine::set_parameters(Mistral::Solver& s) {
   s.parameters.prefix_objective = pobjectiveArg->getValue();
   s.parameters.prefix_solution = psolutionArg->getValue();
   s.parameters.prefix_outcome = poutcomeArg->getValue();
-  // s.parameters.find_all = allsolArg->getValue();
+  s.parameters.preprocess = preprocessArg->getValue();
+  s.parameters.presolve = presolveArg->getValue();
+  s.parameters.reuse_trail = reuseTrailArg->getValue();
+  s.parameters.dichotomy = dichotomyArg->getValue();
+  s.parameters.probe_fail_limit = probeArg->getValue();
+  s.parameters.objective_guided = objguidedArg->getValue();
+  s.parameters.find_all = (allsolArg->getValue() ? -1 : 0);
 }
 
 std::string Mistral::SolverCmdLine::get_value_ordering() {
@@ -13960,6 +15050,12 @@ bool Mistral::SolverCmdLine::enumerate_solutions() {
   return allsolArg->getValue();
 }
 
+int Mistral::SolverCmdLine::get_flush_period() { return flushArg->getValue(); }
+
+std::string Mistral::SolverCmdLine::get_binary_solutions() {
+  return binsolArg->getValue();
+}
+
 #ifdef _CHECK_NOGOOD
 
 void Mistral::Solver::store_reason(Explanation *expl, Atom a) {
@@ -395,6 +395,22 @@ std::ostream& Mistral::Variable::display(std::ostream& os) const {
 
 //#define _DEBUG_BUILD true
 
+static void extract_expression_variable(Mistral::Expression *expression,
+                                        Mistral::Solver *s) {
+  expression->extract_variable(s);
+
+  // SELF CHANGE
+  Mistral::Variable X = expression->_self;
+  expression->id = (X.domain_type == CONST_VAR ? -2 : X.id());
+  expression->solver = s;
+
+#ifdef _DEBUG_BUILD
+  std::cout << " extracted " << X << " -> predicate " << std::endl;
+#endif
+
+  expression->extract_predicate(s); //);
+}
+
 void Mistral::Variable::initialise(Solver *s, const int level) {
 
 // std::cout << "call initialise on " << *this << std::endl;
@@ -424,6 +440,23 @@ void Mistral::Variable::initialise(Solver *s, const int level) {
         expression->children[i].initialise(s, level + 1);
       }
 
+      // merging identical subexpressions must not turn two arguments of a
+      // (binary or ternary) predicate into the same variable
+      if (expression->children.size <= 3) {
+        for (unsigned int i = 1; i < expression->children.size; ++i) {
+          Variable &xi = expression->children[i];
+          for (unsigned int j = 0; j < i; ++j) {
+            if (xi.domain_type == EXPRESSION && xi.id() >= 0 &&
+                xi.id() == expression->children[j].id() &&
+                !xi.same_as(expression->children[j]) &&
+                s->is_merged(xi.expression)) {
+              extract_expression_variable(xi.expression, s);
+              break;
+            }
+          }
+        }
+      }
+
       // std::cout << "lvl = " << level << std::endl;
 
       if (level == 0 && !expression->children.empty()) {
@@ -440,20 +473,15 @@ void Mistral::Variable::initialise(Solver *s, const int level) {
         std::cout << "-> predicate! (extract var)" << std::endl;
 #endif
 
-        expression->extract_variable(s);
-
-        // SELF CHANGE
-        Variable X = expression->_self;
-        expression->id = (X.domain_type == CONST_VAR ? -2 : X.id());
-        expression->solver = s;
-
-#ifdef _DEBUG_BUILD
-        for (int i = 0; i <= level; ++i)
-          std::cout << "  ";
-        std::cout << " extracted " << X << " -> predicate " << std::endl;
-#endif
-
-        expression->extract_predicate(s); //);
+        // an identical expression was already extracted: share its variable
+        Expression *twin = s->get_subexpression(expression);
+        if (twin) {
+          expression->_self = twin->_self;
+          expression->id = twin->id;
+          expression->solver = s;
+        } else {
+          extract_expression_variable(expression, s);
+        }
       }
 
 #ifdef _DEBUG_BUILD
@@ -1294,7 +1322,8 @@ bool Mistral::Variable::intersect(const int lo, const int up) const {
   else if (domain_type == EXPRESSION)
     answer = expression->get_self().intersect(lo, up);
   else
-    answer = (((lo <= 0) | (2 * (up > 0))) & *bool_domain);
+    answer = (((lo <= 0 && up >= 0) | (2 * (lo <= 1 && up >= 1))) &
+              *bool_domain);
 
 #ifdef _PROFILING_PRIMITIVE
   PROFILING_FOOT(_m_intersect_range_)
@@ -2628,16 +2657,35 @@ Mistral::Variable Mistral::Variable::operator+(Variable x) {
   return exp;
 }
 
-Mistral::Variable Mistral::Variable::operator+(int k) {
-  Variable exp(new OffsetExpression(*this, k));
-  return exp;
+/* Affine views: offsets of offsets, factors of factors, and double
+   negations are folded as they are built, and comparisons absorb the offset
+   of their arguments, so that x+1+2 <= y-3 is a single precedence over x and
+   y instead of a chain of auxiliary variables and propagators. */
+static bool is_unary_expression(const Mistral::Variable &x,
+                                const char *name) {
+  return x.domain_type == EXPRESSION &&
+         !strcmp(x.expression->get_name(), name);
 }
 
-Mistral::Variable Mistral::Variable::operator-(int k) {
-  Variable exp(new OffsetExpression(*this, -k));
+// if x = y + k, returns y and adds k to ofs
+static Mistral::Variable strip_offset(Mistral::Variable x, int &ofs) {
+  while (is_unary_expression(x, "offset")) {
+    ofs += ((Mistral::OffsetExpression *)(x.expression))->offset;
+    x = x.expression->children[0];
+  }
+  return x;
+}
+
+Mistral::Variable Mistral::Variable::operator+(int k) {
+  Variable x = strip_offset(*this, k);
+  if (!k)
+    return x;
+  Variable exp(new OffsetExpression(x, k));
   return exp;
 }
 
+Mistral::Variable Mistral::Variable::operator-(int k) { return *this + (-k); }
+
 Mistral::MulExpression::MulExpression(Variable X, Variable Y)
     : Expression(X, Y) {}
 Mistral::MulExpression::~MulExpression() {
@@ -3027,7 +3075,14 @@ Mistral::Variable Mistral::Variable::operator*(Variable x) {
 }
 
 Mistral::Variable Mistral::Variable::operator*(int k) {
-  Variable exp(new FactorExpression(*this, k));
+  Variable x = *this;
+  while (is_unary_expression(x, "factor")) {
+    k *= ((FactorExpression *)(x.expression))->factor;
+    x = x.expression->children[0];
+  }
+  if (k == 1)
+    return x;
+  Variable exp(new FactorExpression(x, k));
   return exp;
 }
 
@@ -3131,6 +3186,8 @@ void Mistral::NotExpression::extract_predicate(Solver *s) {
 }
 
 Mistral::Variable Mistral::Variable::operator!() {
+  if (is_unary_expression(*this, "not"))
+    return expression->children[0];
   Variable exp(new NotExpression(*this));
   return exp;
 }
@@ -3165,6 +3222,8 @@ void Mistral::NegExpression::extract_predicate(Solver *s) {
 }
 
 Mistral::Variable Mistral::Variable::operator-() {
+  if (is_unary_expression(*this, "neg"))
+    return expression->children[0];
   Variable exp(new NegExpression(*this));
   return exp;
 }
@@ -4279,12 +4338,16 @@ Mistral::Variable Mistral::Variable::operator!=(Variable x) {
 }
 
 Mistral::Variable Mistral::Variable::operator==(const int x) {
-  Variable exp(new EqualExpression(*this, x, 1));
+  int k = 0;
+  Variable y = strip_offset(*this, k);
+  Variable exp(new EqualExpression(y, x - k, 1));
   return exp;
 }
 
 Mistral::Variable Mistral::Variable::operator!=(const int x) {
-  Variable exp(new EqualExpression(*this, x, 0));
+  int k = 0;
+  Variable y = strip_offset(*this, k);
+  Variable exp(new EqualExpression(y, x - k, 0));
   return exp;
 }
 
@@ -4387,44 +4450,56 @@ Mistral::Variable Mistral::Precedence(Variable X, const int d, Variable Y)
 }
 
 
+// x + k <= y, where offsets of x and y are absorbed into k
+static Mistral::Variable precedence(Mistral::Variable x, int k,
+                                    Mistral::Variable y) {
+  int kx = 0, ky = 0;
+  Mistral::Variable bx = strip_offset(x, kx);
+  Mistral::Variable by = strip_offset(y, ky);
+  if (bx.same_as(by))
+    return Mistral::Variable(new Mistral::PrecedenceExpression(x, y, k));
+  return Mistral::Variable(
+      new Mistral::PrecedenceExpression(bx, by, k + kx - ky));
+}
+
+// x <= k (spin) or x >= k (!spin)
+static Mistral::Variable bound(Mistral::Variable x, const int k,
+                               const int spin) {
+  int kx = 0;
+  Mistral::Variable bx = strip_offset(x, kx);
+  return Mistral::Variable(new Mistral::PrecedenceExpression(bx, k - kx, spin));
+}
+
 Mistral::Variable Mistral::Variable::operator<(Variable x) {
-  Variable exp(new PrecedenceExpression(*this, x, 1));
-  return exp;
+  return precedence(*this, 1, x);
 }
 
 Mistral::Variable Mistral::Variable::operator>(Variable x) {
-  Variable exp(new PrecedenceExpression(x, *this, 1));
-  return exp;
+  return precedence(x, 1, *this);
 }
 
 Mistral::Variable Mistral::Variable::operator<=(Variable x) {
-  Variable exp(new PrecedenceExpression(*this, x));
-  return exp;
+  return precedence(*this, 0, x);
 }
 
 Mistral::Variable Mistral::Variable::operator>=(Variable x) {
-  Variable exp(new PrecedenceExpression(x, *this));
-  return exp;
+  return precedence(x, 0, *this);
 }
 
 Mistral::Variable Mistral::Variable::operator<(const int k) {
-  Variable exp(new PrecedenceExpression(*this, k - 1, 1));
-  return exp;
+  return bound(*this, k - 1, 1);
 }
 
 Mistral::Variable Mistral::Variable::operator>(const int k) {
-  Variable exp(new PrecedenceExpression(*this, k + 1, 0));
-  return exp;
+  return bound(*this, k + 1, 0);
 }
 
 Mistral::Variable Mistral::Variable::operator<=(const int k) {
-  Variable exp(new PrecedenceExpression(*this, k, 1));
-  return exp;
+  return bound(*this, k, 1);
 }
 
 Mistral::Variable Mistral::Variable::operator>=(const int k) {
-  Variable exp(new PrecedenceExpression(*this, k, 0));
-  return exp;
+  return bound(*this, k, 0);
 }
 
 Mistral::DisjunctiveExpression::DisjunctiveExpression(const Variable X,
@@ -4549,8 +4624,24 @@ void Mistral::AllDiffExpression::extract_constraint(Solver *s) {
   //   Constraint *con = new ConstraintAllDiff(children);
   //   con->initialise();
   //   return con;
-  if (consistency_level == BOUND_CONSISTENCY)
+  int level = consistency_level;
+  if (level == AUTO_CONSISTENCY) {
+    // domain consistency pays off when the variables compete for few values
+    // (assignment-like), bounds consistency is used otherwise
+    int lb = INFTY, ub = -INFTY;
+    for (unsigned int i = 0; i < children.size; ++i) {
+      if (children[i].get_min() < lb)
+        lb = children[i].get_min();
+      if (children[i].get_max() > ub)
+        ub = children[i].get_max();
+    }
+    level = ((double)(ub - lb + 1) <= 2.0 * children.size ? DOMAIN_CONSISTENCY
+                                                           : BOUND_CONSISTENCY);
+  }
+  if (level == BOUND_CONSISTENCY)
     s->add(Constraint(new ConstraintAllDiff(children)));
+  else if (level == DOMAIN_CONSISTENCY)
+    s->add(Constraint(new ConstraintAllDiffGAC(children)));
   s->add(Constraint(new ConstraintCliqueNotEqual(children, exception)));
   //   Vector< Variable > pair;
   //   for(unsigned int i=0; i<children.size-1; ++i)
@@ -4706,6 +4797,17 @@ Mistral::OccurrencesExpression::~OccurrencesExpression() {
 }
 
 void Mistral::OccurrencesExpression::extract_constraint(Solver *s) {
+  if (consistency_level == DOMAIN_CONSISTENCY) {
+    std::vector<int> values, lbs, ubs;
+    for (int v = firstval; v <= lastval; ++v) {
+      values.push_back(v);
+      lbs.push_back(lower_bounds[v - firstval]);
+      ubs.push_back(upper_bounds[v - firstval]);
+    }
+    s->add(Constraint(new ConstraintGccGAC(children, values, lbs, ubs)));
+    return;
+  }
+
   if (consistency_level == BOUND_CONSISTENCY)
     s->add(Constraint(new ConstraintOccurrences(children, firstval, lastval,
                                                 lower_bounds, upper_bounds)));
@@ -4748,8 +4850,9 @@ Mistral::Variable Mistral::Occurrences(Vector< Variable >& args, std::vector<int
   // std::fill(lb, lb+last-first+1, -INFTY);
   // std::fill(ub, ub+last-first+1,  INFTY);
 
+  // values in the gaps of 'values' are unconstrained
   std::fill(lb, lb + last - first + 1, 0);
-  std::fill(ub, ub + last - first + 1, 0);
+  std::fill(ub, ub + last - first + 1, args.size);
 
   for (unsigned int i = 0; i < values.size(); ++i) {
     lb[values[i] - first] = lbs[i];
@@ -4761,6 +4864,48 @@ Mistral::Variable Mistral::Occurrences(Vector< Variable >& args, std::vector<int
 }
 
 
+Mistral::CardinalityExpression::CardinalityExpression(
+    Vector<Variable> &args, const std::vector<int> &vals,
+    Vector<Variable> &counts)
+    : Expression(args), values(vals) {
+  for (unsigned int i = 0; i < counts.size; ++i)
+    children.add(counts[i]);
+}
+
+Mistral::CardinalityExpression::~CardinalityExpression() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete cardinality expression" << std::endl;
+#endif
+}
+
+void Mistral::CardinalityExpression::extract_constraint(Solver *s) {
+  s->add(Constraint(new ConstraintGccGAC(children, values)));
+}
+
+void Mistral::CardinalityExpression::extract_variable(Solver *s) {
+  std::cerr << "Error: Cardinality constraint can't yet be used as a predicate"
+            << std::endl;
+  exit(0);
+}
+
+void Mistral::CardinalityExpression::extract_predicate(Solver *s) {
+  std::cerr << "Error: Cardinality constraint can't yet be used as a predicate"
+            << std::endl;
+  exit(0);
+}
+
+const char *Mistral::CardinalityExpression::get_name() const {
+  return "cardinality";
+}
+
+Mistral::Variable Mistral::Cardinality(Vector<Variable> &args,
+                                       const std::vector<int> &values,
+                                       Vector<Variable> &counts) {
+  Variable exp(new CardinalityExpression(args, values, counts));
+  return exp;
+}
+
+
 
 
 Mistral::VertexCoverExpression::VertexCoverExpression(Vector< Variable >& args, const Graph& g) 
@@ -4894,6 +5039,47 @@ Mistral::Variable Mistral::MultiAtMostSeqCard(Vector< Variable >& args, const in
   return exp;
 }
 
+Mistral::SequenceExpression::SequenceExpression(Vector<Variable> &args,
+                                                const int lo, const int hi,
+                                                const int q,
+                                                const std::vector<int> &vals)
+    : Expression(args), lower_bound(lo), upper_bound(hi), window(q),
+      values(vals) {}
+
+Mistral::SequenceExpression::~SequenceExpression() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete sequence expression" << std::endl;
+#endif
+}
+
+void Mistral::SequenceExpression::extract_constraint(Solver *s) {
+  s->add(Constraint(new ConstraintSequence(children, lower_bound, upper_bound,
+                                           window, values)));
+}
+
+void Mistral::SequenceExpression::extract_variable(Solver *s) {
+  std::cerr << "Error: Sequence constraint can't yet be used as a predicate"
+            << std::endl;
+  exit(0);
+}
+
+void Mistral::SequenceExpression::extract_predicate(Solver *s) {
+  std::cerr << "Error: Sequence constraint can't yet be used as a predicate"
+            << std::endl;
+  exit(0);
+}
+
+const char *Mistral::SequenceExpression::get_name() const {
+  return "sequence";
+}
+
+Mistral::Variable Mistral::Sequence(Vector<Variable> &args, const int lo,
+                                    const int hi, const int q,
+                                    const std::vector<int> &vals) {
+  Variable exp(new SequenceExpression(args, lo, hi, q, vals));
+  return exp;
+}
+
 Mistral::StretchExpression::StretchExpression(const Vector<Variable> &args,
                                               std::vector<int> &typ,
                                               std::vector<int> &lb,
@@ -5094,8 +5280,6 @@ Mistral::LexExpression::LexExpression(Vector<Variable> &r1,
     children.add(r1[i]);
   for (int i = 0; i < row_size; ++i)
     children.add(r2[i]);
-  for (int i = 0; i <= row_size; ++i)
-    children.add(Variable(0, 1));
   strict = st_;
 }
 
@@ -5106,51 +5290,7 @@ Mistral::LexExpression::~LexExpression() {
 }
 
 void Mistral::LexExpression::extract_constraint(Solver *s) {
-  int arity = (children.size - 1) / 3;
-  VarArray scp;
-  // scp.add(children[0]);
-  // scp.add(children[arity]);
-  // scp.add(children[2*arity]);
-
-  // s->add( new ConstraintLexf(scp) );
-
-  for (int i = 0; i < arity; ++i) {
-    scp.clear();
-
-    // scp.add(children[i]);
-    // scp.add(children[i+arity]);
-    // scp.add(children[i+2*arity]);
-    // scp.add(children[i+2*arity+1]);
-    //
-    // s->add(Constraint(new ConstraintLex(scp)));
-
-    s->add((children[i + 2 * arity] <= children[i + 2 * arity + 1]));
-
-    // assert(children[i + 2 * arity].id() != children[i + 2 * arity + 1].id());
-    // assert(children[i].id() != children[i + arity].id());
-
-    if (children[i + 2 * arity].id() != children[i + 2 * arity + 1].id()) {
-      if (children[i].id() != children[i + arity].id())
-        s->add((children[i + 2 * arity] < children[i + 2 * arity + 1]) <=
-               (children[i] < children[i + arity]));
-      else
-        s->add((children[i + 2 * arity] >= children[i + 2 * arity + 1]));
-    }
-
-    if (children[i].id() != children[i + arity].id()) {
-      s->add((children[i + 2 * arity] >= (children[i] > children[i + arity])));
-      s->add((children[i] != children[i + arity]) <= children[i + 2 * arity + 1]);
-    }
-    
-  }
-
-  if (FAILED(children[2 * arity].set_domain(0))) {
-    s->fail();
-  }
-  if (strict)
-    if (FAILED(children[3 * arity].set_domain(1))) {
-      s->fail();
-    }
+  s->add(Constraint(new ConstraintLexGAC(children, strict)));
 }
 
 void Mistral::LexExpression::extract_variable(Solver *s) {
@@ -5177,6 +5317,49 @@ Mistral::Variable Mistral::LexLess(VarArray& r1, VarArray& r2) {
   return exp;
 }
 
+Mistral::LexChainExpression::LexChainExpression(std::vector<VarArray> &rows,
+                                                const int st_)
+    : Expression() {
+  row_size = (rows.empty() ? 0 : rows[0].size);
+  for (auto &r : rows)
+    for (unsigned int i = 0; i < r.size; ++i)
+      children.add(r[i]);
+  strict = st_;
+}
+
+Mistral::LexChainExpression::~LexChainExpression() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete lex chain expression" << std::endl;
+#endif
+}
+
+void Mistral::LexChainExpression::extract_constraint(Solver *s) {
+  if (row_size && children.size > (unsigned)row_size)
+    s->add(Constraint(new ConstraintLexChain(children, row_size, strict)));
+}
+
+void Mistral::LexChainExpression::extract_variable(Solver *s) {
+  std::cerr << "Error: LexChain constraint can't be used as a predicate"
+            << std::endl;
+  exit(0);
+}
+
+void Mistral::LexChainExpression::extract_predicate(Solver *s) {
+  std::cerr << "Error: LexChain constraint can't be used as a predicate"
+            << std::endl;
+  exit(0);
+}
+
+const char *Mistral::LexChainExpression::get_name() const {
+  return "lex_chain";
+}
+
+Mistral::Variable Mistral::LexChain(std::vector<VarArray> &rows,
+                                    const int strict) {
+  Variable exp(new LexChainExpression(rows, strict));
+  return exp;
+}
+
 Mistral::Variable Mistral::VarArray::operator<(VarArray& X) {
   return LexLess(*this, X);
 }
@@ -5446,14 +5629,18 @@ Mistral::Variable Mistral::BoolSum(Vector< Variable >& args, const Vector< int >
 Mistral::KnapsackExpression::KnapsackExpression(std::vector<Variable> &args,
                                                 const int w_bound,
                                                 const std::vector<int> &w,
-                                                const std::vector<int> &p)
-    : Expression(args), weight_upper_bound(w_bound), weight(w), profit(p) {}
+                                                const std::vector<int> &p,
+                                                const int w_lbound)
+    : Expression(args), weight_upper_bound(w_bound),
+      weight_lower_bound(w_lbound), weight(w), profit(p) {}
 
 Mistral::KnapsackExpression::KnapsackExpression(Vector<Variable> &args,
                                                 const int w_bound,
                                                 const std::vector<int> &w,
-                                                const std::vector<int> &p)
-    : Expression(args), weight_upper_bound(w_bound), weight(w), profit(p) {}
+                                                const std::vector<int> &p,
+                                                const int w_lbound)
+    : Expression(args), weight_upper_bound(w_bound),
+      weight_lower_bound(w_lbound), weight(w), profit(p) {}
 
 void Mistral::KnapsackExpression::order_vars() {
   // std::vector<int> order(children.size);
@@ -5525,22 +5712,56 @@ void Mistral::KnapsackExpression::extract_variable(Solver *s) {
 }
 
 void Mistral::KnapsackExpression::extract_predicate(Solver *s) {
-  s->add(Constraint(
-      new PredicateKnapsack(children, weight_upper_bound, weight, profit)));
+  bool non_negative = (weight_upper_bound >= 0);
+  for (unsigned int i = 0; non_negative && i < weight.size(); ++i)
+    non_negative = (weight[i] >= 0 && profit[i] >= 0 &&
+                    children[i].get_min() >= 0);
+
+  ConstraintKnapsack *knapsack = NULL;
+  if (non_negative) {
+    knapsack = new ConstraintKnapsack(children, weight, profit,
+                                      std::max(0, weight_lower_bound),
+                                      weight_upper_bound);
+    s->add(Constraint(knapsack));
+    // the DP filters both sums on its own
+    if (knapsack->use_dp)
+      return;
+  } else {
+    s->add(Constraint(
+        new PredicateKnapsack(children, weight_upper_bound, weight, profit)));
+  }
+
+  // otherwise the sums remain: the reduced costs prune the items neither from
+  // the upper bound of the profit nor from the lower capacity
+  bool boolean = true;
+  for (unsigned int i = 0; boolean && i < weight.size(); ++i)
+    boolean = children[i].is_boolean();
 
   Vector<int> W;
   for(auto w : profit)
     W.add(w);
-  s->add(Constraint(new PredicateWeightedBoolSum(children, W)));
-
   auto args{children};
   args.pop();
+  if (boolean) {
+    s->add(Constraint(new PredicateWeightedBoolSum(children, W)));
+  } else {
+    W.add(-1);
+    s->add(Constraint(new PredicateWeightedSum(children, W, 0, 0)));
+  }
+
+  // the upper capacity alone is enforced by the reduced costs
+  if (knapsack && weight_lower_bound <= 0)
+    return;
+
   W.clear();
   for(auto w : weight)
     W.add(w);
-  s->add(Constraint(new ConstraintWeightedBoolSumInterval(
-      args, W, -INFTY, weight_upper_bound)));
-
+  if (boolean && weight_lower_bound == -INFTY)
+    s->add(Constraint(new ConstraintWeightedBoolSumInterval(
+        args, W, -INFTY, weight_upper_bound)));
+  else
+    s->add(Constraint(new PredicateWeightedSum(args, W, weight_lower_bound,
+                                               weight_upper_bound)));
 }
 
 const char *Mistral::KnapsackExpression::get_name() const { return "knapsack"; }
@@ -5548,15 +5769,17 @@ const char *Mistral::KnapsackExpression::get_name() const { return "knapsack"; }
 Mistral::Variable Mistral::Knapsack(std::vector<Variable> &args,
                                     const int w_bound,
                                     const std::vector<int> &w,
-                                    const std::vector<int> &p) {
-  Variable exp(new KnapsackExpression(args, w_bound, w, p));
+                                    const std::vector<int> &p,
+                                    const int w_lbound) {
+  Variable exp(new KnapsackExpression(args, w_bound, w, p, w_lbound));
   return exp;
 }
 
 Mistral::Variable Mistral::Knapsack(Vector<Variable> &args, const int w_bound,
                                     const std::vector<int> &w,
-                                    const std::vector<int> &p) {
-  Variable exp(new KnapsackExpression(args, w_bound, w, p));
+                                    const std::vector<int> &p,
+                                    const int w_lbound) {
+  Variable exp(new KnapsackExpression(args, w_bound, w, p, w_lbound));
   return exp;
 }
 
@@ -5841,8 +6064,12 @@ void Mistral::LinearExpression::extract_constraint(Solver *s) {
 
       // std::cout << "PredicateWeightedSum" << std::endl;
 
-      s->add(Constraint(new PredicateWeightedSum(children, weight, lower_bound,
-                                                 upper_bound)));
+      if (children.size >= LONG_SUM_ARITY)
+        s->add(Constraint(new ConstraintIncrementalWeightedSum(
+            children, weight, lower_bound, upper_bound)));
+      else
+        s->add(Constraint(new PredicateWeightedSum(children, weight,
+                                                   lower_bound, upper_bound)));
     }
   }
   //
@@ -5905,8 +6132,12 @@ void Mistral::LinearExpression::extract_variable(Solver *s) {
 const char *Mistral::LinearExpression::get_name() const { return "linear_sum"; }
 
 void Mistral::LinearExpression::extract_predicate(Solver *s) {
-  s->add(
-      Constraint(new PredicateWeightedSum(children, weight, -offset, -offset)));
+  if (children.size >= LONG_SUM_ARITY)
+    s->add(Constraint(new ConstraintIncrementalWeightedSum(children, weight,
+                                                           -offset, -offset)));
+  else
+    s->add(Constraint(
+        new PredicateWeightedSum(children, weight, -offset, -offset)));
 }
 
 Mistral::Variable Mistral::Sum(Vector< Variable >& args, Variable T, const int offset) {
@@ -6165,6 +6396,104 @@ void Mistral::MaxExpression::extract_predicate(Solver *s) {
   s->add(Constraint(new PredicateMax(children)));
 }
 
+Mistral::Variable Mistral::NValue(Vector<Variable>& X) {
+  Variable exp(new NValueExpression(X));
+  return exp;
+}
+
+Mistral::Variable Mistral::NValue(VarArray& X) {
+  Variable exp(new NValueExpression(X));
+  return exp;
+}
+
+Mistral::NValueExpression::NValueExpression(Vector<Variable> &args)
+    : Expression(args) {}
+
+Mistral::NValueExpression::~NValueExpression() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete nvalue expression" << std::endl;
+#endif
+}
+
+void Mistral::NValueExpression::extract_constraint(Solver *s) {
+  std::cerr << "Error: NValue predicate can't be used as a constraint"
+            << std::endl;
+  exit(0);
+}
+
+void Mistral::NValueExpression::extract_variable(Solver *s) {
+  int arity = children.size;
+  int lower_bound = (arity > 0);
+  int upper_bound = arity;
+
+  if (arity) {
+    int lb = children[0].get_min(), ub = children[0].get_max();
+    for (int i = 1; i < arity; ++i) {
+      if (children[i].get_min() < lb)
+        lb = children[i].get_min();
+      if (children[i].get_max() > ub)
+        ub = children[i].get_max();
+    }
+    if (ub - lb + 1 < upper_bound)
+      upper_bound = ub - lb + 1;
+  }
+
+  Variable aux(lower_bound, upper_bound, DYN_VAR);
+  _self = aux;
+
+  _self.initialise(s, 1);
+  _self = _self.get_var();
+  children.add(_self);
+}
+
+const char *Mistral::NValueExpression::get_name() const { return "nvalue"; }
+
+void Mistral::NValueExpression::extract_predicate(Solver *s) {
+  s->add(Constraint(new ConstraintNValue(children)));
+}
+
+Mistral::Variable Mistral::BinPacking(Vector<Variable> &items,
+                                      const std::vector<int> &sizes,
+                                      Vector<Variable> &loads,
+                                      const int first) {
+  Variable exp(new BinPackingExpression(items, sizes, loads, first));
+  return exp;
+}
+
+Mistral::BinPackingExpression::BinPackingExpression(
+    Vector<Variable> &items, const std::vector<int> &sizes,
+    Vector<Variable> &loads, const int first)
+    : Expression(items), size(sizes), first_bin(first) {
+  for (unsigned int j = 0; j < loads.size; ++j)
+    children.add(loads[j]);
+}
+
+Mistral::BinPackingExpression::~BinPackingExpression() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete binpacking expression" << std::endl;
+#endif
+}
+
+void Mistral::BinPackingExpression::extract_constraint(Solver *s) {
+  s->add(Constraint(new ConstraintBinPacking(children, size, first_bin)));
+}
+
+void Mistral::BinPackingExpression::extract_variable(Solver *s) {
+  std::cerr << "Error: BinPacking constraint can't yet be used as a predicate"
+            << std::endl;
+  exit(0);
+}
+
+void Mistral::BinPackingExpression::extract_predicate(Solver *s) {
+  std::cerr << "Error: BinPacking constraint can't yet be used as a predicate"
+            << std::endl;
+  exit(0);
+}
+
+const char *Mistral::BinPackingExpression::get_name() const {
+  return "binpacking";
+}
+
 
 Mistral::ElementExpression::ElementExpression(const Vector< Variable >& args, 
 Variable X, int ofs) 
@@ -6323,7 +6652,95 @@ void Mistral::ElementExpression::extract_predicate(Solver *s) {
   else
     std::cout << "ok\n";
 #endif
-  s->add(Constraint(new PredicateElement(children, offset)));
+
+  // an array of constants is handled by a dedicated propagator
+  bool constant_array = true;
+  for (int i = 0; constant_array && i < arity; ++i)
+    constant_array = children[i].is_ground();
+
+  if (constant_array) {
+    std::vector<int> table;
+    for (int i = 0; i < arity; ++i)
+      table.push_back(children[i].get_value());
+    Vector<Variable> scp;
+    scp.add(children[arity]);
+    scp.add(children[arity + 1]);
+    s->add(Constraint(new ConstraintIntElement(scp, table, offset)));
+  } else {
+    s->add(Constraint(new PredicateElement(children, offset)));
+  }
+}
+
+Mistral::Element2DExpression::Element2DExpression(
+    const std::vector<std::vector<int> > &M, Variable R, Variable C,
+    const int ro, const int co)
+    : Expression(R, C), matrix(M), row_offset(ro), col_offset(co) {}
+
+Mistral::Element2DExpression::~Element2DExpression() {
+#ifdef _DEBUG_MEMORY
+  std::cout << "c delete element2d expression" << std::endl;
+#endif
+}
+
+void Mistral::Element2DExpression::extract_constraint(Solver *s) {
+  std::cerr << "Error: Element2D predicate can't be used as a constraint"
+            << std::endl;
+  exit(0);
+}
+
+void Mistral::Element2DExpression::extract_variable(Solver *s) {
+  // the values of the cells reachable from the domains of the indices
+  std::vector<int> reachable;
+  int r, c, rnxt = children[0].get_min(), cnxt;
+  do {
+    r = rnxt;
+    rnxt = children[0].next(r);
+    if (r - row_offset >= 0 && r - row_offset < (int)matrix.size()) {
+      const std::vector<int> &row = matrix[r - row_offset];
+      cnxt = children[1].get_min();
+      do {
+        c = cnxt;
+        cnxt = children[1].next(c);
+        if (c - col_offset >= 0 && c - col_offset < (int)row.size())
+          reachable.push_back(row[c - col_offset]);
+      } while (c < cnxt);
+    }
+  } while (r < rnxt);
+
+  std::sort(reachable.begin(), reachable.end());
+  Vector<int> values;
+  for (unsigned int i = 0; i < reachable.size(); ++i)
+    if (!i || reachable[i] != reachable[i - 1])
+      values.add(reachable[i]);
+  if (values.empty()) {
+    // no reachable cell, the variable is only built for consistency
+    s->fail();
+    values.add(0);
+  }
+
+  Variable aux(values, DYN_VAR);
+  _self = aux;
+
+  _self.initialise(s, 1);
+  _self = _self.get_var();
+
+  children.add(_self);
+}
+
+const char *Mistral::Element2DExpression::get_name() const {
+  return "element2d";
+}
+
+void Mistral::Element2DExpression::extract_predicate(Solver *s) {
+  s->add(Constraint(
+      new ConstraintElement2D(children, matrix, row_offset, col_offset)));
+}
+
+Mistral::Variable Mistral::Element(const std::vector<std::vector<int> > &M,
+                                   Variable row, Variable col,
+                                   const int row_offset, const int col_offset) {
+  Variable exp(new Element2DExpression(M, row, col, row_offset, col_offset));
+  return exp;
 }
 
 